@@ -18,3 +18,7 @@ if (PROJECT_IS_DARWIN)
 endif()
 
 add_project_test_executable(${PROJECT_NAME}_test lib${PROJECT_NAME} lib${PROJECT_NAME})
+
+if (PROJECT_ENABLE_TESTING)
+  add_project_executable(${PROJECT_NAME}_bench lib${PROJECT_NAME} lib${PROJECT_NAME})
+endif()
@@ -74,9 +74,11 @@ private:
   std::atomic<std::uint16_t> api_port_;
   utils::atomic<std::string> api_user_;
   std::string cache_directory_;
+  std::atomic<std::uint64_t> chunk_cache_size_bytes_;
   std::atomic<bool> config_changed_;
   std::string data_directory_;
   std::atomic<database_type> db_type_{database_type::rocksdb};
+  std::atomic<std::uint16_t> directory_cache_timeout_secs_;
   std::atomic<std::uint8_t> download_timeout_secs_;
   std::atomic<bool> enable_download_timeout_;
   std::atomic<bool> enable_drive_events_;
@@ -87,13 +89,18 @@ private:
   std::atomic<std::uint32_t> eviction_delay_mins_;
   std::atomic<bool> eviction_uses_accessed_time_;
   std::atomic<std::uint16_t> high_freq_interval_secs_;
+  std::atomic<std::uint16_t> kernel_attr_timeout_secs_;
   std::string log_directory_;
   std::atomic<std::uint16_t> low_freq_interval_secs_;
   std::atomic<std::uint64_t> max_cache_size_bytes_;
+  std::atomic<std::uint8_t> max_download_count_;
+  std::atomic<std::uint64_t> max_upload_bytes_;
   std::atomic<std::uint8_t> max_upload_count_;
   std::atomic<std::uint16_t> med_freq_interval_secs_;
+  std::atomic<std::uint16_t> meta_flush_interval_secs_;
   std::atomic<std::uint16_t> online_check_retry_secs_;
   std::atomic<download_type> preferred_download_type_;
+  std::atomic<read_ahead_policy> read_ahead_policy_;
   std::atomic<std::uint16_t> retry_read_count_;
   std::atomic<std::uint16_t> ring_buffer_file_size_;
   std::atomic<std::uint16_t> task_wait_ms_;
@@ -129,12 +136,17 @@ public:
 
   [[nodiscard]] auto get_cache_directory() const -> std::string;
 
+  [[nodiscard]] auto get_chunk_cache_size_bytes() const -> std::uint64_t;
+
   [[nodiscard]] auto get_config_file_path() const -> std::string;
 
   [[nodiscard]] auto get_database_type() const -> database_type;
 
   [[nodiscard]] auto get_data_directory() const -> std::string;
 
+  [[nodiscard]] auto get_directory_cache_timeout_secs() const
+      -> std::uint16_t;
+
   [[nodiscard]] auto get_download_timeout_secs() const -> std::uint8_t;
 
   [[nodiscard]] auto get_enable_download_timeout() const -> bool;
@@ -161,20 +173,30 @@ public:
 
   [[nodiscard]] auto get_log_directory() const -> std::string;
 
+  [[nodiscard]] auto get_kernel_attr_timeout_secs() const -> std::uint16_t;
+
   [[nodiscard]] auto get_low_frequency_interval_secs() const -> std::uint16_t;
 
   [[nodiscard]] auto get_max_cache_size_bytes() const -> std::uint64_t;
 
+  [[nodiscard]] auto get_max_download_count() const -> std::uint8_t;
+
+  [[nodiscard]] auto get_max_upload_bytes() const -> std::uint64_t;
+
   [[nodiscard]] auto get_max_upload_count() const -> std::uint8_t;
 
   [[nodiscard]] auto get_med_frequency_interval_secs() const -> std::uint16_t;
 
+  [[nodiscard]] auto get_meta_flush_interval_secs() const -> std::uint16_t;
+
   [[nodiscard]] auto get_online_check_retry_secs() const -> std::uint16_t;
 
   [[nodiscard]] auto get_preferred_download_type() const -> download_type;
 
   [[nodiscard]] auto get_provider_type() const -> provider_type;
 
+  [[nodiscard]] auto get_read_ahead_policy() const -> read_ahead_policy;
+
   [[nodiscard]] auto get_remote_config() const -> remote::remote_config;
 
   [[nodiscard]] auto get_remote_mount() const -> remote::remote_mount;
@@ -205,10 +227,14 @@ public:
 
   void set_api_user(std::string_view value);
 
+  void set_chunk_cache_size_bytes(std::uint64_t value);
+
   void set_download_timeout_secs(std::uint8_t value);
 
   void set_database_type(const database_type &value);
 
+  void set_directory_cache_timeout_secs(std::uint16_t value);
+
   void set_enable_download_timeout(bool value);
 
   void set_enable_drive_events(bool value);
@@ -229,18 +255,28 @@ public:
 
   void set_host_config(host_config value);
 
+  void set_kernel_attr_timeout_secs(std::uint16_t value);
+
   void set_low_frequency_interval_secs(std::uint16_t value);
 
   void set_max_cache_size_bytes(std::uint64_t value);
 
+  void set_max_download_count(std::uint8_t value);
+
+  void set_max_upload_bytes(std::uint64_t value);
+
   void set_max_upload_count(std::uint8_t value);
 
   void set_med_frequency_interval_secs(std::uint16_t value);
 
+  void set_meta_flush_interval_secs(std::uint16_t value);
+
   void set_online_check_retry_secs(std::uint16_t value);
 
   void set_preferred_download_type(const download_type &value);
 
+  void set_read_ahead_policy(const read_ahead_policy &value);
+
   void set_remote_config(remote::remote_config value);
 
   void set_remote_mount(remote::remote_mount value);
@@ -69,6 +69,9 @@ public:
   [[nodiscard]] static auto create_host_config(const s3_config &cfg)
       -> host_config;
 
+  [[nodiscard]] static auto get_pool_key(const host_config &cfg)
+      -> std::string;
+
   [[nodiscard]] static auto url_encode(CURL *curl, std::string_view data,
                                        bool allow_slash) -> std::string;
 
@@ -147,8 +150,10 @@ public:
 
       response_code = 0;
 
-      auto *curl = create_curl();
+      auto pool_key = get_pool_key(cfg);
+      auto *curl = reset_curl(curl_shared::acquire(pool_key));
       if (not request.set_method(curl, stop_requested)) {
+        curl_shared::release(pool_key, curl);
         return false;
       }
 
@@ -217,10 +222,14 @@ public:
       auto url = construct_url(curl, request.get_path(), cfg) + parameters;
       curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
 
-      multi_request curl_request(curl, stop_requested);
+      {
+        multi_request curl_request(curl, stop_requested);
+
+        curl_code = CURLE_OK;
+        curl_request.get_result(curl_code, response_code);
+      }
 
-      curl_code = CURLE_OK;
-      curl_request.get_result(curl_code, response_code);
+      curl_shared::release(pool_key, curl);
 
       if (header_list != nullptr) {
         curl_slist_free_all(header_list);
@@ -44,9 +44,16 @@ public:
   auto operator=(const curl_shared &) -> curl_shared & = delete;
   auto operator=(curl_shared &&) -> curl_shared & = delete;
 
+public:
+  static constexpr std::size_t max_pool_size{32U};
+
 private:
   static curl_sh_t cache_;
-  static std::recursive_mutex mtx_;
+  static std::array<std::mutex, CURL_LOCK_DATA_LAST> mtx_list_;
+  static std::unordered_map<std::string, std::deque<CURL *>> pool_;
+  static std::atomic<std::uint64_t> pool_hits_;
+  static std::atomic<std::uint64_t> pool_misses_;
+  static std::mutex pool_mtx_;
 
 private:
   static void lock_callback(CURL * /* curl */, curl_lock_data /* data */,
@@ -56,10 +63,18 @@ private:
                               curl_lock_access /* access */, void * /* ptr */);
 
 public:
+  [[nodiscard]] static auto acquire(std::string_view key) -> CURL *;
+
   static void cleanup();
 
+  [[nodiscard]] static auto get_pool_hits() -> std::uint64_t;
+
+  [[nodiscard]] static auto get_pool_misses() -> std::uint64_t;
+
   [[nodiscard]] static auto init() -> bool;
 
+  static void release(std::string_view key, CURL *curl);
+
   static void set_share(CURL *curl);
 };
 } // namespace repertory
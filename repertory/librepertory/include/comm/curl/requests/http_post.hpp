@@ -26,6 +26,7 @@
 
 namespace repertory::curl::requests {
 struct http_post final : http_request_base {
+  std::optional<std::string> body;
   std::optional<nlohmann::json> json;
 
   [[nodiscard]] auto get_type() const -> std::string override { return "post"; }
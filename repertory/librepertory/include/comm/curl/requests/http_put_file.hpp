@@ -28,6 +28,7 @@
 namespace repertory::curl::requests {
 struct http_put_file final : http_request_base {
   std::shared_ptr<utils::encryption::encrypting_reader> reader;
+  std::optional<http_range> source_range;
   std::string source_path;
 
   [[nodiscard]] auto get_type() const -> std::string override { return "put"; }
@@ -36,7 +37,18 @@ struct http_put_file final : http_request_base {
       -> bool override;
 
 private:
+  struct read_range_info final {
+    utils::encryption::encrypting_reader *reader{};
+    std::uint64_t remain{};
+  };
+
   mutable std::shared_ptr<read_file_info> read_info{};
+  mutable std::shared_ptr<read_range_info> range_info{};
+
+private:
+  [[nodiscard]] static auto range_reader(char *buffer, size_t size,
+                                         size_t nitems, void *instream)
+      -> size_t;
 };
 } // namespace repertory::curl::requests
 
@@ -33,6 +33,7 @@ struct read_file_info final {
   stop_type &stop_requested;
   std::unique_ptr<utils::file::i_file> file{};
   std::uint64_t offset{};
+  std::optional<std::uint64_t> end_offset{};
 };
 
 [[nodiscard]] auto curl_file_reader(char *buffer, size_t size, size_t nitems,
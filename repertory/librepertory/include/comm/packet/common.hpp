@@ -22,10 +22,29 @@
 #ifndef REPERTORY_INCLUDE_COMM_PACKET_COMMON_HPP_
 #define REPERTORY_INCLUDE_COMM_PACKET_COMMON_HPP_
 
+#include "utils/hash.hpp"
+
 namespace repertory::comm {
 inline static constexpr std::uint32_t max_packet_bytes{32U * 1024U * 1024U};
 inline constexpr const std::uint8_t max_read_attempts{2U};
 inline constexpr const std::uint16_t packet_nonce_size{256U};
+
+// Protocol 1 allows one outstanding request per connection. Protocol 2 tags
+// each request with an ID so many requests can be in flight on a connection
+// and their responses can arrive out of order. Protocol 3 adds paged
+// directory listings that carry each entry's attributes. Clients request the
+// latest protocol with a protocol method call immediately after the
+// handshake and servers answer with the highest protocol they support;
+// servers that do not recognize the method leave the connection on
+// protocol 1.
+inline constexpr const std::string_view packet_protocol_method{
+    "::packet_protocol"};
+inline constexpr const std::uint32_t packet_protocol_single{1U};
+inline constexpr const std::uint32_t packet_protocol_multiplexed{2U};
+inline constexpr const std::uint32_t packet_protocol_readdir_plus{3U};
+inline constexpr const std::uint32_t packet_protocol_latest{
+    packet_protocol_readdir_plus,
+};
 inline constexpr const std::size_t read_write_size{131072U};
 inline constexpr const std::uint16_t server_handshake_timeout_ms{3000U};
 
@@ -47,6 +66,12 @@ private:
 
 void apply_common_socket_properties(boost::asio::ip::tcp::socket &sock);
 
+// Protocol 2 connections encrypt with a key bound to the connection nonce,
+// derived once after negotiation instead of hashing the token per packet.
+[[nodiscard]] auto create_session_key(const utils::hash::hash_256_t &token_key,
+                                      std::string_view nonce)
+    -> utils::hash::hash_256_t;
+
 [[nodiscard]] auto is_socket_still_alive(boost::asio::ip::tcp::socket &sock)
     -> bool;
 } // namespace repertory::comm
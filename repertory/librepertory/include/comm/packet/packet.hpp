@@ -110,8 +110,12 @@ public:
 
   [[nodiscard]] auto decode(remote::file_info &val) -> error_type;
 
+  [[nodiscard]] auto decode(remote::directory_entry &val) -> error_type;
+
   [[nodiscard]] auto decrypt(std::string_view token) -> error_type;
 
+  [[nodiscard]] auto decrypt(const utils::hash::hash_256_t &key) -> error_type;
+
   void encode(const void *buffer, std::size_t size, bool should_reserve = true);
 
   void encode(const char *str) {
@@ -158,6 +162,8 @@ public:
 
   void encode(remote::file_info val);
 
+  void encode(const remote::directory_entry &val);
+
   void encode_top(const void *buffer, std::size_t size,
                   bool should_reserve = true);
 
@@ -202,6 +208,8 @@ public:
 
   void encrypt(std::string_view token, bool include_size = true);
 
+  void encrypt(const utils::hash::hash_256_t &key, bool include_size = true);
+
   [[nodiscard]] auto get_size() const -> std::uint32_t {
     return static_cast<std::uint32_t>(buffer_.size());
   }
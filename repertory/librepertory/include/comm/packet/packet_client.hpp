@@ -27,10 +27,39 @@ using boost::asio::ip::tcp;
 namespace repertory {
 class packet_client final {
 private:
+  struct pending_request final {
+    bool complete{false};
+    std::mutex mtx;
+    std::condition_variable notify;
+    packet response;
+    bool success{false};
+  };
+
   struct client final {
     explicit client(boost::asio::io_context &ctx) : socket(ctx) {}
+
+    client(const client &) = delete;
+    client(client &&) = delete;
+
+    ~client();
+
+    auto operator=(const client &) -> client & = delete;
+    auto operator=(client &&) -> client & = delete;
+
+    utils::hash::hash_256_t key{};
     std::string nonce;
     tcp::socket socket;
+
+    // Only used once the connection has negotiated protocol 2
+    std::atomic<bool> alive{true};
+    std::atomic<std::uint32_t> in_flight{0U};
+    bool multiplexed{false};
+    std::uint64_t next_request_id{};
+    std::unordered_map<std::uint64_t, std::shared_ptr<pending_request>>
+        pending;
+    std::mutex pending_mtx;
+    std::unique_ptr<std::thread> reader;
+    std::mutex write_mtx;
   };
 
 public:
@@ -45,11 +74,15 @@ public:
 
 private:
   remote::remote_config cfg_;
+  utils::hash::hash_256_t encryption_key_;
   mutable boost::asio::io_context io_context_;
   utils::atomic<std::string> unique_id_;
 
 private:
   std::atomic<bool> allow_connections_{true};
+  std::atomic<bool> multiplex_supported_{true};
+  std::atomic<bool> multiplexed_{false};
+  std::atomic<std::uint32_t> protocol_{0U};
   utils::atomic<
       boost::asio::ip::basic_resolver<boost::asio::ip::tcp>::results_type>
       resolve_results_;
@@ -69,21 +102,35 @@ private:
   [[nodiscard]] auto handshake(client &cli, std::uint32_t &min_version) const
       -> bool;
 
+  [[nodiscard]] auto negotiate_protocol(client &cli) -> bool;
+
   void put_client(std::shared_ptr<client> &cli);
 
-  void read_data(client &cli, data_buffer &buffer) const;
+  void read_data(client &cli, data_buffer &buffer, bool timed) const;
 
-  [[nodiscard]] auto read_packet(client &cli, packet &response) const
-      -> packet::error_type;
+  [[nodiscard]] auto read_packet(client &cli, packet &response,
+                                 bool timed) const -> packet::error_type;
+
+  void read_responses(client &cli) const;
 
   void resolve();
 
+  [[nodiscard]] auto send_multiplexed(client &cli, const packet &base_request,
+                                      packet &request, packet &response) const
+      -> packet::error_type;
+
   void write_data(client &cli, const packet &request) const;
 
 public:
   [[nodiscard]] auto check_version(std::uint32_t client_version,
                                    std::uint32_t &min_version) -> api_error;
 
+  // Protocol negotiated by the most recent connection or 0 before the first
+  // connection is made
+  [[nodiscard]] auto get_protocol() const -> std::uint32_t {
+    return protocol_;
+  }
+
   [[nodiscard]] auto send(std::string_view method, std::uint32_t &service_flags)
       -> packet::error_type;
 
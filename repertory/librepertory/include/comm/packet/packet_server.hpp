@@ -39,9 +39,11 @@ public:
                          packet *, packet &, message_complete_callback)>;
 
 public:
+  // max_protocol caps the protocol answered during negotiation
   packet_server(std::uint16_t port, std::string token, std::uint8_t pool_size,
                 closed_callback closed,
-                message_handler_callback message_handler);
+                message_handler_callback message_handler,
+                std::uint32_t max_protocol = comm::packet_protocol_latest);
 
   ~packet_server();
 
@@ -60,17 +62,26 @@ private:
     tcp::acceptor &acceptor;
     data_buffer buffer;
     std::string client_id;
+    utils::hash::hash_256_t key{};
     std::string nonce;
 
+    // Only used once the connection has negotiated protocol 2
+    std::uint64_t last_request_id{};
+    bool multiplexed{false};
+    std::mutex write_mtx;
+    std::deque<data_buffer> write_queue;
+    bool writing{false};
+
     void generate_nonce() {
       nonce = utils::generate_random_string(comm::packet_nonce_size);
     }
   };
 
 private:
-  std::string encryption_token_;
+  utils::hash::hash_256_t encryption_key_;
   closed_callback closed_;
   message_handler_callback message_handler_;
+  std::uint32_t max_protocol_;
   mutable io_context io_context_;
   std::unique_ptr<std::thread> server_thread_;
   std::vector<std::thread> service_threads_;
@@ -93,10 +104,19 @@ private:
 
   void read_packet(std::shared_ptr<connection> conn, std::uint32_t data_size);
 
+  void read_multiplexed_packet(std::shared_ptr<connection> conn);
+
   void remove_client(connection &conn);
 
+  void send_multiplexed_response(std::shared_ptr<connection> conn,
+                                 std::uint64_t request_id,
+                                 const packet::error_type &result,
+                                 packet &response);
+
   void send_response(std::shared_ptr<connection> conn,
                      const packet::error_type &result, packet &response);
+
+  void write_next(std::shared_ptr<connection> conn);
 };
 } // namespace repertory
 
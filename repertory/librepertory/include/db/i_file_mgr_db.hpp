@@ -29,6 +29,21 @@ class i_file_mgr_db {
   INTERFACE_SETUP(i_file_mgr_db);
 
 public:
+  struct cache_entry final {
+    std::string source_path;
+    std::uint64_t accessed{};
+  };
+
+  struct multipart_entry final {
+    std::string api_path;
+    std::string upload_id;
+    std::uint64_t part_size{};
+    std::map<std::uint32_t, std::string> parts;
+    std::uint64_t source_modified{};
+    std::string source_path;
+    std::uint64_t source_size{};
+  };
+
   struct resume_entry final {
     std::string api_path;
     std::uint64_t chunk_size{};
@@ -44,6 +59,12 @@ public:
   using upload_entry = upload_active_entry;
 
 public:
+  [[nodiscard]] virtual auto add_cache_entry(const cache_entry &entry)
+      -> bool = 0;
+
+  [[nodiscard]] virtual auto add_multipart(const multipart_entry &entry)
+      -> bool = 0;
+
   [[nodiscard]] virtual auto add_resume(const resume_entry &entry) -> bool = 0;
 
   [[nodiscard]] virtual auto add_upload(const upload_entry &entry) -> bool = 0;
@@ -53,6 +74,12 @@ public:
 
   virtual void clear() = 0;
 
+  [[nodiscard]] virtual auto get_cache_entry_list() const
+      -> std::vector<cache_entry> = 0;
+
+  [[nodiscard]] virtual auto get_multipart(std::string_view api_path) const
+      -> std::optional<multipart_entry> = 0;
+
   [[nodiscard]] virtual auto get_next_upload() const
       -> std::optional<upload_entry> = 0;
 
@@ -65,6 +92,15 @@ public:
   [[nodiscard]] virtual auto get_upload_active_list() const
       -> std::vector<upload_active_entry> = 0;
 
+  [[nodiscard]] virtual auto get_upload_list() const
+      -> std::vector<upload_entry> = 0;
+
+  [[nodiscard]] virtual auto remove_cache_entry(std::string_view source_path)
+      -> bool = 0;
+
+  [[nodiscard]] virtual auto remove_multipart(std::string_view api_path)
+      -> bool = 0;
+
   [[nodiscard]] virtual auto remove_resume(std::string_view api_path)
       -> bool = 0;
 
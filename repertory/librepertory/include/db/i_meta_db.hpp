@@ -42,6 +42,10 @@ public:
   [[nodiscard]] virtual auto get_api_path_list() const
       -> std::vector<std::string> = 0;
 
+  [[nodiscard]] virtual auto get_api_path_list(std::string_view after,
+                                               std::size_t count) const
+      -> std::vector<std::string> = 0;
+
   [[nodiscard]] virtual auto get_item_meta(std::string_view api_path,
                                            api_meta_map &meta) const
       -> api_error = 0;
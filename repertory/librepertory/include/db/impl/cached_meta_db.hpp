@@ -0,0 +1,139 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_DB_IMPL_CACHED_META_DB_HPP_
+#define REPERTORY_INCLUDE_DB_IMPL_CACHED_META_DB_HPP_
+
+#include "db/i_meta_db.hpp"
+#include "types/repertory.hpp"
+
+namespace repertory {
+// Sharded in-memory attribute cache in front of another i_meta_db. Missing
+// items are cached as negative entries. Writes made through this instance
+// invalidate immediately; entries also expire after 'ttl' so changes made by
+// another process become visible. A full shard evicts its least recently used
+// entry.
+class cached_meta_db final : public i_meta_db {
+public:
+  static constexpr std::chrono::milliseconds default_ttl{1000ms};
+  static constexpr std::size_t default_max_entries{64U * 1024U};
+  static constexpr std::size_t shard_count{16U};
+
+public:
+  cached_meta_db(std::unique_ptr<i_meta_db> meta_db,
+                 std::chrono::milliseconds ttl = default_ttl,
+                 std::size_t max_entries = default_max_entries);
+  ~cached_meta_db() override = default;
+
+  cached_meta_db(const cached_meta_db &) = delete;
+  cached_meta_db(cached_meta_db &&) = delete;
+  auto operator=(const cached_meta_db &) -> cached_meta_db & = delete;
+  auto operator=(cached_meta_db &&) -> cached_meta_db & = delete;
+
+private:
+  struct entry final {
+    std::chrono::steady_clock::time_point expires;
+    std::optional<api_meta_map> meta;
+    std::list<std::string>::iterator lru_iter;
+  };
+
+  struct shard final {
+    std::unordered_map<std::string, entry> entries;
+    std::uint64_t generation{0U};
+    // Most recently used first
+    std::list<std::string> lru;
+    std::mutex mtx;
+
+    void erase(std::unordered_map<std::string, entry>::iterator iter);
+  };
+
+private:
+  std::unique_ptr<i_meta_db> meta_db_;
+  std::size_t max_shard_entries_;
+  mutable std::array<shard, shard_count> shards_;
+  std::chrono::milliseconds ttl_;
+
+private:
+  [[nodiscard]] auto get_cached_meta(std::string_view api_path,
+                                     api_meta_map &meta) const -> api_error;
+
+  [[nodiscard]] auto get_shard(std::string_view api_path) const -> shard &;
+
+  void invalidate(std::string_view api_path);
+
+  void invalidate_all();
+
+public:
+  void clear() override;
+
+  void enumerate_api_path_list(
+      std::function<void(const std::vector<std::string> &)> callback,
+      stop_type_callback stop_requested_cb) const override;
+
+  [[nodiscard]] auto get_api_path(std::string_view source_path,
+                                  std::string &api_path) const
+      -> api_error override;
+
+  [[nodiscard]] auto get_api_path_list() const
+      -> std::vector<std::string> override;
+
+  [[nodiscard]] auto get_api_path_list(std::string_view after,
+                                       std::size_t count) const
+      -> std::vector<std::string> override;
+
+  [[nodiscard]] auto get_item_meta(std::string_view api_path,
+                                   api_meta_map &meta) const
+      -> api_error override;
+
+  [[nodiscard]] auto get_item_meta(std::string_view api_path,
+                                   std::string_view key,
+                                   std::string &value) const
+      -> api_error override;
+
+  [[nodiscard]] auto get_pinned_files() const
+      -> std::vector<std::string> override;
+
+  [[nodiscard]] auto get_total_item_count() const -> std::uint64_t override;
+
+  [[nodiscard]] auto get_total_size() const -> std::uint64_t override;
+
+  void remove_api_path(std::string_view api_path) override;
+
+  [[nodiscard]] auto remove_item_meta(std::string_view api_path,
+                                      std::string_view key)
+      -> api_error override;
+
+  [[nodiscard]] auto rename_item_meta(std::string_view from_api_path,
+                                      std::string_view to_api_path)
+      -> api_error override;
+
+  [[nodiscard]] auto set_item_meta(std::string_view api_path,
+                                   std::string_view key,
+                                   std::string_view value)
+      -> api_error override;
+
+  [[nodiscard]] auto set_item_meta(std::string_view api_path,
+                                   const api_meta_map &meta)
+      -> api_error override;
+};
+} // namespace repertory
+
+#endif // REPERTORY_INCLUDE_DB_IMPL_CACHED_META_DB_HPP_
@@ -42,7 +42,9 @@ private:
 
 private:
   std::unique_ptr<rocksdb::TransactionDB> db_{nullptr};
+  rocksdb::ColumnFamilyHandle *cache_family_{};
   std::atomic<std::uint64_t> id_{0U};
+  rocksdb::ColumnFamilyHandle *multipart_family_{};
   rocksdb::ColumnFamilyHandle *resume_family_{};
   rocksdb::ColumnFamilyHandle *upload_active_family_{};
   rocksdb::ColumnFamilyHandle *upload_family_{};
@@ -69,6 +71,12 @@ private:
                                 rocksdb::Transaction *txn) -> rocksdb::Status;
 
 public:
+  [[nodiscard]] auto add_cache_entry(const cache_entry &entry)
+      -> bool override;
+
+  [[nodiscard]] auto add_multipart(const multipart_entry &entry)
+      -> bool override;
+
   [[nodiscard]] auto add_resume(const resume_entry &entry) -> bool override;
 
   [[nodiscard]] auto add_upload(const upload_entry &entry) -> bool override;
@@ -78,6 +86,12 @@ public:
 
   void clear() override;
 
+  [[nodiscard]] auto get_cache_entry_list() const
+      -> std::vector<cache_entry> override;
+
+  [[nodiscard]] auto get_multipart(std::string_view api_path) const
+      -> std::optional<multipart_entry> override;
+
   [[nodiscard]] auto get_next_upload() const
       -> std::optional<upload_entry> override;
 
@@ -90,6 +104,15 @@ public:
   [[nodiscard]] auto get_upload_active_list() const
       -> std::vector<upload_active_entry> override;
 
+  [[nodiscard]] auto get_upload_list() const
+      -> std::vector<upload_entry> override;
+
+  [[nodiscard]] auto remove_cache_entry(std::string_view source_path)
+      -> bool override;
+
+  [[nodiscard]] auto remove_multipart(std::string_view api_path)
+      -> bool override;
+
   [[nodiscard]] auto remove_resume(std::string_view api_path) -> bool override;
 
   [[nodiscard]] auto remove_upload(std::string_view api_path) -> bool override;
@@ -54,8 +54,7 @@ private:
 
   void create_or_open(bool clear);
 
-  [[nodiscard]] auto get_item_meta_json(std::string_view api_path,
-                                        json &json_data) const -> api_error;
+  void migrate_legacy_meta();
 
   [[nodiscard]] static auto
   perform_action(std::string_view function_name,
@@ -71,7 +70,8 @@ private:
                                      rocksdb::Transaction *txn)
       -> rocksdb::Status;
 
-  [[nodiscard]] auto update_item_meta(std::string_view api_path, json json_data,
+  [[nodiscard]] auto update_item_meta(std::string_view api_path,
+                                      api_meta_map meta,
                                       rocksdb::Transaction *base_txn = nullptr,
                                       rocksdb::Status *status = nullptr)
       -> api_error;
@@ -90,6 +90,10 @@ public:
   [[nodiscard]] auto get_api_path_list() const
       -> std::vector<std::string> override;
 
+  [[nodiscard]] auto get_api_path_list(std::string_view after,
+                                       std::size_t count) const
+      -> std::vector<std::string> override;
+
   [[nodiscard]] auto get_item_meta(std::string_view api_path,
                                    api_meta_map &meta) const
       -> api_error override;
@@ -44,6 +44,8 @@ private:
   constexpr static const auto table_name = "meta";
 
 private:
+  void migrate_legacy_table();
+
   [[nodiscard]] auto update_item_meta(std::string_view api_path,
                                       api_meta_map meta) -> api_error;
 
@@ -61,6 +63,10 @@ public:
   [[nodiscard]] auto get_api_path_list() const
       -> std::vector<std::string> override;
 
+  [[nodiscard]] auto get_api_path_list(std::string_view after,
+                                       std::size_t count) const
+      -> std::vector<std::string> override;
+
   [[nodiscard]] auto get_item_meta(std::string_view api_path,
                                    api_meta_map &meta) const
       -> api_error override;
@@ -0,0 +1,77 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_DB_META_CODEC_HPP_
+#define REPERTORY_INCLUDE_DB_META_CODEC_HPP_
+
+#include "types/repertory.hpp"
+
+namespace repertory::meta_codec {
+// Meta keys that are stored as unsigned integers whenever their value is a
+// canonical decimal number; anything else is kept verbatim as a string. The
+// position of a name is its bit in the persisted mask, so only append.
+inline constexpr std::array<std::string_view, 10U> NUMERIC_NAMES{
+    META_ACCESSED, META_ATTRIBUTES, META_CHANGED,  META_CREATION, META_GID,
+    META_MODE,     META_MODIFIED,   META_OSXFLAGS, META_UID,      META_WRITTEN,
+};
+
+// Meta keys that are stored as plain strings in their own field.
+inline constexpr std::array<std::string_view, 3U> STRING_NAMES{
+    META_BACKUP,
+    META_KDF,
+    META_KEY,
+};
+
+// Tags written in place of well-known key names. Tags are persisted, so this
+// table is append-only: never reorder, reuse or remove an entry. Tag 0 is
+// reserved for keys that are stored by name.
+inline constexpr std::array<std::pair<std::uint64_t, std::string_view>, 17U>
+    KEY_TAGS{{
+        {1U, META_ACCESSED},
+        {2U, META_ATTRIBUTES},
+        {3U, META_BACKUP},
+        {4U, META_CHANGED},
+        {5U, META_CREATION},
+        {6U, META_DIRECTORY},
+        {7U, META_GID},
+        {8U, META_KDF},
+        {9U, META_KEY},
+        {10U, META_MODE},
+        {11U, META_MODIFIED},
+        {12U, META_OSXFLAGS},
+        {13U, META_PINNED},
+        {14U, META_SIZE},
+        {15U, META_SOURCE},
+        {16U, META_UID},
+        {17U, META_WRITTEN},
+    }};
+
+[[nodiscard]] auto decode(std::string_view data, api_meta_map &meta) -> bool;
+
+[[nodiscard]] auto encode(const api_meta_map &meta) -> std::string;
+
+[[nodiscard]] auto is_legacy_json(std::string_view data) -> bool;
+
+[[nodiscard]] auto to_numeric(std::string_view value)
+    -> std::optional<std::uint64_t>;
+} // namespace repertory::meta_codec
+
+#endif // REPERTORY_INCLUDE_DB_META_CODEC_HPP_
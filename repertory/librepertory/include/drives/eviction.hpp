@@ -27,31 +27,32 @@
 namespace repertory {
 class app_config;
 class i_file_manager;
-class i_provider;
 
 class eviction final : public single_thread_service_base {
 public:
-  eviction(i_provider &provider, const app_config &config,
-           i_file_manager &file_mgr)
+  eviction(const app_config &config, i_file_manager &file_mgr)
       : single_thread_service_base("eviction"),
         config_(config),
-        file_mgr_(file_mgr),
-        provider_(provider) {}
+        file_mgr_(file_mgr) {}
 
   ~eviction() override = default;
 
+private:
+  static constexpr std::size_t batch_size{64U};
+
 private:
   const app_config &config_;
   i_file_manager &file_mgr_;
-  i_provider &provider_;
+  std::atomic<bool> pressure_{false};
 
 private:
-  [[nodiscard]] auto check_minimum_requirements(std::string_view file_path)
-      -> bool;
-
-  [[nodiscard]] auto get_filtered_cached_files() -> std::deque<std::string>;
+  void evict_to_low_watermark();
 
 protected:
+  void on_start() override;
+
+  void on_stop() override;
+
   void service_function() override;
 };
 } // namespace repertory
@@ -67,10 +67,12 @@ private:
   bool was_mounted_{false};
 
 private:
-  void update_accessed_time(std::string_view api_path);
+  void flush_pending_meta(std::string_view api_path);
 
   void stop_all();
 
+  void update_accessed_time(i_open_file &open_file);
+
 protected:
 #if defined(__APPLE__)
   [[nodiscard]] auto chflags_impl(std::string api_path, uint32_t flags)
@@ -118,6 +118,14 @@ public:
                remote::file_handle handle, std::string &item_path)
       -> packet::error_type = 0;
 
+  // Returns up to max_count entries from offset along with their attributes.
+  // -ENOTSUP is returned if the connection did not negotiate support for it.
+  [[nodiscard]] virtual auto
+  fuse_readdir_plus(const char *path, remote::file_offset offset,
+                    remote::file_handle handle, std::uint32_t max_count,
+                    std::vector<remote::directory_entry> &entries)
+      -> packet::error_type = 0;
+
   [[nodiscard]] virtual auto fuse_release(const char *path,
                                           remote::file_handle handle)
       -> packet::error_type = 0;
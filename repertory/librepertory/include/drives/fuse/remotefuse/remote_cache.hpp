@@ -0,0 +1,145 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_DRIVES_FUSE_REMOTEFUSE_REMOTE_CACHE_HPP_
+#define REPERTORY_INCLUDE_DRIVES_FUSE_REMOTEFUSE_REMOTE_CACHE_HPP_
+
+#include "comm/packet/packet.hpp"
+#include "types/remote.hpp"
+
+namespace repertory::remote_fuse {
+// Client side cache for remote mounts. Attributes, lookup failures and access
+// checks are kept for a short time to avoid a round trip per metadata call.
+// Sequential reads on a handle grow a readahead window that is served from a
+// local buffer. Any change made through this client drops the affected
+// entries, but changes made by other clients are only seen once the entries
+// expire.
+class remote_cache final {
+public:
+  using access_loader_t = std::function<packet::error_type()>;
+  using attr_loader_t =
+      std::function<packet::error_type(remote::stat &r_stat, bool &directory)>;
+  using read_loader_t = std::function<packet::error_type(
+      char *buffer, remote::file_size read_size,
+      remote::file_offset read_offset)>;
+
+  static constexpr std::size_t max_attr_entries{16384U};
+  static constexpr std::size_t max_readahead_size{4U * 1024U * 1024U};
+  static constexpr std::size_t max_total_readahead_size{
+      64U * 1024U * 1024U,
+  };
+  static constexpr std::size_t min_readahead_size{128U * 1024U};
+
+private:
+  struct attr_entry final {
+    std::chrono::steady_clock::time_point expires;
+    packet::error_type res{};
+    remote::stat r_stat{};
+    bool directory{false};
+    std::unordered_map<std::int32_t, packet::error_type> access;
+  };
+
+  struct read_state final {
+    std::string api_path;
+    std::vector<char> data;
+    remote::file_offset data_offset{};
+    remote::file_offset next_offset{};
+    std::size_t window{};
+    std::mutex mtx;
+  };
+
+public:
+  explicit remote_cache(std::chrono::milliseconds timeout)
+      : timeout_(timeout) {}
+
+  remote_cache(const remote_cache &) = delete;
+  remote_cache(remote_cache &&) = delete;
+
+  ~remote_cache() = default;
+
+  auto operator=(const remote_cache &) -> remote_cache & = delete;
+  auto operator=(remote_cache &&) -> remote_cache & = delete;
+
+private:
+  std::chrono::milliseconds timeout_;
+
+private:
+  std::unordered_map<std::string, attr_entry> attrs_;
+  std::atomic<std::size_t> buffered_size_{};
+  std::uint64_t generation_{};
+  mutable std::mutex mtx_;
+  std::unordered_map<std::string, std::set<remote::file_handle>> read_handles_;
+  std::unordered_map<remote::file_handle, std::shared_ptr<read_state>> reads_;
+
+private:
+  [[nodiscard]] auto find_attr(const std::string &api_path)
+      -> attr_entry *;
+
+  void clear_read_data(read_state &state);
+
+  void remove_read_handle(const std::string &api_path,
+                          remote::file_handle handle);
+
+  [[nodiscard]] auto get_read_state(const std::string &api_path,
+                                    remote::file_handle handle)
+      -> std::shared_ptr<read_state>;
+
+  void store_attr(const std::string &api_path, std::uint64_t generation,
+                  const attr_entry &entry);
+
+public:
+  [[nodiscard]] auto check_access(const std::string &api_path,
+                                  std::int32_t mask,
+                                  const access_loader_t &loader)
+      -> packet::error_type;
+
+  void clear();
+
+  [[nodiscard]] auto get_attr(const std::string &api_path,
+                              remote::stat &r_stat, bool &directory,
+                              const attr_loader_t &loader)
+      -> packet::error_type;
+
+  // Changes whenever entries are invalidated. Read it before fetching
+  // attributes that are later passed to set_attr().
+  [[nodiscard]] auto get_generation() const -> std::uint64_t;
+
+  // Drops the cached state of a path after this client changes it. Parent
+  // attributes are dropped too since their size and times follow their
+  // children. Directory renames and removals also drop every descendant.
+  void invalidate(const std::string &api_path, bool recursive = false);
+
+  [[nodiscard]] auto read(const std::string &api_path,
+                          remote::file_handle handle, char *buffer,
+                          remote::file_size read_size,
+                          remote::file_offset read_offset,
+                          const read_loader_t &loader) -> packet::error_type;
+
+  void release(remote::file_handle handle);
+
+  // Stores attributes that arrived with a directory listing. Nothing is
+  // stored if anything was invalidated after generation was read.
+  void set_attr(const std::string &api_path, std::uint64_t generation,
+                const remote::stat &r_stat, bool directory);
+};
+} // namespace repertory::remote_fuse
+
+#endif // REPERTORY_INCLUDE_DRIVES_FUSE_REMOTEFUSE_REMOTE_CACHE_HPP_
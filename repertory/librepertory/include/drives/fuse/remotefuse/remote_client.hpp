@@ -130,6 +130,12 @@ public:
                                   std::string &item_path)
       -> packet::error_type override;
 
+  [[nodiscard]] auto
+  fuse_readdir_plus(const char *path, remote::file_offset offset,
+                    remote::file_handle handle, std::uint32_t max_count,
+                    std::vector<remote::directory_entry> &entries)
+      -> packet::error_type override;
+
   [[nodiscard]] auto fuse_release(const char *path, remote::file_handle handle)
       -> packet::error_type override;
 
@@ -25,6 +25,7 @@
 
 #include "drives/fuse/fuse_base.hpp"
 #include "drives/fuse/remotefuse/i_remote_instance.hpp"
+#include "drives/fuse/remotefuse/remote_cache.hpp"
 
 namespace repertory {
 class app_config;
@@ -37,8 +38,8 @@ namespace remote_fuse {
 class remote_fuse_drive final : public fuse_base {
 public:
   remote_fuse_drive(app_config &config, remote_instance_factory factory,
-                    lock_data &lock)
-      : fuse_base(config), factory_(std::move(factory)), lock_data_(lock) {}
+                    lock_data &lock);
+
   remote_fuse_drive(const remote_fuse_drive &) = delete;
   remote_fuse_drive(remote_fuse_drive &&) = delete;
 
@@ -48,6 +49,10 @@ public:
   ~remote_fuse_drive() override = default;
 
 private:
+  static constexpr std::uint32_t readdir_page_size{256U};
+
+private:
+  remote_cache cache_;
   remote_instance_factory factory_;
   lock_data &lock_data_;
   std::shared_ptr<console_consumer> console_consumer_;
@@ -265,6 +265,15 @@ private:
             return this->handle_fuse_readdir(client_id, request, response);
           },
       },
+      {
+          "::fuse_readdir_plus",
+          [this](auto && /* service_flags */, auto &&client_id,
+                 auto && /* thread_id */, auto && /* method */, auto &&request,
+                 auto &&response) -> auto {
+            return this->handle_fuse_readdir_plus(client_id, request,
+                                                  response);
+          },
+      },
       {
           "::fuse_release",
           [this](auto && /* service_flags */, auto && /* client_id */,
@@ -884,6 +893,50 @@ private:
     return ret;
   }
 
+  [[nodiscard]] auto handle_fuse_readdir_plus(std::string_view client_id,
+                                              packet *request,
+                                              packet &response)
+      -> packet::error_type {
+    auto ret{0};
+
+    std::string path;
+    DECODE_OR_RETURN(request, path);
+
+    remote::file_offset offset;
+    DECODE_OR_RETURN(request, offset);
+
+    remote::file_handle handle;
+    DECODE_OR_RETURN(request, handle);
+
+    std::uint32_t max_count{};
+    DECODE_OR_RETURN(request, max_count);
+
+    remote::user_id uid;
+    DECODE_OR_RETURN(request, uid);
+
+    remote::group_id gid;
+    DECODE_OR_RETURN(request, gid);
+
+    if (not this->has_open_directory(client_id, handle)) {
+      return -EBADF;
+    }
+
+    std::vector<remote::directory_entry> entries;
+    ret = this->fuse_readdir_plus(
+        path.c_str(), offset, handle,
+        std::clamp(max_count, 1U, remote::max_directory_entries), entries);
+    if (ret == 0) {
+      response.encode(static_cast<std::uint32_t>(entries.size()));
+      for (auto &entry : entries) {
+        entry.r_stat.st_uid = uid;
+        entry.r_stat.st_gid = gid;
+        response.encode(entry);
+      }
+    }
+
+    return ret;
+  }
+
   [[nodiscard]] auto handle_fuse_release(packet *request)
       -> packet::error_type {
     auto ret{0};
@@ -1650,6 +1703,26 @@ protected:
   [[nodiscard]] auto construct_api_path(std::string path) -> std::string {
     return utils::path::create_api_path(path.substr(mount_location_.size()));
   }
+
+public:
+  // Pages are built from the single entry readdir and getattr calls so every
+  // server supports them
+  [[nodiscard]] auto
+  fuse_readdir_plus(const char *path, remote::file_offset offset,
+                    remote::file_handle handle, std::uint32_t max_count,
+                    std::vector<remote::directory_entry> &entries)
+      -> packet::error_type override {
+    return remote::read_directory_page(
+        path, offset, max_count,
+        [this, path, handle](auto &&item_offset, auto &&item_path) -> auto {
+          return this->fuse_readdir(path, item_offset, handle, item_path);
+        },
+        [this](auto &&stat_path, auto &&r_stat, auto &&directory) -> auto {
+          return this->fuse_getattr(std::string{stat_path}.c_str(), r_stat,
+                                    directory);
+        },
+        entries);
+  }
 };
 } // namespace repertory
 
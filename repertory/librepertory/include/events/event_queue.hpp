@@ -0,0 +1,62 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_EVENTS_EVENT_QUEUE_HPP_
+#define REPERTORY_INCLUDE_EVENTS_EVENT_QUEUE_HPP_
+
+namespace repertory {
+class i_event;
+
+// Bounded multi-producer/single-consumer ring buffer. 'push()' never blocks
+// and fails when the buffer is full.
+class event_queue final {
+public:
+  explicit event_queue(std::size_t capacity);
+
+  ~event_queue() = default;
+
+  event_queue(const event_queue &) = delete;
+  event_queue(event_queue &&) = delete;
+  auto operator=(const event_queue &) -> event_queue & = delete;
+  auto operator=(event_queue &&) -> event_queue & = delete;
+
+private:
+  struct cell final {
+    std::atomic<std::size_t> sequence;
+    std::shared_ptr<i_event> evt;
+  };
+
+private:
+  std::size_t mask_;
+  std::unique_ptr<cell[]> cells_;
+  alignas(64) std::atomic<std::size_t> enqueue_pos_{0U};
+  alignas(64) std::atomic<std::size_t> dequeue_pos_{0U};
+
+public:
+  [[nodiscard]] auto get_capacity() const -> std::size_t { return mask_ + 1U; }
+
+  [[nodiscard]] auto pop(std::shared_ptr<i_event> &evt) -> bool;
+
+  [[nodiscard]] auto push(std::shared_ptr<i_event> evt) -> bool;
+};
+} // namespace repertory
+
+#endif // REPERTORY_INCLUDE_EVENTS_EVENT_QUEUE_HPP_
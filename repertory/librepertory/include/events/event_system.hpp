@@ -22,19 +22,19 @@
 #ifndef REPERTORY_INCLUDE_EVENTS_EVENT_SYSTEM_HPP_
 #define REPERTORY_INCLUDE_EVENTS_EVENT_SYSTEM_HPP_
 
+#include "events/event_queue.hpp"
+#include "types/repertory.hpp"
+
 namespace repertory {
 class i_event;
 
 class event_system final {
-private:
-  static constexpr std::uint8_t max_queue_retry{
-      30U,
-  };
-
-  const std::uint32_t max_queue_size{
-      std::thread::hardware_concurrency() * 4U,
+public:
+  static constexpr std::size_t max_queue_size{
+      4096U,
   };
 
+private:
   static constexpr std::chrono::seconds queue_wait_secs{
       5s,
   };
@@ -48,13 +48,14 @@ public:
 protected:
   event_system() = default;
 
-  ~event_system() { stop(); }
+  ~event_system();
 
 public:
   class event_consumer final {
   public:
-    explicit event_consumer(std::function<void(const i_event &)> callback)
-        : callback_(std::move(callback)) {
+    explicit event_consumer(std::function<void(const i_event &)> callback,
+                            event_level level = event_level::trace)
+        : callback_(std::move(callback)), level_(level) {
       event_system::instance().attach(this);
     }
 
@@ -74,48 +75,86 @@ public:
 
   private:
     std::function<void(const i_event &)> callback_;
+    std::atomic<event_level> level_{event_level::trace};
 
   public:
+    [[nodiscard]] auto get_level() const -> event_level { return level_; }
+
     void notify_event(const i_event &event) { callback_(event); }
-  };
 
-private:
-  static event_system instance_;
+    void set_level(event_level level) {
+      level_ = level;
+      event_system::instance().update_level();
+    }
+  };
 
 public:
   [[nodiscard]] static auto instance() -> event_system &;
 
 private:
-  std::unordered_map<std::string, std::deque<event_consumer *>>
+  struct consumer_data;
+
+private:
+  std::atomic<std::int32_t> all_level_{-1};
+  std::map<std::string, std::vector<std::shared_ptr<consumer_data>>,
+           std::less<>>
       event_consumers_;
-  std::recursive_mutex consumer_mutex_;
-  std::vector<std::shared_ptr<i_event>> event_list_;
-  std::condition_variable event_notify_;
-  std::mutex event_mutex_;
-  std::unique_ptr<std::thread> event_thread_;
-  std::mutex run_mutex_;
+  std::shared_mutex consumer_mutex_;
+  std::mutex dispatch_mtx_;
+  std::unique_ptr<std::thread> dispatch_thread_;
+  std::atomic<std::thread::id> dispatch_thread_id_;
+  std::mutex drain_mtx_;
+  std::condition_variable drain_notify_;
+  std::atomic<std::uint64_t> dropped_count_{0U};
+  std::atomic<std::uint64_t> processed_{0U};
+  std::atomic<std::uint64_t> pushed_{0U};
+  event_queue queue_{max_queue_size};
+  std::mutex run_mtx_;
+  std::atomic<std::uint32_t> signal_{0U};
   stop_type stop_requested_{false};
 
 private:
-  [[nodiscard]] auto get_stop_requested() const -> bool;
+  void add_consumer(std::string_view event_name, event_consumer *consumer);
+
+  void dispatch(const i_event &evt);
 
-  void process_events();
+  [[nodiscard]] auto is_dispatch_thread() const -> bool;
+
+  [[nodiscard]] auto is_subscribed(std::string_view event_name,
+                                   event_level level) -> bool;
+
+  void notify();
 
   void queue_event(std::shared_ptr<i_event> evt);
 
+  void run();
+
+  void update_level();
+
 public:
   void attach(event_consumer *consumer);
 
   void attach(std::string_view event_name, event_consumer *consumer);
 
+  [[nodiscard]] auto get_dropped_count() const -> std::uint64_t {
+    return dropped_count_;
+  }
+
   template <typename evt_t, typename... arg_t> void raise(arg_t &&...args) {
+    if (not is_subscribed(evt_t::name, evt_t::level)) {
+      return;
+    }
+
     queue_event(std::make_shared<evt_t>(std::forward<arg_t>(args)...));
   }
 
   void release(event_consumer *consumer);
 
+  // Events raised before 'start()' stay queued until the dispatcher runs.
   void start();
 
+  // Waits for events that have already been queued to be delivered, then
+  // stops the dispatcher.
   void stop();
 };
 
@@ -125,7 +164,10 @@ using event_consumer = event_system::event_consumer;
 private:                                                                       \
   std::vector<std::shared_ptr<repertory::event_consumer>> event_consumers_
 
-#define E_CONSUMER_RELEASE() event_consumers_.clear()
+#define E_CONSUMER_RELEASE()                                                   \
+  while (not event_consumers_.empty()) {                                       \
+    event_consumers_.pop_back();                                               \
+  }
 
 #define E_SUBSCRIBE(event, callback)                                           \
   event_consumers_.emplace_back(std::make_shared<repertory::event_consumer>(   \
@@ -133,9 +175,9 @@ private:                                                                       \
         callback(dynamic_cast<const event &>(evt));                            \
       }))
 
-#define E_SUBSCRIBE_ALL(callback)                                              \
+#define E_SUBSCRIBE_ALL(callback, ...)                                         \
   event_consumers_.emplace_back(std::make_shared<repertory::event_consumer>(   \
-      [this](const i_event &evt) { callback(evt); }))
+      [this](const i_event &evt) { callback(evt); } __VA_OPT__(, ) __VA_ARGS__))
 } // namespace repertory
 
 #endif // REPERTORY_INCLUDE_EVENTS_EVENT_SYSTEM_HPP_
@@ -0,0 +1,85 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_EVENTS_TYPES_CACHE_STALL_ENDED_HPP_
+#define REPERTORY_INCLUDE_EVENTS_TYPES_CACHE_STALL_ENDED_HPP_
+
+#include "events/i_event.hpp"
+#include "types/repertory.hpp"
+
+namespace repertory {
+struct cache_stall_ended final : public i_event {
+  cache_stall_ended() = default;
+  cache_stall_ended(std::uint64_t cache_size_, std::string_view function_name_,
+                    std::uint64_t max_cache_size_, std::uint64_t stall_ms_,
+                    bool timed_out_)
+      : cache_size(cache_size_),
+        function_name(function_name_),
+        max_cache_size(max_cache_size_),
+        stall_ms(stall_ms_),
+        timed_out(timed_out_) {}
+
+  static constexpr event_level level{event_level::warn};
+  static constexpr std::string_view name{"cache_stall_ended"};
+
+  std::uint64_t cache_size{};
+  std::string function_name;
+  std::uint64_t max_cache_size{};
+  std::uint64_t stall_ms{};
+  bool timed_out{};
+
+  [[nodiscard]] auto get_event_level() const -> event_level override {
+    return level;
+  }
+
+  [[nodiscard]] auto get_name() const -> std::string_view override {
+    return name;
+  }
+
+  [[nodiscard]] auto get_single_line() const -> std::string override {
+    return fmt::format("{}|func|{}|size|{}|max|{}|stall_ms|{}|timed_out|{}",
+                       name, function_name, cache_size, max_cache_size,
+                       stall_ms, timed_out);
+  }
+};
+} // namespace repertory
+
+NLOHMANN_JSON_NAMESPACE_BEGIN
+template <> struct adl_serializer<repertory::cache_stall_ended> {
+  static void to_json(json &data, const repertory::cache_stall_ended &value) {
+    data["cache_size"] = value.cache_size;
+    data["function_name"] = value.function_name;
+    data["max_cache_size"] = value.max_cache_size;
+    data["stall_ms"] = value.stall_ms;
+    data["timed_out"] = value.timed_out;
+  }
+
+  static void from_json(const json &data, repertory::cache_stall_ended &value) {
+    data.at("cache_size").get_to<std::uint64_t>(value.cache_size);
+    data.at("function_name").get_to<std::string>(value.function_name);
+    data.at("max_cache_size").get_to<std::uint64_t>(value.max_cache_size);
+    data.at("stall_ms").get_to<std::uint64_t>(value.stall_ms);
+    data.at("timed_out").get_to<bool>(value.timed_out);
+  }
+};
+NLOHMANN_JSON_NAMESPACE_END
+
+#endif // REPERTORY_INCLUDE_EVENTS_TYPES_CACHE_STALL_ENDED_HPP_
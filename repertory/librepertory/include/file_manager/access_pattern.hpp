@@ -0,0 +1,95 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_FILE_MANAGER_ACCESS_PATTERN_HPP_
+#define REPERTORY_INCLUDE_FILE_MANAGER_ACCESS_PATTERN_HPP_
+
+#include "types/repertory.hpp"
+
+namespace repertory {
+// Tracks a few concurrent read streams on one file and sizes a readahead
+// window for each. Reads reach an open file without their handle, so streams
+// are matched by offset. Not thread safe; callers serialize access.
+class access_pattern final {
+public:
+  enum class type {
+    random,
+    reverse,
+    sequential,
+    strided,
+  };
+
+public:
+  static constexpr std::size_t default_max_window{16U};
+  static constexpr std::size_t max_streams{4U};
+  static constexpr std::size_t min_hits{2U};
+
+public:
+  explicit access_pattern(std::uint64_t chunk_size,
+                          std::size_t max_window = default_max_window)
+      : chunk_size_(chunk_size), max_window_(max_window) {}
+
+  ~access_pattern() = default;
+
+public:
+  access_pattern(const access_pattern &) = delete;
+  access_pattern(access_pattern &&) = delete;
+  auto operator=(const access_pattern &) -> access_pattern & = delete;
+  auto operator=(access_pattern &&) -> access_pattern & = delete;
+
+private:
+  struct stream final {
+    std::uint64_t offset{};
+    std::uint64_t end{};
+    std::int64_t stride{};
+    type pattern{type::random};
+    std::size_t hits{};
+    std::size_t window{};
+    std::uint64_t last_used{};
+  };
+
+private:
+  std::uint64_t chunk_size_;
+  type last_type_{type::random};
+  std::size_t max_window_;
+  std::uint64_t sequence_{};
+  std::vector<stream> streams_;
+
+private:
+  [[nodiscard]] auto classify(const stream &item, std::uint64_t offset,
+                              std::size_t size) const -> std::optional<type>;
+
+  [[nodiscard]] auto get_window_chunks(const stream &item,
+                                       std::size_t chunk_count) const
+      -> std::vector<std::size_t>;
+
+public:
+  [[nodiscard]] auto get_last_type() const -> type { return last_type_; }
+
+  // Records a read and returns the chunks worth fetching ahead of it, nearest
+  // first. Random access yields an empty window.
+  [[nodiscard]] auto record(std::uint64_t offset, std::size_t size,
+                            std::size_t chunk_count)
+      -> std::vector<std::size_t>;
+};
+} // namespace repertory
+
+#endif // REPERTORY_INCLUDE_FILE_MANAGER_ACCESS_PATTERN_HPP_
@@ -0,0 +1,74 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_FILE_MANAGER_CACHE_INDEX_HPP_
+#define REPERTORY_INCLUDE_FILE_MANAGER_CACHE_INDEX_HPP_
+
+#include "db/i_file_mgr_db.hpp"
+
+namespace repertory {
+// Least recently used ordering of the files held in the cache directory so
+// eviction can pick candidates without listing the directory. Entries are
+// keyed by source path since renames leave the source path unchanged.
+class cache_index final {
+public:
+  using entry = i_file_mgr_db::cache_entry;
+
+public:
+  cache_index() = default;
+
+  cache_index(const cache_index &) = delete;
+  cache_index(cache_index &&) = delete;
+
+  ~cache_index() = default;
+
+  auto operator=(const cache_index &) -> cache_index & = delete;
+  auto operator=(cache_index &&) -> cache_index & = delete;
+
+private:
+  std::list<entry> entries_;
+  std::unordered_map<std::string, std::list<entry>::iterator> lookup_;
+  mutable std::mutex mtx_;
+
+public:
+  void clear();
+
+  [[nodiscard]] auto contains(std::string_view source_path) const -> bool;
+
+  // Replaces the index contents, oldest access first
+  void load(std::vector<entry> entries);
+
+  // Returns up to count of the least recently used entries, stopping at the
+  // first one accessed after max_accessed. Returned entries are moved to the
+  // back of the order so files that cannot be evicted yet are not offered
+  // again before the rest of the index.
+  [[nodiscard]] auto pop(std::size_t count, std::uint64_t max_accessed)
+      -> std::vector<entry>;
+
+  auto remove(std::string_view source_path) -> bool;
+
+  [[nodiscard]] auto size() const -> std::size_t;
+
+  void touch(std::string_view source_path, std::uint64_t accessed);
+};
+} // namespace repertory
+
+#endif // REPERTORY_INCLUDE_FILE_MANAGER_CACHE_INDEX_HPP_
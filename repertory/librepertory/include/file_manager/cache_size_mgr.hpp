@@ -28,6 +28,27 @@ namespace repertory {
 class app_config;
 
 class cache_size_mgr final {
+public:
+  using pressure_callback = std::function<void()>;
+
+  static constexpr std::uint64_t high_watermark_percent{90U};
+  static constexpr std::uint64_t low_watermark_percent{80U};
+
+  struct stats final {
+    std::uint64_t evicted_bytes{};
+    std::uint64_t evicted_count{};
+    std::uint64_t max_stall_ms{};
+    std::uint64_t stall_count{};
+    std::uint64_t stall_ms{};
+    std::uint64_t stall_timeout_count{};
+  };
+
+  // Longest a caller waits for eviction before its reservation is allowed to
+  // exceed the maximum cache size
+  static constexpr std::chrono::seconds max_stall_secs{
+      30s,
+  };
+
 private:
   static constexpr std::chrono::seconds cache_wait_secs{
       5s,
@@ -53,17 +74,39 @@ private:
   mutable std::mutex mtx_;
   std::condition_variable notify_;
   stop_type stop_requested_{false};
+  pressure_callback pressure_callback_;
+  std::mutex pressure_mtx_;
+  stats stats_;
 
 private:
   [[nodiscard]] auto get_stop_requested() const -> bool;
 
+  [[nodiscard]] auto get_watermark(std::uint64_t percent) const
+      -> std::uint64_t;
+
+  void notify_pressure();
+
 public:
+  // Reserves size bytes up front. The caller only blocks when the reservation
+  // exceeds the maximum cache size, and then for at most max_stall_secs.
   [[nodiscard]] auto expand(std::uint64_t size) -> api_error;
 
+  [[nodiscard]] auto get_high_watermark() const -> std::uint64_t;
+
+  [[nodiscard]] auto get_low_watermark() const -> std::uint64_t;
+
+  [[nodiscard]] auto get_stats() const -> stats;
+
   void initialize(app_config *cfg);
 
   [[nodiscard]] static auto instance() -> cache_size_mgr & { return instance_; }
 
+  void record_eviction(std::uint64_t size);
+
+  // Invoked without the size lock held whenever the cache grows past the high
+  // watermark. Passing an empty callback waits for in-flight calls to finish.
+  void set_pressure_callback(pressure_callback callback);
+
   [[nodiscard]] auto shrink(std::uint64_t size) -> api_error;
 
   [[nodiscard]] auto size() const -> std::uint64_t;
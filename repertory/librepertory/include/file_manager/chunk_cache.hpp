@@ -0,0 +1,105 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_FILE_MANAGER_CHUNK_CACHE_HPP_
+#define REPERTORY_INCLUDE_FILE_MANAGER_CHUNK_CACHE_HPP_
+
+#include "types/repertory.hpp"
+
+namespace repertory {
+class chunk_cache final {
+public:
+  using buffer_ptr = std::shared_ptr<const data_buffer>;
+  using loader_t = std::function<api_error(data_buffer &)>;
+
+public:
+  static constexpr std::uint64_t default_max_size{
+      default_chunk_cache_size_bytes,
+  };
+
+public:
+  explicit chunk_cache(std::uint64_t max_size = default_max_size)
+      : max_size_(max_size) {}
+
+  ~chunk_cache() = default;
+
+public:
+  chunk_cache(const chunk_cache &) = delete;
+  chunk_cache(chunk_cache &&) = delete;
+  auto operator=(const chunk_cache &) -> chunk_cache & = delete;
+  auto operator=(chunk_cache &&) -> chunk_cache & = delete;
+
+private:
+  using key_t = std::tuple<std::string, std::string, std::size_t>;
+
+  struct entry final {
+    buffer_ptr buffer;
+    bool referenced{true};
+  };
+
+  struct pending_load final {
+    buffer_ptr buffer;
+    bool done{false};
+    bool invalidated{false};
+    api_error result{api_error::success};
+  };
+
+private:
+  static chunk_cache instance_;
+
+private:
+  std::map<key_t, entry> entries_;
+  std::map<key_t, entry>::iterator hand_{entries_.end()};
+  std::uint64_t max_size_;
+  mutable std::mutex mtx_;
+  std::condition_variable notify_;
+  std::map<key_t, std::shared_ptr<pending_load>> pending_;
+  std::uint64_t size_{0U};
+
+private:
+  void advance_hand();
+
+  void erase_entry(std::map<key_t, entry>::iterator iter);
+
+  void evict();
+
+public:
+  [[nodiscard]] auto get_max_size() const -> std::uint64_t;
+
+  // Returns the cached chunk or loads it exactly once. Concurrent callers
+  // requesting the same chunk wait for the active load. Buffers handed out
+  // remain pinned and are skipped by eviction until released.
+  [[nodiscard]] auto get_or_load(std::string_view api_path,
+                                 std::string_view version, std::size_t chunk,
+                                 const loader_t &loader, buffer_ptr &buffer)
+      -> api_error;
+
+  [[nodiscard]] auto get_size() const -> std::uint64_t;
+
+  [[nodiscard]] static auto instance() -> chunk_cache & { return instance_; }
+
+  void invalidate(std::string_view api_path);
+
+  void set_max_size(std::uint64_t max_size);
+};
+} // namespace repertory
+
+#endif // REPERTORY_INCLUDE_FILE_MANAGER_CHUNK_CACHE_HPP_
@@ -46,7 +46,9 @@ public:
       -> direct_open_file & = delete;
 
 private:
-  std::array<data_buffer, min_ring_size> ring_data_;
+  // Only used when no chunk cache is set. Cached chunks are fetched from the
+  // cache on each read so they are not pinned for the life of the file.
+  std::array<chunk_cache::buffer_ptr, min_ring_size> ring_data_;
 
 protected:
   [[nodiscard]] auto on_check_start() -> bool override;
@@ -57,9 +59,8 @@ protected:
     return api_error::success;
   }
 
-  [[nodiscard]] auto on_read_chunk(std::size_t chunk, std::size_t read_size,
-                                   std::uint64_t read_offset, data_buffer &data,
-                                   std::size_t &bytes_read)
+  [[nodiscard]] auto on_read_chunk(std::size_t chunk, std::uint64_t read_offset,
+                                   data_span data, std::size_t &bytes_read)
       -> api_error override;
 
   [[nodiscard]] auto use_buffer(std::size_t chunk,
@@ -24,11 +24,12 @@
 
 #include "db/i_file_mgr_db.hpp"
 #include "events/event_system.hpp"
-#include "events/types/file_upload_completed.hpp"
+#include "file_manager/cache_index.hpp"
 #include "file_manager/i_file_manager.hpp"
 #include "file_manager/i_open_file.hpp"
 #include "file_manager/i_upload_manager.hpp"
 #include "file_manager/upload.hpp"
+#include "file_manager/upload_scheduler.hpp"
 #include "types/repertory.hpp"
 #include "utils/file.hpp"
 
@@ -37,8 +38,6 @@ class app_config;
 class i_provider;
 
 class file_manager final : public i_file_manager, public i_upload_manager {
-  E_CONSUMER();
-
 private:
   static constexpr std::chrono::seconds queue_wait_secs{
       5s,
@@ -62,6 +61,7 @@ private:
 
 private:
   std::unique_ptr<i_file_mgr_db> mgr_db_;
+  cache_index cache_index_;
   std::atomic<std::uint64_t> next_handle_{0U};
   mutable std::recursive_mutex open_file_mtx_;
   std::unordered_map<std::string, std::shared_ptr<i_closeable_open_file>>
@@ -69,14 +69,19 @@ private:
   stop_type stop_requested_{false};
   std::unordered_map<std::uint64_t, std::shared_ptr<i_closeable_open_file>>
       unlinked_file_lookup_;
-  std::unordered_map<std::string, std::unique_ptr<upload>> upload_lookup_;
+  std::unordered_map<std::string, std::shared_ptr<upload>> upload_lookup_;
   mutable std::mutex upload_mtx_;
   std::condition_variable upload_notify_;
-  std::unique_ptr<std::thread> upload_thread_;
+  upload_scheduler upload_scheduler_;
+  std::vector<std::unique_ptr<std::thread>> upload_threads_;
 
 private:
   void close_timed_out_files();
 
+  void load_cache_index();
+
+  void flush_expired_meta();
+
   [[nodiscard]] auto get_open_file_by_handle(std::uint64_t handle,
                                              bool &is_unlinked) const
       -> std::shared_ptr<i_closeable_open_file>;
@@ -95,6 +100,10 @@ private:
   void queue_upload(std::string_view api_path, std::string_view source_path,
                     bool is_unlinked, bool no_lock);
 
+  void queue_upload(upload_scheduler::entry entry, bool no_lock);
+
+  void remove_cached_file(std::string_view source_path);
+
   void remove_resume(std::string_view api_path, std::string_view source_path,
                      bool no_lock);
 
@@ -103,7 +112,9 @@ private:
   void swap_renamed_items(std::string_view from_api_path,
                           std::string_view to_api_path, bool directory);
 
-  void upload_completed(const file_upload_completed &evt);
+  void touch_cached_file(std::string_view source_path);
+
+  void upload_completed(const std::shared_ptr<upload> &completed);
 
   void upload_handler();
 
@@ -139,6 +150,8 @@ public:
 
   [[nodiscard]] auto evict_file(std::string_view api_path) -> bool override;
 
+  [[nodiscard]] auto get_cached_file_count() const -> std::size_t override;
+
   [[nodiscard]] auto get_directory_item(std::string_view api_path,
                                         directory_item &item) const
       -> api_error override;
@@ -146,6 +159,14 @@ public:
   [[nodiscard]] auto get_directory_items(std::string_view api_path) const
       -> directory_item_list override;
 
+  [[nodiscard]] auto get_eviction_candidates(std::size_t count,
+                                             std::uint64_t max_accessed)
+      -> std::vector<std::string> override;
+
+  [[nodiscard]] auto get_file_mgr_db() -> i_file_mgr_db * override {
+    return mgr_db_.get();
+  }
+
   [[nodiscard]] auto get_open_file(std::string_view api_path,
                                    std::shared_ptr<i_open_file> &file) -> bool;
 
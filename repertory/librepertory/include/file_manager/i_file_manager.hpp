@@ -25,6 +25,7 @@
 #include "types/repertory.hpp"
 
 namespace repertory {
+class i_file_mgr_db;
 class i_provider;
 
 class i_file_manager {
@@ -36,6 +37,8 @@ public:
 
   [[nodiscard]] virtual auto evict_file(std::string_view api_path) -> bool = 0;
 
+  [[nodiscard]] virtual auto get_cached_file_count() const -> std::size_t = 0;
+
   [[nodiscard]] virtual auto get_directory_item(std::string_view api_path,
                                                 directory_item &item) const
       -> api_error = 0;
@@ -44,6 +47,12 @@ public:
   get_directory_items(std::string_view api_path) const
       -> directory_item_list = 0;
 
+  [[nodiscard]] virtual auto
+  get_eviction_candidates(std::size_t count, std::uint64_t max_accessed)
+      -> std::vector<std::string> = 0;
+
+  [[nodiscard]] virtual auto get_file_mgr_db() -> i_file_mgr_db * = 0;
+
   [[nodiscard]] virtual auto get_open_files() const
       -> std::unordered_map<std::string, std::size_t> = 0;
 
@@ -32,6 +32,8 @@ public:
   using native_operation_callback = std::function<api_error(native_handle)>;
 
 public:
+  [[nodiscard]] virtual auto flush_pending_meta() -> api_error = 0;
+
   virtual void force_download() = 0;
 
   [[nodiscard]] virtual auto get_api_path() const -> std::string = 0;
@@ -56,6 +58,8 @@ public:
 
   [[nodiscard]] virtual auto get_open_file_count() const -> std::size_t = 0;
 
+  [[nodiscard]] virtual auto get_pending_meta() const -> api_meta_map = 0;
+
   [[nodiscard]] virtual auto get_read_state() const
       -> boost::dynamic_bitset<> = 0;
 
@@ -72,6 +76,8 @@ public:
 
   [[nodiscard]] virtual auto is_directory() const -> bool = 0;
 
+  [[nodiscard]] virtual auto is_sync_requested() const -> bool = 0;
+
   [[nodiscard]] virtual auto is_unlinked() const -> bool = 0;
 
   [[nodiscard]] virtual auto is_write_supported() const -> bool = 0;
@@ -87,14 +93,26 @@ public:
                                   std::uint64_t read_offset, data_buffer &data)
       -> api_error = 0;
 
+  [[nodiscard]] virtual auto read(std::uint64_t read_offset, data_span data,
+                                  std::size_t &bytes_read) -> api_error = 0;
+
   [[nodiscard]] virtual auto resize(std::uint64_t new_file_size)
       -> api_error = 0;
 
   virtual void set_api_path(std::string_view api_path) = 0;
 
+  [[nodiscard]] virtual auto set_pending_meta(const api_meta_map &meta)
+      -> api_error = 0;
+
+  virtual void set_sync_requested(bool value) = 0;
+
   [[nodiscard]] virtual auto write(std::uint64_t write_offset,
                                    const data_buffer &data,
                                    std::size_t &bytes_written) -> api_error = 0;
+
+  [[nodiscard]] virtual auto write(std::uint64_t write_offset,
+                                   data_cspan data, std::size_t &bytes_written)
+      -> api_error = 0;
 };
 
 class i_closeable_open_file : public i_open_file {
@@ -114,10 +132,14 @@ public:
 
   [[nodiscard]] virtual auto is_modified() const -> bool = 0;
 
+  [[nodiscard]] virtual auto is_pending_meta_expired() const -> bool = 0;
+
   virtual void remove(std::uint64_t handle) = 0;
 
   virtual void remove_all() = 0;
 
+  virtual void set_meta_flush_interval(std::uint16_t seconds) = 0;
+
   virtual void set_unlinked(bool value) = 0;
 
   virtual void set_unlinked_meta(api_meta_map meta) = 0;
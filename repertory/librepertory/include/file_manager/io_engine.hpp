@@ -0,0 +1,138 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_FILE_MANAGER_IO_ENGINE_HPP_
+#define REPERTORY_INCLUDE_FILE_MANAGER_IO_ENGINE_HPP_
+
+#include "types/repertory.hpp"
+
+namespace repertory {
+namespace utils::file {
+struct i_file;
+} // namespace utils::file
+
+// Process wide executor for open file work. Cache file I/O runs on a small
+// pool of I/O workers; each open file owns a strand so its I/O still runs in
+// submission order, one operation at a time. Long running work such as read
+// ahead runs as tasks on a separate pool so downloads never delay cache file
+// I/O. Cache files are accessed through utils::file::i_file, so both pools
+// are plain worker threads; workers start on first use.
+class io_engine final {
+public:
+  using action_t = std::function<api_error()>;
+  using completed_t = std::function<void(api_error result, std::size_t bytes)>;
+  using task_t = std::function<void()>;
+
+  // Work for one file; items run in order and never concurrently
+  struct strand final {
+    strand() = default;
+    strand(const strand &) = delete;
+    strand(strand &&) = delete;
+
+    ~strand() = default;
+
+    auto operator=(const strand &) -> strand & = delete;
+    auto operator=(strand &&) -> strand & = delete;
+
+    bool active{false};
+    mutable std::mutex mtx;
+    std::condition_variable notify;
+    std::deque<task_t> queue;
+
+    [[nodiscard]] auto is_idle() const -> bool;
+
+    // Blocks until everything queued on the strand has completed
+    void wait();
+  };
+
+  static constexpr std::size_t max_strand_batch{16U};
+  static constexpr std::size_t min_io_threads{2U};
+  static constexpr std::size_t min_task_threads{8U};
+
+private:
+  struct pool final {
+    std::mutex mtx;
+    std::condition_variable notify;
+    std::deque<task_t> queue;
+    std::vector<std::unique_ptr<std::thread>> threads;
+  };
+
+public:
+  io_engine(const io_engine &) = delete;
+  io_engine(io_engine &&) = delete;
+  auto operator=(const io_engine &) -> io_engine & = delete;
+  auto operator=(io_engine &&) -> io_engine & = delete;
+
+private:
+  io_engine() = default;
+
+  ~io_engine() { stop(); }
+
+private:
+  static io_engine instance_;
+
+public:
+  static auto instance() -> io_engine & { return instance_; }
+
+private:
+  pool io_pool_;
+  std::once_flag start_flag_;
+  stop_type stop_requested_{false};
+  pool task_pool_;
+
+private:
+  void enqueue(pool &target, task_t item);
+
+  void post(const std::shared_ptr<strand> &str, task_t item);
+
+  void run_strand(std::shared_ptr<strand> str);
+
+  void start();
+
+  void stop();
+
+  void worker_thread(pool &source);
+
+public:
+  // Runs action on the strand and waits for its result. Must not be called
+  // from work already running on the same strand.
+  [[nodiscard]] auto execute(const std::shared_ptr<strand> &str,
+                             action_t action) -> api_error;
+
+  [[nodiscard]] auto get_io_thread_count() -> std::size_t;
+
+  [[nodiscard]] auto get_task_thread_count() -> std::size_t;
+
+  void read(const std::shared_ptr<strand> &str, utils::file::i_file &file,
+            std::uint64_t offset, data_span data, completed_t completed);
+
+  // Runs long running work, such as read ahead, outside of the I/O workers
+  void schedule(task_t task);
+
+  void submit(const std::shared_ptr<strand> &str, action_t action,
+              std::function<void(api_error result)> completed);
+
+  void write(const std::shared_ptr<strand> &str, utils::file::i_file &file,
+             std::uint64_t offset, data_cspan data, completed_t completed);
+};
+} // namespace repertory
+
+#endif // REPERTORY_INCLUDE_FILE_MANAGER_IO_ENGINE_HPP_
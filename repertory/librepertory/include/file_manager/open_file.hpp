@@ -22,6 +22,7 @@
 #ifndef REPERTORY_INCLUDE_FILE_MANAGER_OPEN_FILE_HPP_
 #define REPERTORY_INCLUDE_FILE_MANAGER_OPEN_FILE_HPP_
 
+#include "file_manager/access_pattern.hpp"
 #include "file_manager/open_file_base.hpp"
 
 #include "types/repertory.hpp"
@@ -68,12 +69,23 @@ private:
   i_upload_manager &mgr_;
 
 private:
+  access_pattern access_pattern_;
   bool allocated{false};
+  bool full_read_ahead_{false};
+  std::atomic<std::uint8_t> max_download_count_{default_max_download_count};
   std::unique_ptr<utils::file::i_file> nf_;
   bool notified_{false};
+  std::deque<std::size_t> read_ahead_chunks_;
+  std::atomic<read_ahead_policy> read_ahead_policy_{
+      read_ahead_policy::adaptive,
+  };
   std::size_t read_chunk_{};
   boost::dynamic_bitset<> read_state_;
-  std::unique_ptr<std::thread> reader_thread_;
+  std::size_t reader_chunk_{};
+  std::mutex reader_mtx_;
+  std::size_t reader_next_chunk_{};
+  std::condition_variable reader_notify_;
+  bool reader_scheduled_{false};
   mutable std::recursive_mutex rw_mtx_;
   stop_type stop_requested_{false};
 
@@ -83,13 +95,26 @@ private:
 
   [[nodiscard]] auto check_start() -> api_error;
 
+  [[nodiscard]] auto claim_chunks(std::size_t begin_chunk,
+                                  std::size_t end_chunk)
+      -> std::vector<std::size_t>;
+
   void download_chunk(std::size_t chunk, bool skip_active, bool should_reset);
 
+  void download_chunks(const std::vector<std::size_t> &chunks,
+                       bool skip_active, bool should_reset);
+
   void download_range(std::size_t begin_chunk, std::size_t end_chunk,
                       bool should_reset);
 
+  [[nodiscard]] auto get_next_read_ahead_chunks() -> std::vector<std::size_t>;
+
   [[nodiscard]] auto get_stop_requested() const -> bool;
 
+  void read_ahead();
+
+  void release_chunks(const std::vector<std::size_t> &chunks, api_error err);
+
   void set_modified();
 
   void set_read_state(std::size_t chunk);
@@ -105,6 +130,10 @@ public:
 
   [[nodiscard]] auto get_allocated() const -> bool override;
 
+  [[nodiscard]] auto get_max_download_count() const -> std::uint8_t;
+
+  [[nodiscard]] auto get_read_ahead_policy() const -> read_ahead_policy;
+
   [[nodiscard]] auto get_read_state() const -> boost::dynamic_bitset<> override;
 
   [[nodiscard]] auto get_read_state(std::size_t chunk) const -> bool override;
@@ -126,12 +155,20 @@ public:
 
   void remove_all() override;
 
-  [[nodiscard]] auto read(std::size_t read_size, std::uint64_t read_offset,
-                          data_buffer &data) -> api_error override;
+  using open_file_base::read;
+
+  [[nodiscard]] auto read(std::uint64_t read_offset, data_span data,
+                          std::size_t &bytes_read) -> api_error override;
 
   [[nodiscard]] auto resize(std::uint64_t new_file_size) -> api_error override;
 
-  [[nodiscard]] auto write(std::uint64_t write_offset, const data_buffer &data,
+  void set_max_download_count(std::uint8_t count);
+
+  void set_read_ahead_policy(read_ahead_policy policy);
+
+  using open_file_base::write;
+
+  [[nodiscard]] auto write(std::uint64_t write_offset, data_cspan data,
                            std::size_t &bytes_written) -> api_error override;
 };
 } // namespace repertory
@@ -23,6 +23,7 @@
 #define REPERTORY_INCLUDE_FILE_MANAGER_OPEN_FILE_BASE_HPP_
 
 #include "file_manager/i_open_file.hpp"
+#include "file_manager/io_engine.hpp"
 
 namespace repertory {
 class i_provider;
@@ -71,31 +72,6 @@ public:
     auto wait() -> api_error;
   };
 
-  class io_item final {
-  public:
-    io_item(std::function<api_error()> action) : action_(std::move(action)) {}
-
-    ~io_item() = default;
-
-  public:
-    io_item() = delete;
-    io_item(const io_item &) noexcept = delete;
-    io_item(io_item &&) noexcept = delete;
-    auto operator=(io_item &&) noexcept -> io_item & = delete;
-    auto operator=(const io_item &) noexcept -> io_item & = delete;
-
-  private:
-    std::function<api_error()> action_;
-    std::mutex mtx_;
-    std::condition_variable notify_;
-    std::optional<api_error> result_;
-
-  public:
-    void action();
-
-    [[nodiscard]] auto get_result() -> api_error;
-  };
-
 private:
   std::uint64_t chunk_size_;
   std::uint8_t chunk_timeout_;
@@ -110,23 +86,24 @@ private:
   mutable std::mutex error_mtx_;
   mutable std::recursive_mutex file_mtx_;
   stop_type io_stop_requested_{false};
-  std::unique_ptr<std::thread> io_thread_;
-  mutable std::mutex io_thread_mtx_;
-  std::condition_variable io_thread_notify_;
-  std::deque<std::shared_ptr<io_item>> io_thread_queue_;
+  std::shared_ptr<io_engine::strand> io_strand_;
   std::atomic<std::chrono::system_clock::time_point> last_access_{
       std::chrono::system_clock::now(),
   };
+  std::atomic<std::uint16_t> meta_flush_interval_{
+      default_meta_flush_interval_secs,
+  };
+  std::mutex meta_flush_mtx_;
   bool modified_{false};
+  api_meta_map pending_meta_;
+  std::chrono::system_clock::time_point pending_meta_time_;
   bool removed_{false};
+  std::atomic<bool> sync_requested_{false};
   bool unlinked_{false};
   api_meta_map unlinked_meta_;
 
-private:
-  void file_io_thread();
-
 protected:
-  [[nodiscard]] auto do_io(std::function<api_error()> action) -> api_error;
+  [[nodiscard]] auto do_io(io_engine::action_t action) -> api_error;
 
   [[nodiscard]] auto get_active_downloads()
       -> std::unordered_map<std::size_t, std::shared_ptr<download>> & {
@@ -147,8 +124,6 @@ protected:
 
   [[nodiscard]] auto is_removed() const -> bool;
 
-  void notify_io();
-
   void reset_timeout();
 
   auto set_api_error(api_error err) -> api_error;
@@ -163,8 +138,6 @@ protected:
 
   void set_source_path(std::string source_path);
 
-  void wait_for_io(stop_type_callback stop_requested_cb);
-
 public:
   void add(std::uint64_t handle, open_file_data ofd, bool notify) override;
 
@@ -172,6 +145,8 @@ public:
 
   auto close() -> bool override;
 
+  [[nodiscard]] auto flush_pending_meta() -> api_error override;
+
   [[nodiscard]] auto get_allocated() const -> bool override { return false; }
 
   [[nodiscard]] auto get_api_error() const -> api_error;
@@ -202,6 +177,8 @@ public:
 
   [[nodiscard]] auto get_open_file_count() const -> std::size_t override;
 
+  [[nodiscard]] auto get_pending_meta() const -> api_meta_map override;
+
   [[nodiscard]] auto get_source_path() const -> std::string override;
 
   [[nodiscard]] auto get_unlinked_meta() const -> api_meta_map override;
@@ -212,19 +189,44 @@ public:
     return fsi_.directory;
   }
 
+  [[nodiscard]] auto is_sync_requested() const -> bool override {
+    return sync_requested_;
+  }
+
   [[nodiscard]] auto is_unlinked() const -> bool override;
 
   [[nodiscard]] auto is_modified() const -> bool override;
 
+  [[nodiscard]] auto is_pending_meta_expired() const -> bool override;
+
+  // Buffer based I/O is layered over the span overloads implemented by each
+  // open file type
+  [[nodiscard]] auto read(std::size_t read_size, std::uint64_t read_offset,
+                          data_buffer &data) -> api_error override;
+
+  using i_open_file::read;
+
   void remove(std::uint64_t handle) override;
 
   void remove_all() override;
 
   void set_api_path(std::string_view api_path) override;
 
+  void set_meta_flush_interval(std::uint16_t seconds) override;
+
+  [[nodiscard]] auto set_pending_meta(const api_meta_map &meta)
+      -> api_error override;
+
+  void set_sync_requested(bool value) override { sync_requested_ = value; }
+
   void set_unlinked(bool value) override;
 
   void set_unlinked_meta(api_meta_map meta) override;
+
+  [[nodiscard]] auto write(std::uint64_t write_offset, const data_buffer &data,
+                           std::size_t &bytes_written) -> api_error override;
+
+  using i_open_file::write;
 };
 } // namespace repertory
 
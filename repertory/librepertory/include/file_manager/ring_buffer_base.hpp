@@ -22,6 +22,7 @@
 #ifndef REPERTORY_INCLUDE_FILE_MANAGER_RING_BUFFER_BASE_HPP_
 #define REPERTORY_INCLUDE_FILE_MANAGER_RING_BUFFER_BASE_HPP_
 
+#include "file_manager/chunk_cache.hpp"
 #include "file_manager/open_file_base.hpp"
 
 #include "types/repertory.hpp"
@@ -51,15 +52,25 @@ public:
   static constexpr auto min_ring_size{5U};
 
 private:
+  struct reader_state final {
+    std::size_t last_marker{};
+    std::size_t next_chunk{};
+    bool scheduled{false};
+  };
+
+private:
+  chunk_cache *cache_{nullptr};
+  std::string cache_version_;
   boost::dynamic_bitset<> read_state_;
   std::size_t total_chunks_;
 
 private:
   std::condition_variable chunk_notify_;
   mutable std::mutex chunk_mtx_;
-  std::unique_ptr<std::thread> forward_reader_thread_;
+  reader_state forward_reader_;
   std::mutex read_mtx_;
-  std::unique_ptr<std::thread> reverse_reader_thread_;
+  std::atomic<bool> readers_started_{false};
+  reader_state reverse_reader_;
   std::size_t ring_begin_{};
   std::size_t ring_end_{};
   std::size_t ring_pos_{};
@@ -70,17 +81,28 @@ private:
 
   auto download_chunk(std::size_t chunk, bool skip_active) -> api_error;
 
-  void reader_thread(bool is_forward);
+  void read_ahead(bool is_forward);
+
+  // Requires chunk_mtx_ to be held
+  void schedule_readers();
 
   void update_position(std::size_t count, bool is_forward);
 
   [[nodiscard]] auto get_stop_requested() const -> bool;
 
 protected:
-  [[nodiscard]] auto has_reader_thread() const -> bool {
-    return forward_reader_thread_ != nullptr;
+  // Returns the chunk from the shared cache, loading it again if it was
+  // evicted. Requires a chunk cache to be set.
+  [[nodiscard]] auto get_cached_chunk(std::size_t chunk,
+                                      chunk_cache::buffer_ptr &buffer)
+      -> api_error;
+
+  [[nodiscard]] auto has_chunk_cache() const -> bool {
+    return cache_ != nullptr;
   }
 
+  [[nodiscard]] auto has_readers() const -> bool { return readers_started_; }
+
   [[nodiscard]] auto get_ring_size() const -> std::size_t {
     return read_state_.size();
   }
@@ -91,10 +113,17 @@ protected:
                                                  const data_buffer &buffer)
       -> api_error = 0;
 
-  [[nodiscard]] virtual auto
-  on_read_chunk(std::size_t chunk, std::size_t read_size,
-                std::uint64_t read_offset, data_buffer &data,
-                std::size_t &bytes_read) -> api_error = 0;
+  [[nodiscard]] virtual auto on_chunk_cached(std::size_t chunk,
+                                             chunk_cache::buffer_ptr buffer)
+      -> api_error {
+    return on_chunk_downloaded(chunk, *buffer);
+  }
+
+  [[nodiscard]] virtual auto on_read_chunk(std::size_t chunk,
+                                           std::uint64_t read_offset,
+                                           data_span data,
+                                           std::size_t &bytes_read)
+      -> api_error = 0;
 
   [[nodiscard]] virtual auto
   use_buffer(std::size_t chunk, std::function<api_error(data_buffer &)> func)
@@ -129,8 +158,10 @@ public:
     return false;
   }
 
-  [[nodiscard]] auto read(std::size_t read_size, std::uint64_t read_offset,
-                          data_buffer &data) -> api_error override;
+  using open_file_base::read;
+
+  [[nodiscard]] auto read(std::uint64_t read_offset, data_span data,
+                          std::size_t &bytes_read) -> api_error override;
 
   [[nodiscard]] auto resize(std::uint64_t /* size */) -> api_error override {
     return api_error::not_supported;
@@ -142,8 +173,12 @@ public:
 
   void set_api_path(std::string_view api_path) override;
 
+  void set_chunk_cache(chunk_cache *cache, std::string version);
+
+  using open_file_base::write;
+
   [[nodiscard]] auto write(std::uint64_t /* write_offset */,
-                           const data_buffer & /* data */,
+                           data_cspan /* data */,
                            std::size_t & /* bytes_written */)
       -> api_error override {
     return api_error::not_supported;
@@ -61,9 +61,8 @@ protected:
                                          const data_buffer &buffer)
       -> api_error override;
 
-  [[nodiscard]] auto on_read_chunk(std::size_t chunk, std::size_t read_size,
-                                   std::uint64_t read_offset, data_buffer &data,
-                                   std::size_t &bytes_read)
+  [[nodiscard]] auto on_read_chunk(std::size_t chunk, std::uint64_t read_offset,
+                                   data_span data, std::size_t &bytes_read)
       -> api_error override;
 
   [[nodiscard]] auto use_buffer(std::size_t chunk,
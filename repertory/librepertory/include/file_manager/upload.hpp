@@ -31,7 +31,7 @@ class upload final {
 public:
   upload(filesystem_item fsi, i_provider &provider);
 
-  ~upload();
+  ~upload() = default;
 
 public:
   upload() = delete;
@@ -45,17 +45,16 @@ private:
   i_provider &provider_;
 
 private:
-  bool cancelled_{false};
+  std::atomic<bool> cancelled_{false};
   api_error error_{api_error::success};
   stop_type stop_requested_{false};
-  std::unique_ptr<std::thread> thread_;
-
-private:
-  void upload_thread();
 
 public:
   void cancel();
 
+  // Runs on the calling thread and raises file_upload_completed when done
+  void execute();
+
   [[nodiscard]] auto get_api_error() const -> api_error { return error_; }
 
   [[nodiscard]] auto get_api_path() const -> std::string {
@@ -0,0 +1,102 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_FILE_MANAGER_UPLOAD_SCHEDULER_HPP_
+#define REPERTORY_INCLUDE_FILE_MANAGER_UPLOAD_SCHEDULER_HPP_
+
+#include "types/repertory.hpp"
+
+namespace repertory {
+enum class upload_priority : std::uint8_t {
+  sync_requested,
+  small_file,
+  normal,
+};
+
+// In-memory ordering of pending uploads. The upload table remains the durable
+// record; this only decides which queued file a worker takes next. Entries are
+// taken by priority and then in queue order, skipping any that would exceed
+// the active count or byte budget. Queuing a file that is already waiting
+// updates the existing entry in place. Callers serialize access.
+class upload_scheduler final {
+public:
+  struct entry final {
+    std::string api_path;
+    std::uint64_t file_size{};
+    upload_priority priority{upload_priority::normal};
+    std::chrono::steady_clock::time_point ready_time{};
+    std::string source_path;
+  };
+
+  static constexpr std::uint64_t small_file_size{1024ULL * 1024ULL};
+
+private:
+  using key_t = std::pair<upload_priority, std::uint64_t>;
+
+private:
+  std::unordered_map<std::string, std::uint64_t> active_;
+  std::uint64_t active_bytes_{};
+  std::uint64_t next_id_{};
+  std::map<key_t, entry> queue_;
+  std::unordered_map<std::string, key_t> queued_;
+
+public:
+  void clear();
+
+  [[nodiscard]] auto get_active_bytes() const -> std::uint64_t {
+    return active_bytes_;
+  }
+
+  [[nodiscard]] auto get_active_count() const -> std::size_t {
+    return active_.size();
+  }
+
+  // Earliest time a delayed retry becomes ready
+  [[nodiscard]] auto get_next_ready_time() const
+      -> std::optional<std::chrono::steady_clock::time_point>;
+
+  [[nodiscard]] static auto get_priority(std::uint64_t file_size,
+                                         bool sync_requested)
+      -> upload_priority;
+
+  [[nodiscard]] auto get_queued_count() const -> std::size_t {
+    return queue_.size();
+  }
+
+  [[nodiscard]] auto is_active(std::string_view api_path) const -> bool;
+
+  [[nodiscard]] auto is_queued(std::string_view api_path) const -> bool;
+
+  // A file that exceeds the byte budget on its own is still started once
+  // nothing else is active.
+  [[nodiscard]] auto pop(std::size_t max_count, std::uint64_t max_bytes)
+      -> std::optional<entry>;
+
+  // Returns false when the file was already queued and the entry was merged
+  auto push(entry item) -> bool;
+
+  void release(std::string_view api_path);
+
+  auto remove(std::string_view api_path) -> bool;
+};
+} // namespace repertory
+
+#endif // REPERTORY_INCLUDE_FILE_MANAGER_UPLOAD_SCHEDULER_HPP_
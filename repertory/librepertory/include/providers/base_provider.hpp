@@ -24,6 +24,8 @@
 
 #include "db/i_meta_db.hpp"
 #include "providers/i_provider.hpp"
+#include "providers/listing_cache.hpp"
+#include "providers/listing_snapshot.hpp"
 #include "types/repertory.hpp"
 
 namespace repertory {
@@ -39,9 +41,16 @@ private:
     std::string source_path;
   };
 
+public:
+  static constexpr std::size_t reconcile_page_size{1000U};
+
 public:
   base_provider(app_config &config, i_http_comm &comm)
-      : config_(config), comm_(comm) {}
+      : config_(config),
+        comm_(comm),
+        listing_cache_([this](auto &&api_path, auto &&list) -> api_error {
+          return load_directory_items(api_path, list);
+        }) {}
 
 private:
   app_config &config_;
@@ -50,10 +59,25 @@ private:
 private:
   api_item_added_callback api_item_added_;
   i_file_manager *fm_{nullptr};
+  mutable listing_cache listing_cache_;
   std::unique_ptr<i_meta_db> meta_db_;
+  std::uint64_t previous_listing_start_{};
+  listing_snapshot previous_snapshot_;
+  std::string reconcile_cursor_;
+  std::unordered_map<std::string, std::uint64_t> uploaded_paths_;
+  mutable std::mutex uploaded_mtx_;
 
 private:
-  void add_all_items(stop_type &stop_requested);
+  [[nodiscard]] auto add_all_items(stop_type &stop_requested,
+                                   listing_snapshot &snapshot) -> bool;
+
+  [[nodiscard]] auto is_changed_externally(std::string_view api_path,
+                                           const listing_snapshot::entry &item)
+      -> bool;
+
+  [[nodiscard]] auto load_directory_items(std::string_view api_path,
+                                          directory_item_list &list) const
+      -> api_error;
 
   void process_removed_directories(std::deque<removed_item> removed_list,
                                    stop_type &stop_requested);
@@ -61,9 +85,11 @@ private:
   void process_removed_files(std::deque<removed_item> removed_list,
                              stop_type &stop_requested);
 
-  void process_removed_items(stop_type &stop_requested);
+  [[nodiscard]] auto process_changed_file(std::string_view api_path,
+                                          const listing_snapshot::entry &item,
+                                          api_meta_map &meta) -> bool;
 
-  void remove_deleted_items(stop_type &stop_requested);
+  void reconcile_items(listing_snapshot &snapshot, stop_type &stop_requested);
 
   void remove_unmatched_source_files(stop_type &stop_requested);
 
@@ -86,6 +112,12 @@ protected:
     return api_error::success;
   }
 
+  // Providers whose get_file_list() reports the remote size and last-modified
+  // time (instead of values taken from item meta) can detect external changes.
+  [[nodiscard]] virtual auto is_change_detection_supported() const -> bool {
+    return false;
+  }
+
   [[nodiscard]] auto get_api_item_added() -> api_item_added_callback & {
     return api_item_added_;
   }
@@ -119,6 +151,13 @@ protected:
     return fm_;
   }
 
+  // Drops cached listings of the item's parent and of the item itself.
+  void invalidate_listing(std::string_view api_path);
+
+  // One reconcile pass: compares a complete provider listing with the meta
+  // DB, removing deleted items and refreshing externally changed files.
+  void remove_deleted_items(stop_type &stop_requested);
+
   [[nodiscard]] virtual auto remove_directory_impl(std::string_view api_path)
       -> api_error = 0;
 
@@ -186,6 +225,14 @@ public:
 
   [[nodiscard]] auto is_read_only() const -> bool override { return false; }
 
+  using i_provider::read_file_bytes;
+
+  [[nodiscard]] auto read_file_bytes(std::string_view api_path,
+                                     std::uint64_t offset, data_span data,
+                                     std::size_t &bytes_read,
+                                     stop_type &stop_requested)
+      -> api_error override;
+
   [[nodiscard]] auto remove_directory(std::string_view api_path)
       -> api_error override;
 
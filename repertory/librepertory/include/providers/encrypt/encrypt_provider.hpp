@@ -191,6 +191,12 @@ public:
                                      stop_type &stop_requested)
       -> api_error override;
 
+  [[nodiscard]] auto read_file_bytes(std::string_view api_path,
+                                     std::uint64_t offset, data_span data,
+                                     std::size_t &bytes_read,
+                                     stop_type &stop_requested)
+      -> api_error override;
+
   [[nodiscard]] auto remove_directory(std::string_view /*api_path*/)
       -> api_error override {
     return api_error::not_implemented;
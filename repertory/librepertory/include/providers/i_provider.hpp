@@ -121,6 +121,11 @@ public:
                   std::uint64_t offset, data_buffer &data,
                   stop_type &stop_requested) -> api_error = 0;
 
+  [[nodiscard]] virtual auto
+  read_file_bytes(std::string_view api_path, std::uint64_t offset,
+                  data_span data, std::size_t &bytes_read,
+                  stop_type &stop_requested) -> api_error = 0;
+
   [[nodiscard]] virtual auto remove_directory(std::string_view api_path)
       -> api_error = 0;
 
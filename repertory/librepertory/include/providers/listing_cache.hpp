@@ -0,0 +1,106 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_PROVIDERS_LISTING_CACHE_HPP_
+#define REPERTORY_INCLUDE_PROVIDERS_LISTING_CACHE_HPP_
+
+#include "types/repertory.hpp"
+#include "utils/single_thread_service_base.hpp"
+
+namespace repertory {
+// Bounded cache of sorted directory listings. Listings younger than the
+// timeout are served from memory. Listings older than the timeout but
+// younger than twice the timeout are served stale while a background refresh
+// runs; anything older is reloaded synchronously.
+class listing_cache final : public single_thread_service_base {
+public:
+  using list_ptr = std::shared_ptr<const directory_item_list>;
+  using loader_t = std::function<api_error(std::string_view api_path,
+                                           directory_item_list &list)>;
+
+  static constexpr std::size_t default_max_entries{1024U};
+
+private:
+  struct entry final {
+    std::chrono::steady_clock::time_point fetched;
+    std::uint64_t last_used{};
+    list_ptr list;
+    bool refreshing{false};
+  };
+
+  struct load_state final {
+    std::size_t count{};
+    bool invalidated{false};
+  };
+
+public:
+  explicit listing_cache(loader_t loader,
+                         std::size_t max_entries = default_max_entries)
+      : single_thread_service_base("listing_cache"),
+        loader_(std::move(loader)),
+        max_entries_(std::max(std::size_t{1U}, max_entries)) {}
+
+  listing_cache(const listing_cache &) = delete;
+  listing_cache(listing_cache &&) = delete;
+
+  ~listing_cache() override = default;
+
+  auto operator=(const listing_cache &) -> listing_cache & = delete;
+  auto operator=(listing_cache &&) -> listing_cache & = delete;
+
+private:
+  loader_t loader_;
+  std::size_t max_entries_;
+
+private:
+  std::unordered_map<std::string, entry> entries_;
+  std::unordered_map<std::string, load_state> loading_;
+  std::deque<std::string> pending_;
+  bool running_{false};
+  std::uint64_t use_count_{};
+
+private:
+  void evict_oldest();
+
+  [[nodiscard]] auto load(std::string_view api_path, bool cacheable,
+                          list_ptr &list) -> api_error;
+
+protected:
+  void on_start() override;
+
+  void on_stop() override;
+
+  void service_function() override;
+
+public:
+  void clear();
+
+  [[nodiscard]] auto get(std::string_view api_path,
+                         std::chrono::milliseconds timeout, list_ptr &list)
+      -> api_error;
+
+  [[nodiscard]] auto get_size() const -> std::size_t;
+
+  void invalidate(std::string_view api_path);
+};
+} // namespace repertory
+
+#endif // REPERTORY_INCLUDE_PROVIDERS_LISTING_CACHE_HPP_
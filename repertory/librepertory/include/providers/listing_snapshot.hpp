@@ -0,0 +1,63 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_INCLUDE_PROVIDERS_LISTING_SNAPSHOT_HPP_
+#define REPERTORY_INCLUDE_PROVIDERS_LISTING_SNAPSHOT_HPP_
+
+#include "types/repertory.hpp"
+
+namespace repertory {
+// Sorted view of a complete provider listing. Directories are derived from
+// the parents of listed files. Lookups are expected in ascending order and
+// advance a merge cursor; a lookup behind the cursor restarts it.
+class listing_snapshot final {
+public:
+  struct entry final {
+    std::string api_path;
+    bool directory{false};
+    std::uint64_t modified_date{};
+    std::uint64_t size{};
+  };
+
+private:
+  std::vector<entry> entries_;
+  std::string last_parent_;
+  std::size_t pos_{0U};
+
+public:
+  void add(const api_file &file);
+
+  void clear();
+
+  [[nodiscard]] auto empty() const -> bool { return entries_.empty(); }
+
+  [[nodiscard]] auto find(std::string_view api_path) -> const entry *;
+
+  void seal();
+
+  [[nodiscard]] auto size() const -> std::size_t { return entries_.size(); }
+
+  // Replaces the sealed entry with the same api path, if present
+  void update(const entry &item);
+};
+} // namespace repertory
+
+#endif // REPERTORY_INCLUDE_PROVIDERS_LISTING_SNAPSHOT_HPP_
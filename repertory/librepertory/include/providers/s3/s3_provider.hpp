@@ -22,8 +22,11 @@
 #ifndef REPERTORY_INCLUDE_PROVIDERS_S3_S3_PROVIDER_HPP_
 #define REPERTORY_INCLUDE_PROVIDERS_S3_S3_PROVIDER_HPP_
 
+#include "db/i_file_mgr_db.hpp"
+#include "events/event_system.hpp"
 #include "providers/base_provider.hpp"
 #include "types/repertory.hpp"
+#include "utils/encrypting_reader.hpp"
 #include "utils/encryption.hpp"
 #include "utils/hash.hpp"
 
@@ -34,6 +37,11 @@ struct i_http_comm;
 struct head_object_result;
 
 class s3_provider final : public base_provider {
+  E_CONSUMER();
+
+private:
+  static constexpr std::size_t max_cached_data_keys{1024U};
+
 private:
   using interate_callback_t = std::function<api_error(
       std::string_view prefix, const pugi::xml_node &node,
@@ -45,7 +53,7 @@ public:
 public:
   s3_provider(app_config &config, i_http_comm &comm);
 
-  ~s3_provider() override = default;
+  ~s3_provider() override;
 
 public:
   s3_provider(const s3_provider &) = delete;
@@ -62,10 +70,28 @@ private:
   utils::hash::hash_256_t master_key_{};
 
 private:
+  struct data_key_entry final {
+    std::string kdf;
+    utils::hash::hash_256_t key;
+  };
+
+  std::unordered_map<std::string, data_key_entry> data_key_cache_;
+  mutable std::mutex data_key_mtx_;
+
+private:
+  [[nodiscard]] auto abort_multipart_upload(std::string_view object_name,
+                                            std::string_view upload_id) const
+      -> api_error;
+
   [[nodiscard]] auto add_if_not_found(api_file &file,
                                       std::string_view object_name) const
       -> api_error;
 
+  [[nodiscard]] auto
+  complete_multipart_upload(std::string_view object_name,
+                            const i_file_mgr_db::multipart_entry &entry) const
+      -> api_error;
+
   [[nodiscard]] auto create_directory_object(std::string_view api_path,
                                              std::string_view object_name) const
       -> api_error;
@@ -78,9 +104,17 @@ private:
                                        api_meta_map &meta)
       -> api_error override;
 
+  [[nodiscard]] auto create_multipart_upload(std::string_view object_name,
+                                             std::string &upload_id) const
+      -> api_error;
+
   [[nodiscard]] auto decrypt_object_name(std::string &object_name) const
       -> api_error;
 
+  [[nodiscard]] auto get_data_key(std::string_view api_path,
+                                  std::string_view kdf_str)
+      -> utils::hash::hash_256_t;
+
   [[nodiscard]] auto
   get_kdf_config_from_meta(std::string_view api_path,
                            utils::encryption::kdf_config &cfg) const
@@ -110,12 +144,27 @@ private:
   [[nodiscard]] auto initialize_crypto(const s3_config &cfg, bool is_retry)
       -> bool;
 
+  void remove_data_key(std::string_view api_path);
+
   [[nodiscard]] auto
   search_keys_for_master_kdf(std::string_view encryption_token) -> bool;
 
   [[nodiscard]] auto set_meta_key(std::string_view api_path, api_meta_map &meta)
       -> api_error;
 
+  [[nodiscard]] auto upload_multipart(std::string_view api_path,
+                                      std::string_view object_name,
+                                      std::string_view source_path,
+                                      std::uint64_t file_size,
+                                      std::uint64_t upload_size,
+                                      stop_type &stop_requested) -> api_error;
+
+  [[nodiscard]] auto upload_part(
+      std::string_view object_name, std::string_view source_path,
+      std::string_view upload_id, std::uint32_t part_number, http_range range,
+      std::shared_ptr<utils::encryption::encrypting_reader> reader,
+      std::string &etag, stop_type &stop_requested) const -> api_error;
+
 protected:
   [[nodiscard]] auto create_directory_impl(std::string_view api_path,
                                            api_meta_map &meta)
@@ -125,6 +174,10 @@ protected:
                                               directory_item_list &list) const
       -> api_error override;
 
+  [[nodiscard]] auto is_change_detection_supported() const -> bool override {
+    return true;
+  }
+
   [[nodiscard]] auto remove_directory_impl(std::string_view api_path)
       -> api_error override;
 
@@ -180,6 +233,8 @@ public:
                                     interate_callback_t key_action) const
       -> api_error;
 
+  using base_provider::read_file_bytes;
+
   [[nodiscard]] auto read_file_bytes(std::string_view api_path,
                                      std::size_t size, std::uint64_t offset,
                                      data_buffer &data,
@@ -124,6 +124,8 @@ public:
     return true;
   }
 
+  using base_provider::read_file_bytes;
+
   [[nodiscard]] auto read_file_bytes(std::string_view api_path,
                                      std::size_t size, std::uint64_t offset,
                                      data_buffer &buffer,
@@ -218,6 +218,31 @@ struct statfs_x final : public statfs {
 };
 #pragma pack()
 
+inline constexpr const std::uint32_t max_directory_entries{1024U};
+
+struct directory_entry final {
+  std::string item_path;
+  std::int32_t res{};
+  stat r_stat{};
+  bool directory{false};
+};
+
+using read_directory_entry_callback =
+    std::function<std::int32_t(file_offset offset, std::string &item_path)>;
+
+using get_directory_entry_attr_callback = std::function<std::int32_t(
+    std::string_view item_path, stat &r_stat, bool &directory)>;
+
+// Builds a page of at most max_count entries from single entry reads.
+// Attribute failures are returned per entry. Read errors, including -120 at
+// the end of the listing, are only returned when the page is empty.
+[[nodiscard]] auto
+read_directory_page(std::string_view api_path, file_offset offset,
+                    std::uint32_t max_count,
+                    const read_directory_entry_callback &read_entry,
+                    const get_directory_entry_attr_callback &get_attr,
+                    std::vector<directory_entry> &entries) -> std::int32_t;
+
 #if !defined(_WIN32)
 [[nodiscard]] auto create_open_flags(std::uint32_t flags) -> open_flags;
 
@@ -27,6 +27,10 @@
 
 namespace repertory {
 inline constexpr auto default_api_password_size{48U};
+inline constexpr auto default_chunk_cache_size_bytes{
+    std::uint64_t(256ULL * 1024ULL * 1024ULL),
+};
+inline constexpr auto default_directory_cache_timeout_secs{std::uint16_t{10U}};
 inline constexpr auto default_download_timeout_secs{30U};
 inline constexpr auto default_eviction_delay_mins{1U};
 inline constexpr auto default_high_freq_interval_secs{std::uint16_t{30U}};
@@ -36,10 +40,17 @@ inline constexpr auto default_low_freq_interval_secs{
 inline constexpr auto default_max_cache_size_bytes{
     std::uint64_t(20ULL * 1024ULL * 1024ULL * 1024ULL),
 };
+inline constexpr auto default_max_download_count{8U};
+inline constexpr auto default_kernel_attr_timeout_secs{std::uint16_t{1U}};
+inline constexpr auto default_max_upload_part_count{4U};
+inline constexpr auto default_max_upload_bytes{
+    std::uint64_t(1024ULL * 1024ULL * 1024ULL),
+};
 inline constexpr auto default_max_upload_count{5U};
 inline constexpr auto default_med_freq_interval_secs{
     std::uint16_t{2U * 60U},
 };
+inline constexpr auto default_meta_flush_interval_secs{std::uint16_t{5U}};
 inline constexpr auto default_online_check_retry_secs{60U};
 inline constexpr auto default_retry_read_count{6U};
 inline constexpr auto default_ring_buffer_file_size{512U};
@@ -47,9 +58,11 @@ inline constexpr auto default_rpc_port{std::uint16_t(10000U)};
 inline constexpr auto default_task_wait_ms{100U};
 inline constexpr auto default_timeout_ms{60000U};
 inline constexpr auto default_ui_mgmt_port{std::uint16_t{30000U}};
+inline constexpr auto default_upload_part_size{64U};
 inline constexpr auto max_ring_buffer_file_size{std::uint16_t(1024U)};
 inline constexpr auto max_s3_object_name_length{1024U};
 inline constexpr auto max_s3_segment_name_length{255U};
+inline constexpr auto max_s3_upload_part_count{10000U};
 inline constexpr auto min_cache_size_bytes{
     std::uint64_t(100ULL * 1024ULL * 1024ULL),
 };
@@ -58,6 +71,7 @@ inline constexpr auto min_online_check_retry_secs{std::uint16_t(15U)};
 inline constexpr auto min_retry_read_count{std::uint16_t(2U)};
 inline constexpr auto min_ring_buffer_file_size{std::uint16_t(64U)};
 inline constexpr auto min_task_wait_ms{std::uint16_t(50U)};
+inline constexpr auto min_upload_part_size{5U};
 
 inline constexpr auto max_time{
     std::numeric_limits<std::uint64_t>::max(),
@@ -241,6 +255,19 @@ provider_type_from_string(std::string_view type,
 
 [[nodiscard]] auto provider_type_to_string(provider_type type) -> std::string;
 
+enum class read_ahead_policy {
+  adaptive,
+  full,
+  none,
+};
+[[nodiscard]] auto read_ahead_policy_from_string(
+    std::string_view policy,
+    read_ahead_policy default_policy = read_ahead_policy::adaptive)
+    -> read_ahead_policy;
+
+[[nodiscard]] auto read_ahead_policy_to_string(const read_ahead_policy &policy)
+    -> std::string;
+
 void clean_json_config(provider_type prov, nlohmann::json &data);
 
 [[nodiscard]] auto clean_json_value(std::string_view name,
@@ -342,9 +369,11 @@ struct s3_config final {
   std::string bucket;
   std::string encryption_token;
   bool force_legacy_encryption{false};
+  std::uint16_t max_upload_part_count{default_max_upload_part_count};
   std::string region{"any"};
   std::string secret_key;
   std::uint32_t timeout_ms{default_timeout_ms};
+  std::uint32_t upload_part_size{default_upload_part_size};
   std::string url;
   bool use_path_style{false};
   bool use_region_in_url{false};
@@ -354,8 +383,10 @@ struct s3_config final {
       return access_key == cfg.access_key && bucket == cfg.bucket &&
              encryption_token == cfg.encryption_token &&
              force_legacy_encryption == cfg.force_legacy_encryption &&
+             max_upload_part_count == cfg.max_upload_part_count &&
              region == cfg.region && secret_key == cfg.secret_key &&
-             timeout_ms == cfg.timeout_ms && url == cfg.url &&
+             timeout_ms == cfg.timeout_ms &&
+             upload_part_size == cfg.upload_part_size && url == cfg.url &&
              use_path_style == cfg.use_path_style &&
              use_region_in_url == cfg.use_region_in_url;
     }
@@ -408,9 +439,12 @@ inline constexpr auto JSON_API_PORT{"ApiPort"};
 inline constexpr auto JSON_API_USER{"ApiUser"};
 inline constexpr auto JSON_AUTO_START{"AutoStart"};
 inline constexpr auto JSON_BUCKET{"Bucket"};
+inline constexpr auto JSON_CHUNK_CACHE_SIZE_BYTES{"ChunkCacheSizeBytes"};
 inline constexpr auto JSON_CLIENT_POOL_SIZE{"ClientPoolSize"};
 inline constexpr auto JSON_CONNECT_TIMEOUT_MS{"ConnectTimeoutMs"};
 inline constexpr auto JSON_DATABASE_TYPE{"DatabaseType"};
+inline constexpr auto JSON_DIRECTORY_CACHE_TIMEOUT_SECS{
+    "DirectoryCacheTimeoutSeconds"};
 inline constexpr auto JSON_DIRECTORY{"Directory"};
 inline constexpr auto JSON_DOWNLOAD_TIMEOUT_SECS{"DownloadTimeoutSeconds"};
 inline constexpr auto JSON_ENABLE_DOWNLOAD_TIMEOUT{"EnableDownloadTimeout"};
@@ -427,18 +461,24 @@ inline constexpr auto JSON_HIGH_FREQ_INTERVAL_SECS{"HighFreqIntervalSeconds"};
 inline constexpr auto JSON_HOST_CONFIG{"HostConfig"};
 inline constexpr auto JSON_HOST_NAME_OR_IP{"HostNameOrIp"};
 inline constexpr auto JSON_KDF_CONFIG{"KDFConfig"};
+inline constexpr auto JSON_KERNEL_ATTR_TIMEOUT_SECS{"KernelAttrTimeoutSeconds"};
 inline constexpr auto JSON_LOW_FREQ_INTERVAL_SECS{"LowFreqIntervalSeconds"};
 inline constexpr auto JSON_MAX_CACHE_SIZE_BYTES{"MaxCacheSizeBytes"};
 inline constexpr auto JSON_MAX_CONNECTIONS{"MaxConnections"};
+inline constexpr auto JSON_MAX_DOWNLOAD_COUNT{"MaxDownloadCount"};
+inline constexpr auto JSON_MAX_UPLOAD_BYTES{"MaxUploadBytes"};
 inline constexpr auto JSON_MAX_UPLOAD_COUNT{"MaxUploadCount"};
+inline constexpr auto JSON_MAX_UPLOAD_PART_COUNT{"MaxUploadPartCount"};
 inline constexpr auto JSON_MED_FREQ_INTERVAL_SECS{"MedFreqIntervalSeconds"};
 inline constexpr auto JSON_META{"Meta"};
+inline constexpr auto JSON_META_FLUSH_INTERVAL_SECS{"MetaFlushIntervalSeconds"};
 inline constexpr auto JSON_MOUNT_AUTO_START{"MountAutoStart"};
 inline constexpr auto JSON_MOUNT_LOCATIONS{"MountLocations"};
 inline constexpr auto JSON_ONLINE_CHECK_RETRY_SECS{"OnlineCheckRetrySeconds"};
 inline constexpr auto JSON_PATH{"Path"};
 inline constexpr auto JSON_PREFERRED_DOWNLOAD_TYPE{"PreferredDownloadType"};
 inline constexpr auto JSON_PROTOCOL{"Protocol"};
+inline constexpr auto JSON_READ_AHEAD_POLICY{"ReadAheadPolicy"};
 inline constexpr auto JSON_RECV_TIMEOUT_MS{"ReceiveTimeoutMs"};
 inline constexpr auto JSON_REGION{"Region"};
 inline constexpr auto JSON_REMOTE_CONFIG{"RemoteConfig"};
@@ -452,6 +492,7 @@ inline constexpr auto JSON_SIA_CONFIG{"SiaConfig"};
 inline constexpr auto JSON_SIZE{"Size"};
 inline constexpr auto JSON_TASK_WAIT_MS{"TaskWaitMs"};
 inline constexpr auto JSON_TIMEOUT_MS{"TimeoutMs"};
+inline constexpr auto JSON_UPLOAD_PART_SIZE{"UploadPartSize"};
 inline constexpr auto JSON_URL{"URL"};
 inline constexpr auto JSON_USE_PATH_STYLE{"UsePathStyle"};
 inline constexpr auto JSON_USE_REGION_IN_URL{"UseRegionInURL"};
@@ -544,9 +585,11 @@ template <> struct adl_serializer<repertory::s3_config> {
     data[repertory::JSON_ENCRYPTION_TOKEN] = value.encryption_token;
     data[repertory::JSON_FORCE_LEGACY_ENCRYPTION] =
         value.force_legacy_encryption;
+    data[repertory::JSON_MAX_UPLOAD_PART_COUNT] = value.max_upload_part_count;
     data[repertory::JSON_REGION] = value.region;
     data[repertory::JSON_SECRET_KEY] = value.secret_key;
     data[repertory::JSON_TIMEOUT_MS] = value.timeout_ms;
+    data[repertory::JSON_UPLOAD_PART_SIZE] = value.upload_part_size;
     data[repertory::JSON_URL] = value.url;
     data[repertory::JSON_USE_PATH_STYLE] = value.use_path_style;
     data[repertory::JSON_USE_REGION_IN_URL] = value.use_region_in_url;
@@ -566,6 +609,15 @@ template <> struct adl_serializer<repertory::s3_config> {
       data.at(repertory::JSON_FORCE_LEGACY_ENCRYPTION)
           .get_to(value.force_legacy_encryption);
     }
+
+    if (data.contains(repertory::JSON_MAX_UPLOAD_PART_COUNT)) {
+      data.at(repertory::JSON_MAX_UPLOAD_PART_COUNT)
+          .get_to(value.max_upload_part_count);
+    }
+
+    if (data.contains(repertory::JSON_UPLOAD_PART_SIZE)) {
+      data.at(repertory::JSON_UPLOAD_PART_SIZE).get_to(value.upload_part_size);
+    }
   }
 };
 
@@ -649,6 +701,19 @@ template <> struct adl_serializer<std::atomic<repertory::download_type>> {
   }
 };
 
+template <> struct adl_serializer<std::atomic<repertory::read_ahead_policy>> {
+  static void to_json(json &data,
+                      const std::atomic<repertory::read_ahead_policy> &value) {
+    data = repertory::read_ahead_policy_to_string(value.load());
+  }
+
+  static void from_json(const json &data,
+                        std::atomic<repertory::read_ahead_policy> &value) {
+    value.store(
+        repertory::read_ahead_policy_from_string(data.get<std::string>()));
+  }
+};
+
 template <> struct adl_serializer<repertory::database_type> {
   static void to_json(json &data, const repertory::database_type &value) {
     data = repertory::database_type_to_string(value);
@@ -678,6 +743,16 @@ template <> struct adl_serializer<repertory::event_level> {
     value = repertory::event_level_from_string(data.get<std::string>());
   }
 };
+
+template <> struct adl_serializer<repertory::read_ahead_policy> {
+  static void to_json(json &data, const repertory::read_ahead_policy &value) {
+    data = repertory::read_ahead_policy_to_string(value);
+  }
+
+  static void from_json(const json &data, repertory::read_ahead_policy &value) {
+    value = repertory::read_ahead_policy_from_string(data.get<std::string>());
+  }
+};
 NLOHMANN_JSON_NAMESPACE_END
 
 #endif // REPERTORY_INCLUDE_TYPES_REPERTORY_HPP_
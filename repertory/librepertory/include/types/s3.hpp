@@ -23,6 +23,7 @@
 #define REPERTORY_INCLUDE_TYPES_S3_HPP_
 
 #include "types/repertory.hpp"
+#include "utils/common.hpp"
 #include "utils/string.hpp"
 #include "utils/time.hpp"
 #include "utils/utils.hpp"
@@ -71,6 +72,54 @@ struct head_object_result {
     return *this;
   }
 };
+
+// Byte ranges of an S3 multipart upload. The first part also carries
+// 'header_size' leading bytes. When 'chunk_size' is set, every part boundary
+// falls on a chunk boundary, so parts can be produced independently.
+struct multipart_layout final {
+  std::uint64_t header_size{};
+  std::uint32_t part_count{};
+  std::uint64_t part_size{};
+  std::uint64_t total_size{};
+
+  [[nodiscard]] static auto create(std::uint64_t total_size,
+                                   std::uint64_t min_part_size,
+                                   std::uint64_t header_size = 0U,
+                                   std::uint64_t chunk_size = 0U)
+      -> multipart_layout {
+    auto body_size{total_size - std::min(header_size, total_size)};
+    auto part_size{
+        std::max(min_part_size,
+                 utils::divide_with_ceiling(
+                     body_size,
+                     static_cast<std::uint64_t>(max_s3_upload_part_count))),
+    };
+    if (chunk_size != 0U) {
+      part_size = utils::divide_with_ceiling(part_size, chunk_size) *
+                  chunk_size;
+    }
+
+    return {
+        .header_size = header_size,
+        .part_count = std::max(
+            static_cast<std::uint32_t>(
+                utils::divide_with_ceiling(body_size, part_size)),
+            std::uint32_t{1U}),
+        .part_size = part_size,
+        .total_size = total_size,
+    };
+  }
+
+  [[nodiscard]] auto get_range(std::uint32_t part_number) const
+      -> http_range {
+    auto index{static_cast<std::uint64_t>(part_number - 1U)};
+    return {
+        .begin = index == 0U ? 0U : header_size + index * part_size,
+        .end = std::min(header_size + (index + 1U) * part_size, total_size) -
+               1U,
+    };
+  }
+};
 } // namespace repertory
 
 #endif // REPERTORY_INCLUDE_TYPES_S3_HPP_
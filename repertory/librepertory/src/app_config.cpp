@@ -70,8 +70,10 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
       api_port_(default_rpc_port),
       api_user_(std::string{REPERTORY}),
       cache_directory_(utils::path::combine(data_directory, {"cache"})),
+      chunk_cache_size_bytes_(default_chunk_cache_size_bytes),
       config_changed_(false),
       data_directory_(utils::path::absolute(data_directory)),
+      directory_cache_timeout_secs_(default_directory_cache_timeout_secs),
       download_timeout_secs_(default_download_timeout_secs),
       enable_download_timeout_(true),
       enable_drive_events_(false),
@@ -82,13 +84,18 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
       eviction_delay_mins_(default_eviction_delay_mins),
       eviction_uses_accessed_time_(false),
       high_freq_interval_secs_(default_high_freq_interval_secs),
+      kernel_attr_timeout_secs_(default_kernel_attr_timeout_secs),
       log_directory_(utils::path::combine(data_directory, {"logs"})),
       low_freq_interval_secs_(default_low_freq_interval_secs),
       max_cache_size_bytes_(default_max_cache_size_bytes),
+      max_download_count_(default_max_download_count),
+      max_upload_bytes_(default_max_upload_bytes),
       max_upload_count_(default_max_upload_count),
       med_freq_interval_secs_(default_med_freq_interval_secs),
+      meta_flush_interval_secs_(default_meta_flush_interval_secs),
       online_check_retry_secs_(default_online_check_retry_secs),
       preferred_download_type_(download_type::default_),
+      read_ahead_policy_(read_ahead_policy::adaptive),
       retry_read_count_(default_retry_read_count),
       ring_buffer_file_size_(default_ring_buffer_file_size),
       task_wait_ms_(default_task_wait_ms) {
@@ -124,8 +131,14 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
       {JSON_API_PASSWORD, [this]() { return get_api_password(); }},
       {JSON_API_PORT, [this]() { return std::to_string(get_api_port()); }},
       {JSON_API_USER, [this]() { return get_api_user(); }},
+      {JSON_CHUNK_CACHE_SIZE_BYTES,
+       [this]() { return std::to_string(get_chunk_cache_size_bytes()); }},
       {JSON_DATABASE_TYPE,
        [this]() { return database_type_to_string(get_database_type()); }},
+      {JSON_DIRECTORY_CACHE_TIMEOUT_SECS,
+       [this]() {
+         return std::to_string(get_directory_cache_timeout_secs());
+       }},
       {JSON_DOWNLOAD_TIMEOUT_SECS,
        [this]() { return std::to_string(get_download_timeout_secs()); }},
       {JSON_ENABLE_DOWNLOAD_TIMEOUT,
@@ -172,20 +185,32 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
        [this]() { return get_host_config().protocol; }},
       {fmt::format("{}.{}", JSON_HOST_CONFIG, JSON_TIMEOUT_MS),
        [this]() { return std::to_string(get_host_config().timeout_ms); }},
+      {JSON_KERNEL_ATTR_TIMEOUT_SECS,
+       [this]() { return std::to_string(get_kernel_attr_timeout_secs()); }},
       {JSON_LOW_FREQ_INTERVAL_SECS,
        [this]() { return std::to_string(get_low_frequency_interval_secs()); }},
       {JSON_MAX_CACHE_SIZE_BYTES,
        [this]() { return std::to_string(get_max_cache_size_bytes()); }},
+      {JSON_MAX_DOWNLOAD_COUNT,
+       [this]() { return std::to_string(get_max_download_count()); }},
+      {JSON_MAX_UPLOAD_BYTES,
+       [this]() { return std::to_string(get_max_upload_bytes()); }},
       {JSON_MAX_UPLOAD_COUNT,
        [this]() { return std::to_string(get_max_upload_count()); }},
       {JSON_MED_FREQ_INTERVAL_SECS,
        [this]() { return std::to_string(get_med_frequency_interval_secs()); }},
+      {JSON_META_FLUSH_INTERVAL_SECS,
+       [this]() { return std::to_string(get_meta_flush_interval_secs()); }},
       {JSON_ONLINE_CHECK_RETRY_SECS,
        [this]() { return std::to_string(get_online_check_retry_secs()); }},
       {JSON_PREFERRED_DOWNLOAD_TYPE,
        [this]() {
          return download_type_to_string(get_preferred_download_type());
        }},
+      {JSON_READ_AHEAD_POLICY,
+       [this]() {
+         return read_ahead_policy_to_string(get_read_ahead_policy());
+       }},
       {fmt::format("{}.{}", JSON_REMOTE_CONFIG, JSON_API_PORT),
        [this]() { return std::to_string(get_remote_config().api_port); }},
       {fmt::format("{}.{}", JSON_REMOTE_CONFIG, JSON_CONNECT_TIMEOUT_MS),
@@ -235,12 +260,18 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
          return utils::string::from_bool(
              get_s3_config().force_legacy_encryption);
        }},
+      {fmt::format("{}.{}", JSON_S3_CONFIG, JSON_MAX_UPLOAD_PART_COUNT),
+       [this]() {
+         return std::to_string(get_s3_config().max_upload_part_count);
+       }},
       {fmt::format("{}.{}", JSON_S3_CONFIG, JSON_REGION),
        [this]() { return get_s3_config().region; }},
       {fmt::format("{}.{}", JSON_S3_CONFIG, JSON_SECRET_KEY),
        [this]() { return get_s3_config().secret_key; }},
       {fmt::format("{}.{}", JSON_S3_CONFIG, JSON_TIMEOUT_MS),
        [this]() { return std::to_string(get_s3_config().timeout_ms); }},
+      {fmt::format("{}.{}", JSON_S3_CONFIG, JSON_UPLOAD_PART_SIZE),
+       [this]() { return std::to_string(get_s3_config().upload_part_size); }},
       {fmt::format("{}.{}", JSON_S3_CONFIG, JSON_URL),
        [this]() { return get_s3_config().url; }},
       {fmt::format("{}.{}", JSON_S3_CONFIG, JSON_USE_PATH_STYLE),
@@ -279,6 +310,14 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
             return get_api_user();
           },
       },
+      {
+          JSON_CHUNK_CACHE_SIZE_BYTES,
+          [this](std::string_view value) {
+            set_chunk_cache_size_bytes(
+                utils::string::to_uint64(std::string{value}));
+            return std::to_string(get_chunk_cache_size_bytes());
+          },
+      },
       {
           JSON_DATABASE_TYPE,
           [this](std::string_view value) {
@@ -286,6 +325,14 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
             return database_type_to_string(db_type_);
           },
       },
+      {
+          JSON_DIRECTORY_CACHE_TIMEOUT_SECS,
+          [this](std::string_view value) {
+            set_directory_cache_timeout_secs(
+                utils::string::to_uint16(std::string{value}));
+            return std::to_string(get_directory_cache_timeout_secs());
+          },
+      },
       {
           JSON_DOWNLOAD_TIMEOUT_SECS,
           [this](std::string_view value) {
@@ -440,6 +487,14 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
             return std::to_string(get_host_config().timeout_ms);
           },
       },
+      {
+          JSON_KERNEL_ATTR_TIMEOUT_SECS,
+          [this](std::string_view value) {
+            set_kernel_attr_timeout_secs(
+                utils::string::to_uint16(std::string{value}));
+            return std::to_string(get_kernel_attr_timeout_secs());
+          },
+      },
       {
           JSON_LOW_FREQ_INTERVAL_SECS,
           [this](std::string_view value) {
@@ -456,6 +511,14 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
             return std::to_string(get_med_frequency_interval_secs());
           },
       },
+      {
+          JSON_META_FLUSH_INTERVAL_SECS,
+          [this](std::string_view value) {
+            set_meta_flush_interval_secs(
+                utils::string::to_uint16(std::string{value}));
+            return std::to_string(get_meta_flush_interval_secs());
+          },
+      },
       {
           JSON_MAX_CACHE_SIZE_BYTES,
           [this](std::string_view value) {
@@ -464,6 +527,20 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
             return std::to_string(get_max_cache_size_bytes());
           },
       },
+      {
+          JSON_MAX_DOWNLOAD_COUNT,
+          [this](std::string_view value) {
+            set_max_download_count(utils::string::to_uint8(std::string{value}));
+            return std::to_string(get_max_download_count());
+          },
+      },
+      {
+          JSON_MAX_UPLOAD_BYTES,
+          [this](std::string_view value) {
+            set_max_upload_bytes(utils::string::to_uint64(std::string{value}));
+            return std::to_string(get_max_upload_bytes());
+          },
+      },
       {
           JSON_MAX_UPLOAD_COUNT,
           [this](std::string_view value) {
@@ -486,6 +563,13 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
             return download_type_to_string(get_preferred_download_type());
           },
       },
+      {
+          JSON_READ_AHEAD_POLICY,
+          [this](std::string_view value) {
+            set_read_ahead_policy(read_ahead_policy_from_string(value));
+            return read_ahead_policy_to_string(get_read_ahead_policy());
+          },
+      },
       {
           fmt::format("{}.{}", JSON_REMOTE_CONFIG, JSON_API_PORT),
           [this](std::string_view value) {
@@ -638,6 +722,16 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
                 get_s3_config().force_legacy_encryption);
           },
       },
+      {
+          fmt::format("{}.{}", JSON_S3_CONFIG, JSON_MAX_UPLOAD_PART_COUNT),
+          [this](std::string_view value) {
+            auto cfg = get_s3_config();
+            cfg.max_upload_part_count =
+                utils::string::to_uint16(std::string{value});
+            set_s3_config(cfg);
+            return std::to_string(get_s3_config().max_upload_part_count);
+          },
+      },
       {
           fmt::format("{}.{}", JSON_S3_CONFIG, JSON_REGION),
           [this](std::string_view value) {
@@ -665,6 +759,15 @@ app_config::app_config(provider_type prov, std::string_view data_directory)
             return std::to_string(get_s3_config().timeout_ms);
           },
       },
+      {
+          fmt::format("{}.{}", JSON_S3_CONFIG, JSON_UPLOAD_PART_SIZE),
+          [this](std::string_view value) {
+            auto cfg = get_s3_config();
+            cfg.upload_part_size = utils::string::to_uint32(std::string{value});
+            set_s3_config(cfg);
+            return std::to_string(get_s3_config().upload_part_size);
+          },
+      },
       {
           fmt::format("{}.{}", JSON_S3_CONFIG, JSON_URL),
           [this](std::string_view value) {
@@ -790,6 +893,10 @@ auto app_config::get_cache_directory() const -> std::string {
   return cache_directory_;
 }
 
+auto app_config::get_chunk_cache_size_bytes() const -> std::uint64_t {
+  return chunk_cache_size_bytes_;
+}
+
 auto app_config::get_config_file_path() const -> std::string {
   return utils::path::combine(data_directory_, {"config.json"});
 }
@@ -800,6 +907,10 @@ auto app_config::get_data_directory() const -> std::string {
   return data_directory_;
 }
 
+auto app_config::get_directory_cache_timeout_secs() const -> std::uint16_t {
+  return directory_cache_timeout_secs_;
+}
+
 auto app_config::get_download_timeout_secs() const -> std::uint8_t {
   return std::max(min_download_timeout_secs, download_timeout_secs_.load());
 }
@@ -844,8 +955,10 @@ auto app_config::get_json() const -> json {
       {JSON_API_PASSWORD, api_password_},
       {JSON_API_PORT, api_port_},
       {JSON_API_USER, api_user_},
+      {JSON_CHUNK_CACHE_SIZE_BYTES, chunk_cache_size_bytes_},
       {JSON_DOWNLOAD_TIMEOUT_SECS, download_timeout_secs_},
       {JSON_DATABASE_TYPE, db_type_},
+      {JSON_DIRECTORY_CACHE_TIMEOUT_SECS, directory_cache_timeout_secs_},
       {JSON_ENABLE_DOWNLOAD_TIMEOUT, enable_download_timeout_},
       {JSON_ENABLE_DRIVE_EVENTS, enable_drive_events_},
 #if defined(_WIN32)
@@ -857,12 +970,17 @@ auto app_config::get_json() const -> json {
       {JSON_EVICTION_USE_ACCESS_TIME, eviction_uses_accessed_time_},
       {JSON_HIGH_FREQ_INTERVAL_SECS, high_freq_interval_secs_},
       {JSON_HOST_CONFIG, host_config_},
+      {JSON_KERNEL_ATTR_TIMEOUT_SECS, kernel_attr_timeout_secs_},
       {JSON_LOW_FREQ_INTERVAL_SECS, low_freq_interval_secs_},
       {JSON_MAX_CACHE_SIZE_BYTES, max_cache_size_bytes_},
+      {JSON_MAX_DOWNLOAD_COUNT, max_download_count_},
+      {JSON_MAX_UPLOAD_BYTES, max_upload_bytes_},
       {JSON_MAX_UPLOAD_COUNT, max_upload_count_},
       {JSON_MED_FREQ_INTERVAL_SECS, med_freq_interval_secs_},
+      {JSON_META_FLUSH_INTERVAL_SECS, meta_flush_interval_secs_},
       {JSON_ONLINE_CHECK_RETRY_SECS, online_check_retry_secs_},
       {JSON_PREFERRED_DOWNLOAD_TYPE, preferred_download_type_},
+      {JSON_READ_AHEAD_POLICY, read_ahead_policy_},
       {JSON_REMOTE_CONFIG, remote_config_},
       {JSON_REMOTE_MOUNT, remote_mount_},
       {JSON_RETRY_READ_COUNT, retry_read_count_},
@@ -875,15 +993,19 @@ auto app_config::get_json() const -> json {
 
   switch (prov_) {
   case provider_type::encrypt: {
+    ret.erase(JSON_DIRECTORY_CACHE_TIMEOUT_SECS);
     ret.erase(JSON_DOWNLOAD_TIMEOUT_SECS);
     ret.erase(JSON_ENABLE_DOWNLOAD_TIMEOUT);
     ret.erase(JSON_EVICTION_DELAY_MINS);
     ret.erase(JSON_EVICTION_USE_ACCESS_TIME);
     ret.erase(JSON_HOST_CONFIG);
     ret.erase(JSON_MAX_CACHE_SIZE_BYTES);
+    ret.erase(JSON_MAX_DOWNLOAD_COUNT);
+    ret.erase(JSON_MAX_UPLOAD_BYTES);
     ret.erase(JSON_MAX_UPLOAD_COUNT);
     ret.erase(JSON_ONLINE_CHECK_RETRY_SECS);
     ret.erase(JSON_PREFERRED_DOWNLOAD_TYPE);
+    ret.erase(JSON_READ_AHEAD_POLICY);
     ret.erase(JSON_REMOTE_CONFIG);
     ret.erase(JSON_RETRY_READ_COUNT);
     ret.erase(JSON_RING_BUFFER_FILE_SIZE);
@@ -891,7 +1013,9 @@ auto app_config::get_json() const -> json {
     ret.erase(JSON_SIA_CONFIG);
   } break;
   case provider_type::remote: {
+    ret.erase(JSON_CHUNK_CACHE_SIZE_BYTES);
     ret.erase(JSON_DATABASE_TYPE);
+    ret.erase(JSON_DIRECTORY_CACHE_TIMEOUT_SECS);
     ret.erase(JSON_DOWNLOAD_TIMEOUT_SECS);
     ret.erase(JSON_ENABLE_DOWNLOAD_TIMEOUT);
     ret.erase(JSON_ENCRYPT_CONFIG);
@@ -901,10 +1025,14 @@ auto app_config::get_json() const -> json {
     ret.erase(JSON_HOST_CONFIG);
     ret.erase(JSON_LOW_FREQ_INTERVAL_SECS);
     ret.erase(JSON_MAX_CACHE_SIZE_BYTES);
+    ret.erase(JSON_MAX_DOWNLOAD_COUNT);
+    ret.erase(JSON_MAX_UPLOAD_BYTES);
     ret.erase(JSON_MAX_UPLOAD_COUNT);
     ret.erase(JSON_MED_FREQ_INTERVAL_SECS);
+    ret.erase(JSON_META_FLUSH_INTERVAL_SECS);
     ret.erase(JSON_ONLINE_CHECK_RETRY_SECS);
     ret.erase(JSON_PREFERRED_DOWNLOAD_TYPE);
+    ret.erase(JSON_READ_AHEAD_POLICY);
     ret.erase(JSON_REMOTE_MOUNT);
     ret.erase(JSON_RETRY_READ_COUNT);
     ret.erase(JSON_RING_BUFFER_FILE_SIZE);
@@ -934,6 +1062,10 @@ auto app_config::get_log_directory() const -> std::string {
   return log_directory_;
 }
 
+auto app_config::get_kernel_attr_timeout_secs() const -> std::uint16_t {
+  return kernel_attr_timeout_secs_;
+}
+
 auto app_config::get_low_frequency_interval_secs() const -> std::uint16_t {
   return std::max(static_cast<std::uint16_t>(1U),
                   low_freq_interval_secs_.load());
@@ -946,6 +1078,14 @@ auto app_config::get_max_cache_size_bytes() const -> std::uint64_t {
                                 : max_space;
 }
 
+auto app_config::get_max_download_count() const -> std::uint8_t {
+  return std::max(std::uint8_t(1U), max_download_count_.load());
+}
+
+auto app_config::get_max_upload_bytes() const -> std::uint64_t {
+  return max_upload_bytes_;
+}
+
 auto app_config::get_max_upload_count() const -> std::uint8_t {
   return std::max(std::uint8_t(1U), max_upload_count_.load());
 }
@@ -955,6 +1095,10 @@ auto app_config::get_med_frequency_interval_secs() const -> std::uint16_t {
                   med_freq_interval_secs_.load());
 }
 
+auto app_config::get_meta_flush_interval_secs() const -> std::uint16_t {
+  return meta_flush_interval_secs_;
+}
+
 auto app_config::get_online_check_retry_secs() const -> std::uint16_t {
   return std::max(min_online_check_retry_secs, online_check_retry_secs_.load());
 }
@@ -983,6 +1127,10 @@ auto app_config::get_provider_name(provider_type prov) -> std::string {
 
 auto app_config::get_provider_type() const -> provider_type { return prov_; }
 
+auto app_config::get_read_ahead_policy() const -> read_ahead_policy {
+  return read_ahead_policy_;
+}
+
 auto app_config::get_remote_config() const -> remote::remote_config {
   return remote_config_;
 }
@@ -1057,7 +1205,11 @@ auto app_config::load() -> bool {
     get_value(json_document, JSON_API_PASSWORD, api_password_, found);
     get_value(json_document, JSON_API_PORT, api_port_, found);
     get_value(json_document, JSON_API_USER, api_user_, found);
+    get_value(json_document, JSON_CHUNK_CACHE_SIZE_BYTES,
+              chunk_cache_size_bytes_, found);
     get_value(json_document, JSON_DATABASE_TYPE, db_type_, found);
+    get_value(json_document, JSON_DIRECTORY_CACHE_TIMEOUT_SECS,
+              directory_cache_timeout_secs_, found);
     get_value(json_document, JSON_DOWNLOAD_TIMEOUT_SECS, download_timeout_secs_,
               found);
     get_value(json_document, JSON_ENABLE_DOWNLOAD_TIMEOUT,
@@ -1077,17 +1229,26 @@ auto app_config::load() -> bool {
     get_value(json_document, JSON_HIGH_FREQ_INTERVAL_SECS,
               high_freq_interval_secs_, found);
     get_value(json_document, JSON_HOST_CONFIG, host_config_, found);
+    get_value(json_document, JSON_KERNEL_ATTR_TIMEOUT_SECS,
+              kernel_attr_timeout_secs_, found);
     get_value(json_document, JSON_LOW_FREQ_INTERVAL_SECS,
               low_freq_interval_secs_, found);
     get_value(json_document, JSON_MAX_CACHE_SIZE_BYTES, max_cache_size_bytes_,
               found);
+    get_value(json_document, JSON_MAX_DOWNLOAD_COUNT, max_download_count_,
+              found);
+    get_value(json_document, JSON_MAX_UPLOAD_BYTES, max_upload_bytes_, found);
     get_value(json_document, JSON_MAX_UPLOAD_COUNT, max_upload_count_, found);
     get_value(json_document, JSON_MED_FREQ_INTERVAL_SECS,
               med_freq_interval_secs_, found);
+    get_value(json_document, JSON_META_FLUSH_INTERVAL_SECS,
+              meta_flush_interval_secs_, found);
     get_value(json_document, JSON_ONLINE_CHECK_RETRY_SECS,
               online_check_retry_secs_, found);
     get_value(json_document, JSON_PREFERRED_DOWNLOAD_TYPE,
               preferred_download_type_, found);
+    get_value(json_document, JSON_READ_AHEAD_POLICY, read_ahead_policy_,
+              found);
     get_value(json_document, JSON_REMOTE_CONFIG, remote_config_, found);
     get_value(json_document, JSON_REMOTE_MOUNT, remote_mount_, found);
     get_value(json_document, JSON_RETRY_READ_COUNT, retry_read_count_, found);
@@ -1178,6 +1339,10 @@ void app_config::set_api_user(std::string_view value) {
   set_value(api_user_, value);
 }
 
+void app_config::set_chunk_cache_size_bytes(std::uint64_t value) {
+  set_value(chunk_cache_size_bytes_, value);
+}
+
 void app_config::set_download_timeout_secs(std::uint8_t value) {
   set_value(download_timeout_secs_, value);
 }
@@ -1186,6 +1351,10 @@ void app_config::set_database_type(const database_type &value) {
   set_value(db_type_, value);
 }
 
+void app_config::set_directory_cache_timeout_secs(std::uint16_t value) {
+  set_value(directory_cache_timeout_secs_, value);
+}
+
 void app_config::set_enable_download_timeout(bool value) {
   set_value(enable_download_timeout_, value);
 }
@@ -1228,6 +1397,10 @@ void app_config::set_host_config(host_config value) {
   set_value(host_config_, value);
 }
 
+void app_config::set_kernel_attr_timeout_secs(std::uint16_t value) {
+  set_value(kernel_attr_timeout_secs_, value);
+}
+
 void app_config::set_low_frequency_interval_secs(std::uint16_t value) {
   set_value(low_freq_interval_secs_, value);
 }
@@ -1242,6 +1415,14 @@ void app_config::set_max_cache_size_bytes(std::uint64_t value) {
   }
 }
 
+void app_config::set_max_download_count(std::uint8_t value) {
+  set_value(max_download_count_, value);
+}
+
+void app_config::set_max_upload_bytes(std::uint64_t value) {
+  set_value(max_upload_bytes_, value);
+}
+
 void app_config::set_max_upload_count(std::uint8_t value) {
   set_value(max_upload_count_, value);
 }
@@ -1250,6 +1431,10 @@ void app_config::set_med_frequency_interval_secs(std::uint16_t value) {
   set_value(med_freq_interval_secs_, value);
 }
 
+void app_config::set_meta_flush_interval_secs(std::uint16_t value) {
+  set_value(meta_flush_interval_secs_, value);
+}
+
 void app_config::set_online_check_retry_secs(std::uint16_t value) {
   set_value(online_check_retry_secs_, value);
 }
@@ -1258,6 +1443,10 @@ void app_config::set_preferred_download_type(const download_type &value) {
   set_value(preferred_download_type_, value);
 }
 
+void app_config::set_read_ahead_policy(const read_ahead_policy &value) {
+  set_value(read_ahead_policy_, value);
+}
+
 void app_config::set_remote_config(remote::remote_config value) {
   set_value(remote_config_, value);
 }
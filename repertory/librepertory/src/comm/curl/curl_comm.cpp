@@ -129,6 +129,12 @@ auto curl_comm::create_host_config(const s3_config &cfg) -> host_config {
   return host_cfg;
 }
 
+auto curl_comm::get_pool_key(const host_config &cfg) -> std::string {
+  return fmt::format("{}://{}:{}", cfg.protocol,
+                     utils::string::trim_copy(cfg.host_name_or_ip),
+                     cfg.api_port);
+}
+
 auto curl_comm::make_request(const curl::requests::http_delete &del,
                              long &response_code,
                              stop_type &stop_requested) const -> bool {
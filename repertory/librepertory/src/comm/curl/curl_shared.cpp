@@ -25,13 +25,47 @@
 namespace repertory {
 curl_shared::curl_sh_t curl_shared::cache_;
 
-std::recursive_mutex curl_shared::mtx_;
+std::array<std::mutex, CURL_LOCK_DATA_LAST> curl_shared::mtx_list_;
+
+std::unordered_map<std::string, std::deque<CURL *>> curl_shared::pool_;
+
+std::atomic<std::uint64_t> curl_shared::pool_hits_{0U};
+
+std::atomic<std::uint64_t> curl_shared::pool_misses_{0U};
+
+std::mutex curl_shared::pool_mtx_;
+
+auto curl_shared::acquire(std::string_view key) -> CURL * {
+  mutex_lock lock(pool_mtx_);
+  auto iter = pool_.find(std::string{key});
+  if (iter == pool_.end() || iter->second.empty()) {
+    ++pool_misses_;
+    return curl_easy_init();
+  }
+
+  auto *curl = iter->second.back();
+  iter->second.pop_back();
+  ++pool_hits_;
+  return curl;
+}
 
 void curl_shared::cleanup() {
+  mutex_lock lock(pool_mtx_);
+  for (auto &[key, handles] : pool_) {
+    for (auto *curl : handles) {
+      curl_easy_cleanup(curl);
+    }
+  }
+  pool_.clear();
+
   cache_.reset(nullptr);
   curl_global_cleanup();
 }
 
+auto curl_shared::get_pool_hits() -> std::uint64_t { return pool_hits_; }
+
+auto curl_shared::get_pool_misses() -> std::uint64_t { return pool_misses_; }
+
 auto curl_shared::init() -> bool {
   REPERTORY_USES_FUNCTION_NAME();
 
@@ -50,7 +84,9 @@ auto curl_shared::init() -> bool {
   }
   cache_.reset(cache);
 
+  curl_share_setopt(cache, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
   curl_share_setopt(cache, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  curl_share_setopt(cache, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
   curl_share_setopt(cache, CURLSHOPT_LOCKFUNC, lock_callback);
   curl_share_setopt(cache, CURLSHOPT_UNLOCKFUNC, unlock_callback);
   return true;
@@ -59,11 +95,22 @@ auto curl_shared::init() -> bool {
 void curl_shared::lock_callback(CURL * /* curl */, curl_lock_data data,
                                 curl_lock_access /* access */,
                                 void * /* ptr */) {
-  if (data != CURL_LOCK_DATA_DNS) {
+  mtx_list_.at(static_cast<std::size_t>(data)).lock();
+}
+
+void curl_shared::release(std::string_view key, CURL *curl) {
+  if (curl == nullptr) {
+    return;
+  }
+
+  mutex_lock lock(pool_mtx_);
+  auto &handles = pool_[std::string{key}];
+  if (not cache_ || handles.size() >= max_pool_size) {
+    curl_easy_cleanup(curl);
     return;
   }
 
-  mtx_.lock();
+  handles.push_back(curl);
 }
 
 void curl_shared::set_share(CURL *curl) {
@@ -73,10 +120,6 @@ void curl_shared::set_share(CURL *curl) {
 void curl_shared::unlock_callback(CURL * /* curl */, curl_lock_data data,
                                   curl_lock_access /* access */,
                                   void * /* ptr */) {
-  if (data != CURL_LOCK_DATA_DNS) {
-    return;
-  }
-
-  mtx_.unlock();
+  mtx_list_.at(static_cast<std::size_t>(data)).unlock();
 }
 } // namespace repertory
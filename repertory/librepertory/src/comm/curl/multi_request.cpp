@@ -34,7 +34,6 @@ multi_request::multi_request(CURL *curl_handle, stop_type &stop_requested)
 
 multi_request::~multi_request() {
   curl_multi_remove_handle(multi_handle_, curl_handle_);
-  curl_easy_cleanup(curl_handle_);
   curl_multi_cleanup(multi_handle_);
 }
 
@@ -31,6 +31,10 @@ auto http_post::set_method(CURL *curl, stop_type & /*stop_requested*/) const
     json_str = json->dump();
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_str->c_str());
     curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, -1L);
+  } else if (body.has_value()) {
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body->c_str());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE,
+                     static_cast<curl_off_t>(body->size()));
   }
 
   return true;
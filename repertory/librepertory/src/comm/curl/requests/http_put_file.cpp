@@ -36,6 +36,19 @@ auto http_put_file::set_method(CURL *curl, stop_type &stop_requested) const
     return true;
   }
 
+  if (reader && source_range.has_value()) {
+    reader->set_read_position(source_range->begin);
+    range_info = std::make_shared<read_range_info>(read_range_info{
+        reader.get(),
+        source_range->end - source_range->begin + 1U,
+    });
+
+    curl_easy_setopt(curl, CURLOPT_READDATA, range_info.get());
+    curl_easy_setopt(curl, CURLOPT_READFUNCTION, range_reader);
+    curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, range_info->remain);
+    return true;
+  }
+
   if (reader) {
     curl_easy_setopt(curl, CURLOPT_READDATA, reader.get());
     curl_easy_setopt(
@@ -66,6 +79,12 @@ auto http_put_file::set_method(CURL *curl, stop_type &stop_requested) const
   }
 
   auto file_size = opt_size.value();
+  if (source_range.has_value()) {
+    read_info->offset = source_range->begin;
+    read_info->end_offset = source_range->end;
+    file_size = source_range->end - source_range->begin + 1U;
+  }
+
   if (file_size == 0U) {
     curl_easy_setopt(curl, CURLOPT_INFILESIZE, 0L);
     return true;
@@ -77,4 +96,23 @@ auto http_put_file::set_method(CURL *curl, stop_type &stop_requested) const
 
   return true;
 }
+
+auto http_put_file::range_reader(char *buffer, size_t size, size_t nitems,
+                                 void *instream) -> size_t {
+  auto *info = reinterpret_cast<read_range_info *>(instream);
+
+  auto to_read = static_cast<std::size_t>(
+      std::min(static_cast<std::uint64_t>(size * nitems), info->remain));
+  if (to_read == 0U) {
+    return 0U;
+  }
+
+  auto ret = utils::encryption::encrypting_reader::reader_function(
+      buffer, 1U, to_read, info->reader);
+  if (ret <= to_read) {
+    info->remain -= ret;
+  }
+
+  return ret;
+}
 } // namespace repertory::curl::requests
@@ -29,10 +29,21 @@ auto curl_file_reader(char *buffer, size_t size, size_t nitems, void *instream)
     -> size_t {
   auto *read_info = reinterpret_cast<read_file_info *>(instream);
 
+  auto to_read = size * nitems;
+  if (read_info->end_offset.has_value()) {
+    if (read_info->offset > read_info->end_offset.value()) {
+      return 0U;
+    }
+
+    to_read = static_cast<std::size_t>(std::min(
+        static_cast<std::uint64_t>(to_read),
+        read_info->end_offset.value() - read_info->offset + 1U));
+  }
+
   std::size_t bytes_read{};
   auto ret =
-      read_info->file->read(reinterpret_cast<unsigned char *>(buffer),
-                            size * nitems, read_info->offset, &bytes_read);
+      read_info->file->read(reinterpret_cast<unsigned char *>(buffer), to_read,
+                            read_info->offset, &bytes_read);
   if (ret) {
     read_info->offset += bytes_read;
   }
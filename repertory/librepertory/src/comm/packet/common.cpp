@@ -66,6 +66,13 @@ auto is_socket_still_alive(boost::asio::ip::tcp::socket &sock) -> bool {
   return not err;
 }
 
+auto create_session_key(const utils::hash::hash_256_t &token_key,
+                        std::string_view nonce) -> utils::hash::hash_256_t {
+  data_buffer buffer(token_key.begin(), token_key.end());
+  buffer.insert(buffer.end(), nonce.begin(), nonce.end());
+  return utils::hash::create_hash_blake2b_256(buffer);
+}
+
 void apply_common_socket_properties(boost::asio::ip::tcp::socket &sock) {
   sock.set_option(boost::asio::ip::tcp::no_delay(true));
   sock.set_option(boost::asio::socket_base::linger(false, 0));
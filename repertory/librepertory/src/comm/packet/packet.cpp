@@ -218,6 +218,25 @@ auto packet::decode(remote::file_info &val) -> packet::error_type {
   return ret;
 }
 
+auto packet::decode(remote::directory_entry &val) -> packet::error_type {
+  auto ret = decode(val.item_path);
+  if (ret == 0) {
+    ret = decode(val.res);
+  }
+
+  // Attributes are only sent for entries that could be stat'd
+  if (ret == 0 && val.res == 0) {
+    ret = decode(val.r_stat);
+    if (ret == 0) {
+      std::uint8_t directory{};
+      ret = decode(directory);
+      val.directory = (directory != 0U);
+    }
+  }
+
+  return ret;
+}
+
 auto packet::decode_json(packet &response, json &json_data) -> int {
   REPERTORY_USES_FUNCTION_NAME();
 
@@ -237,17 +256,19 @@ auto packet::decode_json(packet &response, json &json_data) -> int {
 }
 
 auto packet::decrypt(std::string_view token) -> packet::error_type {
+  return decrypt(
+      utils::encryption::generate_key<utils::hash::hash_256_t>(token));
+}
+
+auto packet::decrypt(const utils::hash::hash_256_t &key) -> packet::error_type {
   REPERTORY_USES_FUNCTION_NAME();
 
   auto ret = utils::from_api_error(api_error::success);
   try {
-    data_buffer result;
-    if (not utils::encryption::decrypt_data(token, &buffer_[decode_offset_],
-                                            buffer_.size() - decode_offset_,
-                                            result)) {
+    if (not utils::encryption::decrypt_data_in_place(key, buffer_,
+                                                     decode_offset_)) {
       throw std::runtime_error("decryption failed");
     }
-    buffer_ = std::move(result);
     decode_offset_ = 0;
   } catch (const std::exception &e) {
     utils::error::raise_error(function_name, e, "exception occurred");
@@ -389,6 +410,15 @@ void packet::encode(remote::file_info val) {
   encode(&val, sizeof(val), true);
 }
 
+void packet::encode(const remote::directory_entry &val) {
+  encode(val.item_path);
+  encode(val.res);
+  if (val.res == 0) {
+    encode(val.r_stat);
+    encode(static_cast<std::uint8_t>(val.directory));
+  }
+}
+
 void packet::encode_top(const void *buffer, std::size_t size,
                         bool should_reserve) {
   if (size != 0U) {
@@ -519,12 +549,15 @@ void packet::encode_top(remote::file_info val) {
 }
 
 void packet::encrypt(std::string_view token, bool include_size) {
+  encrypt(utils::encryption::generate_key<utils::hash::hash_256_t>(token),
+          include_size);
+}
+
+void packet::encrypt(const utils::hash::hash_256_t &key, bool include_size) {
   REPERTORY_USES_FUNCTION_NAME();
 
   try {
-    data_buffer result;
-    utils::encryption::encrypt_data(token, buffer_, result);
-    buffer_ = std::move(result);
+    utils::encryption::encrypt_data_in_place(key, buffer_);
     if (include_size) {
       encode_top(static_cast<std::uint32_t>(buffer_.size()));
     }
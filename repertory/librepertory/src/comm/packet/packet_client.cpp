@@ -38,7 +38,10 @@ using namespace repertory::comm;
 
 namespace repertory {
 packet_client::packet_client(remote::remote_config cfg)
-    : cfg_(std::move(cfg)), unique_id_(utils::create_uuid_string()) {
+    : cfg_(std::move(cfg)),
+      encryption_key_(utils::encryption::generate_key<utils::hash::hash_256_t>(
+          cfg_.encryption_token)),
+      unique_id_(utils::create_uuid_string()) {
   for (std::uint8_t idx = 0U; idx < cfg.max_connections; ++idx) {
     service_threads_.emplace_back([this]() { io_context_.run(); });
   }
@@ -67,6 +70,20 @@ packet_client::~packet_client() {
   }
 }
 
+packet_client::client::~client() {
+  if (not reader) {
+    return;
+  }
+
+  alive = false;
+  packet_client::close(*this);
+  if (reader->get_id() == std::this_thread::get_id()) {
+    reader->detach();
+  } else if (reader->joinable()) {
+    reader->join();
+  }
+}
+
 void packet_client::close(client &cli) noexcept {
   boost::system::error_code err;
   [[maybe_unused]] auto res = cli.socket.cancel(err);
@@ -86,6 +103,8 @@ void packet_client::close_all() {
   }
   clients_.clear();
 
+  multiplex_supported_ = true;
+  multiplexed_ = false;
   resolve_results_.store({});
   unique_id_ = utils::create_uuid_string();
 }
@@ -164,10 +183,21 @@ auto packet_client::connect(client &cli) -> bool {
     }
 
     packet response;
-    auto res = read_packet(cli, response);
+    auto res = read_packet(cli, response, true);
+    if (res == 0) {
+      res = response.decode(cli.nonce);
+    }
     if (res != 0) {
       throw std::runtime_error(fmt::format("read packet failed|err|{}", res));
     }
+
+    cli.multiplexed = negotiate_protocol(cli);
+    if (cli.multiplexed) {
+      cli.reader = std::make_unique<std::thread>(
+          [this, &cli]() { read_responses(cli); });
+    }
+    multiplexed_ = cli.multiplexed;
+
     return true;
   } catch (...) {
     close(cli);
@@ -185,15 +215,40 @@ auto packet_client::get_client() -> std::shared_ptr<packet_client::client> {
 
   try {
     unique_mutex_lock clients_lock(clients_mutex_);
-    if (clients_.empty()) {
+    std::erase_if(clients_, [](auto &&cli) -> bool {
+      return cli->multiplexed && not cli->alive;
+    });
+
+    if (multiplexed_) {
+      // Multiplexed connections are shared. Another one is only opened while
+      // every existing connection has requests in flight.
+      auto iter = std::ranges::min_element(
+          clients_, [](auto &&cli1, auto &&cli2) -> bool {
+            return cli1->in_flight < cli2->in_flight;
+          });
+      if (iter != clients_.end() && (*iter)->multiplexed &&
+          ((*iter)->in_flight == 0U ||
+           clients_.size() >= cfg_.max_connections)) {
+        return *iter;
+      }
+    }
+
+    if (multiplexed_ || clients_.empty()) {
       clients_lock.unlock();
 
       auto cli = std::make_shared<client>(io_context_);
-      if (connect(*cli)) {
-        return cli;
+      if (not connect(*cli)) {
+        return nullptr;
       }
 
-      return nullptr;
+      if (cli->multiplexed) {
+        clients_lock.lock();
+        if (clients_.size() < cfg_.max_connections) {
+          clients_.emplace_back(cli);
+        }
+      }
+
+      return cli;
     }
 
     auto cli = clients_.at(0U);
@@ -217,6 +272,7 @@ auto packet_client::handshake(client &cli, std::uint32_t &min_version) const
   REPERTORY_USES_FUNCTION_NAME();
 
   try {
+    cli.key = encryption_key_;
     min_version = 0U;
 
     data_buffer buffer;
@@ -228,7 +284,7 @@ auto packet_client::handshake(client &cli, std::uint32_t &min_version) const
       tmp.to_buffer(buffer);
     }
 
-    read_data(cli, buffer);
+    read_data(cli, buffer, true);
     packet response(buffer);
 
     auto res = response.decode(min_version);
@@ -246,7 +302,7 @@ auto packet_client::handshake(client &cli, std::uint32_t &min_version) const
       throw std::runtime_error("failed to decode server version");
     }
 
-    response.encrypt(cfg_.encryption_token, false);
+    response.encrypt(cli.key, false);
     write_data(cli, response);
 
     return true;
@@ -257,8 +313,60 @@ auto packet_client::handshake(client &cli, std::uint32_t &min_version) const
   return false;
 }
 
+auto packet_client::negotiate_protocol(client &cli) -> bool {
+  if (not multiplex_supported_) {
+    return false;
+  }
+
+  packet request;
+  request.encode(packet_protocol_latest);
+  request.encode_top(std::string{packet_protocol_method});
+  request.encode_top(utils::get_thread_id());
+  request.encode_top(unique_id_.load());
+  request.encode_top(PACKET_SERVICE_FLAGS);
+  request.encode_top(std::string{project_get_version()});
+  request.encode_top(cli.nonce);
+  request.encrypt(cli.key, true);
+  write_data(cli, request);
+
+  packet response;
+  auto res = read_packet(cli, response, true);
+  if (res == 0) {
+    res = response.decode(cli.nonce);
+  }
+
+  std::uint32_t service_flags{};
+  if (res == 0) {
+    res = response.decode(service_flags);
+  }
+
+  packet::error_type result{};
+  if (res == 0) {
+    res = response.decode(result);
+  }
+
+  if (res != 0) {
+    throw std::runtime_error(
+        fmt::format("protocol negotiation failed|err|{}", res));
+  }
+
+  std::uint32_t protocol{};
+  if (result != 0 || response.decode(protocol) != 0 ||
+      protocol < packet_protocol_multiplexed) {
+    multiplex_supported_ = false;
+    protocol_ = packet_protocol_single;
+    return false;
+  }
+
+  protocol_ = std::min(protocol, packet_protocol_latest);
+
+  // The nonce stays fixed from here on, so it can be bound into the key
+  cli.key = create_session_key(encryption_key_, cli.nonce);
+  return true;
+}
+
 void packet_client::put_client(std::shared_ptr<client> &cli) {
-  if (not cli || not is_socket_still_alive(cli->socket)) {
+  if (not cli || cli->multiplexed || not is_socket_still_alive(cli->socket)) {
     return;
   }
 
@@ -268,16 +376,20 @@ void packet_client::put_client(std::shared_ptr<client> &cli) {
   }
 }
 
-void packet_client::read_data(client &cli, data_buffer &buffer) const {
+void packet_client::read_data(client &cli, data_buffer &buffer,
+                              bool timed) const {
   REPERTORY_USES_FUNCTION_NAME();
 
-  utils::timeout timeout(
-      [&cli]() {
-        event_system::instance().raise<packet_client_timeout>("response",
-                                                              function_name);
-        packet_client::close(cli);
-      },
-      std::chrono::milliseconds(cfg_.recv_timeout_ms));
+  std::optional<utils::timeout> timeout;
+  if (timed) {
+    timeout.emplace(
+        [&cli]() {
+          event_system::instance().raise<packet_client_timeout>("response",
+                                                                function_name);
+          packet_client::close(cli);
+        },
+        std::chrono::milliseconds(cfg_.recv_timeout_ms));
+  }
 
   std::uint32_t offset{};
   while (offset < buffer.size()) {
@@ -288,14 +400,16 @@ void packet_client::read_data(client &cli, data_buffer &buffer) const {
       throw std::runtime_error("read failed|" + std::to_string(bytes_read));
     }
     offset += static_cast<std::uint32_t>(bytes_read);
-    timeout.reset();
+    if (timeout.has_value()) {
+      timeout->reset();
+    }
   }
 }
 
-auto packet_client::read_packet(client &cli, packet &response) const
-    -> packet::error_type {
+auto packet_client::read_packet(client &cli, packet &response,
+                                bool timed) const -> packet::error_type {
   data_buffer buffer(sizeof(std::uint32_t));
-  read_data(cli, buffer);
+  read_data(cli, buffer, timed);
 
   std::uint32_t size{};
   std::memcpy(&size, buffer.data(), buffer.size());
@@ -310,16 +424,75 @@ auto packet_client::read_packet(client &cli, packet &response) const
   }
 
   buffer.resize(size);
-  read_data(cli, buffer);
+  read_data(cli, buffer, timed);
 
   response = std::move(buffer);
+  return response.decrypt(cli.key);
+}
 
-  auto ret = response.decrypt(cfg_.encryption_token);
-  if (ret == 0) {
-    ret = response.decode(cli.nonce);
+void packet_client::read_responses(client &cli) const {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  try {
+    while (cli.alive) {
+      packet response;
+      auto res = read_packet(cli, response, false);
+
+      std::string nonce;
+      if (res == 0) {
+        res = response.decode(nonce);
+      }
+
+      std::uint64_t request_id{};
+      if (res == 0) {
+        res = response.decode(request_id);
+      }
+
+      if (res != 0) {
+        throw std::runtime_error(fmt::format("read packet failed|err|{}", res));
+      }
+
+      if (nonce != cli.nonce) {
+        throw std::runtime_error("nonce mismatch");
+      }
+
+      std::shared_ptr<pending_request> pending;
+      {
+        mutex_lock pending_lock(cli.pending_mtx);
+        auto iter = cli.pending.find(request_id);
+        if (iter == cli.pending.end()) {
+          continue;
+        }
+
+        pending = iter->second;
+        cli.pending.erase(iter);
+      }
+
+      mutex_lock request_lock(pending->mtx);
+      pending->response = std::move(response);
+      pending->success = true;
+      pending->complete = true;
+      pending->notify.notify_all();
+    }
+  } catch (const std::exception &e) {
+    if (cli.alive) {
+      utils::error::raise_error(function_name, e, "read responses failed");
+    }
   }
 
-  return ret;
+  std::unordered_map<std::uint64_t, std::shared_ptr<pending_request>> pending;
+  {
+    mutex_lock pending_lock(cli.pending_mtx);
+    cli.alive = false;
+    std::swap(pending, cli.pending);
+  }
+  close(cli);
+
+  for (auto &item : pending) {
+    mutex_lock request_lock(item.second->mtx);
+    item.second->complete = true;
+    item.second->notify.notify_all();
+  }
 }
 
 void packet_client::resolve() {
@@ -377,14 +550,23 @@ auto packet_client::send(std::string_view method, packet &request,
     }
 
     try {
-      auto current_request = base_request;
-      current_request.encode_top(current_client->nonce);
-      request = current_request;
-
-      current_request.encrypt(cfg_.encryption_token, true);
-      write_data(*current_client, current_request);
+      if (current_client->multiplexed) {
+        ret = send_multiplexed(*current_client, base_request, request,
+                               response);
+      } else {
+        auto current_request = base_request;
+        current_request.encode_top(current_client->nonce);
+        request = current_request;
+
+        current_request.encrypt(current_client->key, true);
+        write_data(*current_client, current_request);
+
+        ret = read_packet(*current_client, response, true);
+        if (ret == 0) {
+          ret = response.decode(current_client->nonce);
+        }
+      }
 
-      ret = read_packet(*current_client, response);
       if (ret == 0) {
         ret = response.decode(service_flags);
         if (ret == 0) {
@@ -412,6 +594,65 @@ auto packet_client::send(std::string_view method, packet &request,
   return CONVERT_STATUS_NOT_IMPLEMENTED(ret);
 }
 
+auto packet_client::send_multiplexed(client &cli, const packet &base_request,
+                                     packet &request, packet &response) const
+    -> packet::error_type {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  auto pending = std::make_shared<pending_request>();
+
+  ++cli.in_flight;
+  try {
+    {
+      // Request IDs must reach the server in ascending order
+      mutex_lock write_lock(cli.write_mtx);
+
+      std::uint64_t request_id{};
+      {
+        mutex_lock pending_lock(cli.pending_mtx);
+        if (not cli.alive) {
+          throw std::runtime_error("connection closed");
+        }
+
+        request_id = ++cli.next_request_id;
+        cli.pending[request_id] = pending;
+      }
+
+      auto current_request = base_request;
+      current_request.encode_top(request_id);
+      current_request.encode_top(cli.nonce);
+      request = current_request;
+
+      current_request.encrypt(cli.key, true);
+      write_data(cli, current_request);
+    }
+
+    unique_mutex_lock request_lock(pending->mtx);
+    if (not pending->notify.wait_for(
+            request_lock, std::chrono::milliseconds(cfg_.recv_timeout_ms),
+            [&pending]() -> bool { return pending->complete; })) {
+      request_lock.unlock();
+      event_system::instance().raise<packet_client_timeout>("response",
+                                                            function_name);
+      cli.alive = false;
+      close(cli);
+      throw std::runtime_error("response timed out");
+    }
+
+    if (not pending->success) {
+      throw std::runtime_error("connection closed");
+    }
+
+    response = std::move(pending->response);
+  } catch (...) {
+    --cli.in_flight;
+    throw;
+  }
+
+  --cli.in_flight;
+  return 0;
+}
+
 void packet_client::write_data(client &cli, const packet &request) const {
   REPERTORY_USES_FUNCTION_NAME();
 
@@ -40,10 +40,13 @@ using std::thread;
 namespace repertory {
 packet_server::packet_server(std::uint16_t port, std::string token,
                              std::uint8_t pool_size, closed_callback closed,
-                             message_handler_callback message_handler)
-    : encryption_token_(std::move(token)),
+                             message_handler_callback message_handler,
+                             std::uint32_t max_protocol)
+    : encryption_key_(
+          utils::encryption::generate_key<utils::hash::hash_256_t>(token)),
       closed_(std::move(closed)),
-      message_handler_(std::move(message_handler)) {
+      message_handler_(std::move(message_handler)),
+      max_protocol_(max_protocol) {
   REPERTORY_USES_FUNCTION_NAME();
 
   event_system::instance().raise<service_start_begin>(function_name,
@@ -87,6 +90,7 @@ auto packet_server::handshake(std::shared_ptr<connection> conn) const -> bool {
   REPERTORY_USES_FUNCTION_NAME();
 
   try {
+    conn->key = encryption_key_;
     conn->generate_nonce();
 
     data_buffer buffer;
@@ -145,7 +149,7 @@ auto packet_server::handshake(std::shared_ptr<connection> conn) const -> bool {
 
       if (total_read == to_read) {
         packet response(conn->buffer);
-        if (response.decrypt(encryption_token_) == 0) {
+        if (response.decrypt(conn->key) == 0) {
           std::uint32_t client_version{};
           if (response.decode(client_version) == 0) {
             std::uint32_t client_version_check{};
@@ -296,14 +300,20 @@ void packet_server::read_packet(std::shared_ptr<connection> conn,
           fmt::format("packet too small|size|{}", data_size));
     }
 
-    auto should_send_response = true;
-    auto response = std::make_shared<packet>();
     conn->buffer.resize(data_size);
     read_buffer();
 
+    if (conn->multiplexed) {
+      read_multiplexed_packet(conn);
+      return;
+    }
+
+    auto should_send_response = true;
+    auto response = std::make_shared<packet>();
+
     packet::error_type ret{};
     auto request = std::make_shared<packet>(conn->buffer);
-    if (request->decrypt(encryption_token_) == 0) {
+    if (request->decrypt(conn->key) == 0) {
       std::string nonce;
       ret = request->decode(nonce);
       if (ret == 0) {
@@ -329,7 +339,20 @@ void packet_server::read_packet(std::shared_ptr<connection> conn,
             std::string method;
             DECODE_OR_IGNORE(request, method);
 
-            if (ret == 0) {
+            if (ret == 0 && method == packet_protocol_method) {
+              if (conn->client_id.empty()) {
+                add_client(*conn, client_id);
+              }
+
+              std::uint32_t protocol{};
+              ret = request->decode(protocol);
+              if (ret == 0 && protocol >= packet_protocol_multiplexed) {
+                conn->multiplexed = true;
+                response->encode(std::min(protocol, max_protocol_));
+              } else {
+                ret = utils::from_api_error(api_error::incompatible_version);
+              }
+            } else if (ret == 0) {
               if (conn->client_id.empty()) {
                 add_client(*conn, client_id);
               }
@@ -360,7 +383,82 @@ void packet_server::read_packet(std::shared_ptr<connection> conn,
   } catch (const std::exception &e) {
     remove_client(*conn);
     utils::error::raise_error(function_name, e, "exception occurred");
+
+    boost::system::error_code err{};
+    [[maybe_unused]] auto res = conn->socket.close(err);
+  }
+}
+
+void packet_server::read_multiplexed_packet(std::shared_ptr<connection> conn) {
+  auto request = std::make_shared<packet>(conn->buffer);
+  if (request->decrypt(conn->key) != 0) {
+    throw std::runtime_error("decryption failed");
+  }
+
+  std::string nonce;
+  if (request->decode(nonce) != 0) {
+    throw std::runtime_error("invalid nonce");
+  }
+
+  if (nonce != conn->nonce) {
+    throw std::runtime_error("nonce mismatch");
+  }
+
+  // The nonce is fixed for the life of a multiplexed connection; strictly
+  // increasing request IDs take over its role in rejecting replays.
+  std::uint64_t request_id{};
+  if (request->decode(request_id) != 0) {
+    throw std::runtime_error("invalid request id");
+  }
+
+  if (request_id <= conn->last_request_id) {
+    throw std::runtime_error(
+        fmt::format("request id out of order|id|{}", request_id));
+  }
+  conn->last_request_id = request_id;
+
+  auto response = std::make_shared<packet>();
+
+  std::string version;
+  auto ret = request->decode(version);
+  if (ret != 0) {
+    ret = utils::from_api_error(api_error::invalid_version);
+  } else if (utils::compare_version_strings(
+                 version, std::string{REPERTORY_MIN_REMOTE_VERSION}) < 0) {
+    ret = utils::from_api_error(api_error::incompatible_version);
+  } else {
+    std::uint32_t service_flags{};
+    DECODE_OR_IGNORE(request, service_flags);
+
+    std::string client_id;
+    DECODE_OR_IGNORE(request, client_id);
+
+    std::uint64_t thread_id{};
+    DECODE_OR_IGNORE(request, thread_id);
+
+    std::string method;
+    DECODE_OR_IGNORE(request, method);
+
+    if (ret == 0) {
+      if (conn->client_id.empty()) {
+        add_client(*conn, client_id);
+      }
+
+      message_handler_(
+          service_flags, client_id, thread_id, method, request.get(),
+          *response,
+          [this, conn, request, request_id,
+           response](const packet::error_type &result) {
+            this->send_multiplexed_response(conn, request_id, result,
+                                            *response);
+          });
+      read_header(conn);
+      return;
+    }
   }
+
+  send_multiplexed_response(conn, request_id, ret, *response);
+  read_header(conn);
 }
 
 void packet_server::remove_client(connection &conn) {
@@ -373,6 +471,32 @@ void packet_server::remove_client(connection &conn) {
     connection_lookup_.erase(conn.client_id);
     closed_(conn.client_id);
   }
+
+  // A multiplexed connection can fail on its read and write paths.
+  conn.client_id.clear();
+}
+
+void packet_server::send_multiplexed_response(std::shared_ptr<connection> conn,
+                                              std::uint64_t request_id,
+                                              const packet::error_type &result,
+                                              packet &response) {
+  response.encode_top(result);
+  response.encode_top(PACKET_SERVICE_FLAGS);
+  response.encode_top(request_id);
+  response.encode_top(conn->nonce);
+  response.encrypt(conn->key);
+
+  data_buffer buffer;
+  response.to_buffer(buffer);
+
+  mutex_lock write_lock(conn->write_mtx);
+  conn->write_queue.emplace_back(std::move(buffer));
+  if (conn->writing) {
+    return;
+  }
+
+  conn->writing = true;
+  write_next(conn);
 }
 
 void packet_server::send_response(std::shared_ptr<connection> conn,
@@ -383,9 +507,14 @@ void packet_server::send_response(std::shared_ptr<connection> conn,
   response.encode_top(result);
   response.encode_top(PACKET_SERVICE_FLAGS);
   response.encode_top(conn->nonce);
-  response.encrypt(encryption_token_);
+  response.encrypt(conn->key);
   response.to_buffer(conn->buffer);
 
+  if (conn->multiplexed) {
+    // Protocol negotiation is the last protocol 1 response on a connection
+    conn->key = create_session_key(encryption_key_, conn->nonce);
+  }
+
   boost::asio::async_write(conn->socket, boost::asio::buffer(conn->buffer),
                            [this, conn](auto &&err, auto &&) {
                              if (err) {
@@ -397,4 +526,33 @@ void packet_server::send_response(std::shared_ptr<connection> conn,
                              }
                            });
 }
+
+void packet_server::write_next(std::shared_ptr<connection> conn) {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  // Called with write_mtx held; responses are written one at a time in the
+  // order they completed.
+  boost::asio::async_write(
+      conn->socket, boost::asio::buffer(conn->write_queue.front()),
+      [this, conn](auto &&err, auto &&) {
+        unique_mutex_lock write_lock(conn->write_mtx);
+        if (err) {
+          conn->write_queue.clear();
+          conn->writing = false;
+          write_lock.unlock();
+
+          remove_client(*conn);
+          utils::error::raise_error(function_name, err.message());
+          return;
+        }
+
+        conn->write_queue.pop_front();
+        if (conn->write_queue.empty()) {
+          conn->writing = false;
+          return;
+        }
+
+        write_next(conn);
+      });
+}
 } // namespace repertory
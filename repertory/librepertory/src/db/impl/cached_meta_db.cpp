@@ -0,0 +1,223 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "db/impl/cached_meta_db.hpp"
+
+#include "types/repertory.hpp"
+
+namespace repertory {
+cached_meta_db::cached_meta_db(std::unique_ptr<i_meta_db> meta_db,
+                               std::chrono::milliseconds ttl,
+                               std::size_t max_entries)
+    : meta_db_(std::move(meta_db)),
+      max_shard_entries_(std::max(std::size_t{1U}, max_entries / shard_count)),
+      ttl_(ttl) {}
+
+void cached_meta_db::clear() {
+  meta_db_->clear();
+  invalidate_all();
+}
+
+void cached_meta_db::enumerate_api_path_list(
+    std::function<void(const std::vector<std::string> &)> callback,
+    stop_type_callback stop_requested_cb) const {
+  meta_db_->enumerate_api_path_list(callback, stop_requested_cb);
+}
+
+auto cached_meta_db::get_api_path(std::string_view source_path,
+                                  std::string &api_path) const -> api_error {
+  return meta_db_->get_api_path(source_path, api_path);
+}
+
+auto cached_meta_db::get_api_path_list() const -> std::vector<std::string> {
+  return meta_db_->get_api_path_list();
+}
+
+auto cached_meta_db::get_api_path_list(std::string_view after,
+                                       std::size_t count) const
+    -> std::vector<std::string> {
+  return meta_db_->get_api_path_list(after, count);
+}
+
+auto cached_meta_db::get_cached_meta(std::string_view api_path,
+                                     api_meta_map &meta) const -> api_error {
+  auto &cache = get_shard(api_path);
+
+  unique_mutex_lock lock(cache.mtx);
+  auto now{std::chrono::steady_clock::now()};
+  auto iter = cache.entries.find(std::string{api_path});
+  if (iter != cache.entries.end()) {
+    if (iter->second.expires > now) {
+      cache.lru.splice(cache.lru.begin(), cache.lru, iter->second.lru_iter);
+      if (not iter->second.meta.has_value()) {
+        return api_error::item_not_found;
+      }
+
+      meta = iter->second.meta.value();
+      return api_error::success;
+    }
+
+    cache.erase(iter);
+  }
+
+  auto generation{cache.generation};
+  lock.unlock();
+
+  api_meta_map db_meta;
+  auto res = meta_db_->get_item_meta(api_path, db_meta);
+  if (res != api_error::success && res != api_error::item_not_found) {
+    return res;
+  }
+
+  lock.lock();
+  // A write raced with this lookup; its invalidation bumped the generation so
+  // the possibly stale result must not be cached.
+  if (generation == cache.generation) {
+    // A concurrent lookup of the same path may have cached it already.
+    iter = cache.entries.find(std::string{api_path});
+    if (iter != cache.entries.end()) {
+      cache.erase(iter);
+    }
+
+    while (cache.entries.size() >= max_shard_entries_) {
+      cache.erase(cache.entries.find(cache.lru.back()));
+    }
+
+    cache.lru.emplace_front(api_path);
+    cache.entries.emplace(std::string{api_path},
+                          entry{
+                              .expires = now + ttl_,
+                              .meta = res == api_error::success
+                                          ? std::make_optional<api_meta_map>(
+                                                db_meta)
+                                          : std::nullopt,
+                              .lru_iter = cache.lru.begin(),
+                          });
+  }
+  lock.unlock();
+
+  if (res == api_error::success) {
+    meta = std::move(db_meta);
+  }
+
+  return res;
+}
+
+auto cached_meta_db::get_item_meta(std::string_view api_path,
+                                   api_meta_map &meta) const -> api_error {
+  return get_cached_meta(api_path, meta);
+}
+
+auto cached_meta_db::get_item_meta(std::string_view api_path,
+                                   std::string_view key,
+                                   std::string &value) const -> api_error {
+  api_meta_map meta;
+  auto res = get_cached_meta(api_path, meta);
+  if (res != api_error::success) {
+    return res;
+  }
+
+  auto iter = meta.find(std::string{key});
+  if (iter != meta.end()) {
+    value = iter->second;
+  }
+
+  return api_error::success;
+}
+
+auto cached_meta_db::get_pinned_files() const -> std::vector<std::string> {
+  return meta_db_->get_pinned_files();
+}
+
+auto cached_meta_db::get_shard(std::string_view api_path) const -> shard & {
+  return shards_.at(std::hash<std::string_view>{}(api_path) % shard_count);
+}
+
+auto cached_meta_db::get_total_item_count() const -> std::uint64_t {
+  return meta_db_->get_total_item_count();
+}
+
+auto cached_meta_db::get_total_size() const -> std::uint64_t {
+  return meta_db_->get_total_size();
+}
+
+void cached_meta_db::invalidate(std::string_view api_path) {
+  auto &cache = get_shard(api_path);
+
+  mutex_lock lock(cache.mtx);
+  ++cache.generation;
+  auto iter = cache.entries.find(std::string{api_path});
+  if (iter != cache.entries.end()) {
+    cache.erase(iter);
+  }
+}
+
+void cached_meta_db::invalidate_all() {
+  for (auto &cache : shards_) {
+    mutex_lock lock(cache.mtx);
+    ++cache.generation;
+    cache.entries.clear();
+    cache.lru.clear();
+  }
+}
+
+void cached_meta_db::remove_api_path(std::string_view api_path) {
+  meta_db_->remove_api_path(api_path);
+  invalidate(api_path);
+}
+
+auto cached_meta_db::remove_item_meta(std::string_view api_path,
+                                      std::string_view key) -> api_error {
+  auto res = meta_db_->remove_item_meta(api_path, key);
+  invalidate(api_path);
+  return res;
+}
+
+auto cached_meta_db::rename_item_meta(std::string_view from_api_path,
+                                      std::string_view to_api_path)
+    -> api_error {
+  auto res = meta_db_->rename_item_meta(from_api_path, to_api_path);
+  invalidate(from_api_path);
+  invalidate(to_api_path);
+  return res;
+}
+
+auto cached_meta_db::set_item_meta(std::string_view api_path,
+                                   std::string_view key,
+                                   std::string_view value) -> api_error {
+  auto res = meta_db_->set_item_meta(api_path, key, value);
+  invalidate(api_path);
+  return res;
+}
+
+auto cached_meta_db::set_item_meta(std::string_view api_path,
+                                   const api_meta_map &meta) -> api_error {
+  auto res = meta_db_->set_item_meta(api_path, meta);
+  invalidate(api_path);
+  return res;
+}
+
+void cached_meta_db::shard::erase(
+    std::unordered_map<std::string, entry>::iterator iter) {
+  lru.erase(iter->second.lru_iter);
+  entries.erase(iter);
+}
+} // namespace repertory
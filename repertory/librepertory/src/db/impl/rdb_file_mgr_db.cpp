@@ -45,6 +45,8 @@ void rdb_file_mgr_db::create_or_open(bool clear) {
                         rocksdb::ColumnFamilyOptions());
   families.emplace_back("upload_active", rocksdb::ColumnFamilyOptions());
   families.emplace_back("upload", rocksdb::ColumnFamilyOptions());
+  families.emplace_back("multipart", rocksdb::ColumnFamilyOptions());
+  families.emplace_back("cache", rocksdb::ColumnFamilyOptions());
 
   auto handles = std::vector<rocksdb::ColumnFamilyHandle *>();
   db_ = utils::create_rocksdb(cfg_, "file_mgr", families, handles, clear);
@@ -53,6 +55,37 @@ void rdb_file_mgr_db::create_or_open(bool clear) {
   resume_family_ = handles.at(idx++);
   upload_active_family_ = handles.at(idx++);
   upload_family_ = handles.at(idx++);
+  multipart_family_ = handles.at(idx++);
+  cache_family_ = handles.at(idx++);
+}
+
+auto rdb_file_mgr_db::add_cache_entry(const cache_entry &entry) -> bool {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  return perform_action(
+      function_name,
+      [this, &entry](rocksdb::Transaction *txn) -> rocksdb::Status {
+        return txn->Put(cache_family_, entry.source_path,
+                        std::to_string(entry.accessed));
+      });
+}
+
+auto rdb_file_mgr_db::add_multipart(const multipart_entry &entry) -> bool {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  return perform_action(
+      function_name,
+      [this, &entry](rocksdb::Transaction *txn) -> rocksdb::Status {
+        auto data = json({
+            {"part_size", entry.part_size},
+            {"parts", entry.parts},
+            {"source_modified", entry.source_modified},
+            {"source_path", entry.source_path},
+            {"source_size", entry.source_size},
+            {"upload_id", entry.upload_id},
+        });
+        return txn->Put(multipart_family_, entry.api_path, data.dump());
+      });
 }
 
 auto rdb_file_mgr_db::add_resume(const resume_entry &entry) -> bool {
@@ -108,6 +141,54 @@ auto rdb_file_mgr_db::create_iterator(rocksdb::ColumnFamilyHandle *family) const
       db_->NewIterator(rocksdb::ReadOptions(), family));
 }
 
+auto rdb_file_mgr_db::get_cache_entry_list() const
+    -> std::vector<cache_entry> {
+  std::vector<cache_entry> ret;
+
+  auto iter = create_iterator(cache_family_);
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ret.emplace_back(cache_entry{
+        iter->key().ToString(),
+        utils::string::to_uint64(iter->value().ToString()),
+    });
+  }
+
+  return ret;
+}
+
+auto rdb_file_mgr_db::get_multipart(std::string_view api_path) const
+    -> std::optional<multipart_entry> {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  try {
+    std::string value;
+    auto res = db_->Get(rocksdb::ReadOptions{}, multipart_family_, api_path,
+                        &value);
+    if (not res.ok()) {
+      if (not res.IsNotFound()) {
+        utils::error::raise_error(function_name, res.ToString());
+      }
+
+      return std::nullopt;
+    }
+
+    auto data = json::parse(value);
+    return multipart_entry{
+        std::string{api_path},
+        data.at("upload_id").get<std::string>(),
+        data.at("part_size").get<std::uint64_t>(),
+        data.at("parts").get<std::map<std::uint32_t, std::string>>(),
+        data.at("source_modified").get<std::uint64_t>(),
+        data.at("source_path").get<std::string>(),
+        data.at("source_size").get<std::uint64_t>(),
+    };
+  } catch (const std::exception &ex) {
+    utils::error::raise_error(function_name, ex);
+  }
+
+  return std::nullopt;
+}
+
 auto rdb_file_mgr_db::get_next_upload() const -> std::optional<upload_entry> {
   auto iter = create_iterator(upload_family_);
   for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
@@ -178,6 +259,23 @@ auto rdb_file_mgr_db::get_upload_active_list() const
   return ret;
 }
 
+auto rdb_file_mgr_db::get_upload_list() const -> std::vector<upload_entry> {
+  std::vector<upload_entry> ret;
+
+  auto iter = create_iterator(upload_family_);
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    auto parts = utils::string::split(iter->key().ToString(), '|', false);
+    parts.erase(parts.begin());
+
+    ret.emplace_back(upload_entry{
+        utils::string::join(parts, '|'),
+        iter->value().ToString(),
+    });
+  }
+
+  return ret;
+}
+
 auto rdb_file_mgr_db::perform_action(std::string_view function_name,
                                      std::function<rocksdb::Status()> action)
     -> bool {
@@ -229,6 +327,27 @@ auto rdb_file_mgr_db::perform_action(
   return false;
 }
 
+auto rdb_file_mgr_db::remove_cache_entry(std::string_view source_path)
+    -> bool {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  return perform_action(
+      function_name,
+      [this, &source_path](rocksdb::Transaction *txn) -> rocksdb::Status {
+        return txn->Delete(cache_family_, source_path);
+      });
+}
+
+auto rdb_file_mgr_db::remove_multipart(std::string_view api_path) -> bool {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  return perform_action(
+      function_name,
+      [this, &api_path](rocksdb::Transaction *txn) -> rocksdb::Status {
+        return txn->Delete(multipart_family_, api_path);
+      });
+}
+
 auto rdb_file_mgr_db::remove_resume(std::string_view api_path) -> bool {
   REPERTORY_USES_FUNCTION_NAME();
 
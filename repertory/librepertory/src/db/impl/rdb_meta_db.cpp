@@ -22,6 +22,7 @@
 #include "db/impl/rdb_meta_db.hpp"
 
 #include "app_config.hpp"
+#include "db/meta_codec.hpp"
 #include "types/startup_exception.hpp"
 #include "utils/collection.hpp"
 #include "utils/error_utils.hpp"
@@ -55,6 +56,10 @@ void rdb_meta_db::create_or_open(bool clear) {
   pinned_family_ = handles.at(idx++);
   size_family_ = handles.at(idx++);
   source_family_ = handles.at(idx++);
+
+  if (not clear) {
+    migrate_legacy_meta();
+  }
 }
 
 void rdb_meta_db::clear() { create_or_open(true); }
@@ -112,12 +117,33 @@ auto rdb_meta_db::get_api_path_list() const -> std::vector<std::string> {
   return ret;
 }
 
-auto rdb_meta_db::get_item_meta_json(std::string_view api_path,
-                                     json &json_data) const -> api_error {
+auto rdb_meta_db::get_api_path_list(std::string_view after,
+                                    std::size_t count) const
+    -> std::vector<std::string> {
+  std::vector<std::string> ret;
+  auto iter = create_iterator(meta_family_);
+  if (after.empty()) {
+    iter->SeekToFirst();
+  } else {
+    iter->Seek(after);
+    if (iter->Valid() && iter->key().ToString() == after) {
+      iter->Next();
+    }
+  }
+
+  for (; iter->Valid() && ret.size() < count; iter->Next()) {
+    ret.push_back(iter->key().ToString());
+  }
+
+  return ret;
+}
+
+auto rdb_meta_db::get_item_meta(std::string_view api_path,
+                                api_meta_map &meta) const -> api_error {
   REPERTORY_USES_FUNCTION_NAME();
 
   try {
-    json_data.clear();
+    api_meta_map item_meta;
 
     {
       std::string value;
@@ -128,8 +154,11 @@ auto rdb_meta_db::get_item_meta_json(std::string_view api_path,
         return res;
       }
 
-      if (not value.empty()) {
-        json_data = json::parse(value);
+      if (not meta_codec::decode(value, item_meta)) {
+        utils::error::raise_api_path_error(function_name, api_path,
+                                           api_error::error,
+                                           "failed to decode item meta");
+        return api_error::error;
       }
     }
 
@@ -143,7 +172,7 @@ auto rdb_meta_db::get_item_meta_json(std::string_view api_path,
         return res;
       }
       if (not value.empty()) {
-        json_data[META_PINNED] = value;
+        item_meta[META_PINNED] = value;
       }
     }
 
@@ -156,11 +185,19 @@ auto rdb_meta_db::get_item_meta_json(std::string_view api_path,
         return res;
       }
       if (not value.empty()) {
-        json_data[META_SIZE] = value;
+        item_meta[META_SIZE] = value;
       }
     }
 
-    return json_data.empty() ? api_error::item_not_found : api_error::success;
+    if (item_meta.empty()) {
+      return api_error::item_not_found;
+    }
+
+    for (auto &item : item_meta) {
+      meta[item.first] = std::move(item.second);
+    }
+
+    return api_error::success;
   } catch (const std::exception &e) {
     utils::error::raise_api_path_error(function_name, api_path, e,
                                        "failed to get item meta");
@@ -169,21 +206,6 @@ auto rdb_meta_db::get_item_meta_json(std::string_view api_path,
   return api_error::error;
 }
 
-auto rdb_meta_db::get_item_meta(std::string_view api_path,
-                                api_meta_map &meta) const -> api_error {
-  json json_data;
-  auto ret = get_item_meta_json(api_path, json_data);
-  if (ret != api_error::success) {
-    return ret;
-  }
-
-  for (auto it = json_data.begin(); it != json_data.end(); ++it) {
-    meta[it.key()] = it.value().get<std::string>();
-  }
-
-  return api_error::success;
-}
-
 auto rdb_meta_db::get_item_meta(std::string_view api_path, std::string_view key,
                                 std::string &value) const -> api_error {
   REPERTORY_USES_FUNCTION_NAME();
@@ -200,14 +222,15 @@ auto rdb_meta_db::get_item_meta(std::string_view api_path, std::string_view key,
     });
   }
 
-  json json_data;
-  auto ret = get_item_meta_json(api_path, json_data);
+  api_meta_map meta;
+  auto ret = get_item_meta(api_path, meta);
   if (ret != api_error::success) {
     return ret;
   }
 
-  if (json_data.find(key) != json_data.end()) {
-    value = json_data[key].get<std::string>();
+  auto iter = meta.find(std::string{key});
+  if (iter != meta.end()) {
+    value = iter->second;
   }
 
   return api_error::success;
@@ -247,6 +270,50 @@ auto rdb_meta_db::get_total_size() const -> std::uint64_t {
   return ret;
 }
 
+void rdb_meta_db::migrate_legacy_meta() {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  // Older databases stored meta as JSON; rewrite those records using the
+  // binary encoding so reads never need to parse JSON.
+  constexpr const auto max_batch_size{1000};
+
+  const auto write_batch = [this](rocksdb::WriteBatch &batch) {
+    auto res = db_->Write(rocksdb::WriteOptions{}, &batch);
+    if (not res.ok()) {
+      throw startup_exception(
+          fmt::format("failed to migrate legacy meta|{}", res.ToString()));
+    }
+    batch.Clear();
+  };
+
+  rocksdb::WriteBatch batch;
+  auto iter = create_iterator(meta_family_);
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    auto value = iter->value().ToString();
+    if (not meta_codec::is_legacy_json(value)) {
+      continue;
+    }
+
+    auto res =
+        batch.Put(meta_family_, iter->key(),
+                  meta_codec::encode(json::parse(value).get<api_meta_map>()));
+    if (not res.ok()) {
+      utils::error::raise_api_path_error(function_name, iter->key().ToString(),
+                                         api_error::error,
+                                         "failed to migrate legacy meta");
+      continue;
+    }
+
+    if (batch.Count() >= max_batch_size) {
+      write_batch(batch);
+    }
+  }
+
+  if (batch.Count() > 0) {
+    write_batch(batch);
+  }
+}
+
 auto rdb_meta_db::perform_action(std::string_view function_name,
                                  std::function<rocksdb::Status()> action)
     -> api_error {
@@ -354,37 +421,36 @@ auto rdb_meta_db::remove_item_meta(std::string_view api_path,
     return api_error::permission_denied;
   }
 
-  json json_data;
-  auto res = get_item_meta_json(api_path, json_data);
+  api_meta_map meta;
+  auto res = get_item_meta(api_path, meta);
   if (res != api_error::success) {
     return res;
   }
 
-  json_data.erase(key);
-  return update_item_meta(api_path, json_data);
+  meta.erase(std::string{key});
+  return update_item_meta(api_path, meta);
 }
 
 auto rdb_meta_db::rename_item_meta(std::string_view from_api_path,
                                    std::string_view to_api_path) -> api_error {
   REPERTORY_USES_FUNCTION_NAME();
 
-  json json_data;
-  auto res = get_item_meta_json(from_api_path, json_data);
+  api_meta_map meta;
+  auto res = get_item_meta(from_api_path, meta);
   if (res != api_error::success) {
     return res;
   }
 
   return perform_action(
       function_name, [&](rocksdb::Transaction *txn) -> rocksdb::Status {
-        auto txn_res = remove_api_path(
-            from_api_path, json_data[META_SOURCE].get<std::string>(), txn);
+        auto txn_res = remove_api_path(from_api_path, meta[META_SOURCE], txn);
         if (not txn_res.ok()) {
           return txn_res;
         }
 
         rocksdb::Status status;
         [[maybe_unused]] auto api_res =
-            update_item_meta(to_api_path, json_data, txn, &status);
+            update_item_meta(to_api_path, meta, txn, &status);
         return status;
       });
 }
@@ -407,66 +473,61 @@ auto rdb_meta_db::set_item_meta(std::string_view api_path, std::string_view key,
                           });
   }
 
-  json json_data;
-  auto res = get_item_meta_json(api_path, json_data);
+  api_meta_map meta;
+  auto res = get_item_meta(api_path, meta);
   if (res != api_error::success && res != api_error::item_not_found) {
     return res;
   }
 
-  json_data[key] = value;
+  meta[std::string{key}] = value;
 
-  return update_item_meta(api_path, json_data);
+  return update_item_meta(api_path, meta);
 }
 
 auto rdb_meta_db::set_item_meta(std::string_view api_path,
                                 const api_meta_map &meta) -> api_error {
   REPERTORY_USES_FUNCTION_NAME();
 
-  json json_data;
-  auto res = get_item_meta_json(api_path, json_data);
+  api_meta_map existing_meta;
+  auto res = get_item_meta(api_path, existing_meta);
   if (res != api_error::success && res != api_error::item_not_found) {
     utils::error::raise_api_path_error(function_name, api_path, res,
                                        "failed to get item meta");
   }
 
   for (const auto &data : meta) {
-    json_data[data.first] = data.second;
+    existing_meta[data.first] = data.second;
   }
 
-  return update_item_meta(api_path, json_data);
+  return update_item_meta(api_path, existing_meta);
 }
 
-auto rdb_meta_db::update_item_meta(std::string_view api_path, json json_data,
+auto rdb_meta_db::update_item_meta(std::string_view api_path,
+                                   api_meta_map meta,
                                    rocksdb::Transaction *base_txn,
                                    rocksdb::Status *status) -> api_error {
   REPERTORY_USES_FUNCTION_NAME();
 
   try {
-    if (not json_data.contains(META_PINNED)) {
-      json_data[META_PINNED] = utils::string::from_bool(false);
+    if (not meta.contains(META_PINNED)) {
+      meta[META_PINNED] = utils::string::from_bool(false);
     }
-    if (not json_data.contains(META_SIZE)) {
-      json_data[META_SIZE] = "0";
+    if (not meta.contains(META_SIZE)) {
+      meta[META_SIZE] = "0";
     }
-    if (not json_data.contains(META_SOURCE)) {
-      json_data[META_SOURCE] = "";
+    if (not meta.contains(META_SOURCE)) {
+      meta[META_SOURCE] = "";
     }
 
-    auto directory =
-        utils::string::to_bool(json_data.at(META_DIRECTORY).get<std::string>());
+    auto directory = utils::string::to_bool(meta.at(META_DIRECTORY));
 
-    auto pinned = directory ? false
-                            : utils::string::to_bool(
-                                  json_data.at(META_PINNED).get<std::string>());
+    auto pinned =
+        directory ? false : utils::string::to_bool(meta.at(META_PINNED));
     auto size = directory ? std::uint64_t(0U)
-                          : utils::string::to_uint64(
-                                json_data.at(META_SIZE).get<std::string>());
-    auto source_path = directory ? std::string("")
-                                 : json_data.at(META_SOURCE).get<std::string>();
+                          : utils::string::to_uint64(meta.at(META_SIZE));
+    auto source_path = directory ? std::string("") : meta.at(META_SOURCE);
 
-    json_data[META_PINNED] = utils::string::from_bool(pinned);
-    json_data[META_SIZE] = std::to_string(size);
-    json_data[META_SOURCE] = source_path;
+    meta[META_SOURCE] = source_path;
 
     auto should_del_source{false};
     std::string orig_source_path;
@@ -480,8 +541,8 @@ auto rdb_meta_db::update_item_meta(std::string_view api_path, json json_data,
           not orig_source_path.empty() && orig_source_path != source_path;
     }
 
-    json_data.erase(META_PINNED);
-    json_data.erase(META_SIZE);
+    meta.erase(META_PINNED);
+    meta.erase(META_SIZE);
 
     const auto set_status = [&status](rocksdb::Status res) -> rocksdb::Status {
       if (status != nullptr) {
@@ -518,7 +579,8 @@ auto rdb_meta_db::update_item_meta(std::string_view api_path, json json_data,
         }
       }
 
-      return set_status(txn->Put(meta_family_, api_path, json_data.dump()));
+      return set_status(
+          txn->Put(meta_family_, api_path, meta_codec::encode(meta)));
     };
 
     if (base_txn == nullptr) {
@@ -35,10 +35,37 @@
 #include "utils/string.hpp"
 
 namespace {
+const std::string cache_table = "cache";
+const std::string multipart_table = "multipart";
 const std::string resume_table = "resume";
 const std::string upload_table = "upload";
 const std::string upload_active_table = "upload_active";
 const std::map<std::string, std::string> sql_create_tables{
+    {
+        {cache_table},
+        {
+            "CREATE TABLE IF NOT EXISTS " + cache_table +
+                "("
+                "source_path TEXT PRIMARY KEY ASC, "
+                "accessed INTEGER"
+                ");",
+        },
+    },
+    {
+        {multipart_table},
+        {
+            "CREATE TABLE IF NOT EXISTS " + multipart_table +
+                "("
+                "api_path TEXT PRIMARY KEY ASC, "
+                "part_size INTEGER, "
+                "parts TEXT, "
+                "source_modified INTEGER, "
+                "source_path TEXT, "
+                "source_size INTEGER, "
+                "upload_id TEXT"
+                ");",
+        },
+    },
     {
         {resume_table},
         {
@@ -89,6 +116,30 @@ sqlite_file_mgr_db::sqlite_file_mgr_db(const app_config &cfg) {
 
 sqlite_file_mgr_db::~sqlite_file_mgr_db() { db_.reset(); }
 
+auto sqlite_file_mgr_db::add_cache_entry(const cache_entry &entry) -> bool {
+  return utils::db::sqlite::db_insert{*db_, cache_table}
+      .or_replace()
+      .column_value("source_path", entry.source_path)
+      .column_value("accessed", static_cast<std::int64_t>(entry.accessed))
+      .go()
+      .ok();
+}
+
+auto sqlite_file_mgr_db::add_multipart(const multipart_entry &entry) -> bool {
+  return utils::db::sqlite::db_insert{*db_, multipart_table}
+      .or_replace()
+      .column_value("api_path", entry.api_path)
+      .column_value("part_size", static_cast<std::int64_t>(entry.part_size))
+      .column_value("parts", nlohmann::json(entry.parts).dump())
+      .column_value("source_modified",
+                    static_cast<std::int64_t>(entry.source_modified))
+      .column_value("source_path", entry.source_path)
+      .column_value("source_size", static_cast<std::int64_t>(entry.source_size))
+      .column_value("upload_id", entry.upload_id)
+      .go()
+      .ok();
+}
+
 auto sqlite_file_mgr_db::add_resume(const resume_entry &entry) -> bool {
   return utils::db::sqlite::db_insert{*db_, resume_table}
       .or_replace()
@@ -123,7 +174,21 @@ auto sqlite_file_mgr_db::add_upload_active(const upload_active_entry &entry)
 void sqlite_file_mgr_db::clear() {
   REPERTORY_USES_FUNCTION_NAME();
 
-  auto result = utils::db::sqlite::db_delete{*db_, resume_table}.go();
+  auto result = utils::db::sqlite::db_delete{*db_, cache_table}.go();
+  if (not result.ok()) {
+    utils::error::raise_error(function_name,
+                              "failed to clear cache table|" +
+                                  std::to_string(result.get_error()));
+  }
+
+  result = utils::db::sqlite::db_delete{*db_, multipart_table}.go();
+  if (not result.ok()) {
+    utils::error::raise_error(function_name,
+                              "failed to clear multipart table|" +
+                                  std::to_string(result.get_error()));
+  }
+
+  result = utils::db::sqlite::db_delete{*db_, resume_table}.go();
   if (not result.ok()) {
     utils::error::raise_error(function_name,
                               "failed to clear resume table|" +
@@ -145,6 +210,69 @@ void sqlite_file_mgr_db::clear() {
   }
 }
 
+auto sqlite_file_mgr_db::get_cache_entry_list() const
+    -> std::vector<cache_entry> {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  std::vector<cache_entry> ret;
+  auto result = utils::db::sqlite::db_select{*db_, cache_table}.go();
+  while (result.has_row()) {
+    try {
+      std::optional<utils::db::sqlite::db_result::row> row;
+      if (not result.get_row(row)) {
+        continue;
+      }
+      if (not row.has_value()) {
+        continue;
+      }
+
+      ret.push_back(cache_entry{
+          row->get_column("source_path").get_value<std::string>(),
+          static_cast<std::uint64_t>(
+              row->get_column("accessed").get_value<std::int64_t>()),
+      });
+    } catch (const std::exception &ex) {
+      utils::error::raise_error(function_name, ex, "query error");
+    }
+  }
+
+  return ret;
+}
+
+auto sqlite_file_mgr_db::get_multipart(std::string_view api_path) const
+    -> std::optional<multipart_entry> {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  try {
+    auto result = utils::db::sqlite::db_select{*db_, multipart_table}
+                      .where("api_path")
+                      .equals(std::string{api_path})
+                      .go();
+    std::optional<utils::db::sqlite::db_result::row> row;
+    if (not result.get_row(row) || not row.has_value()) {
+      return std::nullopt;
+    }
+
+    return multipart_entry{
+        row->get_column("api_path").get_value<std::string>(),
+        row->get_column("upload_id").get_value<std::string>(),
+        static_cast<std::uint64_t>(
+            row->get_column("part_size").get_value<std::int64_t>()),
+        nlohmann::json::parse(row->get_column("parts").get_value<std::string>())
+            .get<std::map<std::uint32_t, std::string>>(),
+        static_cast<std::uint64_t>(
+            row->get_column("source_modified").get_value<std::int64_t>()),
+        row->get_column("source_path").get_value<std::string>(),
+        static_cast<std::uint64_t>(
+            row->get_column("source_size").get_value<std::int64_t>()),
+    };
+  } catch (const std::exception &ex) {
+    utils::error::raise_error(function_name, ex, "query error");
+  }
+
+  return std::nullopt;
+}
+
 auto sqlite_file_mgr_db::get_next_upload() const
     -> std::optional<upload_entry> {
   auto result = utils::db::sqlite::db_select{*db_, upload_table}
@@ -238,6 +366,52 @@ auto sqlite_file_mgr_db::get_upload_active_list() const
   return ret;
 }
 
+auto sqlite_file_mgr_db::get_upload_list() const -> std::vector<upload_entry> {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  std::vector<upload_entry> ret;
+  auto result = utils::db::sqlite::db_select{*db_, upload_table}
+                    .order_by("id", true)
+                    .go();
+  while (result.has_row()) {
+    try {
+      std::optional<utils::db::sqlite::db_result::row> row;
+      if (not result.get_row(row)) {
+        continue;
+      }
+      if (not row.has_value()) {
+        continue;
+      }
+
+      ret.push_back(upload_entry{
+          row->get_column("api_path").get_value<std::string>(),
+          row->get_column("source_path").get_value<std::string>(),
+      });
+    } catch (const std::exception &ex) {
+      utils::error::raise_error(function_name, ex, "query error");
+    }
+  }
+
+  return ret;
+}
+
+auto sqlite_file_mgr_db::remove_cache_entry(std::string_view source_path)
+    -> bool {
+  return utils::db::sqlite::db_delete{*db_, cache_table}
+      .where("source_path")
+      .equals(std::string{source_path})
+      .go()
+      .ok();
+}
+
+auto sqlite_file_mgr_db::remove_multipart(std::string_view api_path) -> bool {
+  return utils::db::sqlite::db_delete{*db_, multipart_table}
+      .where("api_path")
+      .equals(std::string{api_path})
+      .go()
+      .ok();
+}
+
 auto sqlite_file_mgr_db::remove_resume(std::string_view api_path) -> bool {
   return utils::db::sqlite::db_delete{*db_, resume_table}
       .where("api_path")
@@ -22,6 +22,7 @@
 #include "db/impl/sqlite_meta_db.hpp"
 
 #include "app_config.hpp"
+#include "db/meta_codec.hpp"
 #include "types/startup_exception.hpp"
 #include "utils/collection.hpp"
 #include "utils/db/sqlite/db_common.hpp"
@@ -33,21 +34,99 @@
 #include "utils/path.hpp"
 #include "utils/string.hpp"
 
+namespace {
+constexpr const auto legacy_table_name = "meta_legacy";
+
+[[nodiscard]] auto create_table_sql(std::string_view name) -> std::string {
+  return fmt::format("CREATE TABLE IF NOT EXISTS "
+                     "\"{}\" "
+                     "("
+                     "api_path TEXT PRIMARY KEY ASC, "
+                     "accessed INTEGER, "
+                     "attributes INTEGER, "
+                     "backup TEXT, "
+                     "changed INTEGER, "
+                     "creation INTEGER, "
+                     "directory INTEGER, "
+                     "extra BLOB, "
+                     "flags INTEGER, "
+                     "gid INTEGER, "
+                     "kdf TEXT, "
+                     "\"key\" TEXT, "
+                     "mode INTEGER, "
+                     "modified INTEGER, "
+                     "pinned INTEGER, "
+                     "size INTEGER, "
+                     "source_path TEXT, "
+                     "uid INTEGER, "
+                     "written INTEGER"
+                     ");",
+                     name);
+}
+
+[[nodiscard]] auto get_column_name(std::string_view key) -> std::string {
+  if (key == repertory::META_SOURCE) {
+    return "source_path";
+  }
+
+  return repertory::utils::collection::includes(repertory::META_USED_NAMES,
+                                                std::string{key})
+             ? std::string{key}
+             : "extra";
+}
+
+void populate_meta(const repertory::utils::db::sqlite::db_result::row &row,
+                   repertory::api_meta_map &meta) {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  for (const auto &column : row.get_columns()) {
+    auto name = column.get_name();
+    if (name == "api_path") {
+      continue;
+    }
+
+    if (name == "extra") {
+      auto data = column.get_value<repertory::data_buffer>();
+      if (not repertory::meta_codec::decode(
+              std::string_view{
+                  reinterpret_cast<const char *>(data.data()),
+                  data.size(),
+              },
+              meta)) {
+        throw repertory::utils::error::create_exception(
+            function_name, {
+                               "failed to decode meta",
+                           });
+      }
+      continue;
+    }
+
+    if (name == "source_path") {
+      meta[repertory::META_SOURCE] = column.get_value<std::string>();
+      continue;
+    }
+
+    if (repertory::utils::collection::includes(
+            repertory::meta_codec::STRING_NAMES, std::string_view{name})) {
+      meta[name] = column.get_value<std::string>();
+      continue;
+    }
+
+    auto value = column.get_value<std::int64_t>();
+    meta[name] = (name == repertory::META_DIRECTORY ||
+                  name == repertory::META_PINNED)
+                     ? repertory::utils::string::from_bool(value == 1)
+                     : std::to_string(static_cast<std::uint64_t>(value));
+  }
+}
+} // namespace
+
 namespace repertory {
 sqlite_meta_db::sqlite_meta_db(const app_config &cfg) {
   const std::map<std::string, std::string> sql_create_tables{
       {
           {"meta"},
-          {"CREATE TABLE IF NOT EXISTS "
-           "meta "
-           "("
-           "api_path TEXT PRIMARY KEY ASC, "
-           "data TEXT, "
-           "directory INTEGER, "
-           "pinned INTEGER, "
-           "size INTEGER, "
-           "source_path TEXT"
-           ");"},
+          {create_table_sql(table_name)},
       },
   };
 
@@ -59,6 +138,7 @@ sqlite_meta_db::sqlite_meta_db(const app_config &cfg) {
 
   db_ = utils::db::sqlite::create_db(utils::path::combine(db_dir, {"meta.db"}),
                                      sql_create_tables);
+  migrate_legacy_table();
 }
 
 sqlite_meta_db::~sqlite_meta_db() { db_.reset(); }
@@ -136,6 +216,29 @@ auto sqlite_meta_db::get_api_path_list() const -> std::vector<std::string> {
   return ret;
 }
 
+auto sqlite_meta_db::get_api_path_list(std::string_view after,
+                                       std::size_t count) const
+    -> std::vector<std::string> {
+  std::vector<std::string> ret{};
+
+  auto result = utils::db::sqlite::db_select{*db_, table_name}
+                    .column("api_path")
+                    .where("api_path")
+                    .gt(std::string{after})
+                    .op()
+                    .order_by("api_path", true)
+                    .limit(static_cast<std::int32_t>(count))
+                    .go();
+  while (result.has_row()) {
+    std::optional<utils::db::sqlite::db_result::row> row;
+    if (result.get_row(row) && row.has_value()) {
+      ret.push_back(row->get_column("api_path").get_value<std::string>());
+    }
+  }
+
+  return ret;
+}
+
 auto sqlite_meta_db::get_item_meta(std::string_view api_path,
                                    api_meta_map &meta) const -> api_error {
   REPERTORY_USES_FUNCTION_NAME();
@@ -154,16 +257,8 @@ auto sqlite_meta_db::get_item_meta(std::string_view api_path,
   try {
     std::optional<utils::db::sqlite::db_result::row> row;
     if (result.get_row(row) && row.has_value()) {
-      meta = json::parse(row->get_column("data").get_value<std::string>())
-                 .get<api_meta_map>();
-      meta[META_DIRECTORY] = utils::string::from_bool(
-          row->get_column("directory").get_value<std::int64_t>() == 1);
-      meta[META_PINNED] = utils::string::from_bool(
-          row->get_column("pinned").get_value<std::int64_t>() == 1);
-      meta[META_SIZE] = std::to_string(static_cast<std::uint64_t>(
-          row->get_column("size").get_value<std::int64_t>()));
-      meta[META_SOURCE] =
-          row->get_column("source_path").get_value<std::string>();
+      meta.clear();
+      populate_meta(row.value(), meta);
       return api_error::success;
     }
 
@@ -181,9 +276,14 @@ auto sqlite_meta_db::get_item_meta(std::string_view api_path,
                                    std::string &value) const -> api_error {
   REPERTORY_USES_FUNCTION_NAME();
 
-  auto result = utils::db::sqlite::db_select{*db_, table_name}
-                    .column("*")
-                    .where("api_path")
+  auto column_name = get_column_name(key);
+  auto query = utils::db::sqlite::db_select{*db_, table_name}.column(
+      column_name);
+  if (column_name != "extra") {
+    query = query.column("extra");
+  }
+
+  auto result = query.where("api_path")
                     .equals(std::string{api_path})
                     .op()
                     .limit(1)
@@ -195,21 +295,13 @@ auto sqlite_meta_db::get_item_meta(std::string_view api_path,
   try {
     std::optional<utils::db::sqlite::db_result::row> row;
     if (result.get_row(row) && row.has_value()) {
-      value =
-          key == META_SOURCE
-              ? row->get_column("source_path").get_value<std::string>()
-          : key == META_PINNED
-              ? utils::string::from_bool(
-                    row->get_column("pinned").get_value<std::int64_t>() == 1)
-          : key == META_DIRECTORY
-              ? utils::string::from_bool(
-                    row->get_column("directory").get_value<std::int64_t>() == 1)
-          : key == META_SIZE
-              ? std::to_string(static_cast<std::uint64_t>(
-                    row->get_column("size").get_value<std::int64_t>()))
-              : json::parse(
-                    row->get_column("data").get_value<std::string>())[key]
-                    .get<std::string>();
+      api_meta_map meta;
+      populate_meta(row.value(), meta);
+
+      auto iter = meta.find(std::string{key});
+      if (iter != meta.end()) {
+        value = iter->second;
+      }
       return api_error::success;
     }
 
@@ -291,6 +383,69 @@ auto sqlite_meta_db::get_total_size() const -> std::uint64_t {
   return 0U;
 }
 
+void sqlite_meta_db::migrate_legacy_table() {
+  // Older databases stored everything but directory, pinned, size and source
+  // as a JSON blob in the 'data' column.
+  if (not utils::db::sqlite::db_select{*db_, table_name}
+              .column("data")
+              .limit(1)
+              .go()
+              .ok()) {
+    return;
+  }
+
+  const auto execute = [this](const std::string &sql) {
+    std::string err;
+    if (not utils::db::sqlite::execute_sql(*db_, sql, err)) {
+      throw startup_exception(err);
+    }
+  };
+
+  try {
+    execute("BEGIN TRANSACTION;");
+    execute(fmt::format("ALTER TABLE \"{}\" RENAME TO \"{}\";", table_name,
+                        legacy_table_name));
+    execute(create_table_sql(table_name));
+
+    {
+      auto result = utils::db::sqlite::db_select{*db_, legacy_table_name}
+                        .column("*")
+                        .go();
+      while (result.has_row()) {
+        std::optional<utils::db::sqlite::db_result::row> row;
+        if (not result.get_row(row) || not row.has_value()) {
+          continue;
+        }
+
+        auto api_path = row->get_column("api_path").get_value<std::string>();
+        auto meta =
+            json::parse(row->get_column("data").get_value<std::string>())
+                .get<api_meta_map>();
+        meta[META_DIRECTORY] = utils::string::from_bool(
+            row->get_column("directory").get_value<std::int64_t>() == 1);
+        meta[META_PINNED] = utils::string::from_bool(
+            row->get_column("pinned").get_value<std::int64_t>() == 1);
+        meta[META_SIZE] = std::to_string(static_cast<std::uint64_t>(
+            row->get_column("size").get_value<std::int64_t>()));
+        meta[META_SOURCE] =
+            row->get_column("source_path").get_value<std::string>();
+
+        if (update_item_meta(api_path, meta) != api_error::success) {
+          throw startup_exception(
+              fmt::format("failed to migrate meta|{}", api_path));
+        }
+      }
+    }
+
+    execute(fmt::format("DROP TABLE \"{}\";", legacy_table_name));
+    execute("COMMIT;");
+  } catch (...) {
+    std::string err;
+    std::ignore = utils::db::sqlite::execute_sql(*db_, "ROLLBACK;", err);
+    throw;
+  }
+}
+
 void sqlite_meta_db::remove_api_path(std::string_view api_path) {
   REPERTORY_USES_FUNCTION_NAME();
 
@@ -390,15 +545,47 @@ auto sqlite_meta_db::update_item_meta(std::string_view api_path,
     meta.erase(META_SIZE);
     meta.erase(META_SOURCE);
 
-    auto result = utils::db::sqlite::db_insert{*db_, table_name}
-                      .or_replace()
-                      .column_value("api_path", std::string{api_path})
-                      .column_value("data", nlohmann::json(meta).dump())
-                      .column_value("directory", directory ? 1 : 0)
-                      .column_value("pinned", pinned ? 1 : 0)
-                      .column_value("size", static_cast<std::int64_t>(size))
-                      .column_value("source_path", source_path)
-                      .go();
+    auto query = utils::db::sqlite::db_insert{*db_, table_name}
+                     .or_replace()
+                     .column_value("api_path", std::string{api_path})
+                     .column_value("directory", directory ? 1 : 0)
+                     .column_value("pinned", pinned ? 1 : 0)
+                     .column_value("size", static_cast<std::int64_t>(size))
+                     .column_value("source_path", source_path);
+
+    for (const auto &name : meta_codec::NUMERIC_NAMES) {
+      auto iter = meta.find(std::string{name});
+      if (iter == meta.end()) {
+        continue;
+      }
+
+      auto value = meta_codec::to_numeric(iter->second);
+      if (not value.has_value()) {
+        continue;
+      }
+
+      query = query.column_value(std::string{name},
+                                 static_cast<std::int64_t>(value.value()));
+      meta.erase(iter);
+    }
+
+    for (const auto &name : meta_codec::STRING_NAMES) {
+      auto iter = meta.find(std::string{name});
+      if (iter == meta.end()) {
+        continue;
+      }
+
+      query = query.column_value(std::string{name}, iter->second);
+      meta.erase(iter);
+    }
+
+    if (not meta.empty()) {
+      auto extra = meta_codec::encode(meta);
+      query = query.column_value("extra",
+                                 data_buffer(extra.begin(), extra.end()));
+    }
+
+    auto result = query.go();
     if (not result.ok()) {
       utils::error::raise_api_path_error(function_name, api_path,
                                          result.get_error(),
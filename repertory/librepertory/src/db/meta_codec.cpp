@@ -0,0 +1,230 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "db/meta_codec.hpp"
+
+namespace {
+// Leading byte of an encoded record; legacy records are JSON objects and
+// always begin with '{'.
+constexpr const unsigned char record_version{0x01U};
+
+void write_varint(std::string &data, std::uint64_t value) {
+  while (value >= 0x80U) {
+    data.push_back(static_cast<char>((value & 0x7FU) | 0x80U));
+    value >>= 7U;
+  }
+  data.push_back(static_cast<char>(value));
+}
+
+[[nodiscard]] auto read_varint(std::string_view data, std::size_t &offset,
+                               std::uint64_t &value) -> bool {
+  value = 0U;
+  for (std::uint32_t shift = 0U; shift < 64U; shift += 7U) {
+    if (offset >= data.size()) {
+      return false;
+    }
+
+    auto byte = static_cast<unsigned char>(data.at(offset++));
+    value |= static_cast<std::uint64_t>(byte & 0x7FU) << shift;
+    if ((byte & 0x80U) == 0U) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void write_string(std::string &data, std::string_view value) {
+  write_varint(data, value.size());
+  data.append(value);
+}
+
+[[nodiscard]] auto read_string(std::string_view data, std::size_t &offset,
+                               std::string &value) -> bool {
+  std::uint64_t size{};
+  if (not read_varint(data, offset, size) || size > data.size() - offset) {
+    return false;
+  }
+
+  value = data.substr(offset, size);
+  offset += size;
+  return true;
+}
+
+[[nodiscard]] auto get_key_name(std::uint64_t tag)
+    -> std::optional<std::string_view> {
+  auto iter = std::ranges::find_if(
+      repertory::meta_codec::KEY_TAGS,
+      [tag](auto &&item) -> bool { return item.first == tag; });
+  if (iter == repertory::meta_codec::KEY_TAGS.end()) {
+    return std::nullopt;
+  }
+
+  return iter->second;
+}
+
+[[nodiscard]] auto get_key_tag(std::string_view name) -> std::uint64_t {
+  auto iter = std::ranges::find_if(
+      repertory::meta_codec::KEY_TAGS,
+      [name](auto &&item) -> bool { return item.second == name; });
+  return iter == repertory::meta_codec::KEY_TAGS.end() ? 0U : iter->first;
+}
+} // namespace
+
+namespace repertory::meta_codec {
+auto decode(std::string_view data, api_meta_map &meta) -> bool {
+  if (data.empty()) {
+    return true;
+  }
+
+  if (static_cast<unsigned char>(data.at(0U)) != record_version) {
+    return false;
+  }
+
+  std::size_t offset{1U};
+  std::uint64_t mask{};
+  if (not read_varint(data, offset, mask)) {
+    return false;
+  }
+
+  for (std::size_t idx = 0U; idx < NUMERIC_NAMES.size(); ++idx) {
+    if ((mask & (std::uint64_t{1U} << idx)) == 0U) {
+      continue;
+    }
+
+    std::uint64_t value{};
+    if (not read_varint(data, offset, value)) {
+      return false;
+    }
+    meta[std::string{NUMERIC_NAMES.at(idx)}] = std::to_string(value);
+  }
+
+  std::uint64_t count{};
+  if (not read_varint(data, offset, count)) {
+    return false;
+  }
+
+  for (std::uint64_t idx = 0U; idx < count; ++idx) {
+    std::uint64_t tag{};
+    if (not read_varint(data, offset, tag)) {
+      return false;
+    }
+
+    std::string key;
+    if (tag == 0U) {
+      if (not read_string(data, offset, key)) {
+        return false;
+      }
+    } else {
+      auto name = get_key_name(tag);
+      if (not name.has_value()) {
+        return false;
+      }
+      key = name.value();
+    }
+
+    std::string value;
+    if (not read_string(data, offset, value)) {
+      return false;
+    }
+    meta[key] = value;
+  }
+
+  return offset == data.size();
+}
+
+auto encode(const api_meta_map &meta) -> std::string {
+  std::string data;
+  data.push_back(static_cast<char>(record_version));
+
+  std::uint64_t mask{};
+  std::vector<std::uint64_t> values;
+  for (std::size_t idx = 0U; idx < NUMERIC_NAMES.size(); ++idx) {
+    auto iter = meta.find(std::string{NUMERIC_NAMES.at(idx)});
+    if (iter == meta.end()) {
+      continue;
+    }
+
+    auto value = to_numeric(iter->second);
+    if (not value.has_value()) {
+      continue;
+    }
+
+    mask |= std::uint64_t{1U} << idx;
+    values.push_back(value.value());
+  }
+
+  write_varint(data, mask);
+  for (const auto &value : values) {
+    write_varint(data, value);
+  }
+
+  std::vector<std::pair<std::uint64_t, const api_meta_map::value_type *>>
+      entries;
+  for (const auto &item : meta) {
+    auto num_iter =
+        std::find(NUMERIC_NAMES.begin(), NUMERIC_NAMES.end(), item.first);
+    if (num_iter != NUMERIC_NAMES.end() &&
+        to_numeric(item.second).has_value()) {
+      continue;
+    }
+
+    entries.emplace_back(get_key_tag(item.first), &item);
+  }
+
+  write_varint(data, entries.size());
+  for (const auto &[tag, item] : entries) {
+    write_varint(data, tag);
+    if (tag == 0U) {
+      write_string(data, item->first);
+    }
+    write_string(data, item->second);
+  }
+
+  return data;
+}
+
+auto is_legacy_json(std::string_view data) -> bool {
+  return not data.empty() && data.at(0U) == '{';
+}
+
+auto to_numeric(std::string_view value) -> std::optional<std::uint64_t> {
+  if (value.empty() || (value.size() > 1U && value.at(0U) == '0')) {
+    return std::nullopt;
+  }
+
+  std::uint64_t ret{};
+  for (const auto &chr : value) {
+    if (chr < '0' || chr > '9') {
+      return std::nullopt;
+    }
+
+    auto digit = static_cast<std::uint64_t>(chr - '0');
+    if (ret > (std::numeric_limits<std::uint64_t>::max() - digit) / 10U) {
+      return std::nullopt;
+    }
+
+    ret = (ret * 10U) + digit;
+  }
+
+  return ret;
+}
+} // namespace repertory::meta_codec
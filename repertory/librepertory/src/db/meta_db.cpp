@@ -22,6 +22,7 @@
 #include "db/meta_db.hpp"
 
 #include "app_config.hpp"
+#include "db/impl/cached_meta_db.hpp"
 #include "db/impl/rdb_meta_db.hpp"
 #include "db/impl/sqlite_meta_db.hpp"
 
@@ -29,10 +30,11 @@ namespace repertory {
 auto create_meta_db(const app_config &cfg) -> std::unique_ptr<i_meta_db> {
   switch (cfg.get_database_type()) {
   case database_type::sqlite:
-    return std::make_unique<sqlite_meta_db>(cfg);
+    return std::make_unique<cached_meta_db>(
+        std::make_unique<sqlite_meta_db>(cfg));
 
   default:
-    return std::make_unique<rdb_meta_db>(cfg);
+    return std::make_unique<cached_meta_db>(std::make_unique<rdb_meta_db>(cfg));
   }
 }
 } // namespace repertory
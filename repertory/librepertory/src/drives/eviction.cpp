@@ -22,75 +22,67 @@
 #include "drives/eviction.hpp"
 
 #include "app_config.hpp"
+#include "file_manager/cache_size_mgr.hpp"
 #include "file_manager/i_file_manager.hpp"
-#include "platform/platform.hpp"
-#include "providers/i_provider.hpp"
-#include "types/repertory.hpp"
 #include "utils/error_utils.hpp"
-#include "utils/file_utils.hpp"
 #include "utils/time.hpp"
-#include "utils/utils.hpp"
 
 namespace repertory {
-auto eviction::check_minimum_requirements(std::string_view file_path) -> bool {
+void eviction::evict_to_low_watermark() {
   REPERTORY_USES_FUNCTION_NAME();
 
-  auto file = utils::file::file{file_path};
-  auto reference_time = file.get_time(config_.get_eviction_uses_accessed_time()
-                                          ? utils::file::time_type::accessed
-                                          : utils::file::time_type::modified);
-
-  if (not reference_time.has_value()) {
-    utils::error::raise_error(function_name, utils::get_last_error_code(),
-                              file_path, "failed to get file time");
-    return false;
-  }
+  auto &cache_mgr{cache_size_mgr::instance()};
 
   auto delay =
       static_cast<std::uint64_t>(config_.get_eviction_delay_mins() * 60U) *
       utils::time::NANOS_PER_SECOND;
-  return (reference_time.value() + delay) <= utils::time::get_time_now();
-}
-
-auto eviction::get_filtered_cached_files() -> std::deque<std::string> {
-  auto list =
-      utils::file::get_directory_files(config_.get_cache_directory(), true);
-  list.erase(std::remove_if(list.begin(), list.end(),
-                            [this](auto &&path) -> bool {
-                              return not this->check_minimum_requirements(path);
-                            }),
-             list.end());
-  return list;
-}
-
-void eviction::service_function() {
-  REPERTORY_USES_FUNCTION_NAME();
+  auto now{utils::time::get_time_now()};
+  auto max_accessed{now > delay ? now - delay : 0U};
+
+  // Candidates that cannot be evicted are rotated to the back of the index,
+  // so visiting at most its size per pass keeps the pass bounded
+  auto remaining{file_mgr_.get_cached_file_count()};
+  while (not get_stop_requested() && remaining != 0U &&
+         cache_mgr.size() > cache_mgr.get_low_watermark()) {
+    auto count{std::min(batch_size, remaining)};
+    remaining -= count;
+
+    auto candidates = file_mgr_.get_eviction_candidates(count, max_accessed);
+    if (candidates.empty()) {
+      return;
+    }
 
-  auto cached_files_list = get_filtered_cached_files();
-  auto was_file_evicted{false};
-  while (not get_stop_requested() && not cached_files_list.empty()) {
-    auto file_path = cached_files_list.front();
-    cached_files_list.pop_front();
-
-    try {
-      std::string api_path;
-      auto res = provider_.get_api_path_from_source(file_path, api_path);
-      if (res != api_error::success) {
-        continue;
+    for (const auto &api_path : candidates) {
+      if (get_stop_requested() ||
+          cache_mgr.size() <= cache_mgr.get_low_watermark()) {
+        return;
       }
 
-      if (file_mgr_.evict_file(api_path)) {
-        was_file_evicted = true;
+      try {
+        [[maybe_unused]] auto evicted = file_mgr_.evict_file(api_path);
+      } catch (const std::exception &ex) {
+        utils::error::raise_api_path_error(function_name, api_path, ex,
+                                           "failed to evict file");
       }
-    } catch (const std::exception &ex) {
-      utils::error::raise_error(
-          function_name, ex,
-          fmt::format("failed to process cached file|sp|{}", file_path));
     }
   }
+}
 
-  if (get_stop_requested() || was_file_evicted) {
-    return;
+void eviction::on_start() {
+  cache_size_mgr::instance().set_pressure_callback([this]() {
+    pressure_ = true;
+    notify_all();
+  });
+}
+
+void eviction::on_stop() {
+  cache_size_mgr::instance().set_pressure_callback(nullptr);
+}
+
+void eviction::service_function() {
+  auto &cache_mgr{cache_size_mgr::instance()};
+  if (cache_mgr.size() >= cache_mgr.get_high_watermark()) {
+    evict_to_low_watermark();
   }
 
   unique_mutex_lock lock(get_mutex());
@@ -98,6 +90,9 @@ void eviction::service_function() {
     return;
   }
 
-  get_notify().wait_for(lock, 30s);
+  get_notify().wait_for(lock, 30s, [this]() -> bool {
+    return pressure_ || get_stop_requested();
+  });
+  pressure_ = false;
 }
 } // namespace repertory
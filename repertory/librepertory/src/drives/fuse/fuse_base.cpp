@@ -376,6 +376,9 @@ auto fuse_base::init_impl(struct fuse_conn_info *conn) -> void * {
 #if FUSE_USE_VERSION >= 30
   cfg->nullpath_ok = 0;
   cfg->hard_remove = 1;
+  cfg->attr_timeout =
+      static_cast<double>(config_.get_kernel_attr_timeout_secs());
+  cfg->entry_timeout = cfg->attr_timeout;
 #endif // FUSE_USE_VERSION >= 30
 
   if (not utils::file::change_to_process_directory()) {
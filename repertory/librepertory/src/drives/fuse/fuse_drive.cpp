@@ -398,6 +398,10 @@ auto fuse_drive::fgetattr_impl(std::string api_path, struct stat *u_stat,
     if (res != api_error::success) {
       return res;
     }
+
+    for (const auto &[key, value] : open_file->get_pending_meta()) {
+      meta[key] = value;
+    }
   }
 
   fuse_drive_base::populate_stat(api_path, open_file->get_file_size(), meta,
@@ -409,6 +413,13 @@ auto fuse_drive::fgetattr_impl(std::string api_path, struct stat *u_stat,
   return api_error::success;
 }
 
+void fuse_drive::flush_pending_meta(std::string_view api_path) {
+  std::shared_ptr<i_open_file> open_file;
+  if (fm_->get_open_file(api_path, open_file)) {
+    std::ignore = open_file->flush_pending_meta();
+  }
+}
+
 #if defined(__APPLE__)
 auto fuse_drive::fsetattr_x_impl(std::string api_path, struct setattr_x *attr,
                                  struct fuse_file_info *f_info) -> api_error {
@@ -428,6 +439,13 @@ auto fuse_drive::fsync_impl(std::string /*api_path*/, int datasync,
     return api_error::invalid_handle;
   }
 
+  auto res = open_file->flush_pending_meta();
+  if (res != api_error::success) {
+    return res;
+  }
+
+  open_file->set_sync_requested(true);
+
   return open_file->native_operation([&datasync](int handle) -> api_error {
     if (handle != REPERTORY_INVALID_HANDLE) {
 #if defined(__APPLE__)
@@ -495,7 +513,19 @@ auto fuse_drive::get_file_size(std::string_view api_path) const
 
 auto fuse_drive::get_item_meta(std::string_view api_path,
                                api_meta_map &meta) const -> api_error {
-  return provider_.get_item_meta(api_path, meta);
+  auto ret = provider_.get_item_meta(api_path, meta);
+  if (ret != api_error::success) {
+    return ret;
+  }
+
+  std::shared_ptr<i_open_file> open_file;
+  if (fm_->get_open_file(api_path, open_file)) {
+    for (const auto &[key, value] : open_file->get_pending_meta()) {
+      meta[key] = value;
+    }
+  }
+
+  return ret;
 }
 
 auto fuse_drive::get_item_meta(std::string_view api_path, std::string_view name,
@@ -524,6 +554,10 @@ auto fuse_drive::get_item_stat(std::uint64_t handle,
     if (ret != api_error::success) {
       return ret;
     }
+
+    for (const auto &[key, value] : open_file->get_pending_meta()) {
+      meta[key] = value;
+    }
   }
 
   fuse_drive_base::populate_stat(open_file->get_api_path(),
@@ -549,7 +583,7 @@ auto fuse_drive::getattr_impl(std::string api_path, struct stat *u_stat)
   }
 
   api_meta_map meta{};
-  res = provider_.get_item_meta(api_path, meta);
+  res = get_item_meta(api_path, meta);
   if (res != api_error::success) {
     return res;
   }
@@ -633,7 +667,7 @@ auto fuse_drive::init_impl(struct fuse_conn_info *conn) -> void * {
     fm_ = std::make_unique<file_manager>(config_, provider_);
     server_ = std::make_unique<full_server>(config_, provider_, *fm_);
     if (not provider_.is_read_only()) {
-      eviction_ = std::make_unique<eviction>(provider_, config_, *fm_);
+      eviction_ = std::make_unique<eviction>(config_, *fm_);
     }
 
     directory_cache_ = std::make_unique<directory_cache>();
@@ -804,14 +838,12 @@ auto fuse_drive::read_impl(std::string api_path, char *buffer, size_t read_size,
     return res;
   }
 
-  data_buffer data;
-  res =
-      open_file->read(read_size, static_cast<std::uint64_t>(read_offset), data);
-  bytes_read = data.size();
+  res = open_file->read(
+      static_cast<std::uint64_t>(read_offset),
+      data_span{reinterpret_cast<unsigned char *>(buffer), read_size},
+      bytes_read);
   if (bytes_read != 0U) {
-    std::memcpy(buffer, data.data(), data.size());
-    data.clear();
-    update_accessed_time(api_path);
+    update_accessed_time(*open_file);
   }
 
   return res;
@@ -1462,6 +1494,7 @@ auto fuse_drive::utimens_impl(std::string api_path, const struct timespec tv[2])
   process_timespec(tv[1U], META_MODIFIED);
 
   if (not meta.empty()) {
+    flush_pending_meta(api_path);
     return provider_.set_item_meta(api_path, meta);
   }
 
@@ -1495,23 +1528,25 @@ auto fuse_drive::write_impl(std::string /*api_path*/
       write_offset = static_cast<off_t>(open_file->get_file_size());
     }
 
-    data_buffer data(write_size);
-    std::memcpy(data.data(), buffer, write_size);
-    return open_file->write(static_cast<std::uint64_t>(write_offset),
-                            std::move(data), bytes_written);
+    return open_file->write(
+        static_cast<std::uint64_t>(write_offset),
+        data_cspan{reinterpret_cast<const unsigned char *>(buffer), write_size},
+        bytes_written);
   }
 
   return api_error::success;
 }
 
-void fuse_drive::update_accessed_time(std::string_view api_path) {
+void fuse_drive::update_accessed_time(i_open_file &open_file) {
   REPERTORY_USES_FUNCTION_NAME();
 
   if (atime_enabled_) {
-    auto res = provider_.set_item_meta(
-        api_path, META_ACCESSED, std::to_string(utils::time::get_time_now()));
+    auto res = open_file.set_pending_meta({
+        {META_ACCESSED, std::to_string(utils::time::get_time_now())},
+    });
     if (res != api_error::success) {
-      utils::error::raise_api_path_error(function_name, api_path, res,
+      utils::error::raise_api_path_error(function_name,
+                                         open_file.get_api_path(), res,
                                          "failed to set accessed time");
     }
   }
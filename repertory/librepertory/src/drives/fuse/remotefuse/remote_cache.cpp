@@ -0,0 +1,336 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "drives/fuse/remotefuse/remote_cache.hpp"
+
+#include "utils/path.hpp"
+
+namespace repertory::remote_fuse {
+auto remote_cache::check_access(const std::string &api_path, std::int32_t mask,
+                                const access_loader_t &loader)
+    -> packet::error_type {
+  std::uint64_t generation{};
+  {
+    mutex_lock lock(mtx_);
+    auto *entry = find_attr(api_path);
+    if (entry != nullptr) {
+      if (entry->res != 0) {
+        return entry->res;
+      }
+
+      auto iter = entry->access.find(mask);
+      if (iter != entry->access.end()) {
+        return iter->second;
+      }
+    }
+
+    generation = generation_;
+  }
+
+  auto res = loader();
+
+  mutex_lock lock(mtx_);
+  if (generation != generation_) {
+    return res;
+  }
+
+  // Access results ride along with the attributes of the path so that they
+  // expire together
+  auto *entry = find_attr(api_path);
+  if (entry != nullptr && entry->res == 0) {
+    entry->access[mask] = res;
+  }
+
+  return res;
+}
+
+void remote_cache::clear() {
+  std::vector<std::shared_ptr<read_state>> states;
+  {
+    mutex_lock lock(mtx_);
+    ++generation_;
+    attrs_.clear();
+
+    for (auto &&item : reads_) {
+      states.emplace_back(item.second);
+    }
+    read_handles_.clear();
+    reads_.clear();
+  }
+
+  for (auto &&state : states) {
+    mutex_lock state_lock(state->mtx);
+    clear_read_data(*state);
+  }
+}
+
+void remote_cache::clear_read_data(read_state &state) {
+  buffered_size_ -= state.data.size();
+  state.data.clear();
+  state.data.shrink_to_fit();
+  state.window = 0U;
+}
+
+auto remote_cache::find_attr(const std::string &api_path) -> attr_entry * {
+  auto iter = attrs_.find(api_path);
+  if (iter == attrs_.end()) {
+    return nullptr;
+  }
+
+  if (iter->second.expires <= std::chrono::steady_clock::now()) {
+    attrs_.erase(iter);
+    return nullptr;
+  }
+
+  return &iter->second;
+}
+
+auto remote_cache::get_attr(const std::string &api_path, remote::stat &r_stat,
+                            bool &directory, const attr_loader_t &loader)
+    -> packet::error_type {
+  std::uint64_t generation{};
+  {
+    mutex_lock lock(mtx_);
+    const auto *entry = find_attr(api_path);
+    if (entry != nullptr) {
+      if (entry->res == 0) {
+        r_stat = entry->r_stat;
+        directory = entry->directory;
+      }
+
+      return entry->res;
+    }
+
+    generation = generation_;
+  }
+
+  auto res = loader(r_stat, directory);
+  if (res == 0 || res == -ENOENT) {
+    attr_entry entry{};
+    entry.expires = std::chrono::steady_clock::now() + timeout_;
+    entry.res = res;
+    if (res == 0) {
+      entry.r_stat = r_stat;
+      entry.directory = directory;
+    }
+    store_attr(api_path, generation, entry);
+  }
+
+  return res;
+}
+
+auto remote_cache::get_generation() const -> std::uint64_t {
+  mutex_lock lock(mtx_);
+  return generation_;
+}
+
+auto remote_cache::get_read_state(const std::string &api_path,
+                                  remote::file_handle handle)
+    -> std::shared_ptr<read_state> {
+  mutex_lock lock(mtx_);
+  auto &state = reads_[handle];
+  if (not state) {
+    state = std::make_shared<read_state>();
+  }
+
+  // Open handles keep working across renames
+  if (state->api_path != api_path) {
+    remove_read_handle(state->api_path, handle);
+    state->api_path = api_path;
+    read_handles_[api_path].insert(handle);
+  }
+
+  return state;
+}
+
+void remote_cache::invalidate(const std::string &api_path, bool recursive) {
+  std::vector<std::shared_ptr<read_state>> states;
+  const auto add_states = [this, &states](auto &&handles) {
+    for (auto &&handle : handles) {
+      states.emplace_back(reads_.at(handle));
+    }
+  };
+
+  {
+    mutex_lock lock(mtx_);
+    ++generation_;
+
+    attrs_.erase(utils::path::get_parent_api_path(api_path));
+
+    // Every write invalidates its path, so only directory renames and
+    // removals pay for a scan of the whole cache
+    if (not recursive) {
+      attrs_.erase(api_path);
+
+      auto iter = read_handles_.find(api_path);
+      if (iter != read_handles_.end()) {
+        add_states(iter->second);
+      }
+    } else {
+      auto prefix = api_path == "/" ? api_path : api_path + '/';
+      const auto matches = [&api_path,
+                            &prefix](const std::string &path) -> bool {
+        return path == api_path || path.starts_with(prefix);
+      };
+
+      std::erase_if(attrs_,
+                    [&matches](auto &&item) { return matches(item.first); });
+
+      for (auto &&item : read_handles_) {
+        if (matches(item.first)) {
+          add_states(item.second);
+        }
+      }
+    }
+  }
+
+  for (auto &&state : states) {
+    mutex_lock state_lock(state->mtx);
+    clear_read_data(*state);
+  }
+}
+
+auto remote_cache::read(const std::string &api_path,
+                        remote::file_handle handle, char *buffer,
+                        remote::file_size read_size,
+                        remote::file_offset read_offset,
+                        const read_loader_t &loader) -> packet::error_type {
+  auto state = get_read_state(api_path, handle);
+  mutex_lock state_lock(state->mtx);
+
+  auto size = static_cast<std::size_t>(read_size);
+  if (not state->data.empty() && read_offset >= state->data_offset &&
+      (read_offset + read_size) <=
+          (state->data_offset + state->data.size())) {
+    std::memcpy(buffer, &state->data.at(read_offset - state->data_offset),
+                size);
+    state->next_offset = read_offset + read_size;
+    return static_cast<packet::error_type>(size);
+  }
+
+  if (read_offset == state->next_offset) {
+    state->window = state->window == 0U
+                        ? std::max(min_readahead_size, size * 2U)
+                        : std::min(max_readahead_size, state->window * 2U);
+  } else {
+    state->window = 0U;
+  }
+
+  auto used = buffered_size_.load() - state->data.size();
+  auto window = std::min(state->window, max_total_readahead_size -
+                                            std::min(max_total_readahead_size,
+                                                     used));
+  clear_read_data(*state);
+  state->window = window;
+
+  if (window <= size) {
+    auto res = loader(buffer, read_size, read_offset);
+    if (res >= 0) {
+      state->next_offset = read_offset + static_cast<std::uint64_t>(res);
+    }
+
+    return res;
+  }
+
+  state->data.resize(window);
+  buffered_size_ += window;
+
+  auto res = loader(state->data.data(), window, read_offset);
+  if (res < 0) {
+    clear_read_data(*state);
+    return res;
+  }
+
+  buffered_size_ -= window - static_cast<std::size_t>(res);
+  state->data.resize(static_cast<std::size_t>(res));
+  state->data_offset = read_offset;
+
+  auto count = std::min(size, state->data.size());
+  std::memcpy(buffer, state->data.data(), count);
+  state->next_offset = read_offset + count;
+  return static_cast<packet::error_type>(count);
+}
+
+void remote_cache::release(remote::file_handle handle) {
+  std::shared_ptr<read_state> state;
+  {
+    mutex_lock lock(mtx_);
+    auto iter = reads_.find(handle);
+    if (iter == reads_.end()) {
+      return;
+    }
+
+    state = iter->second;
+    remove_read_handle(state->api_path, handle);
+    reads_.erase(iter);
+  }
+
+  mutex_lock state_lock(state->mtx);
+  clear_read_data(*state);
+}
+
+void remote_cache::remove_read_handle(const std::string &api_path,
+                                      remote::file_handle handle) {
+  auto iter = read_handles_.find(api_path);
+  if (iter == read_handles_.end()) {
+    return;
+  }
+
+  iter->second.erase(handle);
+  if (iter->second.empty()) {
+    read_handles_.erase(iter);
+  }
+}
+
+void remote_cache::set_attr(const std::string &api_path,
+                            std::uint64_t generation,
+                            const remote::stat &r_stat, bool directory) {
+  attr_entry entry{};
+  entry.expires = std::chrono::steady_clock::now() + timeout_;
+  entry.r_stat = r_stat;
+  entry.directory = directory;
+  store_attr(api_path, generation, entry);
+}
+
+void remote_cache::store_attr(const std::string &api_path,
+                              std::uint64_t generation,
+                              const attr_entry &entry) {
+  if (timeout_.count() == 0) {
+    return;
+  }
+
+  mutex_lock lock(mtx_);
+  if (generation != generation_) {
+    return;
+  }
+
+  if (attrs_.size() >= max_attr_entries) {
+    auto now = std::chrono::steady_clock::now();
+    std::erase_if(attrs_,
+                  [&now](auto &&item) { return item.second.expires <= now; });
+    if (attrs_.size() >= max_attr_entries) {
+      attrs_.clear();
+    }
+  }
+
+  attrs_[api_path] = entry;
+}
+} // namespace repertory::remote_fuse
@@ -22,6 +22,7 @@
 #include "drives/fuse/remotefuse/remote_client.hpp"
 
 #include "app_config.hpp"
+#include "comm/packet/common.hpp"
 #include "comm/packet/packet.hpp"
 #include "utils/path.hpp"
 
@@ -471,6 +472,56 @@ auto remote_client::fuse_readdir(const char *path, remote::file_offset offset,
   return ret;
 }
 
+auto remote_client::fuse_readdir_plus(
+    const char *path, remote::file_offset offset, remote::file_handle handle,
+    std::uint32_t max_count, std::vector<remote::directory_entry> &entries)
+    -> packet::error_type {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  entries.clear();
+  const auto is_supported = [this]() -> bool {
+    return packet_client_.get_protocol() >= comm::packet_protocol_readdir_plus;
+  };
+
+  // The protocol is unknown until the first connection is made
+  if (packet_client_.get_protocol() != 0U && not is_supported()) {
+    return -ENOTSUP;
+  }
+
+  packet request;
+  request.encode(path);
+  request.encode(offset);
+  request.encode(handle);
+  request.encode(max_count);
+  request.encode(uid_);
+  request.encode(gid_);
+
+  packet response;
+  std::uint32_t service_flags{};
+  auto ret =
+      packet_client_.send(function_name, request, response, service_flags);
+  if (not is_supported()) {
+    return -ENOTSUP;
+  }
+
+  if (ret != 0) {
+    return ret;
+  }
+
+  std::uint32_t count{};
+  DECODE_OR_RETURN(&response, count);
+  if (count > remote::max_directory_entries) {
+    return -EBADMSG;
+  }
+
+  entries.resize(count);
+  for (auto &entry : entries) {
+    DECODE_OR_RETURN(&response, entry);
+  }
+
+  return ret;
+}
+
 auto remote_client::fuse_release(const char *path, remote::file_handle handle)
     -> packet::error_type {
   REPERTORY_USES_FUNCTION_NAME();
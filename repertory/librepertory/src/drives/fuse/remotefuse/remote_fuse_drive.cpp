@@ -44,17 +44,27 @@
 #include "utils/utils.hpp"
 
 namespace repertory::remote_fuse {
+remote_fuse_drive::remote_fuse_drive(app_config &config,
+                                     remote_instance_factory factory,
+                                     lock_data &lock)
+    : fuse_base(config),
+      cache_(std::chrono::seconds(config.get_kernel_attr_timeout_secs())),
+      factory_(std::move(factory)),
+      lock_data_(lock) {}
+
 auto remote_fuse_drive::access_impl(std::string api_path, int mask)
     -> api_error {
-  return utils::to_api_error(
-      remote_instance_->fuse_access(api_path.c_str(), mask));
+  return utils::to_api_error(cache_.check_access(api_path, mask, [&]() {
+    return remote_instance_->fuse_access(api_path.c_str(), mask);
+  }));
 }
 
 #if defined(__APPLE__)
 auto remote_fuse_drive::chflags_impl(std::string api_path, uint32_t flags)
     -> api_error {
-  return utils::to_api_error(
-      remote_instance_->fuse_chflags(api_path.c_str(), flags));
+  auto res = remote_instance_->fuse_chflags(api_path.c_str(), flags);
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 #endif // defined(__APPLE__)
 
@@ -66,8 +76,10 @@ auto remote_fuse_drive::chmod_impl(std::string api_path, mode_t mode,
 auto remote_fuse_drive::chmod_impl(std::string api_path, mode_t mode)
     -> api_error {
 #endif // FUSE_USE_VERSION >= 30
-  return utils::to_api_error(remote_instance_->fuse_chmod(
-      api_path.c_str(), static_cast<remote::file_mode>(mode)));
+  auto res = remote_instance_->fuse_chmod(
+      api_path.c_str(), static_cast<remote::file_mode>(mode));
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 
 #if FUSE_USE_VERSION >= 30
@@ -78,17 +90,20 @@ auto remote_fuse_drive::chown_impl(std::string api_path, uid_t uid, gid_t gid,
 auto remote_fuse_drive::chown_impl(std::string api_path, uid_t uid, gid_t gid)
     -> api_error {
 #endif // FUSE_USE_VERSION >= 30
-  return utils::to_api_error(
-      remote_instance_->fuse_chown(api_path.c_str(), uid, gid));
+  auto res = remote_instance_->fuse_chown(api_path.c_str(), uid, gid);
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 
 auto remote_fuse_drive::create_impl(std::string api_path, mode_t mode,
                                     struct fuse_file_info *f_info)
     -> api_error {
-  return utils::to_api_error(remote_instance_->fuse_create(
+  auto res = remote_instance_->fuse_create(
       api_path.c_str(), static_cast<remote::file_mode>(mode),
       remote::create_open_flags(static_cast<std::uint32_t>(f_info->flags)),
-      f_info->fh));
+      f_info->fh);
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 
 void remote_fuse_drive::destroy_impl(void *ptr) {
@@ -112,6 +127,8 @@ void remote_fuse_drive::destroy_impl(void *ptr) {
     remote_instance_.reset();
   }
 
+  cache_.clear();
+
   if (not lock_data_.set_mount_state(false, "", -1)) {
     utils::error::raise_error(function_name, "failed to set mount state");
   }
@@ -128,8 +145,12 @@ auto remote_fuse_drive::fgetattr_impl(std::string api_path, struct stat *u_stat,
   remote::stat r_stat{};
   auto directory = false;
 
-  auto res = remote_instance_->fuse_fgetattr(api_path.c_str(), r_stat,
-                                             directory, f_info->fh);
+  auto res = cache_.get_attr(
+      api_path, r_stat, directory,
+      [this, &api_path, &f_info](remote::stat &st, bool &dir) {
+        return remote_instance_->fuse_fgetattr(api_path.c_str(), st, dir,
+                                               f_info->fh);
+      });
   if (res == 0) {
     populate_stat(r_stat, directory, *u_stat);
   }
@@ -177,8 +198,10 @@ auto remote_fuse_drive::fsetattr_x_impl(std::string api_path,
         utils::time::NANOS_PER_SECOND) +
        static_cast<remote::file_time>(attr->bkuptime.tv_nsec));
   attributes.flags = attr->flags;
-  return utils::to_api_error(remote_instance_->fuse_fsetattr_x(
-      api_path.c_str(), attributes, f_info->fh));
+  auto res = remote_instance_->fuse_fsetattr_x(api_path.c_str(), attributes,
+                                               f_info->fh);
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 #endif // defined(__APPLE__)
 
@@ -192,8 +215,10 @@ auto remote_fuse_drive::fsync_impl(std::string api_path, int datasync,
 auto remote_fuse_drive::ftruncate_impl(std::string api_path, off_t size,
                                        struct fuse_file_info *f_info)
     -> api_error {
-  return utils::to_api_error(
-      remote_instance_->fuse_ftruncate(api_path.c_str(), size, f_info->fh));
+  auto res =
+      remote_instance_->fuse_ftruncate(api_path.c_str(), size, f_info->fh);
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 #endif // FUSE_USE_VERSION < 30
 
@@ -212,8 +237,11 @@ auto remote_fuse_drive::getattr_impl(std::string api_path, struct stat *u_stat)
   bool directory = false;
   remote::stat r_stat{};
 
-  auto res =
-      remote_instance_->fuse_getattr(api_path.c_str(), r_stat, directory);
+  auto res = cache_.get_attr(api_path, r_stat, directory,
+                             [this, &api_path](remote::stat &st, bool &dir) {
+                               return remote_instance_->fuse_getattr(
+                                   api_path.c_str(), st, dir);
+                             });
   if (res == 0) {
     populate_stat(r_stat, directory, *u_stat);
   }
@@ -293,8 +321,10 @@ auto remote_fuse_drive::init_impl(struct fuse_conn_info *conn) -> void * {
 
 auto remote_fuse_drive::mkdir_impl(std::string api_path, mode_t mode)
     -> api_error {
-  return utils::to_api_error(remote_instance_->fuse_mkdir(
-      api_path.c_str(), static_cast<remote::file_mode>(mode)));
+  auto res = remote_instance_->fuse_mkdir(
+      api_path.c_str(), static_cast<remote::file_mode>(mode));
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 
 void remote_fuse_drive::notify_fuse_main_exit(int &ret) {
@@ -311,10 +341,15 @@ void remote_fuse_drive::notify_fuse_main_exit(int &ret) {
 
 auto remote_fuse_drive::open_impl(std::string api_path,
                                   struct fuse_file_info *f_info) -> api_error {
-  return utils::to_api_error(remote_instance_->fuse_open(
+  auto res = remote_instance_->fuse_open(
       api_path.c_str(),
       remote::create_open_flags(static_cast<std::uint32_t>(f_info->flags)),
-      f_info->fh));
+      f_info->fh);
+  if ((f_info->flags & O_TRUNC) == O_TRUNC) {
+    cache_.invalidate(api_path);
+  }
+
+  return utils::to_api_error(res);
 }
 
 auto remote_fuse_drive::opendir_impl(std::string api_path,
@@ -385,9 +420,14 @@ auto remote_fuse_drive::read_impl(std::string api_path, char *buffer,
                                   size_t read_size, off_t read_offset,
                                   struct fuse_file_info *f_info,
                                   std::size_t &bytes_read) -> api_error {
-  auto res = remote_instance_->fuse_read(
-      api_path.c_str(), buffer, read_size,
-      static_cast<remote::file_offset>(read_offset), f_info->fh);
+  auto res = cache_.read(
+      api_path, f_info->fh, buffer, read_size,
+      static_cast<remote::file_offset>(read_offset),
+      [this, &api_path, &f_info](char *data, remote::file_size size,
+                                 remote::file_offset offset) {
+        return remote_instance_->fuse_read(api_path.c_str(), data, size,
+                                           offset, f_info->fh);
+      });
   if (res >= 0) {
     bytes_read = static_cast<size_t>(res);
     return api_error::success;
@@ -411,8 +451,73 @@ auto remote_fuse_drive::readdir_impl(std::string api_path, void *buf,
     -> api_error {
 #endif // FUSE_USE_VERSION >= 30
 
+  // Servers that negotiated it return a page of entries with attributes per
+  // round trip. The attributes are handed to the kernel and cached so the
+  // lookups that follow a listing are answered locally.
+  std::vector<remote::directory_entry> entries;
+  auto generation{cache_.get_generation()};
+  int res = remote_instance_->fuse_readdir_plus(
+      api_path.c_str(), static_cast<remote::file_offset>(offset), f_info->fh,
+      readdir_page_size, entries);
+  if (res != -ENOTSUP) {
+    auto is_full{false};
+    while (res == 0 && not is_full) {
+      for (const auto &entry : entries) {
+        struct stat u_stat{};
+        auto *p_stat{&u_stat};
+        auto item_path{entry.item_path};
+        auto is_dots{item_path == "." || item_path == ".."};
+        if (item_path == ".." && api_path == "/" &&
+            get_mount_location() != "/") {
+          res = stat(utils::path::get_parent_path(get_mount_location()).c_str(),
+                     p_stat);
+        } else if (entry.res == 0) {
+          populate_stat(entry.r_stat, entry.directory, u_stat);
+          if (item_path != "..") {
+            cache_.set_attr(item_path == "." ? api_path : item_path,
+                            generation, entry.r_stat, entry.directory);
+          }
+        } else if (is_dots) {
+          res = entry.res;
+        } else {
+          p_stat = nullptr;
+        }
+
+        if (res != 0) {
+          break;
+        }
+
+        if (not is_dots) {
+          item_path = utils::path::strip_to_file_name(item_path);
+        }
+
+#if FUSE_USE_VERSION >= 30
+        if (fuse_fill_dir(buf, item_path.c_str(), p_stat, ++offset,
+                          FUSE_FILL_DIR_PLUS) != 0) {
+#else  // FUSE_USE_VERSION < 30
+        if (fuse_fill_dir(buf, item_path.c_str(), p_stat, ++offset) != 0) {
+#endif // FUSE_USE_VERSION >= 30
+          is_full = true;
+          break;
+        }
+      }
+
+      if (res == 0 && not is_full) {
+        generation = cache_.get_generation();
+        res = remote_instance_->fuse_readdir_plus(
+            api_path.c_str(), static_cast<remote::file_offset>(offset),
+            f_info->fh, readdir_page_size, entries);
+      }
+    }
+
+    if (res == -120) {
+      res = 0;
+    }
+
+    return utils::to_api_error(res);
+  }
+
   std::string item_path;
-  int res{0};
   while ((res = remote_instance_->fuse_readdir(
               api_path.c_str(), static_cast<remote::file_offset>(offset),
               f_info->fh, item_path)) == 0) {
@@ -473,6 +578,7 @@ auto remote_fuse_drive::readdir_impl(std::string api_path, void *buf,
 auto remote_fuse_drive::release_impl(std::string api_path,
                                      struct fuse_file_info *f_info)
     -> api_error {
+  cache_.release(f_info->fh);
   return utils::to_api_error(
       remote_instance_->fuse_release(api_path.c_str(), f_info->fh));
 }
@@ -492,12 +598,17 @@ auto remote_fuse_drive::rename_impl(std::string from_api_path,
 auto remote_fuse_drive::rename_impl(std::string from_api_path,
                                     std::string to_api_path) -> api_error {
 #endif // FUSE_USE_VERSION >= 30
-  return utils::to_api_error(remote_instance_->fuse_rename(
-      from_api_path.c_str(), to_api_path.c_str()));
+  auto res = remote_instance_->fuse_rename(from_api_path.c_str(),
+                                          to_api_path.c_str());
+  cache_.invalidate(from_api_path, true);
+  cache_.invalidate(to_api_path, true);
+  return utils::to_api_error(res);
 }
 
 auto remote_fuse_drive::rmdir_impl(std::string api_path) -> api_error {
-  return utils::to_api_error(remote_instance_->fuse_rmdir(api_path.c_str()));
+  auto res = remote_instance_->fuse_rmdir(api_path.c_str());
+  cache_.invalidate(api_path, true);
+  return utils::to_api_error(res);
 }
 
 #if defined(__APPLE__)
@@ -538,8 +649,9 @@ auto remote_fuse_drive::setattr_x_impl(std::string api_path,
         utils::time::NANOS_PER_SECOND) +
        static_cast<remote::file_time>(attr->bkuptime.tv_nsec));
   attributes.flags = attr->flags;
-  return utils::to_api_error(
-      remote_instance_->fuse_setattr_x(api_path.c_str(), attributes));
+  auto res = remote_instance_->fuse_setattr_x(api_path.c_str(), attributes);
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 
 auto remote_fuse_drive::setbkuptime_impl(std::string api_path,
@@ -549,8 +661,10 @@ auto remote_fuse_drive::setbkuptime_impl(std::string api_path,
       ((static_cast<remote::file_time>(bkuptime->tv_sec) *
         utils::time::NANOS_PER_SECOND) +
        static_cast<remote::file_time>(bkuptime->tv_nsec));
-  return utils::to_api_error(
-      remote_instance_->fuse_setbkuptime(api_path.c_str(), repertory_bkuptime));
+  auto res =
+      remote_instance_->fuse_setbkuptime(api_path.c_str(), repertory_bkuptime);
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 
 auto remote_fuse_drive::setchgtime_impl(std::string api_path,
@@ -560,8 +674,10 @@ auto remote_fuse_drive::setchgtime_impl(std::string api_path,
       ((static_cast<remote::file_time>(chgtime->tv_sec) *
         utils::time::NANOS_PER_SECOND) +
        static_cast<remote::file_time>(chgtime->tv_nsec));
-  return utils::to_api_error(
-      remote_instance_->fuse_setchgtime(api_path.c_str(), repertory_chgtime));
+  auto res =
+      remote_instance_->fuse_setchgtime(api_path.c_str(), repertory_chgtime);
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 
 auto remote_fuse_drive::setcrtime_impl(std::string api_path,
@@ -571,8 +687,10 @@ auto remote_fuse_drive::setcrtime_impl(std::string api_path,
       ((static_cast<remote::file_time>(crtime->tv_sec) *
         utils::time::NANOS_PER_SECOND) +
        static_cast<remote::file_time>(crtime->tv_nsec));
-  return utils::to_api_error(
-      remote_instance_->fuse_setcrtime(api_path.c_str(), repertory_crtime));
+  auto res =
+      remote_instance_->fuse_setcrtime(api_path.c_str(), repertory_crtime);
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 
 auto remote_fuse_drive::setvolname_impl(const char *volname) -> api_error {
@@ -634,12 +752,16 @@ auto remote_fuse_drive::truncate_impl(std::string api_path, off_t size,
 auto remote_fuse_drive::truncate_impl(std::string api_path, off_t size)
     -> api_error {
 #endif // FUSE_USE_VERSION >= 30
-  return utils::to_api_error(remote_instance_->fuse_truncate(
-      api_path.c_str(), static_cast<remote::file_offset>(size)));
+  auto res = remote_instance_->fuse_truncate(
+      api_path.c_str(), static_cast<remote::file_offset>(size));
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 
 auto remote_fuse_drive::unlink_impl(std::string api_path) -> api_error {
-  return utils::to_api_error(remote_instance_->fuse_unlink(api_path.c_str()));
+  auto res = remote_instance_->fuse_unlink(api_path.c_str());
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 
 #if FUSE_USE_VERSION >= 30
@@ -673,10 +795,12 @@ auto remote_fuse_drive::utimens_impl(std::string api_path,
     update_timespec(rtv[1U], tv[1U]);
   }
 
-  return utils::to_api_error(remote_instance_->fuse_utimens(
+  auto res = remote_instance_->fuse_utimens(
       api_path.c_str(), &rtv[0U],
       static_cast<std::uint64_t>(tv == nullptr ? 0 : tv[0U].tv_nsec),
-      static_cast<std::uint64_t>(tv == nullptr ? 0 : tv[1U].tv_nsec)));
+      static_cast<std::uint64_t>(tv == nullptr ? 0 : tv[1U].tv_nsec));
+  cache_.invalidate(api_path);
+  return utils::to_api_error(res);
 }
 
 auto remote_fuse_drive::write_impl(std::string api_path, const char *buffer,
@@ -686,6 +810,7 @@ auto remote_fuse_drive::write_impl(std::string api_path, const char *buffer,
   auto res = remote_instance_->fuse_write(
       api_path.c_str(), buffer, write_size,
       static_cast<remote::file_offset>(write_offset), f_info->fh);
+  cache_.invalidate(api_path);
   if (res >= 0) {
     bytes_written = static_cast<std::size_t>(res);
     return api_error::success;
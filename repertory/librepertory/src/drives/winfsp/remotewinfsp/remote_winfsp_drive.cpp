@@ -228,7 +228,8 @@ auto remote_winfsp_drive::Init(PVOID host) -> NTSTATUS {
 
   file_system_host->SetCasePreservedNames(TRUE);
   file_system_host->SetCaseSensitiveSearch(TRUE);
-  file_system_host->SetFileInfoTimeout(1000);
+  file_system_host->SetFileInfoTimeout(
+      static_cast<UINT32>(config_.get_kernel_attr_timeout_secs()) * 1000U);
   file_system_host->SetFlushAndPurgeOnCleanup(TRUE);
   file_system_host->SetMaxComponentLength(255U);
   file_system_host->SetNamedStreams(FALSE);
@@ -86,6 +86,13 @@ auto winfsp_drive::handle_error(std::string_view function_name,
     return ret;
   }
 
+  std::shared_ptr<i_open_file> open_file;
+  if (fm_->get_open_file(api_path, open_file)) {
+    for (const auto &[key, value] : open_file->get_pending_meta()) {
+      meta[key] = value;
+    }
+  }
+
   populate_file_info(file_size, meta, *file_info);
   return ret;
 }
@@ -223,6 +230,8 @@ VOID winfsp_drive::Cleanup(PVOID file_node, PVOID file_desc,
     return handle_error(fm_->remove_file(api_path));
   }
 
+  std::ignore = file->flush_pending_meta();
+
   if (((flags & FspCleanupSetArchiveBit) != 0U) && not directory) {
     api_meta_map meta;
     if (provider_.get_item_meta(api_path, meta) == api_error::success) {
@@ -386,6 +395,13 @@ auto winfsp_drive::Flush(PVOID /*file_node*/, PVOID file_desc,
   }
 
   api_path = file->get_api_path();
+  auto res = file->flush_pending_meta();
+  if (res != api_error::success) {
+    return handle_error(res);
+  }
+
+  file->set_sync_requested(true);
+
   return handle_error(file->native_operation([&](native_handle op_handle) {
     if (::FlushFileBuffers(op_handle) == 0) {
       return api_error::os_error;
@@ -569,7 +585,8 @@ auto winfsp_drive::Init(PVOID host) -> NTSTATUS {
 
   file_system_host->SetCasePreservedNames(TRUE);
   file_system_host->SetCaseSensitiveSearch(TRUE);
-  file_system_host->SetFileInfoTimeout(1000);
+  file_system_host->SetFileInfoTimeout(
+      static_cast<UINT32>(config_.get_kernel_attr_timeout_secs()) * 1000U);
   file_system_host->SetFlushAndPurgeOnCleanup(TRUE);
   file_system_host->SetMaxComponentLength(255U);
   file_system_host->SetNamedStreams(FALSE);
@@ -641,7 +658,7 @@ auto winfsp_drive::Mounted(PVOID host) -> NTSTATUS {
     fm_ = std::make_unique<file_manager>(config_, provider_);
     server_ = std::make_unique<full_server>(config_, provider_, *fm_);
     if (not provider_.is_read_only()) {
-      eviction_ = std::make_unique<eviction>(provider_, config_, *fm_);
+      eviction_ = std::make_unique<eviction>(config_, *fm_);
     }
 
     server_->start();
@@ -867,23 +884,21 @@ auto winfsp_drive::Read(PVOID /*file_node*/, PVOID file_desc, PVOID buffer,
     return handle_error(api_error::success);
   }
 
-  data_buffer data;
-  auto res = file->read(length, offset, data);
+  std::size_t bytes_read{};
+  auto res = file->read(
+      offset, data_span{reinterpret_cast<unsigned char *>(buffer), length},
+      bytes_read);
   if (res != api_error::success) {
     return handle_error(res);
   }
 
-  *bytes_transferred = static_cast<ULONG>(data.size());
-
-  auto short_read = data.size() != length;
+  *bytes_transferred = static_cast<ULONG>(bytes_read);
 
-  if (not data.empty()) {
-    ::CopyMemory(buffer, data.data(), data.size());
-    data.clear();
-  }
+  auto short_read = bytes_read != length;
 
-  auto ret = handle_error(provider_.set_item_meta(
-      api_path, META_ACCESSED, std::to_string(utils::time::get_time_now())));
+  auto ret = handle_error(file->set_pending_meta({
+      {META_ACCESSED, std::to_string(utils::time::get_time_now())},
+  }));
 
   if (short_read) {
     ::SetLastError(ERROR_HANDLE_EOF);
@@ -1271,10 +1286,10 @@ auto winfsp_drive::Write(PVOID /*file_node*/, PVOID file_desc, PVOID buffer,
   }
 
   std::size_t bytes_written{};
-  data_buffer data(length);
-  std::memcpy(data.data(), buffer, length);
-
-  auto res = file->write(offset, data, bytes_written);
+  auto res = file->write(
+      offset,
+      data_cspan{reinterpret_cast<const unsigned char *>(buffer), length},
+      bytes_written);
   if (res != api_error::success) {
     return handle_error(res);
   }
@@ -62,9 +62,11 @@ console_consumer::console_consumer(event_level level) {
 
   set_level(level);
 
-  E_SUBSCRIBE_ALL(process_event);
-  E_SUBSCRIBE(event_level_changed,
-                    [](auto &&event) { set_level(event.new_level); });
+  E_SUBSCRIBE_ALL(process_event, level);
+  E_SUBSCRIBE(event_level_changed, [this](auto &&event) {
+    set_level(event.new_level);
+    event_consumers_.front()->set_level(event.new_level);
+  });
 }
 
 console_consumer::~console_consumer() { E_CONSUMER_RELEASE(); }
@@ -0,0 +1,72 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "events/event_queue.hpp"
+
+#include "events/i_event.hpp"
+
+namespace repertory {
+event_queue::event_queue(std::size_t capacity)
+    : mask_(std::bit_ceil(std::max(capacity, std::size_t{2U})) - 1U),
+      cells_(std::make_unique<cell[]>(mask_ + 1U)) {
+  for (std::size_t idx = 0U; idx <= mask_; ++idx) {
+    cells_[idx].sequence.store(idx, std::memory_order_relaxed);
+  }
+}
+
+auto event_queue::pop(std::shared_ptr<i_event> &evt) -> bool {
+  auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+  auto &item = cells_[pos & mask_];
+  if (item.sequence.load(std::memory_order_acquire) != pos + 1U) {
+    return false;
+  }
+
+  evt = std::move(item.evt);
+  item.sequence.store(pos + mask_ + 1U, std::memory_order_release);
+  dequeue_pos_.store(pos + 1U, std::memory_order_relaxed);
+  return true;
+}
+
+auto event_queue::push(std::shared_ptr<i_event> evt) -> bool {
+  auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    auto &item = cells_[pos & mask_];
+    auto diff = static_cast<std::ptrdiff_t>(
+                    item.sequence.load(std::memory_order_acquire)) -
+                static_cast<std::ptrdiff_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1U,
+                                             std::memory_order_relaxed)) {
+        item.evt = std::move(evt);
+        item.sequence.store(pos + 1U, std::memory_order_release);
+        return true;
+      }
+      continue;
+    }
+
+    if (diff < 0) {
+      return false;
+    }
+
+    pos = enqueue_pos_.load(std::memory_order_relaxed);
+  }
+}
+} // namespace repertory
@@ -21,145 +21,218 @@
 */
 #include "events/event_system.hpp"
 
-#include "app_config.hpp"
+#include "events/event_queue.hpp"
 #include "events/i_event.hpp"
 #include "utils/collection.hpp"
+#include "utils/error_utils.hpp"
 
 namespace repertory {
-event_system event_system::instance_{};
+struct event_system::consumer_data final {
+  consumer_data(event_consumer *consumer_, bool check_level_)
+      : check_level(check_level_), consumer(consumer_) {}
 
-auto event_system::instance() -> event_system & { return instance_; }
+  bool check_level;
+  event_consumer *consumer;
+  std::atomic<bool> released{false};
+};
 
-void event_system::attach(event_consumer *consumer) {
-  recur_mutex_lock lock(consumer_mutex_);
-  event_consumers_[""].push_back(consumer);
+event_system::~event_system() { stop(); }
+
+auto event_system::instance() -> event_system & {
+  static event_system instance{};
+  return instance;
 }
 
-void event_system::attach(std::string_view event_name,
-                          event_consumer *consumer) {
-  recur_mutex_lock lock(consumer_mutex_);
-  event_consumers_[std::string{event_name}].push_back(consumer);
+void event_system::add_consumer(std::string_view event_name,
+                                event_consumer *consumer) {
+  auto data = std::make_shared<consumer_data>(consumer, event_name.empty());
+
+  {
+    std::unique_lock lock(consumer_mutex_);
+    event_consumers_[std::string{event_name}].push_back(data);
+  }
+
+  update_level();
 }
 
-auto event_system::get_stop_requested() const -> bool {
-  return stop_requested_ || app_config::get_stop_requested();
+void event_system::attach(event_consumer *consumer) {
+  add_consumer("", consumer);
 }
 
-void event_system::process_events() {
-  unique_mutex_lock lock(event_mutex_);
-  const auto lock_and_notify = [this, &lock]() {
-    lock.lock();
-    event_notify_.notify_all();
-    lock.unlock();
-  };
+void event_system::attach(std::string_view event_name,
+                          event_consumer *consumer) {
+  add_consumer(event_name, consumer);
+}
 
-  if (not get_stop_requested() && event_list_.empty()) {
-    event_notify_.wait_for(lock, queue_wait_secs);
-  }
+void event_system::dispatch(const i_event &evt) {
+  REPERTORY_USES_FUNCTION_NAME();
 
-  std::vector<std::shared_ptr<i_event>> event_list;
-  std::swap(event_list, event_list_);
-  lock.unlock();
+  mutex_lock dispatch_lock(dispatch_mtx_);
 
-  if (event_list.empty()) {
-    lock_and_notify();
-    return;
+  std::vector<std::shared_ptr<consumer_data>> consumers;
+  {
+    std::shared_lock lock(consumer_mutex_);
+    for (const auto &name : {std::string_view{}, evt.get_name()}) {
+      auto iter = event_consumers_.find(name);
+      if (iter != event_consumers_.end()) {
+        consumers.insert(consumers.end(), iter->second.begin(),
+                         iter->second.end());
+      }
+    }
   }
 
-  const auto notify_events = [this](std::string_view name,
-                                    const i_event &event) {
-    std::deque<std::future<void>> futures;
-    recur_mutex_lock consumer_lock(consumer_mutex_);
-    for (auto *consumer : event_consumers_[std::string{name}]) {
-      futures.emplace_back(std::async(std::launch::async, [consumer, &event]() {
-        consumer->notify_event(event);
-      }));
+  for (const auto &data : consumers) {
+    // A consumer may be released by one dispatched before it
+    if (data->released ||
+        (data->check_level &&
+         evt.get_event_level() > data->consumer->get_level())) {
+      continue;
     }
 
-    while (not futures.empty()) {
-      futures.front().get();
-      futures.pop_front();
+    try {
+      data->consumer->notify_event(evt);
+    } catch (const std::exception &e) {
+      utils::error::raise_error(function_name, e,
+                                "event consumer raised an exception");
     }
-  };
+  }
+}
 
-  for (const auto &evt : event_list) {
-    notify_events("", *evt);
-    notify_events(evt->get_name(), *evt);
+auto event_system::is_dispatch_thread() const -> bool {
+  return dispatch_thread_id_.load() == std::this_thread::get_id();
+}
+
+auto event_system::is_subscribed(std::string_view event_name,
+                                 event_level level) -> bool {
+  if (static_cast<std::int32_t>(level) <= all_level_) {
+    return true;
   }
 
-  lock_and_notify();
+  std::shared_lock lock(consumer_mutex_);
+  auto iter = event_consumers_.find(event_name);
+  return iter != event_consumers_.end() && not iter->second.empty();
+}
+
+void event_system::notify() {
+  ++signal_;
+  signal_.notify_one();
 }
 
 void event_system::queue_event(std::shared_ptr<i_event> evt) {
-  unique_mutex_lock lock(event_mutex_);
-  event_list_.push_back(std::move(evt));
-  auto size = event_list_.size();
-  event_notify_.notify_all();
-  lock.unlock();
-
-  for (std::uint8_t retry{0U};
-       size > max_queue_size && retry < max_queue_retry &&
-       not get_stop_requested();
-       ++retry) {
-    lock.lock();
-    size = event_list_.size();
-    if (size > max_queue_size) {
-      event_notify_.wait_for(lock, queue_wait_secs);
-      size = event_list_.size();
+  if (not queue_.push(std::move(evt))) {
+    ++dropped_count_;
+    return;
+  }
+
+  ++pushed_;
+  notify();
+}
+
+void event_system::release(event_consumer *consumer) {
+  std::shared_ptr<consumer_data> data;
+  {
+    std::unique_lock lock(consumer_mutex_);
+    for (auto &item : event_consumers_) {
+      auto iter = std::ranges::find_if(
+          item.second,
+          [consumer](auto &&entry) { return entry->consumer == consumer; });
+      if (iter == item.second.end()) {
+        continue;
+      }
+
+      data = *iter;
+      item.second.erase(iter);
+      break;
     }
+  }
+
+  if (not data) {
+    return;
+  }
+
+  data->released = true;
+  update_level();
 
-    event_notify_.notify_all();
-    lock.unlock();
+  // Wait for an in-flight delivery so the consumer is never called after it
+  // has been destroyed
+  if (not is_dispatch_thread()) {
+    mutex_lock dispatch_lock(dispatch_mtx_);
   }
 }
 
-void event_system::release(event_consumer *consumer) {
-  recur_mutex_lock lock(consumer_mutex_);
-  auto iter =
-      std::ranges::find_if(event_consumers_, [&consumer](auto &&item) -> bool {
-        return utils::collection::includes(item.second, consumer);
-      });
+void event_system::run() {
+  dispatch_thread_id_ = std::this_thread::get_id();
 
-  if (iter != event_consumers_.end()) {
-    utils::collection::remove_element(iter->second, consumer);
+  while (not stop_requested_) {
+    auto current = signal_.load();
+
+    std::shared_ptr<i_event> evt;
+    if (not queue_.pop(evt)) {
+      {
+        mutex_lock drain_lock(drain_mtx_);
+        drain_notify_.notify_all();
+      }
+
+      signal_.wait(current);
+      continue;
+    }
+
+    dispatch(*evt);
+    ++processed_;
   }
+
+  dispatch_thread_id_ = std::thread::id{};
 }
 
 void event_system::start() {
-  mutex_lock lock(run_mutex_);
-  if (event_thread_) {
-    event_notify_.notify_all();
+  mutex_lock run_lock(run_mtx_);
+  if (dispatch_thread_) {
     return;
   }
 
   stop_requested_ = false;
-
-  event_thread_ = std::make_unique<std::thread>([this]() {
-    while (not get_stop_requested()) {
-      process_events();
-    }
-  });
-  event_notify_.notify_all();
+  dispatch_thread_ = std::make_unique<std::thread>([this]() { run(); });
 }
 
 void event_system::stop() {
-  unique_mutex_lock lock(run_mutex_);
-  if (not event_thread_) {
-    event_notify_.notify_all();
+  mutex_lock run_lock(run_mtx_);
+  if (not dispatch_thread_) {
+    return;
+  }
+
+  if (is_dispatch_thread()) {
+    stop_requested_ = true;
+    dispatch_thread_->detach();
+    dispatch_thread_.reset();
     return;
   }
 
+  {
+    unique_mutex_lock drain_lock(drain_mtx_);
+    drain_notify_.wait_for(drain_lock, queue_wait_secs, [this]() -> bool {
+      return processed_ >= pushed_;
+    });
+  }
+
   stop_requested_ = true;
+  notify();
 
-  std::unique_ptr<std::thread> thread{nullptr};
-  std::swap(thread, event_thread_);
+  dispatch_thread_->join();
+  dispatch_thread_.reset();
+}
 
-  event_notify_.notify_all();
-  lock.unlock();
+void event_system::update_level() {
+  std::int32_t level{-1};
 
-  thread->join();
-  thread.reset();
+  std::unique_lock lock(consumer_mutex_);
+  auto iter = event_consumers_.find(std::string_view{});
+  if (iter != event_consumers_.end()) {
+    for (const auto &data : iter->second) {
+      level = std::max(level,
+                       static_cast<std::int32_t>(data->consumer->get_level()));
+    }
+  }
 
-  process_events();
+  all_level_ = level;
 }
 } // namespace repertory
@@ -0,0 +1,182 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "file_manager/access_pattern.hpp"
+
+#include "types/repertory.hpp"
+
+namespace repertory {
+auto access_pattern::classify(const stream &item, std::uint64_t offset,
+                              std::size_t size) const -> std::optional<type> {
+  // Small forward gaps and overlaps still count as sequential; the kernel
+  // splits and reorders large reads
+  if ((offset >= item.offset) && (offset <= item.end + chunk_size_)) {
+    return type::sequential;
+  }
+
+  if ((offset < item.offset) && (offset + size + chunk_size_ >= item.offset)) {
+    return type::reverse;
+  }
+
+  auto delta =
+      static_cast<std::int64_t>(offset) - static_cast<std::int64_t>(item.offset);
+  if ((item.stride != 0) && (delta == item.stride)) {
+    return type::strided;
+  }
+
+  return std::nullopt;
+}
+
+auto access_pattern::get_window_chunks(const stream &item,
+                                       std::size_t chunk_count) const
+    -> std::vector<std::size_t> {
+  std::vector<std::size_t> chunks;
+  if ((item.window == 0U) || (chunk_count == 0U)) {
+    return chunks;
+  }
+
+  auto begin_chunk = static_cast<std::size_t>(item.offset / chunk_size_);
+  auto end_chunk = static_cast<std::size_t>(
+      (item.end > item.offset ? item.end - 1U : item.offset) / chunk_size_);
+
+  switch (item.pattern) {
+  case type::sequential: {
+    for (auto chunk = end_chunk + 1U;
+         (chunk < chunk_count) && (chunks.size() < item.window); ++chunk) {
+      chunks.push_back(chunk);
+    }
+  } break;
+
+  case type::reverse: {
+    for (std::size_t idx = 1U; (idx <= item.window) && (idx <= begin_chunk);
+         ++idx) {
+      chunks.push_back(begin_chunk - idx);
+    }
+  } break;
+
+  case type::strided: {
+    auto size = item.end - item.offset;
+    auto next = static_cast<std::int64_t>(item.offset);
+    for (std::size_t idx = 0U; idx < item.window; ++idx) {
+      next += item.stride;
+      if (next < 0) {
+        break;
+      }
+
+      auto chunk = static_cast<std::size_t>(
+          static_cast<std::uint64_t>(next) / chunk_size_);
+      if (chunk >= chunk_count) {
+        break;
+      }
+
+      auto last_chunk = std::min(
+          chunk_count - 1U,
+          static_cast<std::size_t>(
+              (static_cast<std::uint64_t>(next) + std::max(size, std::uint64_t{1U}) - 1U) /
+              chunk_size_));
+      for (; chunk <= last_chunk; ++chunk) {
+        if (((chunk < begin_chunk) || (chunk > end_chunk)) &&
+            (std::find(chunks.begin(), chunks.end(), chunk) == chunks.end())) {
+          chunks.push_back(chunk);
+        }
+      }
+    }
+  } break;
+
+  case type::random:
+    break;
+  }
+
+  return chunks;
+}
+
+auto access_pattern::record(std::uint64_t offset, std::size_t size,
+                            std::size_t chunk_count)
+    -> std::vector<std::size_t> {
+  ++sequence_;
+
+  auto iter = std::find_if(streams_.begin(), streams_.end(),
+                           [this, &offset, &size](const stream &item) -> bool {
+                             return classify(item, offset, size).has_value();
+                           });
+  if (iter == streams_.end()) {
+    // Seeding the stride from the most recent stream lets the next read
+    // confirm a constant stride
+    std::int64_t stride{};
+    auto recent = std::max_element(
+        streams_.begin(), streams_.end(),
+        [](const stream &item1, const stream &item2) -> bool {
+          return item1.last_used < item2.last_used;
+        });
+    if (recent != streams_.end()) {
+      stride = static_cast<std::int64_t>(offset) -
+               static_cast<std::int64_t>(recent->offset);
+    }
+
+    if (streams_.size() < max_streams) {
+      iter = streams_.emplace(streams_.end());
+    } else {
+      iter = std::min_element(
+          streams_.begin(), streams_.end(),
+          [](const stream &item1, const stream &item2) -> bool {
+            return item1.last_used < item2.last_used;
+          });
+    }
+
+    *iter = stream{
+        .offset = offset,
+        .end = offset + size,
+        .stride = stride,
+        .last_used = sequence_,
+    };
+    last_type_ = type::random;
+    return {};
+  }
+
+  auto &item = *iter;
+  auto pattern = classify(item, offset, size).value();
+  if (pattern == item.pattern) {
+    ++item.hits;
+  } else {
+    item.pattern = pattern;
+    item.hits = 1U;
+    item.window /= 2U;
+  }
+
+  // The window doubles once per chunk crossed so small reads within a large
+  // chunk do not inflate it
+  auto new_chunk = (offset / chunk_size_) != (item.offset / chunk_size_);
+  if ((item.hits >= min_hits) && ((item.window == 0U) || new_chunk)) {
+    item.window = std::min(max_window_, std::max(std::size_t{1U},
+                                                 item.window * 2U));
+  }
+
+  item.stride =
+      static_cast<std::int64_t>(offset) - static_cast<std::int64_t>(item.offset);
+  item.offset = offset;
+  item.end = offset + size;
+  item.last_used = sequence_;
+
+  last_type_ = item.hits >= min_hits ? item.pattern : type::random;
+  return last_type_ == type::random ? std::vector<std::size_t>{}
+                                    : get_window_chunks(item, chunk_count);
+}
+} // namespace repertory
@@ -0,0 +1,112 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "file_manager/cache_index.hpp"
+
+namespace repertory {
+void cache_index::clear() {
+  mutex_lock lock(mtx_);
+  entries_.clear();
+  lookup_.clear();
+}
+
+auto cache_index::contains(std::string_view source_path) const -> bool {
+  mutex_lock lock(mtx_);
+  return lookup_.contains(std::string{source_path});
+}
+
+void cache_index::load(std::vector<entry> entries) {
+  std::ranges::stable_sort(entries,
+                           [](const entry &entry1, const entry &entry2) {
+                             return entry1.accessed < entry2.accessed;
+                           });
+
+  mutex_lock lock(mtx_);
+  entries_.clear();
+  lookup_.clear();
+
+  for (auto &item : entries) {
+    auto iter = lookup_.find(item.source_path);
+    if (iter != lookup_.end()) {
+      iter->second->accessed = item.accessed;
+      entries_.splice(entries_.end(), entries_, iter->second);
+      continue;
+    }
+
+    entries_.push_back(std::move(item));
+    lookup_[entries_.back().source_path] = std::prev(entries_.end());
+  }
+}
+
+auto cache_index::pop(std::size_t count, std::uint64_t max_accessed)
+    -> std::vector<entry> {
+  mutex_lock lock(mtx_);
+
+  std::vector<entry> ret;
+  auto remaining{entries_.size()};
+  while (remaining-- != 0U && ret.size() < count) {
+    auto iter = entries_.begin();
+    if (iter->accessed > max_accessed) {
+      break;
+    }
+
+    ret.push_back(*iter);
+    entries_.splice(entries_.end(), entries_, iter);
+  }
+
+  return ret;
+}
+
+auto cache_index::remove(std::string_view source_path) -> bool {
+  mutex_lock lock(mtx_);
+
+  auto iter = lookup_.find(std::string{source_path});
+  if (iter == lookup_.end()) {
+    return false;
+  }
+
+  entries_.erase(iter->second);
+  lookup_.erase(iter);
+  return true;
+}
+
+auto cache_index::size() const -> std::size_t {
+  mutex_lock lock(mtx_);
+  return entries_.size();
+}
+
+void cache_index::touch(std::string_view source_path, std::uint64_t accessed) {
+  mutex_lock lock(mtx_);
+
+  auto iter = lookup_.find(std::string{source_path});
+  if (iter == lookup_.end()) {
+    entries_.push_back(entry{
+        .source_path = std::string{source_path},
+        .accessed = accessed,
+    });
+    lookup_[entries_.back().source_path] = std::prev(entries_.end());
+    return;
+  }
+
+  iter->second->accessed = accessed;
+  entries_.splice(entries_.end(), entries_, iter->second);
+}
+} // namespace repertory
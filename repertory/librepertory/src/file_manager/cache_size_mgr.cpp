@@ -23,6 +23,7 @@
 
 #include "app_config.hpp"
 #include "events/event_system.hpp"
+#include "events/types/cache_stall_ended.hpp"
 #include "events/types/invalid_cache_size.hpp"
 #include "events/types/max_cache_size_reached.hpp"
 #include "types/startup_exception.hpp"
@@ -46,32 +47,96 @@ auto cache_size_mgr::expand(std::uint64_t size) -> api_error {
     return api_error::success;
   }
 
-  auto last_cache_size{cache_size_};
   cache_size_ += size;
 
-  auto cache_dir{
-      utils::file::directory{cfg_->get_cache_directory()},
+  if (cache_size_ < get_watermark(high_watermark_percent)) {
+    notify_.notify_all();
+    return api_error::success;
+  }
+
+  lock.unlock();
+  notify_pressure();
+  lock.lock();
+
+  const auto is_over_max = [this]() -> bool {
+    return cache_size_ > cfg_->get_max_cache_size_bytes();
   };
-  while (not get_stop_requested() &&
-         cache_size_ > cfg_->get_max_cache_size_bytes() &&
-         cache_dir.count() > 1U) {
-    if (last_cache_size != cache_size_) {
-      event_system::instance().raise<max_cache_size_reached>(
-          cache_size_, function_name, cfg_->get_max_cache_size_bytes());
-      last_cache_size = cache_size_;
+
+  if (not is_over_max() ||
+      utils::file::directory{cfg_->get_cache_directory()}.count() <= 1U) {
+    notify_.notify_all();
+    return get_stop_requested() ? api_error::error : api_error::success;
+  }
+
+  event_system::instance().raise<max_cache_size_reached>(
+      cache_size_, function_name, cfg_->get_max_cache_size_bytes());
+
+  auto start{std::chrono::steady_clock::now()};
+  auto deadline{start + max_stall_secs};
+  while (not get_stop_requested() && is_over_max() &&
+         std::chrono::steady_clock::now() < deadline) {
+    auto woken = notify_.wait_until(
+        lock, std::min(deadline, std::chrono::steady_clock::now() +
+                                     cache_wait_secs));
+    if (woken == std::cv_status::timeout) {
+      lock.unlock();
+      notify_pressure();
+      lock.lock();
     }
-    notify_.wait_for(lock, cache_wait_secs);
   }
 
+  auto stall_ms{
+      static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count()),
+  };
+  auto timed_out{not get_stop_requested() && is_over_max()};
+
+  ++stats_.stall_count;
+  stats_.stall_ms += stall_ms;
+  stats_.max_stall_ms = std::max(stats_.max_stall_ms, stall_ms);
+  if (timed_out) {
+    ++stats_.stall_timeout_count;
+  }
+
+  event_system::instance().raise<cache_stall_ended>(
+      cache_size_, function_name, cfg_->get_max_cache_size_bytes(), stall_ms,
+      timed_out);
+
   notify_.notify_all();
 
   return get_stop_requested() ? api_error::error : api_error::success;
 }
 
+auto cache_size_mgr::get_stats() const -> stats {
+  mutex_lock lock(mtx_);
+  return stats_;
+}
+
 auto cache_size_mgr::get_stop_requested() const -> bool {
   return stop_requested_ || app_config::get_stop_requested();
 }
 
+auto cache_size_mgr::get_high_watermark() const -> std::uint64_t {
+  mutex_lock lock(mtx_);
+  return get_watermark(high_watermark_percent);
+}
+
+auto cache_size_mgr::get_low_watermark() const -> std::uint64_t {
+  mutex_lock lock(mtx_);
+  return get_watermark(low_watermark_percent);
+}
+
+auto cache_size_mgr::get_watermark(std::uint64_t percent) const
+    -> std::uint64_t {
+  if (cfg_ == nullptr) {
+    return std::numeric_limits<std::uint64_t>::max();
+  }
+
+  return cfg_->get_max_cache_size_bytes() / 100U * percent;
+}
+
 void cache_size_mgr::initialize(app_config *cfg) {
   if (cfg == nullptr) {
     throw startup_exception("app_config must not be null");
@@ -95,12 +160,39 @@ void cache_size_mgr::initialize(app_config *cfg) {
   notify_.notify_all();
 }
 
+void cache_size_mgr::notify_pressure() {
+  mutex_lock lock(pressure_mtx_);
+  if (pressure_callback_) {
+    pressure_callback_();
+  }
+}
+
+void cache_size_mgr::record_eviction(std::uint64_t size) {
+  mutex_lock lock(mtx_);
+  ++stats_.evicted_count;
+  stats_.evicted_bytes += size;
+}
+
+void cache_size_mgr::set_pressure_callback(pressure_callback callback) {
+  mutex_lock lock(pressure_mtx_);
+  pressure_callback_ = std::move(callback);
+}
+
 auto cache_size_mgr::shrink(std::uint64_t size) -> api_error {
   REPERTORY_USES_FUNCTION_NAME();
 
-  mutex_lock lock(mtx_);
+  unique_mutex_lock lock(mtx_);
   if (size == 0U) {
+    // Also used to signal a change in maximum cache size
+    auto above_high{
+        cache_size_ >= get_watermark(high_watermark_percent),
+    };
     notify_.notify_all();
+    lock.unlock();
+
+    if (above_high) {
+      notify_pressure();
+    }
     return api_error::success;
   }
 
@@ -0,0 +1,182 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "file_manager/chunk_cache.hpp"
+
+#include "types/repertory.hpp"
+
+namespace repertory {
+chunk_cache chunk_cache::instance_{};
+
+void chunk_cache::advance_hand() {
+  if (entries_.empty()) {
+    hand_ = entries_.end();
+    return;
+  }
+
+  if (hand_ == entries_.end() || ++hand_ == entries_.end()) {
+    hand_ = entries_.begin();
+  }
+}
+
+void chunk_cache::erase_entry(std::map<key_t, entry>::iterator iter) {
+  if (iter == hand_) {
+    advance_hand();
+    if (iter == hand_) {
+      hand_ = entries_.end();
+    }
+  }
+
+  size_ -= iter->second.buffer->size();
+  entries_.erase(iter);
+}
+
+void chunk_cache::evict() {
+  if (hand_ == entries_.end()) {
+    advance_hand();
+  }
+
+  // CLOCK sweep: referenced entries get a second chance and pinned entries
+  // (buffers still held by a reader) are skipped entirely. Two passes are
+  // enough to visit every entry after its reference bit has been cleared.
+  auto remain{entries_.size() * 2U};
+  while (size_ > max_size_ && remain > 0U && hand_ != entries_.end()) {
+    --remain;
+
+    auto &value = hand_->second;
+    if (value.buffer.use_count() > 1L) {
+      advance_hand();
+      continue;
+    }
+
+    if (value.referenced) {
+      value.referenced = false;
+      advance_hand();
+      continue;
+    }
+
+    erase_entry(hand_);
+  }
+}
+
+auto chunk_cache::get_max_size() const -> std::uint64_t {
+  mutex_lock lock(mtx_);
+  return max_size_;
+}
+
+auto chunk_cache::get_or_load(std::string_view api_path,
+                              std::string_view version, std::size_t chunk,
+                              const loader_t &loader, buffer_ptr &buffer)
+    -> api_error {
+  key_t key{std::string{api_path}, std::string{version}, chunk};
+
+  unique_mutex_lock lock(mtx_);
+  while (true) {
+    auto iter = entries_.find(key);
+    if (iter != entries_.end()) {
+      iter->second.referenced = true;
+      buffer = iter->second.buffer;
+      return api_error::success;
+    }
+
+    auto pending_iter = pending_.find(key);
+    if (pending_iter == pending_.end()) {
+      break;
+    }
+
+    auto load = pending_iter->second;
+    notify_.wait(lock, [&load]() -> bool { return load->done; });
+
+    // A load stopped by its owner must not fail unrelated readers; retry and
+    // become the loader if nobody else has.
+    if (load->result == api_error::download_stopped) {
+      continue;
+    }
+
+    buffer = load->buffer;
+    return load->result;
+  }
+
+  auto load{std::make_shared<pending_load>()};
+  pending_[key] = load;
+  lock.unlock();
+
+  auto data{std::make_shared<data_buffer>()};
+  auto result{api_error::error};
+  try {
+    result = loader(*data);
+  } catch (...) {
+    lock.lock();
+    pending_.erase(key);
+    load->done = true;
+    load->result = api_error::error;
+    notify_.notify_all();
+    throw;
+  }
+
+  lock.lock();
+  pending_.erase(key);
+
+  if (result == api_error::success) {
+    load->buffer = data;
+    if (not load->invalidated && data->size() <= max_size_) {
+      size_ += data->size();
+      entries_[key] = entry{.buffer = data};
+      evict();
+    }
+  }
+
+  load->done = true;
+  load->result = result;
+  notify_.notify_all();
+  lock.unlock();
+
+  buffer = load->buffer;
+  return result;
+}
+
+auto chunk_cache::get_size() const -> std::uint64_t {
+  mutex_lock lock(mtx_);
+  return size_;
+}
+
+void chunk_cache::invalidate(std::string_view api_path) {
+  mutex_lock lock(mtx_);
+
+  key_t begin_key{std::string{api_path}, std::string{}, 0U};
+  for (auto iter = pending_.lower_bound(begin_key);
+       iter != pending_.end() && std::get<0>(iter->first) == api_path;
+       ++iter) {
+    iter->second->invalidated = true;
+  }
+
+  auto iter = entries_.lower_bound(begin_key);
+  while (iter != entries_.end() && std::get<0>(iter->first) == api_path) {
+    erase_entry(iter++);
+  }
+}
+
+void chunk_cache::set_max_size(std::uint64_t max_size) {
+  mutex_lock lock(mtx_);
+  max_size_ = max_size;
+  evict();
+}
+} // namespace repertory
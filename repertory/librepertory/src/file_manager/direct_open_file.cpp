@@ -39,25 +39,32 @@ direct_open_file::~direct_open_file() {
 }
 
 auto direct_open_file::on_check_start() -> bool {
-  return (get_file_size() == 0U || has_reader_thread());
+  return (get_file_size() == 0U || has_readers());
 }
 
-auto direct_open_file::on_read_chunk(std::size_t chunk, std::size_t read_size,
-                                     std::uint64_t read_offset,
-                                     data_buffer &data,
+auto direct_open_file::on_read_chunk(std::size_t chunk,
+                                     std::uint64_t read_offset, data_span data,
                                      std::size_t &bytes_read) -> api_error {
-  auto &buffer = ring_data_.at(chunk % get_ring_size());
-  auto begin =
-      std::next(buffer.begin(), static_cast<std::int64_t>(read_offset));
-  auto end = std::next(begin, static_cast<std::int64_t>(read_size));
-  data.insert(data.end(), begin, end);
-  bytes_read = read_size;
+  chunk_cache::buffer_ptr buffer;
+  if (has_chunk_cache()) {
+    auto res{get_cached_chunk(chunk, buffer)};
+    if (res != api_error::success) {
+      return res;
+    }
+  } else {
+    buffer = ring_data_.at(chunk % get_ring_size());
+  }
+
+  std::memcpy(data.data(), &buffer->at(read_offset), data.size());
+  bytes_read = data.size();
   return api_error::success;
 }
 
 auto direct_open_file::use_buffer(std::size_t chunk,
                                   std::function<api_error(data_buffer &)> func)
     -> api_error {
-  return func(ring_data_.at(chunk % get_ring_size()));
+  auto buffer{std::make_shared<data_buffer>()};
+  ring_data_.at(chunk % get_ring_size()) = buffer;
+  return func(*buffer);
 }
 } // namespace repertory
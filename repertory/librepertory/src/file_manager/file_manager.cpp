@@ -41,11 +41,13 @@
 #include "events/types/service_stop_begin.hpp"
 #include "events/types/service_stop_end.hpp"
 #include "file_manager/cache_size_mgr.hpp"
+#include "file_manager/chunk_cache.hpp"
 #include "file_manager/direct_open_file.hpp"
 #include "file_manager/open_file.hpp"
 #include "file_manager/open_file_base.hpp"
 #include "file_manager/ring_buffer_open_file.hpp"
 #include "file_manager/upload.hpp"
+#include "file_manager/upload_scheduler.hpp"
 #include "platform/platform.hpp"
 #include "providers/i_provider.hpp"
 #include "types/repertory.hpp"
@@ -53,27 +55,45 @@
 #include "utils/encrypting_reader.hpp"
 #include "utils/error_utils.hpp"
 #include "utils/file.hpp"
+#include "utils/file_utils.hpp"
 #include "utils/path.hpp"
 #include "utils/polling.hpp"
+#include "utils/time.hpp"
+
+namespace {
+[[nodiscard]] auto create_upload_entry(std::string_view api_path,
+                                       std::string_view source_path,
+                                       std::uint64_t file_size,
+                                       bool sync_requested)
+    -> repertory::upload_scheduler::entry {
+  return {
+      .api_path = std::string{api_path},
+      .file_size = file_size,
+      .priority = repertory::upload_scheduler::get_priority(file_size,
+                                                            sync_requested),
+      .ready_time = std::chrono::steady_clock::now(),
+      .source_path = std::string{source_path},
+  };
+}
+
+[[nodiscard]] auto create_upload_entry(std::string_view api_path,
+                                       std::string_view source_path)
+    -> repertory::upload_scheduler::entry {
+  return create_upload_entry(
+      api_path, source_path,
+      repertory::utils::file::file{source_path}.size().value_or(0U), false);
+}
+} // namespace
 
 namespace repertory {
 file_manager::file_manager(app_config &config, i_provider &provider)
     : config_(config), provider_(provider) {
   mgr_db_ = create_file_mgr_db(config);
-
-  if (provider_.is_read_only()) {
-    return;
-  }
-
-  E_SUBSCRIBE(file_upload_completed,
-              [this](auto &&event) { this->upload_completed(event); });
 }
 
 file_manager::~file_manager() {
   stop();
   mgr_db_.reset();
-
-  E_CONSUMER_RELEASE();
 }
 
 void file_manager::close(std::uint64_t handle) {
@@ -88,6 +108,7 @@ void file_manager::close(std::uint64_t handle) {
   file_lock.unlock();
 
   closeable_file->remove(handle);
+  std::ignore = closeable_file->flush_pending_meta();
 
   file_lock.lock();
   if (is_unlinked) {
@@ -107,6 +128,7 @@ void file_manager::close(std::uint64_t handle) {
 
   auto file = utils::file::file{closeable_file->get_source_path()};
   if (file.remove()) {
+    remove_cached_file(closeable_file->get_source_path());
     return;
   }
 
@@ -137,12 +159,33 @@ void file_manager::close_timed_out_files() {
 
   for (auto &closeable_file : closeable_list) {
     closeable_file->close();
+    if (not closeable_file->is_directory()) {
+      touch_cached_file(closeable_file->get_source_path());
+    }
     event_system::instance().raise<item_timeout>(closeable_file->get_api_path(),
                                                  function_name);
   }
   closeable_list.clear();
 }
 
+void file_manager::flush_expired_meta() {
+  unique_recur_mutex_lock file_lock(open_file_mtx_);
+  auto expired_list =
+      std::accumulate(open_file_lookup_.begin(), open_file_lookup_.end(),
+                      std::vector<std::shared_ptr<i_closeable_open_file>>{},
+                      [](auto &&items, auto &&item) -> auto {
+                        if (item.second->is_pending_meta_expired()) {
+                          items.push_back(item.second);
+                        }
+                        return items;
+                      });
+  file_lock.unlock();
+
+  for (auto &closeable_file : expired_list) {
+    std::ignore = closeable_file->flush_pending_meta();
+  }
+}
+
 auto file_manager::create(std::string_view api_path, api_meta_map &meta,
                           open_file_data ofd, std::uint64_t &handle,
                           std::shared_ptr<i_open_file> &file) -> api_error {
@@ -270,9 +313,12 @@ auto file_manager::evict_file(std::string_view api_path) -> bool {
   auto allocated = closeable_file ? closeable_file->get_allocated() : true;
   closeable_file.reset();
 
+  auto evicted_size = utils::file::file{fsi.source_path}.size().value_or(0U);
   auto removed = remove_source_and_shrink_cache(api_path, fsi.source_path,
                                                 fsi.size, allocated);
   if (removed) {
+    cache_size_mgr::instance().record_eviction(evicted_size);
+    remove_cached_file(fsi.source_path);
     event_system::instance().raise<filesystem_item_evicted>(
         api_path, function_name, fsi.source_path);
   }
@@ -280,6 +326,10 @@ auto file_manager::evict_file(std::string_view api_path) -> bool {
   return removed;
 }
 
+auto file_manager::get_cached_file_count() const -> std::size_t {
+  return cache_index_.size();
+}
+
 auto file_manager::get_directory_items(std::string_view api_path) const
     -> directory_item_list {
   REPERTORY_USES_FUNCTION_NAME();
@@ -307,6 +357,25 @@ auto file_manager::get_directory_item(std::string_view api_path,
   return ret;
 }
 
+auto file_manager::get_eviction_candidates(std::size_t count,
+                                           std::uint64_t max_accessed)
+    -> std::vector<std::string> {
+  std::vector<std::string> ret;
+  for (const auto &entry : cache_index_.pop(count, max_accessed)) {
+    std::string api_path;
+    auto res = provider_.get_api_path_from_source(entry.source_path, api_path);
+    if (res == api_error::success) {
+      ret.push_back(api_path);
+      continue;
+    }
+
+    // Source was replaced or its item removed outside of the file manager
+    remove_cached_file(entry.source_path);
+  }
+
+  return ret;
+}
+
 auto file_manager::get_next_handle() -> std::uint64_t {
   if (++next_handle_ == 0U) {
     ++next_handle_;
@@ -375,6 +444,11 @@ auto file_manager::get_open_file(std::uint64_t handle, bool write_supported,
             : 0U,
         file_ptr->get_filesystem_item(), file_ptr->get_open_data(), provider_,
         *this);
+    writeable_file->set_max_download_count(config_.get_max_download_count());
+    writeable_file->set_read_ahead_policy(config_.get_read_ahead_policy());
+    writeable_file->set_meta_flush_interval(
+        config_.get_meta_flush_interval_secs());
+    std::ignore = file_ptr->flush_pending_meta();
     writeable_file->set_unlinked(is_unlinked);
     if (is_unlinked) {
       writeable_file->set_unlinked_meta(file_ptr->get_unlinked_meta());
@@ -439,6 +513,7 @@ auto file_manager::handle_file_rename(std::string_view from_api_path,
   auto file_iter = open_file_lookup_.find(std::string{from_api_path});
   if (file_iter != open_file_lookup_.end()) {
     source_path = file_iter->second->get_source_path();
+    std::ignore = file_iter->second->flush_pending_meta();
   }
 
   auto should_upload{upload_lookup_.contains(std::string{from_api_path})};
@@ -464,6 +539,8 @@ auto file_manager::handle_file_rename(std::string_view from_api_path,
   }
 
   swap_renamed_items(from_api_path, to_api_path, false);
+  chunk_cache::instance().invalidate(from_api_path);
+  chunk_cache::instance().invalidate(to_api_path);
 
   ret = source_path.empty()
             ? api_error::success
@@ -511,6 +588,46 @@ auto file_manager::is_processing(std::string_view api_path) const -> bool {
              : false;
 }
 
+void file_manager::load_cache_index() {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  auto entries = mgr_db_->get_cache_entry_list();
+  if (not entries.empty()) {
+    cache_index_.load(std::move(entries));
+    return;
+  }
+
+  // Seed the index once from the cache directory so files cached before the
+  // index existed remain eligible for eviction
+  auto type = config_.get_eviction_uses_accessed_time()
+                  ? utils::file::time_type::accessed
+                  : utils::file::time_type::modified;
+  for (const auto &source_path :
+       utils::file::get_directory_files(config_.get_cache_directory(), true)) {
+    auto accessed = utils::file::file{source_path}.get_time(type);
+    if (not accessed.has_value()) {
+      utils::error::raise_error(function_name, utils::get_last_error_code(),
+                                source_path, "failed to get file time");
+      continue;
+    }
+
+    i_file_mgr_db::cache_entry entry{
+        .source_path = source_path,
+        .accessed = accessed.value(),
+    };
+    if (not mgr_db_->add_cache_entry(entry)) {
+      utils::error::raise_error(
+          function_name,
+          fmt::format("failed to add cache entry|sp|{}", source_path));
+      continue;
+    }
+
+    entries.push_back(std::move(entry));
+  }
+
+  cache_index_.load(std::move(entries));
+}
+
 auto file_manager::open(std::string_view api_path, bool directory,
                         const open_file_data &ofd, std::uint64_t &handle,
                         std::shared_ptr<i_open_file> &file) -> api_error {
@@ -632,61 +749,97 @@ auto file_manager::open(std::string_view api_path, bool directory,
           fsi.api_path, fsi.source_path, function_name, type);
     }
 
+    const auto get_cache_version = [&]() -> std::string {
+      std::string modified;
+      std::ignore = provider_.get_item_meta(api_path, META_MODIFIED, modified);
+      return fmt::format("{}|{}", fsi.size, modified);
+    };
+
     switch (type) {
     case repertory::download_type::direct: {
-      closeable_file = std::make_shared<direct_open_file>(
-          chunk_size, chunk_timeout, fsi, provider_);
+      auto file = std::make_shared<direct_open_file>(chunk_size, chunk_timeout,
+                                                     fsi, provider_);
+      file->set_chunk_cache(&chunk_cache::instance(), get_cache_version());
+      closeable_file = file;
     } break;
 
     case repertory::download_type::ring_buffer: {
-      closeable_file = std::make_shared<ring_buffer_open_file>(
+      auto file = std::make_shared<ring_buffer_open_file>(
           buffer_directory, chunk_size, chunk_timeout, fsi, provider_,
           ring_size);
+      file->set_chunk_cache(&chunk_cache::instance(), get_cache_version());
+      closeable_file = file;
     } break;
 
     default: {
-      closeable_file = std::make_shared<open_file>(chunk_size, chunk_timeout,
-                                                   fsi, provider_, *this);
+      auto writeable_file = std::make_shared<open_file>(
+          chunk_size, chunk_timeout, fsi, provider_, *this);
+      writeable_file->set_max_download_count(config_.get_max_download_count());
+      writeable_file->set_read_ahead_policy(config_.get_read_ahead_policy());
+      closeable_file = writeable_file;
     } break;
     }
   }
 
+  closeable_file->set_meta_flush_interval(
+      config_.get_meta_flush_interval_secs());
   open_file_lookup_[std::string{api_path}] = closeable_file;
   create_and_add_handle(closeable_file);
   return api_error::success;
 }
 
 void file_manager::queue_upload(const i_open_file &file) {
-  queue_upload(file.get_api_path(), file.get_source_path(), file.is_unlinked(),
+  if (provider_.is_read_only() || file.is_unlinked()) {
+    return;
+  }
+
+  queue_upload(create_upload_entry(file.get_api_path(), file.get_source_path(),
+                                   file.get_file_size(),
+                                   file.is_sync_requested()),
                false);
 }
 
 void file_manager::queue_upload(std::string_view api_path,
                                 std::string_view source_path, bool is_unlinked,
                                 bool no_lock) {
-  REPERTORY_USES_FUNCTION_NAME();
-
   if (provider_.is_read_only() || is_unlinked) {
     return;
   }
 
+  queue_upload(create_upload_entry(api_path, source_path), no_lock);
+}
+
+void file_manager::queue_upload(upload_scheduler::entry entry, bool no_lock) {
+  REPERTORY_USES_FUNCTION_NAME();
+
   std::unique_ptr<mutex_lock> upload_lock;
   if (not no_lock) {
     upload_lock = std::make_unique<mutex_lock>(upload_mtx_);
   }
 
-  remove_upload(api_path, true);
+  auto api_path{entry.api_path};
+  auto source_path{entry.source_path};
 
-  if (mgr_db_->add_upload(i_file_mgr_db::upload_entry{
-          std::string{api_path},
-          std::string{source_path},
-      })) {
+  if (upload_scheduler_.is_queued(api_path)) {
+    // Closing a file again before its upload starts only refreshes the queued
+    // entry
+    upload_scheduler_.push(std::move(entry));
     remove_resume(api_path, source_path, true);
-    event_system::instance().raise<file_upload_queued>(api_path, function_name,
-                                                       source_path);
   } else {
-    event_system::instance().raise<file_upload_failed>(
-        api_path, "failed to queue upload", function_name, source_path);
+    remove_upload(api_path, true);
+
+    if (mgr_db_->add_upload(i_file_mgr_db::upload_entry{
+            api_path,
+            source_path,
+        })) {
+      upload_scheduler_.push(std::move(entry));
+      remove_resume(api_path, source_path, true);
+      event_system::instance().raise<file_upload_queued>(
+          api_path, function_name, source_path);
+    } else {
+      event_system::instance().raise<file_upload_failed>(
+          api_path, "failed to queue upload", function_name, source_path);
+    }
   }
 
   if (not no_lock) {
@@ -756,15 +909,22 @@ auto file_manager::remove_file(std::string_view api_path) -> api_error {
     return res;
   }
 
+  chunk_cache::instance().invalidate(api_path);
+
   auto file_iter = open_file_lookup_.find(std::string{api_path});
   if (file_iter == open_file_lookup_.end()) {
     remove_source_and_shrink_cache(api_path, fsi.source_path, fsi.size, true);
+    remove_cached_file(fsi.source_path);
     return api_error::success;
   }
 
   auto closed_file = file_iter->second;
   open_file_lookup_.erase(std::string{api_path});
 
+  for (const auto &[key, value] : closed_file->get_pending_meta()) {
+    meta[key] = value;
+  }
+
   auto allocated = closed_file->get_allocated();
   closed_file->set_unlinked(true);
   closed_file->set_unlinked_meta(meta);
@@ -850,6 +1010,20 @@ auto file_manager::remove_source_and_shrink_cache(std::string_view api_path,
   return true;
 }
 
+void file_manager::remove_cached_file(std::string_view source_path) {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  if (not cache_index_.remove(source_path)) {
+    return;
+  }
+
+  if (not mgr_db_->remove_cache_entry(source_path)) {
+    utils::error::raise_error(
+        function_name,
+        fmt::format("failed to remove cache entry|sp|{}", source_path));
+  }
+}
+
 void file_manager::remove_upload(std::string_view api_path) {
   remove_upload(api_path, false);
 }
@@ -878,6 +1052,8 @@ void file_manager::remove_upload(std::string_view api_path, bool no_lock) {
                                        "failed to remove active upload");
   }
 
+  upload_scheduler_.remove(api_path);
+
   if (upload_lookup_.contains(std::string{api_path})) {
     upload_lookup_.at(std::string{api_path})->cancel();
     upload_lookup_.erase(std::string{api_path});
@@ -1044,7 +1220,7 @@ auto file_manager::rename_file(std::string_view from_api_path,
 void file_manager::start() {
   REPERTORY_USES_FUNCTION_NAME();
 
-  if (upload_thread_) {
+  if (not upload_threads_.empty()) {
     return;
   }
 
@@ -1052,6 +1228,8 @@ void file_manager::start() {
                                                       "file_manager");
   stop_requested_ = false;
 
+  chunk_cache::instance().set_max_size(config_.get_chunk_cache_size_bytes());
+
   polling::instance().set_callback({
       .name = "timed_out_close",
       .freq = polling::frequency::second,
@@ -1061,6 +1239,13 @@ void file_manager::start() {
           },
   });
 
+  polling::instance().set_callback({
+      .name = "pending_meta_flush",
+      .freq = polling::frequency::second,
+      .action =
+          [this](auto && /* stop_requested */) { this->flush_expired_meta(); },
+  });
+
   if (provider_.is_read_only()) {
     stop_requested_ = false;
     event_system::instance().raise<service_start_end>(function_name,
@@ -1068,10 +1253,19 @@ void file_manager::start() {
     return;
   }
 
+  load_cache_index();
+
   for (const auto &entry : mgr_db_->get_upload_active_list()) {
     queue_upload(entry.api_path, entry.source_path, false, false);
   }
 
+  unique_mutex_lock upload_lock(upload_mtx_);
+  for (const auto &entry : mgr_db_->get_upload_list()) {
+    upload_scheduler_.push(create_upload_entry(entry.api_path,
+                                               entry.source_path));
+  }
+  upload_lock.unlock();
+
   for (const auto &entry : get_stored_downloads()) {
     try {
       filesystem_item fsi{};
@@ -1120,6 +1314,10 @@ void file_manager::start() {
                                           ? config_.get_download_timeout_secs()
                                           : 0U,
                                       fsi, provider_, entry.read_state, *this);
+      closeable_file->set_max_download_count(config_.get_max_download_count());
+      closeable_file->set_read_ahead_policy(config_.get_read_ahead_policy());
+      closeable_file->set_meta_flush_interval(
+          config_.get_meta_flush_interval_secs());
       open_file_lookup_[entry.api_path] = closeable_file;
       closeable_file->force_download();
 
@@ -1135,7 +1333,11 @@ void file_manager::start() {
     }
   }
 
-  upload_thread_ = std::make_unique<std::thread>([this] { upload_handler(); });
+  for (std::uint8_t idx = 0U; idx < config_.get_max_upload_count(); ++idx) {
+    upload_threads_.emplace_back(
+        std::make_unique<std::thread>([this] { upload_handler(); }));
+  }
+
   event_system::instance().raise<service_start_end>(function_name,
                                                     "file_manager");
 }
@@ -1152,35 +1354,40 @@ void file_manager::stop() {
 
   stop_requested_ = true;
 
+  polling::instance().remove_callback("pending_meta_flush");
   polling::instance().remove_callback("timed_out_close");
 
   unique_mutex_lock upload_lock(upload_mtx_);
-  upload_notify_.notify_all();
-  upload_lock.unlock();
-
-  if (upload_thread_) {
-    upload_thread_->join();
-  }
-
-  open_file_lookup_.clear();
-
-  upload_lock.lock();
   for (auto &item : upload_lookup_) {
     item.second->stop();
   }
   upload_notify_.notify_all();
   upload_lock.unlock();
 
-  while (not upload_lookup_.empty()) {
-    upload_lock.lock();
-    if (not upload_lookup_.empty()) {
-      upload_notify_.wait_for(upload_lock, 1ms);
+  for (auto &thread : upload_threads_) {
+    thread->join();
+  }
+  upload_threads_.clear();
+
+  // Files still open at shutdown never reach close_timed_out_files(), so index
+  // them here to keep them eligible for eviction after a restart. Directories
+  // have no cached source file and are skipped by touch_cached_file().
+  std::vector<std::string> source_paths;
+  for (const auto &item : open_file_lookup_) {
+    if (not item.second->is_unlinked()) {
+      source_paths.push_back(item.second->get_source_path());
     }
-    upload_notify_.notify_all();
-    upload_lock.unlock();
   }
+  open_file_lookup_.clear();
 
-  upload_thread_.reset();
+  for (const auto &source_path : source_paths) {
+    touch_cached_file(source_path);
+  }
+
+  upload_lock.lock();
+  upload_lookup_.clear();
+  upload_scheduler_.clear();
+  upload_lock.unlock();
 
   event_system::instance().raise<service_stop_end>(function_name,
                                                    "file_manager");
@@ -1236,100 +1443,135 @@ void file_manager::swap_renamed_items(std::string_view from_api_path,
                                      "failed to update resume table");
 }
 
-void file_manager::upload_completed(const file_upload_completed &evt) {
+void file_manager::touch_cached_file(std::string_view source_path) {
   REPERTORY_USES_FUNCTION_NAME();
 
-  unique_mutex_lock upload_lock(upload_mtx_);
+  if (provider_.is_read_only() || not utils::file::file{source_path}.exists()) {
+    return;
+  }
 
-  if (not evt.cancelled) {
-    if (evt.error == api_error::success) {
-      if (not mgr_db_->remove_upload_active(evt.api_path)) {
-        utils::error::raise_api_path_error(
-            function_name, evt.api_path, evt.source_path, evt.error,
-            "failed to remove from upload_active table");
-      }
+  i_file_mgr_db::cache_entry entry{
+      .source_path = std::string{source_path},
+      .accessed = utils::time::get_time_now(),
+  };
+  cache_index_.touch(entry.source_path, entry.accessed);
 
-      upload_lookup_.erase(evt.api_path);
-    } else {
-      bool exists{};
-      auto res = provider_.is_file(evt.api_path, exists);
-      if ((res == api_error::success && not exists) ||
-          not utils::file::file(evt.source_path).exists()) {
-        event_system::instance().raise<file_upload_not_found>(
-            evt.api_path, function_name, evt.source_path);
-        remove_upload(evt.api_path, true);
-      } else {
-        event_system::instance().raise<file_upload_retry>(
-            evt.api_path, evt.error, function_name, evt.source_path);
+  if (not mgr_db_->add_cache_entry(entry)) {
+    utils::error::raise_error(
+        function_name,
+        fmt::format("failed to add cache entry|sp|{}", source_path));
+  }
+}
 
-        queue_upload(evt.api_path, evt.source_path, false, true);
-        upload_notify_.wait_for(upload_lock, queue_wait_secs);
-      }
+void file_manager::upload_completed(const std::shared_ptr<upload> &completed) {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  if (completed->is_cancelled()) {
+    return;
+  }
+
+  auto api_path{completed->get_api_path()};
+  auto source_path{completed->get_source_path()};
+  if (completed->get_api_error() == api_error::success) {
+    chunk_cache::instance().invalidate(api_path);
+
+    if (not mgr_db_->remove_upload_active(api_path)) {
+      utils::error::raise_api_path_error(
+          function_name, api_path, source_path, completed->get_api_error(),
+          "failed to remove from upload_active table");
     }
+
+    upload_lookup_.erase(api_path);
+    return;
   }
 
-  upload_notify_.notify_all();
+  bool exists{};
+  auto res = provider_.is_file(api_path, exists);
+  if ((res == api_error::success && not exists) ||
+      not utils::file::file(source_path).exists()) {
+    event_system::instance().raise<file_upload_not_found>(
+        api_path, function_name, source_path);
+    remove_upload(api_path, true);
+    return;
+  }
+
+  event_system::instance().raise<file_upload_retry>(
+      api_path, completed->get_api_error(), function_name, source_path);
+
+  auto entry{create_upload_entry(api_path, source_path)};
+  entry.ready_time += queue_wait_secs;
+  queue_upload(std::move(entry), true);
 }
 
 void file_manager::upload_handler() {
   REPERTORY_USES_FUNCTION_NAME();
 
+  unique_mutex_lock upload_lock(upload_mtx_);
   while (not get_stop_requested()) {
-    auto should_wait{true};
-    unique_mutex_lock upload_lock(upload_mtx_);
-    if (get_stop_requested()) {
-      upload_notify_.notify_all();
+    auto entry = upload_scheduler_.pop(config_.get_max_upload_count(),
+                                       config_.get_max_upload_bytes());
+    if (not entry.has_value()) {
+      auto wait_time{std::chrono::steady_clock::now() + queue_wait_secs};
+      auto ready_time = upload_scheduler_.get_next_ready_time();
+      if (ready_time.has_value() && ready_time.value() < wait_time) {
+        wait_time = ready_time.value();
+      }
+
+      upload_notify_.wait_until(upload_lock, wait_time);
       continue;
     }
 
-    if (upload_lookup_.size() < config_.get_max_upload_count()) {
-      try {
-        auto entry = mgr_db_->get_next_upload();
-        if (entry.has_value()) {
-          filesystem_item fsi{};
-          auto res = provider_.get_filesystem_item(entry->api_path, false, fsi);
-          switch (res) {
-          case api_error::item_not_found: {
-            should_wait = false;
-            event_system::instance().raise<file_upload_not_found>(
-                entry->api_path, function_name, entry->source_path);
-            remove_upload(entry->api_path, true);
-          } break;
-
-          case api_error::success: {
-            should_wait = false;
-
-            upload_lookup_[fsi.api_path] =
-                std::make_unique<upload>(fsi, provider_);
-            if (mgr_db_->remove_upload(entry->api_path)) {
-              if (not mgr_db_->add_upload_active(
-                      i_file_mgr_db::upload_active_entry{
-                          .api_path = entry->api_path,
-                          .source_path = entry->source_path,
-                      })) {
-                utils::error::raise_api_path_error(
-                    function_name, entry->api_path, entry->source_path,
-                    "failed to add to upload_active table");
-              }
-            }
-          } break;
-
-          default: {
-            event_system::instance().raise<file_upload_retry>(
-                entry->api_path, res, function_name, entry->source_path);
-            queue_upload(entry->api_path, entry->source_path, false, true);
-          } break;
+    std::shared_ptr<upload> active_upload;
+    try {
+      filesystem_item fsi{};
+      auto res = provider_.get_filesystem_item(entry->api_path, false, fsi);
+      switch (res) {
+      case api_error::item_not_found: {
+        event_system::instance().raise<file_upload_not_found>(
+            entry->api_path, function_name, entry->source_path);
+        remove_upload(entry->api_path, true);
+      } break;
+
+      case api_error::success: {
+        active_upload = std::make_shared<upload>(fsi, provider_);
+        upload_lookup_[fsi.api_path] = active_upload;
+        if (mgr_db_->remove_upload(entry->api_path)) {
+          if (not mgr_db_->add_upload_active(
+                  i_file_mgr_db::upload_active_entry{
+                      .api_path = entry->api_path,
+                      .source_path = entry->source_path,
+                  })) {
+            utils::error::raise_api_path_error(
+                function_name, entry->api_path, entry->source_path,
+                "failed to add to upload_active table");
           }
         }
-      } catch (const std::exception &ex) {
-        utils::error::raise_error(function_name, ex, "query error");
+      } break;
+
+      default: {
+        event_system::instance().raise<file_upload_retry>(
+            entry->api_path, res, function_name, entry->source_path);
+
+        auto retry_entry{
+            create_upload_entry(entry->api_path, entry->source_path),
+        };
+        retry_entry.ready_time += queue_wait_secs;
+        queue_upload(std::move(retry_entry), true);
+      } break;
       }
+    } catch (const std::exception &ex) {
+      utils::error::raise_error(function_name, ex, "query error");
     }
 
-    if (should_wait) {
-      upload_notify_.wait_for(upload_lock, queue_wait_secs);
+    if (active_upload) {
+      upload_lock.unlock();
+      active_upload->execute();
+      upload_lock.lock();
+
+      upload_completed(active_upload);
     }
 
+    upload_scheduler_.release(entry->api_path);
     upload_notify_.notify_all();
   }
 }
@@ -0,0 +1,238 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "file_manager/io_engine.hpp"
+
+#include "utils/error_utils.hpp"
+#include "utils/types/file/i_file.hpp"
+
+namespace repertory {
+io_engine io_engine::instance_;
+
+auto io_engine::strand::is_idle() const -> bool {
+  mutex_lock lock(mtx);
+  return not active && queue.empty();
+}
+
+void io_engine::strand::wait() {
+  unique_mutex_lock lock(mtx);
+  notify.wait(lock, [this]() -> bool { return not active && queue.empty(); });
+}
+
+void io_engine::enqueue(pool &target, task_t item) {
+  std::call_once(start_flag_, [this]() { start(); });
+
+  unique_mutex_lock lock(target.mtx);
+  if (stop_requested_) {
+    lock.unlock();
+    item();
+    return;
+  }
+
+  target.queue.emplace_back(std::move(item));
+  target.notify.notify_one();
+}
+
+auto io_engine::execute(const std::shared_ptr<strand> &str, action_t action)
+    -> api_error {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  std::mutex mtx;
+  std::condition_variable notify;
+  std::optional<api_error> result;
+
+  post(str, [&action, &mtx, &notify, &result]() {
+    auto res{api_error::error};
+    try {
+      res = action();
+    } catch (const std::exception &ex) {
+      utils::error::raise_error(function_name, ex, "io action failed");
+    }
+
+    mutex_lock lock(mtx);
+    result = res;
+    notify.notify_all();
+  });
+
+  unique_mutex_lock lock(mtx);
+  notify.wait(lock, [&result]() -> bool { return result.has_value(); });
+  return result.value();
+}
+
+auto io_engine::get_io_thread_count() -> std::size_t {
+  mutex_lock lock(io_pool_.mtx);
+  return io_pool_.threads.size();
+}
+
+auto io_engine::get_task_thread_count() -> std::size_t {
+  mutex_lock lock(task_pool_.mtx);
+  return task_pool_.threads.size();
+}
+
+void io_engine::post(const std::shared_ptr<strand> &str, task_t item) {
+  unique_mutex_lock lock(str->mtx);
+  str->queue.emplace_back(std::move(item));
+  if (str->active) {
+    return;
+  }
+
+  str->active = true;
+  lock.unlock();
+
+  enqueue(io_pool_, [this, str]() { run_strand(str); });
+}
+
+void io_engine::read(const std::shared_ptr<strand> &str,
+                     utils::file::i_file &file, std::uint64_t offset,
+                     data_span data, completed_t completed) {
+  post(str, [&file, offset, data, completed = std::move(completed)]() {
+    std::size_t bytes_read{};
+    auto res = file.read(data.data(), data.size(), offset, &bytes_read)
+                   ? api_error::success
+                   : api_error::os_error;
+    completed(res, bytes_read);
+  });
+}
+
+void io_engine::run_strand(std::shared_ptr<strand> str) {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  // Strands give up their worker after a batch so that one busy file cannot
+  // hold a worker while other files wait
+  unique_mutex_lock lock(str->mtx);
+  for (std::size_t count = 0U;
+       count < max_strand_batch && not str->queue.empty(); ++count) {
+    auto item = std::move(str->queue.front());
+    str->queue.pop_front();
+    lock.unlock();
+
+    try {
+      item();
+    } catch (const std::exception &ex) {
+      utils::error::raise_error(function_name, ex, "io item failed");
+    }
+
+    lock.lock();
+  }
+
+  if (str->queue.empty()) {
+    str->active = false;
+    str->notify.notify_all();
+    return;
+  }
+  lock.unlock();
+
+  enqueue(io_pool_, [this, str = std::move(str)]() { run_strand(str); });
+}
+
+void io_engine::schedule(task_t task) { enqueue(task_pool_, std::move(task)); }
+
+void io_engine::start() {
+  if (stop_requested_) {
+    return;
+  }
+
+  auto concurrency{
+      static_cast<std::size_t>(std::thread::hardware_concurrency()),
+  };
+
+  const auto start_pool = [this](pool &target, std::size_t count) {
+    mutex_lock lock(target.mtx);
+    for (std::size_t idx = 0U; idx < count; ++idx) {
+      target.threads.emplace_back(std::make_unique<std::thread>(
+          [this, &target]() { worker_thread(target); }));
+    }
+  };
+
+  start_pool(io_pool_, std::max(min_io_threads, concurrency));
+  start_pool(task_pool_, std::max(min_task_threads, concurrency * 2U));
+}
+
+void io_engine::stop() {
+  std::vector<std::unique_ptr<std::thread>> threads;
+  for (auto *target : {&io_pool_, &task_pool_}) {
+    mutex_lock lock(target->mtx);
+    stop_requested_ = true;
+    target->notify.notify_all();
+    std::ranges::move(target->threads, std::back_inserter(threads));
+    target->threads.clear();
+  }
+
+  for (auto &thread : threads) {
+    thread->join();
+  }
+}
+
+void io_engine::submit(const std::shared_ptr<strand> &str, action_t action,
+                       std::function<void(api_error result)> completed) {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  post(str, [action = std::move(action), completed = std::move(completed)]() {
+    auto res{api_error::error};
+    try {
+      res = action();
+    } catch (const std::exception &ex) {
+      utils::error::raise_error(function_name, ex, "io action failed");
+    }
+
+    completed(res);
+  });
+}
+
+void io_engine::worker_thread(pool &source) {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  unique_mutex_lock lock(source.mtx);
+  while (true) {
+    source.notify.wait(lock, [this, &source]() -> bool {
+      return stop_requested_ || not source.queue.empty();
+    });
+    if (source.queue.empty()) {
+      return;
+    }
+
+    auto item = std::move(source.queue.front());
+    source.queue.pop_front();
+    lock.unlock();
+
+    try {
+      item();
+    } catch (const std::exception &ex) {
+      utils::error::raise_error(function_name, ex, "io task failed");
+    }
+
+    lock.lock();
+  }
+}
+
+void io_engine::write(const std::shared_ptr<strand> &str,
+                      utils::file::i_file &file, std::uint64_t offset,
+                      data_cspan data, completed_t completed) {
+  post(str, [&file, offset, data, completed = std::move(completed)]() {
+    std::size_t bytes_written{};
+    auto res = file.write(data.data(), data.size(),
+                          static_cast<std::size_t>(offset), &bytes_written)
+                   ? api_error::success
+                   : api_error::os_error;
+    completed(res, bytes_written);
+  });
+}
+} // namespace repertory
@@ -66,7 +66,8 @@ open_file::open_file(std::uint64_t chunk_size, std::uint8_t chunk_timeout,
                      i_upload_manager &mgr)
     : open_file_base(chunk_size, chunk_timeout, fsi, open_data, provider,
                      false),
-      mgr_(mgr) {
+      mgr_(mgr),
+      access_pattern_(chunk_size) {
   REPERTORY_USES_FUNCTION_NAME();
 
   if (fsi.directory) {
@@ -114,6 +115,10 @@ open_file::open_file(std::uint64_t chunk_size, std::uint8_t chunk_timeout,
   if (get_provider().is_read_only() || file_size.value() == fsi.size) {
     read_state_.set(0U, read_state_.size(), true);
     allocated = true;
+  } else {
+    // Chunks arrive out of order; reserving the space up front keeps the cache
+    // file from fragmenting without changing its reported size
+    std::ignore = nf_->preallocate(0U, fsi.size);
   }
 
   if (get_api_error() != api_error::success && *nf_) {
@@ -200,6 +205,47 @@ auto open_file::check_start() -> api_error {
   return api_error::success;
 }
 
+auto open_file::claim_chunks(std::size_t begin_chunk, std::size_t end_chunk)
+    -> std::vector<std::size_t> {
+  // Missing chunks in the range are registered as active downloads so readers
+  // and the reader thread wait for the write to make them valid instead of
+  // fetching them
+  while (get_api_error() == api_error::success) {
+    unique_recur_mutex_lock rw_lock(rw_mtx_);
+    auto read_state = get_read_state();
+
+    std::shared_ptr<download> active_download;
+    std::vector<std::size_t> chunks;
+    for (std::size_t chunk = begin_chunk;
+         (chunk <= end_chunk) && (chunk < read_state.size()); ++chunk) {
+      if (read_state[chunk]) {
+        continue;
+      }
+
+      auto iter = get_active_downloads().find(chunk);
+      if (iter != get_active_downloads().end()) {
+        active_download = iter->second;
+        break;
+      }
+
+      chunks.push_back(chunk);
+    }
+
+    if (not active_download) {
+      for (const auto &chunk : chunks) {
+        get_active_downloads()[chunk] = std::make_shared<download>();
+      }
+
+      return chunks;
+    }
+    rw_lock.unlock();
+
+    active_download->wait();
+  }
+
+  return {};
+}
+
 auto open_file::close() -> bool {
   REPERTORY_USES_FUNCTION_NAME();
 
@@ -209,12 +255,10 @@ auto open_file::close() -> bool {
 
   stop_requested_ = true;
 
-  notify_io();
-
-  if (reader_thread_) {
-    reader_thread_->join();
-    reader_thread_.reset();
-  }
+  unique_mutex_lock reader_lock(reader_mtx_);
+  reader_notify_.wait(reader_lock,
+                      [this]() -> bool { return not reader_scheduled_; });
+  reader_lock.unlock();
 
   if (not open_file_base::close()) {
     return false;
@@ -279,6 +323,7 @@ auto open_file::close() -> bool {
 
 void open_file::force_download() {
   unique_recur_mutex_lock rw_lock(rw_mtx_);
+  full_read_ahead_ = true;
   auto read_chunk = read_chunk_;
   rw_lock.unlock();
 
@@ -324,85 +369,123 @@ void open_file::download_chunk(std::size_t chunk, bool skip_active,
       reset_timeout();
     }
 
-    std::async(std::launch::async, [this, chunk, data_size, data_offset,
-                                    should_reset]() {
-      const auto notify_complete = [this, chunk, should_reset]() {
-        auto state = get_read_state();
-
-        unique_recur_mutex_lock lock(rw_mtx_);
-        auto active_download = get_active_downloads().at(chunk);
-        get_active_downloads().erase(chunk);
-        if (get_api_error() == api_error::success) {
-          auto progress = (static_cast<double>(state.count()) /
-                           static_cast<double>(state.size())) *
-                          100.0;
-          event_system::instance().raise<download_progress>(
-              get_api_path(), get_source_path(), function_name, progress);
-          if (state.all() && not notified_) {
-            notified_ = true;
-            event_system::instance().raise<download_end>(
-                get_api_path(), get_source_path(), get_api_error(),
-                function_name);
-          }
-        } else if (not notified_) {
+    const auto notify_complete = [this, chunk, should_reset]() {
+      auto state = get_read_state();
+
+      unique_recur_mutex_lock lock(rw_mtx_);
+      auto active_download = get_active_downloads().at(chunk);
+      get_active_downloads().erase(chunk);
+      if (get_api_error() == api_error::success) {
+        auto progress = (static_cast<double>(state.count()) /
+                         static_cast<double>(state.size())) *
+                        100.0;
+        event_system::instance().raise<download_progress>(
+            get_api_path(), get_source_path(), function_name, progress);
+        if (state.all() && not notified_) {
           notified_ = true;
           event_system::instance().raise<download_end>(
               get_api_path(), get_source_path(), get_api_error(),
               function_name);
         }
-        lock.unlock();
+      } else if (not notified_) {
+        notified_ = true;
+        event_system::instance().raise<download_end>(
+            get_api_path(), get_source_path(), get_api_error(), function_name);
+      }
+      lock.unlock();
 
-        active_download->notify(get_api_error());
+      active_download->notify(get_api_error());
 
-        if (should_reset) {
-          reset_timeout();
-        }
-      };
+      if (should_reset) {
+        reset_timeout();
+      }
+    };
 
-      data_buffer buffer;
-      auto res = get_provider().read_file_bytes(
-          get_api_path(), data_size, data_offset, buffer, stop_requested_);
-      if (res != api_error::success) {
-        set_api_error(res);
-        notify_complete();
-        return;
+    data_buffer buffer;
+    auto res = get_provider().read_file_bytes(
+        get_api_path(), data_size, data_offset, buffer, stop_requested_);
+    if (res != api_error::success) {
+      set_api_error(res);
+      notify_complete();
+      return;
+    }
+
+    if (should_reset) {
+      reset_timeout();
+    }
+
+    res = do_io([&]() -> api_error {
+      std::size_t bytes_written{};
+      if (not nf_->write(buffer, data_offset, &bytes_written)) {
+        return api_error::os_error;
       }
 
       if (should_reset) {
         reset_timeout();
       }
+      return api_error::success;
+    });
+    if (res != api_error::success) {
+      set_api_error(res);
+      notify_complete();
+      return;
+    }
 
-      res = do_io([&]() -> api_error {
-        std::size_t bytes_written{};
-        if (not nf_->write(buffer, data_offset, &bytes_written)) {
-          return api_error::os_error;
-        }
+    set_read_state(chunk);
 
-        if (should_reset) {
-          reset_timeout();
-        }
-        return api_error::success;
-      });
-      if (res != api_error::success) {
-        set_api_error(res);
-        notify_complete();
+    notify_complete();
+  }
+}
+
+void open_file::download_chunks(const std::vector<std::size_t> &chunks,
+                                bool skip_active, bool should_reset) {
+  auto max_count = static_cast<std::size_t>(get_max_download_count());
+  if (chunks.size() == 1U || max_count == 1U) {
+    for (const auto &chunk : chunks) {
+      if (get_api_error() != api_error::success) {
         return;
       }
 
-      set_read_state(chunk);
+      download_chunk(chunk, skip_active, should_reset);
+    }
+    return;
+  }
 
-      notify_complete();
-    }).wait();
+  std::deque<std::future<void>> active;
+  for (const auto &chunk : chunks) {
+    if (get_api_error() != api_error::success) {
+      break;
+    }
+
+    if (active.size() >= max_count) {
+      active.front().wait();
+      active.pop_front();
+    }
+
+    active.emplace_back(std::async(
+        std::launch::async, [this, chunk, skip_active, should_reset]() {
+          download_chunk(chunk, skip_active, should_reset);
+        }));
+  }
+
+  for (auto &item : active) {
+    item.wait();
   }
 }
 
 void open_file::download_range(std::size_t begin_chunk, std::size_t end_chunk,
                                bool should_reset) {
+  auto read_state = get_read_state();
+
+  std::vector<std::size_t> chunks;
   for (std::size_t chunk = begin_chunk;
-       (get_api_error() == api_error::success) && (chunk <= end_chunk);
-       ++chunk) {
-    download_chunk(chunk, false, should_reset);
+       (chunk <= end_chunk) && (chunk < read_state.size()); ++chunk) {
+    if (not read_state[chunk]) {
+      chunks.push_back(chunk);
+    }
   }
+
+  download_chunks(chunks, false, should_reset);
 }
 
 auto open_file::get_allocated() const -> bool {
@@ -410,6 +493,57 @@ auto open_file::get_allocated() const -> bool {
   return allocated;
 }
 
+auto open_file::get_max_download_count() const -> std::uint8_t {
+  return std::max(std::uint8_t(1U), max_download_count_.load());
+}
+
+auto open_file::get_next_read_ahead_chunks() -> std::vector<std::size_t> {
+  std::vector<std::size_t> chunks;
+
+  auto read_state = get_read_state();
+  if (get_stop_requested() || (get_file_size() == 0U) || read_state.all()) {
+    read_ahead_chunks_.clear();
+    return chunks;
+  }
+
+  auto max_count = static_cast<std::size_t>(get_max_download_count());
+
+  // Modified files are uploaded whole and pinned files are cached whole, so
+  // both fetch every chunk regardless of how the file is being read
+  if (full_read_ahead_ || is_modified() ||
+      (read_ahead_policy_ == read_ahead_policy::full)) {
+    if (reader_chunk_ != read_chunk_) {
+      reader_next_chunk_ = reader_chunk_ = read_chunk_;
+    }
+
+    for (std::size_t idx = 0U;
+         (idx < read_state.size()) && (chunks.size() < max_count); ++idx) {
+      reader_next_chunk_ = reader_next_chunk_ + 1U >= read_state.size()
+                               ? 0U
+                               : reader_next_chunk_ + 1U;
+      if (not read_state[reader_next_chunk_]) {
+        chunks.push_back(reader_next_chunk_);
+      }
+    }
+
+    return chunks;
+  }
+
+  while (not read_ahead_chunks_.empty() && (chunks.size() < max_count)) {
+    auto chunk = read_ahead_chunks_.front();
+    read_ahead_chunks_.pop_front();
+    if ((chunk < read_state.size()) && not read_state[chunk]) {
+      chunks.push_back(chunk);
+    }
+  }
+
+  return chunks;
+}
+
+auto open_file::get_read_ahead_policy() const -> read_ahead_policy {
+  return read_ahead_policy_;
+}
+
 auto open_file::get_read_state() const -> boost::dynamic_bitset<> {
   recur_mutex_lock file_lock(get_mutex());
   return read_state_;
@@ -425,6 +559,48 @@ auto open_file::get_stop_requested() const -> bool {
 
 auto open_file::is_complete() const -> bool { return get_read_state().all(); }
 
+void open_file::read_ahead() {
+  // Each pass downloads one batch and then queues the next one behind other
+  // files' read ahead. The reader stops once there is nothing left to fetch
+  // and is scheduled again by the next read or write.
+  unique_recur_mutex_lock rw_lock(rw_mtx_);
+  auto chunks = get_next_read_ahead_chunks();
+  if (not chunks.empty()) {
+    rw_lock.unlock();
+
+    download_chunks(chunks, true, false);
+
+    io_engine::instance().schedule([this]() { read_ahead(); });
+    return;
+  }
+
+  // rw_mtx_ stays held so a window queued by a concurrent read either is seen
+  // above or reschedules the reader
+  mutex_lock reader_lock(reader_mtx_);
+  reader_scheduled_ = false;
+  reader_notify_.notify_all();
+}
+
+void open_file::release_chunks(const std::vector<std::size_t> &chunks,
+                               api_error err) {
+  std::vector<std::shared_ptr<download>> downloads;
+  {
+    recur_mutex_lock rw_lock(rw_mtx_);
+    for (const auto &chunk : chunks) {
+      if (err == api_error::success) {
+        set_read_state(chunk);
+      }
+
+      downloads.push_back(get_active_downloads().at(chunk));
+      get_active_downloads().erase(chunk);
+    }
+  }
+
+  for (auto &active_download : downloads) {
+    active_download->notify(err);
+  }
+}
+
 auto open_file::native_operation(
     i_open_file::native_operation_callback callback) -> api_error {
   if (get_stop_requested()) {
@@ -537,25 +713,14 @@ auto open_file::native_operation(
   set_modified();
 
   set_file_size(new_file_size);
+  update_reader(read_chunk_);
   auto now = std::to_string(utils::time::get_time_now());
-
-  if (is_unlinked()) {
-    auto meta = get_unlinked_meta();
-    meta[META_CHANGED] = now;
-    meta[META_MODIFIED] = now;
-    meta[META_SIZE] = std::to_string(new_file_size);
-    meta[META_WRITTEN] = now;
-    set_unlinked_meta(meta);
-    return api_error::success;
-  }
-
-  res = get_provider().set_item_meta(
-      get_api_path(), {
-                          {META_CHANGED, now},
-                          {META_MODIFIED, now},
-                          {META_SIZE, std::to_string(new_file_size)},
-                          {META_WRITTEN, now},
-                      });
+  res = set_pending_meta({
+      {META_CHANGED, now},
+      {META_MODIFIED, now},
+      {META_SIZE, std::to_string(new_file_size)},
+      {META_WRITTEN, now},
+  });
   if (res == api_error::success) {
     return res;
   }
@@ -565,8 +730,10 @@ auto open_file::native_operation(
   return set_api_error(res);
 }
 
-auto open_file::read(std::size_t read_size, std::uint64_t read_offset,
-                     data_buffer &data) -> api_error {
+auto open_file::read(std::uint64_t read_offset, data_span data,
+                     std::size_t &bytes_read) -> api_error {
+  bytes_read = 0U;
+
   if (is_directory()) {
     return set_api_error(api_error::invalid_operation);
   }
@@ -575,10 +742,9 @@ auto open_file::read(std::size_t read_size, std::uint64_t read_offset,
     return set_api_error(api_error::download_stopped);
   }
 
-  read_size =
-      utils::calculate_read_size(get_file_size(), read_size, read_offset);
+  auto read_size =
+      utils::calculate_read_size(get_file_size(), data.size(), read_offset);
   if (read_size == 0U) {
-    data.resize(0U);
     return api_error::success;
   }
 
@@ -587,16 +753,16 @@ auto open_file::read(std::size_t read_size, std::uint64_t read_offset,
     return res;
   }
 
-  const auto read_from_source = [this, &data, &read_offset,
+  const auto read_from_source = [this, &bytes_read, &data, &read_offset,
                                  &read_size]() -> api_error {
-    return do_io([this, &data, &read_offset, &read_size]() -> api_error {
+    return do_io([this, &bytes_read, &data, &read_offset,
+                  &read_size]() -> api_error {
       if (get_provider().is_read_only()) {
-        return get_provider().read_file_bytes(
-            get_api_path(), read_size, read_offset, data, stop_requested_);
+        return get_provider().read_file_bytes(get_api_path(), read_offset,
+                                              data.first(read_size),
+                                              bytes_read, stop_requested_);
       }
 
-      data.resize(read_size);
-      std::size_t bytes_read{};
       return nf_->read(data.data(), read_size, read_offset, &bytes_read)
                  ? api_error::success
                  : api_error::os_error;
@@ -612,7 +778,14 @@ auto open_file::read(std::size_t read_size, std::uint64_t read_offset,
   auto end_chunk =
       static_cast<std::size_t>((read_size + read_offset) / get_chunk_size());
 
-  update_reader(begin_chunk);
+  if (read_ahead_policy_ == read_ahead_policy::adaptive) {
+    recur_mutex_lock rw_lock(rw_mtx_);
+    auto window = access_pattern_.record(read_offset, read_size,
+                                         get_read_state().size());
+    read_ahead_chunks_.assign(window.begin(), window.end());
+  }
+
+  update_reader(end_chunk);
 
   download_range(begin_chunk, end_chunk, true);
   if (get_api_error() != api_error::success) {
@@ -632,6 +805,7 @@ void open_file::remove(std::uint64_t handle) {
       (get_api_error() == api_error::success)) {
     mgr_.queue_upload(*this);
     open_file_base::set_modified(false);
+    set_sync_requested(false);
   }
 
   if (is_removed() && (get_open_file_count() == 0U)) {
@@ -667,6 +841,10 @@ auto open_file::resize(std::uint64_t new_file_size) -> api_error {
       });
 }
 
+void open_file::set_max_download_count(std::uint8_t count) {
+  max_download_count_ = count;
+}
+
 void open_file::set_modified() {
   if (is_unlinked()) {
     if (not is_modified()) {
@@ -686,6 +864,10 @@ void open_file::set_modified() {
   }
 }
 
+void open_file::set_read_ahead_policy(read_ahead_policy policy) {
+  read_ahead_policy_ = policy;
+}
+
 void open_file::set_read_state(std::size_t chunk) {
   recur_mutex_lock file_lock(get_mutex());
   read_state_.set(chunk);
@@ -697,42 +879,24 @@ void open_file::set_read_state(boost::dynamic_bitset<> read_state) {
 }
 
 void open_file::update_reader(std::size_t chunk) {
-  recur_mutex_lock rw_lock(rw_mtx_);
-  read_chunk_ = chunk;
-
-  if (reader_thread_ || get_stop_requested()) {
-    return;
+  {
+    recur_mutex_lock rw_lock(rw_mtx_);
+    read_chunk_ = chunk;
   }
 
-  reader_thread_ = std::make_unique<std::thread>([this]() {
-    unique_recur_mutex_lock lock(rw_mtx_);
-    auto next_chunk{read_chunk_};
-    auto read_chunk{read_chunk_};
-    lock.unlock();
-
-    while (not get_stop_requested()) {
-      lock.lock();
-
-      auto read_state = get_read_state();
-      if ((get_file_size() == 0U) || read_state.all()) {
-        lock.unlock();
-        wait_for_io([this]() -> bool { return this->get_stop_requested(); });
-        continue;
-      }
-
-      if (read_chunk != read_chunk_) {
-        next_chunk = read_chunk = read_chunk_;
-      }
+  {
+    mutex_lock reader_lock(reader_mtx_);
+    if (reader_scheduled_ || get_stop_requested()) {
+      return;
+    }
 
-      next_chunk = next_chunk + 1U >= read_state.size() ? 0U : next_chunk + 1U;
-      lock.unlock();
+    reader_scheduled_ = true;
+  }
 
-      download_chunk(next_chunk, true, false);
-    }
-  });
+  io_engine::instance().schedule([this]() { read_ahead(); });
 }
 
-auto open_file::write(std::uint64_t write_offset, const data_buffer &data,
+auto open_file::write(std::uint64_t write_offset, data_cspan data,
                       std::size_t &bytes_written) -> api_error {
   REPERTORY_USES_FUNCTION_NAME();
 
@@ -755,55 +919,91 @@ auto open_file::write(std::uint64_t write_offset, const data_buffer &data,
     return res;
   }
 
+  auto write_end = write_offset + data.size();
   auto begin_chunk = static_cast<std::size_t>(write_offset / get_chunk_size());
   auto end_chunk =
-      static_cast<std::size_t>((write_offset + data.size()) / get_chunk_size());
+      static_cast<std::size_t>((write_end - 1U) / get_chunk_size());
 
-  update_reader(begin_chunk);
-
-  download_range(begin_chunk, std::min(get_read_state().size() - 1U, end_chunk),
-                 true);
+  auto chunks = claim_chunks(begin_chunk, end_chunk);
   if (get_api_error() != api_error::success) {
+    release_chunks(chunks, get_api_error());
     return get_api_error();
   }
 
-  unique_recur_mutex_lock rw_lock(rw_mtx_);
-  if ((write_offset + data.size()) > get_file_size()) {
-    res = resize(write_offset + data.size());
-    if (res != api_error::success) {
-      return res;
+  // Only the head of the first chunk and the tail of the last chunk survive the
+  // write, so fully covered chunks are never fetched
+  std::vector<std::pair<std::uint64_t, data_buffer>> gaps;
+  if (not chunks.empty()) {
+    auto chunk_count = get_read_state().size();
+    auto last_chunk_size = get_last_chunk_size();
+    for (const auto &chunk : chunks) {
+      auto chunk_begin = static_cast<std::uint64_t>(chunk) * get_chunk_size();
+      auto chunk_end =
+          chunk_begin + ((chunk == chunk_count - 1U) ? last_chunk_size
+                                                     : get_chunk_size());
+      if (write_offset > chunk_begin) {
+        gaps.emplace_back(chunk_begin, data_buffer{});
+        gaps.back().second.resize(static_cast<std::size_t>(
+            std::min(write_offset, chunk_end) - chunk_begin));
+      }
+
+      if (write_end < chunk_end) {
+        auto tail_begin = std::max(write_end, chunk_begin);
+        gaps.emplace_back(tail_begin, data_buffer{});
+        gaps.back().second.resize(
+            static_cast<std::size_t>(chunk_end - tail_begin));
+      }
+    }
+
+    for (auto &[gap_offset, gap_data] : gaps) {
+      reset_timeout();
+
+      auto gap_size = gap_data.size();
+      res = get_provider().read_file_bytes(get_api_path(), gap_size, gap_offset,
+                                           gap_data, stop_requested_);
+      if (res != api_error::success) {
+        release_chunks(chunks, set_api_error(res));
+        return res;
+      }
     }
   }
 
+  unique_recur_mutex_lock rw_lock(rw_mtx_);
   res = do_io([&]() -> api_error {
-    if (not nf_->write(data, write_offset, &bytes_written)) {
+    for (const auto &[gap_offset, gap_data] : gaps) {
+      if (not nf_->write(gap_data, gap_offset)) {
+        return api_error::os_error;
+      }
+    }
+
+    if (not nf_->write(data.data(), data.size(), write_offset,
+                       &bytes_written)) {
       return api_error::os_error;
     }
 
     reset_timeout();
     return api_error::success;
   });
+  release_chunks(chunks, res);
   if (res != api_error::success) {
     return set_api_error(res);
   }
 
-  auto now = std::to_string(utils::time::get_time_now());
-  if (is_unlinked()) {
-    auto meta = get_unlinked_meta();
-    meta[META_CHANGED] = now;
-    meta[META_MODIFIED] = now;
-    meta[META_WRITTEN] = now;
-    set_unlinked_meta(meta);
-    set_modified();
-
-    return api_error::success;
+  // Chunks past the current end are created valid, so growing the file here
+  // does not download anything
+  if (write_end > get_file_size()) {
+    res = resize(write_end);
+    if (res != api_error::success) {
+      return res;
+    }
   }
 
-  res = get_provider().set_item_meta(get_api_path(), {
-                                                         {META_CHANGED, now},
-                                                         {META_MODIFIED, now},
-                                                         {META_WRITTEN, now},
-                                                     });
+  auto now = std::to_string(utils::time::get_time_now());
+  res = set_pending_meta({
+      {META_CHANGED, now},
+      {META_MODIFIED, now},
+      {META_WRITTEN, now},
+  });
   if (res != api_error::success) {
     utils::error::raise_api_path_error(function_name, get_api_path(), res,
                                        "failed to set file meta");
@@ -811,6 +1011,10 @@ auto open_file::write(std::uint64_t write_offset, const data_buffer &data,
   }
 
   set_modified();
+
+  // Modified files are uploaded whole, so the reader now fetches every
+  // remaining chunk
+  update_reader(begin_chunk);
   return api_error::success;
 }
 } // namespace repertory
@@ -27,6 +27,8 @@
 #include "events/types/filesystem_item_handle_opened.hpp"
 #include "events/types/filesystem_item_opened.hpp"
 #include "providers/i_provider.hpp"
+#include "utils/common.hpp"
+#include "utils/error_utils.hpp"
 #include "utils/path.hpp"
 
 namespace repertory {
@@ -51,23 +53,6 @@ auto open_file_base::download::wait() -> api_error {
   return error_;
 }
 
-void open_file_base::io_item::action() {
-  result_ = action_();
-
-  mutex_lock lock(mtx_);
-  notify_.notify_all();
-}
-
-auto open_file_base::io_item::get_result() -> api_error {
-  unique_mutex_lock lock(mtx_);
-  if (result_.has_value()) {
-    return result_.value();
-  }
-
-  notify_.wait(lock, [this]() { return result_.has_value(); });
-  return result_.value_or(api_error::error);
-}
-
 open_file_base::open_file_base(std::uint64_t chunk_size,
                                std::uint8_t chunk_timeout, filesystem_item fsi,
                                i_provider &provider, bool disable_io)
@@ -88,7 +73,7 @@ open_file_base::open_file_base(
       open_data_(std::move(open_data)),
       provider_(provider) {
   if (not fsi.directory && not disable_io) {
-    io_thread_ = std::make_unique<std::thread>([this] { file_io_thread(); });
+    io_strand_ = std::make_shared<io_engine::strand>();
   }
 }
 
@@ -144,66 +129,63 @@ auto open_file_base::can_close() const -> bool {
 }
 
 auto open_file_base::close() -> bool {
-  unique_mutex_lock io_lock(io_thread_mtx_);
-  if (io_stop_requested_ || not io_thread_) {
-    io_thread_notify_.notify_all();
-    io_lock.unlock();
+  std::ignore = flush_pending_meta();
+
+  if (not io_strand_ || io_stop_requested_.exchange(true)) {
     return false;
   }
 
-  io_stop_requested_ = true;
-  io_thread_notify_.notify_all();
-  io_lock.unlock();
-
-  io_thread_->join();
-  io_thread_.reset();
-
+  io_strand_->wait();
   return true;
 }
 
-auto open_file_base::do_io(std::function<api_error()> action) -> api_error {
-  unique_mutex_lock io_lock(io_thread_mtx_);
-  auto item = std::make_shared<io_item>(action);
-  io_thread_queue_.emplace_back(item);
-  io_thread_notify_.notify_all();
-  io_lock.unlock();
+auto open_file_base::do_io(io_engine::action_t action) -> api_error {
+  if (not io_strand_) {
+    return action();
+  }
 
-  return item->get_result();
+  return io_engine::instance().execute(io_strand_, std::move(action));
 }
 
-void open_file_base::file_io_thread() {
-  unique_mutex_lock io_lock(io_thread_mtx_);
-  io_thread_notify_.notify_all();
-  io_lock.unlock();
+auto open_file_base::flush_pending_meta() -> api_error {
+  REPERTORY_USES_FUNCTION_NAME();
 
-  const auto process_queue = [&]() {
-    io_lock.lock();
-    if (not io_stop_requested_ && io_thread_queue_.empty()) {
-      io_thread_notify_.wait(io_lock, [this]() {
-        return io_stop_requested_ || not io_thread_queue_.empty();
-      });
-    }
+  mutex_lock flush_lock(meta_flush_mtx_);
 
-    while (not io_thread_queue_.empty()) {
-      auto *item = io_thread_queue_.front().get();
-      io_thread_notify_.notify_all();
-      io_lock.unlock();
+  unique_recur_mutex_lock file_lock(file_mtx_);
+  if (pending_meta_.empty()) {
+    return api_error::success;
+  }
 
-      item->action();
+  auto api_path = fsi_.api_path;
+  api_meta_map meta;
+  meta.swap(pending_meta_);
+  file_lock.unlock();
 
-      io_lock.lock();
-      io_thread_queue_.pop_front();
-    }
+  auto res = provider_.set_item_meta(api_path, meta);
+  if (res == api_error::success) {
+    return res;
+  }
 
-    io_thread_notify_.notify_all();
-    io_lock.unlock();
-  };
+  utils::error::raise_api_path_error(function_name, api_path, res,
+                                     "failed to flush pending meta");
 
-  while (not io_stop_requested_) {
-    process_queue();
+  // Keep the batch for the next flush. Values set while the provider call was
+  // in flight are newer and take precedence.
+  file_lock.lock();
+  if (unlinked_) {
+    return res;
   }
 
-  process_queue();
+  if (pending_meta_.empty()) {
+    pending_meta_time_ = std::chrono::system_clock::now();
+  }
+
+  for (auto &[key, value] : meta) {
+    pending_meta_.try_emplace(key, std::move(value));
+  }
+
+  return res;
 }
 
 auto open_file_base::get_api_error() const -> api_error {
@@ -254,6 +236,9 @@ void open_file_base::set_source_path(std::string source_path) {
 void open_file_base::set_unlinked(bool value) {
   recur_mutex_lock file_lock(file_mtx_);
   unlinked_ = value;
+  if (unlinked_) {
+    pending_meta_.clear();
+  }
 }
 
 void open_file_base::set_unlinked_meta(api_meta_map meta) {
@@ -305,6 +290,11 @@ auto open_file_base::get_open_file_count() const -> std::size_t {
   return open_data_.size();
 }
 
+auto open_file_base::get_pending_meta() const -> api_meta_map {
+  recur_mutex_lock file_lock(file_mtx_);
+  return pending_meta_;
+}
+
 auto open_file_base::get_source_path() const -> std::string {
   recur_mutex_lock file_lock(file_mtx_);
   return fsi_.source_path;
@@ -325,6 +315,16 @@ auto open_file_base::is_modified() const -> bool {
   return modified_;
 }
 
+auto open_file_base::is_pending_meta_expired() const -> bool {
+  recur_mutex_lock file_lock(file_mtx_);
+  if (pending_meta_.empty()) {
+    return false;
+  }
+
+  return std::chrono::system_clock::now() - pending_meta_time_ >=
+         std::chrono::seconds(meta_flush_interval_.load());
+}
+
 auto open_file_base::is_removed() const -> bool {
   recur_mutex_lock file_lock(file_mtx_);
   return removed_;
@@ -335,9 +335,15 @@ auto open_file_base::is_unlinked() const -> bool {
   return unlinked_;
 }
 
-void open_file_base::notify_io() {
-  mutex_lock io_lock(io_thread_mtx_);
-  io_thread_notify_.notify_all();
+auto open_file_base::read(std::size_t read_size, std::uint64_t read_offset,
+                          data_buffer &data) -> api_error {
+  data.resize(
+      utils::calculate_read_size(get_file_size(), read_size, read_offset));
+
+  std::size_t bytes_read{};
+  auto res = read(read_offset, data_span{data}, bytes_read);
+  data.resize(res == api_error::success ? bytes_read : 0U);
+  return res;
 }
 
 void open_file_base::remove(std::uint64_t handle) {
@@ -406,14 +412,37 @@ void open_file_base::set_api_path(std::string_view api_path) {
   fsi_.api_parent = utils::path::get_parent_api_path(api_path);
 }
 
-void open_file_base::wait_for_io(stop_type_callback stop_requested_cb) {
-  unique_mutex_lock io_lock(io_thread_mtx_);
-  if (not stop_requested_cb() && io_thread_queue_.empty()) {
-    io_thread_notify_.wait(io_lock, [this, &stop_requested_cb]() {
-      return stop_requested_cb() || not io_thread_queue_.empty();
-    });
+void open_file_base::set_meta_flush_interval(std::uint16_t seconds) {
+  meta_flush_interval_ = seconds;
+}
+
+auto open_file_base::set_pending_meta(const api_meta_map &meta) -> api_error {
+  unique_recur_mutex_lock file_lock(file_mtx_);
+  if (unlinked_) {
+    for (const auto &[key, value] : meta) {
+      unlinked_meta_[key] = value;
+    }
+    return api_error::success;
+  }
+
+  if (pending_meta_.empty()) {
+    pending_meta_time_ = std::chrono::system_clock::now();
+  }
+
+  for (const auto &[key, value] : meta) {
+    pending_meta_[key] = value;
   }
-  io_thread_notify_.notify_all();
-  io_lock.unlock();
+
+  if (meta_flush_interval_ != 0U) {
+    return api_error::success;
+  }
+  file_lock.unlock();
+
+  return flush_pending_meta();
+}
+
+auto open_file_base::write(std::uint64_t write_offset, const data_buffer &data,
+                           std::size_t &bytes_written) -> api_error {
+  return write(write_offset, data_cspan{data}, bytes_written);
 }
 } // namespace repertory
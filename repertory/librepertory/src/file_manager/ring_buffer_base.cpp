@@ -70,10 +70,10 @@ auto ring_buffer_base::check_start() -> api_error {
 
     event_system::instance().raise<download_begin>(
         get_api_path(), get_source_path(), function_name);
-    forward_reader_thread_ =
-        std::make_unique<std::thread>([this]() { reader_thread(true); });
-    reverse_reader_thread_ =
-        std::make_unique<std::thread>([this]() { reader_thread(false); });
+
+    mutex_lock chunk_lock(chunk_mtx_);
+    readers_started_ = true;
+    schedule_readers();
     return api_error::success;
   } catch (const std::exception &ex) {
     utils::error::raise_api_path_error(function_name, get_api_path(),
@@ -84,30 +84,24 @@ auto ring_buffer_base::check_start() -> api_error {
 }
 
 auto ring_buffer_base::close() -> bool {
-  stop_requested_ = true;
+  REPERTORY_USES_FUNCTION_NAME();
 
-  std::unique_ptr<std::thread> forward_reader_thread{nullptr};
-  std::unique_ptr<std::thread> reverse_reader_thread{nullptr};
+  stop_requested_ = true;
 
   unique_mutex_lock chunk_lock(chunk_mtx_);
   chunk_notify_.notify_all();
-  std::swap(forward_reader_thread, forward_reader_thread_);
-  std::swap(reverse_reader_thread, reverse_reader_thread_);
+  chunk_notify_.wait(chunk_lock, [this]() -> bool {
+    return not forward_reader_.scheduled && not reverse_reader_.scheduled;
+  });
   chunk_lock.unlock();
 
-  auto res = open_file_base::close();
-
-  if (forward_reader_thread) {
-    forward_reader_thread->join();
-    forward_reader_thread.reset();
-  }
-
-  if (reverse_reader_thread) {
-    reverse_reader_thread->join();
-    reverse_reader_thread.reset();
+  if (readers_started_.exchange(false)) {
+    event_system::instance().raise<download_end>(
+        get_api_path(), get_source_path(), api_error::download_stopped,
+        function_name);
   }
 
-  return res;
+  return open_file_base::close();
 }
 
 auto ring_buffer_base::download_chunk(std::size_t chunk, bool skip_active)
@@ -117,6 +111,7 @@ auto ring_buffer_base::download_chunk(std::size_t chunk, bool skip_active)
   unique_mutex_lock chunk_lock(chunk_mtx_);
   if (not skip_active) {
     ring_pos_ = chunk;
+    schedule_readers();
   }
 
   const auto notify_and_unlock = [this, &chunk_lock]() {
@@ -152,26 +147,25 @@ auto ring_buffer_base::download_chunk(std::size_t chunk, bool skip_active)
   auto active_download{std::make_shared<download>()};
   get_active_downloads()[chunk] = active_download;
 
-  return use_buffer(chunk, [&](data_buffer &buffer) -> api_error {
-    auto data_offset{chunk * get_chunk_size()};
-    auto data_size{
-        chunk == (total_chunks_ - 1U) ? get_last_chunk_size()
-                                      : get_chunk_size(),
-    };
-    notify_and_unlock();
+  auto data_offset{chunk * get_chunk_size()};
+  auto data_size{
+      chunk == (total_chunks_ - 1U) ? get_last_chunk_size() : get_chunk_size(),
+  };
 
-    auto result{
-        get_provider().read_file_bytes(get_api_path(), data_size, data_offset,
-                                       buffer, stop_requested_),
-    };
+  const auto read_bytes = [&](data_buffer &buffer) -> api_error {
+    return get_provider().read_file_bytes(get_api_path(), data_size,
+                                          data_offset, buffer, stop_requested_);
+  };
 
+  const auto complete = [&](api_error result,
+                            const auto &on_downloaded) -> api_error {
     chunk_lock.lock();
     if (chunk < ring_begin_ || chunk > ring_end_) {
       result = api_error::invalid_ring_buffer_position;
     }
 
     if (result == api_error::success) {
-      result = on_chunk_downloaded(chunk, buffer);
+      result = on_downloaded();
       if (result == api_error::success) {
         read_state_[chunk % read_state_.size()] = true;
         auto progress = (static_cast<double>(chunk + 1U) /
@@ -187,6 +181,23 @@ auto ring_buffer_base::download_chunk(std::size_t chunk, bool skip_active)
 
     active_download->notify(result);
     return result;
+  };
+
+  if (cache_ == nullptr) {
+    return use_buffer(chunk, [&](data_buffer &buffer) -> api_error {
+      notify_and_unlock();
+      return complete(read_bytes(buffer), [&]() -> api_error {
+        return on_chunk_downloaded(chunk, buffer);
+      });
+    });
+  }
+
+  notify_and_unlock();
+
+  chunk_cache::buffer_ptr buffer;
+  auto result{get_cached_chunk(chunk, buffer)};
+  return complete(result, [&]() -> api_error {
+    return on_chunk_cached(chunk, std::move(buffer));
   });
 }
 
@@ -194,6 +205,24 @@ void ring_buffer_base::forward(std::size_t count) {
   update_position(count, true);
 }
 
+auto ring_buffer_base::get_cached_chunk(std::size_t chunk,
+                                        chunk_cache::buffer_ptr &buffer)
+    -> api_error {
+  auto data_offset{chunk * get_chunk_size()};
+  auto data_size{
+      chunk == (total_chunks_ - 1U) ? get_last_chunk_size() : get_chunk_size(),
+  };
+
+  return cache_->get_or_load(
+      get_api_path(), cache_version_, chunk,
+      [&](data_buffer &data) -> api_error {
+        return get_provider().read_file_bytes(get_api_path(), data_size,
+                                              data_offset, data,
+                                              stop_requested_);
+      },
+      buffer);
+}
+
 auto ring_buffer_base::get_read_state() const -> boost::dynamic_bitset<> {
   recur_mutex_lock file_lock(get_mutex());
   return read_state_;
@@ -208,23 +237,25 @@ auto ring_buffer_base::get_stop_requested() const -> bool {
   return stop_requested_ || app_config::get_stop_requested();
 }
 
-auto ring_buffer_base::read(std::size_t read_size, std::uint64_t read_offset,
-                            data_buffer &data) -> api_error {
+auto ring_buffer_base::read(std::uint64_t read_offset, data_span data,
+                            std::size_t &bytes_read) -> api_error {
+  bytes_read = 0U;
+
   if (is_directory()) {
     return api_error::invalid_operation;
   }
 
   reset_timeout();
 
-  read_size =
-      utils::calculate_read_size(get_file_size(), read_size, read_offset);
+  auto read_size{
+      utils::calculate_read_size(get_file_size(), data.size(), read_offset),
+  };
   if (read_size == 0U) {
-    data.resize(0U);
     return api_error::success;
   }
 
   auto begin_chunk{static_cast<std::size_t>(read_offset / get_chunk_size())};
-  read_offset = read_offset - (begin_chunk * get_chunk_size());
+  auto chunk_offset{read_offset - (begin_chunk * get_chunk_size())};
 
   unique_mutex_lock read_lock(read_mtx_);
   auto res = check_start();
@@ -234,7 +265,7 @@ auto ring_buffer_base::read(std::size_t read_size, std::uint64_t read_offset,
 
   for (std::size_t chunk = begin_chunk;
        not get_stop_requested() && (res == api_error::success) &&
-       (read_size > 0U);
+       (bytes_read < read_size);
        ++chunk) {
     reset_timeout();
 
@@ -249,7 +280,12 @@ auto ring_buffer_base::read(std::size_t read_size, std::uint64_t read_offset,
         read_lock.unlock();
 
         // TODO limit retry
-        return read(read_size, read_offset, data);
+        std::size_t remaining_read{};
+        res = read(read_offset + bytes_read,
+                   data.subspan(bytes_read, read_size - bytes_read),
+                   remaining_read);
+        bytes_read += remaining_read;
+        return res;
       }
 
       return res;
@@ -257,33 +293,30 @@ auto ring_buffer_base::read(std::size_t read_size, std::uint64_t read_offset,
 
     reset_timeout();
 
-    std::size_t bytes_read{};
+    std::size_t chunk_read{};
     res = on_read_chunk(
-        chunk,
-        std::min(static_cast<std::size_t>(get_chunk_size() - read_offset),
-                 read_size),
-        read_offset, data, bytes_read);
+        chunk, chunk_offset,
+        data.subspan(bytes_read,
+                     std::min(static_cast<std::size_t>(get_chunk_size() -
+                                                       chunk_offset),
+                              read_size - bytes_read)),
+        chunk_read);
     if (res != api_error::success) {
       return res;
     }
 
     reset_timeout();
 
-    read_size -= bytes_read;
-    read_offset = 0U;
+    bytes_read += chunk_read;
+    chunk_offset = 0U;
   }
 
   return get_stop_requested() ? api_error::download_stopped : res;
 }
 
-void ring_buffer_base::reader_thread(bool is_forward) {
-  REPERTORY_USES_FUNCTION_NAME();
-
+void ring_buffer_base::read_ahead(bool is_forward) {
   unique_mutex_lock chunk_lock(chunk_mtx_);
-  const auto notify_and_unlock = [this, &chunk_lock]() {
-    chunk_notify_.notify_all();
-    chunk_lock.unlock();
-  };
+  auto &reader = is_forward ? forward_reader_ : reverse_reader_;
 
   const auto has_unread_forward = [this]() -> bool {
     auto ring_size = read_state_.size();
@@ -309,71 +342,83 @@ void ring_buffer_base::reader_thread(bool is_forward) {
     return false;
   };
 
-  auto last_marker = is_forward ? ring_pos_ : ring_begin_;
-  auto next_chunk = ring_pos_;
-  notify_and_unlock();
-
-  while (not get_stop_requested()) {
-    chunk_lock.lock();
-
+  // Each pass downloads at most one chunk and then queues the next pass
+  // behind other files' read ahead. A reader that finds nothing to download
+  // within one lap of the ring stops until schedule_readers() runs again.
+  for (std::size_t scanned = 0U;
+       not get_stop_requested() && scanned <= read_state_.size(); ++scanned) {
     if (is_forward) {
-      if (last_marker == ring_pos_) {
-        ++next_chunk;
+      if (reader.last_marker == ring_pos_) {
+        ++reader.next_chunk;
       } else {
-        next_chunk = ring_pos_ + 1U;
-        last_marker = ring_pos_;
+        reader.next_chunk = ring_pos_ + 1U;
+        reader.last_marker = ring_pos_;
       }
 
-      if (next_chunk > ring_end_) {
-        next_chunk = ring_pos_;
+      if (reader.next_chunk > ring_end_) {
+        reader.next_chunk = ring_pos_;
       }
-    } else if (last_marker != ring_begin_) {
-      last_marker = ring_begin_;
-      next_chunk = ring_pos_;
+    } else if (reader.last_marker != ring_begin_) {
+      reader.last_marker = ring_begin_;
+      reader.next_chunk = ring_pos_;
     }
 
-    if (next_chunk > ring_begin_) {
-      --next_chunk;
+    if (reader.next_chunk > ring_begin_) {
+      --reader.next_chunk;
     }
 
-    if (read_state_[next_chunk % read_state_.size()]) {
-      if (get_stop_requested()) {
-        notify_and_unlock();
-        break;
-      }
-
+    if (read_state_[reader.next_chunk % read_state_.size()]) {
       auto has_unread =
           is_forward ? has_unread_forward() : has_unread_reverse();
       if (not has_unread) {
-        chunk_notify_.wait(chunk_lock);
-        if (is_forward) {
-          last_marker = ring_pos_;
-          next_chunk = ring_pos_;
-        } else {
-          last_marker = ring_begin_;
-          next_chunk = ring_pos_;
-        }
+        break;
       }
 
-      notify_and_unlock();
       continue;
     }
 
-    notify_and_unlock();
+    auto next_chunk{reader.next_chunk};
+    chunk_lock.unlock();
+
     download_chunk(next_chunk, true);
-  }
 
-  if (is_forward) {
-    event_system::instance().raise<download_end>(
-        get_api_path(), get_source_path(), api_error::download_stopped,
-        function_name);
+    io_engine::instance().schedule(
+        [this, is_forward]() { read_ahead(is_forward); });
+    return;
   }
+
+  reader.scheduled = false;
+  chunk_notify_.notify_all();
 }
 
 void ring_buffer_base::reverse(std::size_t count) {
   update_position(count, false);
 }
 
+void ring_buffer_base::schedule_readers() {
+  if (not readers_started_ || get_stop_requested()) {
+    return;
+  }
+
+  if (not forward_reader_.scheduled) {
+    forward_reader_ = {
+        .last_marker = ring_pos_,
+        .next_chunk = ring_pos_,
+        .scheduled = true,
+    };
+    io_engine::instance().schedule([this]() { read_ahead(true); });
+  }
+
+  if (not reverse_reader_.scheduled) {
+    reverse_reader_ = {
+        .last_marker = ring_begin_,
+        .next_chunk = ring_pos_,
+        .scheduled = true,
+    };
+    io_engine::instance().schedule([this]() { read_ahead(false); });
+  }
+}
+
 void ring_buffer_base::set(std::size_t first_chunk, std::size_t current_chunk) {
   mutex_lock chunk_lock(chunk_mtx_);
   if (first_chunk >= total_chunks_) {
@@ -394,6 +439,7 @@ void ring_buffer_base::set(std::size_t first_chunk, std::size_t current_chunk) {
   ring_pos_ = current_chunk;
   read_state_.set(0U, read_state_.size(), true);
 
+  schedule_readers();
   chunk_notify_.notify_all();
 }
 
@@ -403,6 +449,13 @@ void ring_buffer_base::set_api_path(std::string_view api_path) {
   chunk_notify_.notify_all();
 }
 
+void ring_buffer_base::set_chunk_cache(chunk_cache *cache,
+                                       std::string version) {
+  mutex_lock chunk_lock(chunk_mtx_);
+  cache_ = cache;
+  cache_version_ = std::move(version);
+}
+
 void ring_buffer_base::update_position(std::size_t count, bool is_forward) {
   if (count == 0U) {
     return;
@@ -429,6 +482,7 @@ void ring_buffer_base::update_position(std::size_t count, bool is_forward) {
       }
     }
 
+    schedule_readers();
     chunk_notify_.notify_all();
   };
 
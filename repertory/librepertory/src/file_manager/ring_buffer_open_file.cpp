@@ -105,6 +105,8 @@ auto ring_buffer_open_file::on_check_start() -> bool {
                                          utils::get_last_error_code()));
   }
 
+  std::ignore = nf_->preallocate(0U, get_ring_size() * get_chunk_size());
+
   return false;
 }
 
@@ -121,25 +123,19 @@ auto ring_buffer_open_file::on_chunk_downloaded(
   });
 }
 
-auto ring_buffer_open_file::on_read_chunk(
-    std::size_t chunk, std::size_t read_size, std::uint64_t read_offset,
-    data_buffer &data, std::size_t &bytes_read) -> api_error {
-  data_buffer buffer(read_size);
-  auto res = do_io([&]() -> api_error {
+auto ring_buffer_open_file::on_read_chunk(std::size_t chunk,
+                                          std::uint64_t read_offset,
+                                          data_span data,
+                                          std::size_t &bytes_read)
+    -> api_error {
+  return do_io([&]() -> api_error {
     return nf_->read(
-               buffer,
+               data.data(), data.size(),
                (((chunk % get_ring_size()) * get_chunk_size()) + read_offset),
                &bytes_read)
                ? api_error::success
                : api_error::os_error;
   });
-
-  if (res != api_error::success) {
-    return res;
-  }
-
-  data.insert(data.end(), buffer.begin(), buffer.end());
-  return api_error::success;
 }
 
 auto ring_buffer_open_file::use_buffer(
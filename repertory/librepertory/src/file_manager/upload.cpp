@@ -30,25 +30,14 @@
 
 namespace repertory {
 upload::upload(filesystem_item fsi, i_provider &provider)
-    : fsi_(std::move(fsi)), provider_(provider) {
-  thread_ = std::make_unique<std::thread>([this] { upload_thread(); });
-}
-
-upload::~upload() {
-  stop();
-
-  thread_->join();
-  thread_.reset();
-}
+    : fsi_(std::move(fsi)), provider_(provider) {}
 
 void upload::cancel() {
   cancelled_ = true;
   stop();
 }
 
-void upload::stop() { stop_requested_ = true; }
-
-void upload::upload_thread() {
+void upload::execute() {
   REPERTORY_USES_FUNCTION_NAME();
 
   error_ =
@@ -64,4 +53,6 @@ void upload::upload_thread() {
       get_api_path(), cancelled_, get_api_error(), function_name,
       get_source_path());
 }
+
+void upload::stop() { stop_requested_ = true; }
 } // namespace repertory
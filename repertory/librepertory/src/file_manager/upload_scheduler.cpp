@@ -0,0 +1,142 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "file_manager/upload_scheduler.hpp"
+
+namespace repertory {
+void upload_scheduler::clear() {
+  active_.clear();
+  active_bytes_ = 0U;
+  queue_.clear();
+  queued_.clear();
+}
+
+auto upload_scheduler::get_next_ready_time() const
+    -> std::optional<std::chrono::steady_clock::time_point> {
+  auto now{std::chrono::steady_clock::now()};
+
+  std::optional<std::chrono::steady_clock::time_point> ret;
+  for (const auto &item : queue_) {
+    if (item.second.ready_time <= now) {
+      continue;
+    }
+
+    if (not ret.has_value() || item.second.ready_time < ret.value()) {
+      ret = item.second.ready_time;
+    }
+  }
+
+  return ret;
+}
+
+auto upload_scheduler::get_priority(std::uint64_t file_size,
+                                    bool sync_requested) -> upload_priority {
+  if (sync_requested) {
+    return upload_priority::sync_requested;
+  }
+
+  return file_size <= small_file_size ? upload_priority::small_file
+                                      : upload_priority::normal;
+}
+
+auto upload_scheduler::is_active(std::string_view api_path) const -> bool {
+  return active_.contains(std::string{api_path});
+}
+
+auto upload_scheduler::is_queued(std::string_view api_path) const -> bool {
+  return queued_.contains(std::string{api_path});
+}
+
+auto upload_scheduler::pop(std::size_t max_count, std::uint64_t max_bytes)
+    -> std::optional<entry> {
+  if (active_.size() >= max_count) {
+    return std::nullopt;
+  }
+
+  auto now{std::chrono::steady_clock::now()};
+  for (auto iter = queue_.begin(); iter != queue_.end(); ++iter) {
+    const auto &item{iter->second};
+    if (item.ready_time > now || active_.contains(item.api_path)) {
+      continue;
+    }
+
+    if (max_bytes != 0U && not active_.empty() &&
+        (active_bytes_ + item.file_size) > max_bytes) {
+      continue;
+    }
+
+    auto ret{std::move(iter->second)};
+    queued_.erase(ret.api_path);
+    queue_.erase(iter);
+
+    active_[ret.api_path] = ret.file_size;
+    active_bytes_ += ret.file_size;
+    return ret;
+  }
+
+  return std::nullopt;
+}
+
+auto upload_scheduler::push(entry item) -> bool {
+  auto queued_iter = queued_.find(item.api_path);
+  if (queued_iter == queued_.end()) {
+    key_t key{item.priority, next_id_++};
+    queued_[item.api_path] = key;
+    queue_[key] = std::move(item);
+    return true;
+  }
+
+  auto key{queued_iter->second};
+  auto existing{std::move(queue_.at(key))};
+  queue_.erase(key);
+
+  existing.file_size = item.file_size;
+  existing.priority = std::min(existing.priority, item.priority);
+  existing.ready_time = std::min(existing.ready_time, item.ready_time);
+  existing.source_path = std::move(item.source_path);
+
+  key.first = existing.priority;
+  queued_iter->second = key;
+  queue_[key] = std::move(existing);
+  return false;
+}
+
+void upload_scheduler::release(std::string_view api_path) {
+  auto iter = active_.find(std::string{api_path});
+  if (iter == active_.end()) {
+    return;
+  }
+
+  active_bytes_ -= iter->second;
+  active_.erase(iter);
+}
+
+auto upload_scheduler::remove(std::string_view api_path) -> bool {
+  auto iter = queued_.find(std::string{api_path});
+  if (iter == queued_.end()) {
+    return false;
+  }
+
+  queue_.erase(iter->second);
+  queued_.erase(iter);
+  return true;
+}
+} // namespace repertory
@@ -27,6 +27,7 @@
 #include "events/types/directory_remove_failed.hpp"
 #include "events/types/directory_removed.hpp"
 #include "events/types/directory_removed_externally.hpp"
+#include "events/types/file_changed_externally.hpp"
 #include "events/types/file_remove_failed.hpp"
 #include "events/types/file_removed.hpp"
 #include "events/types/file_removed_externally.hpp"
@@ -51,7 +52,8 @@
 #include "utils/time.hpp"
 
 namespace repertory {
-void base_provider::add_all_items(stop_type &stop_requested) {
+auto base_provider::add_all_items(stop_type &stop_requested,
+                                  listing_snapshot &snapshot) -> bool {
   const auto get_stop_requested = [&stop_requested]() -> bool {
     return stop_requested || app_config::get_stop_requested();
   };
@@ -62,11 +64,24 @@ void base_provider::add_all_items(stop_type &stop_requested) {
   std::string marker;
   auto res{api_error::more_data};
   while (not get_stop_requested() && res == api_error::more_data) {
+    list.clear();
     res = get_file_list(list, marker);
     if (res != api_error::success && res != api_error::more_data) {
       utils::error::raise_error(function_name, res, "failed to get file list");
+      return false;
     }
+
+    for (const auto &file : list) {
+      snapshot.add(file);
+    }
+  }
+
+  if (get_stop_requested()) {
+    return false;
   }
+
+  snapshot.seal();
+  return true;
 }
 
 auto base_provider::create_api_file(std::string_view path, std::string_view key,
@@ -257,6 +272,7 @@ auto base_provider::create_file(std::string_view api_path, api_meta_map &meta)
     res = upload_file(api_path, meta[META_SOURCE], stop_requested);
     if (res != api_error::success) {
       meta_db_->remove_api_path(api_path);
+      invalidate_listing(api_path);
     }
 
     return res;
@@ -327,62 +343,30 @@ auto base_provider::get_directory_item(std::string_view api_path,
 auto base_provider::get_directory_items(std::string_view api_path,
                                         directory_item_list &list) const
     -> api_error {
-  REPERTORY_USES_FUNCTION_NAME();
-
-  try {
-    bool exists{};
-    auto res = is_directory(api_path, exists);
-    if (res != api_error::success) {
-      return res;
-    }
-
-    if (not exists) {
-      res = is_file(api_path, exists);
-      if (res != api_error::success) {
-        utils::error::raise_api_path_error(
-            function_name, api_path, res, "failed to determine if file exists");
-      }
-
-      return exists ? api_error::item_exists : api_error::directory_not_found;
-    }
-
-    res = get_directory_items_impl(api_path, list);
-    if (res != api_error::success) {
-      return res;
-    }
-  } catch (const std::exception &e) {
-    utils::error::raise_api_path_error(function_name, api_path, e,
-                                       "failed to get directory items");
-    return api_error::error;
+  listing_cache::list_ptr cached;
+  auto res = listing_cache_.get(
+      api_path,
+      std::chrono::seconds(config_.get_directory_cache_timeout_secs()),
+      cached);
+  if (res != api_error::success) {
+    return res;
   }
 
-  std::sort(list.begin(), list.end(),
-            [](const auto &item1, const auto &item2) -> bool {
-              return (item1.directory && not item2.directory) ||
-                     (not(item2.directory && not item1.directory) &&
-                      (item1.api_path.compare(item2.api_path) < 0));
-            });
+  list.clear();
+  list.reserve(cached->size() + 2U);
+  for (const auto *name : {".", ".."}) {
+    list.push_back(directory_item{
+        name,
+        "",
+        true,
+        0U,
+        {
+            {META_DIRECTORY, utils::string::from_bool(true)},
+        },
+    });
+  }
+  list.insert(list.end(), cached->begin(), cached->end());
 
-  list.insert(list.begin(),
-              directory_item{
-                  "..",
-                  "",
-                  true,
-                  0U,
-                  {
-                      {META_DIRECTORY, utils::string::from_bool(true)},
-                  },
-              });
-  list.insert(list.begin(),
-              directory_item{
-                  ".",
-                  "",
-                  true,
-                  0U,
-                  {
-                      {META_DIRECTORY, utils::string::from_bool(true)},
-                  },
-              });
   return api_error::success;
 }
 
@@ -477,6 +461,68 @@ auto base_provider::get_used_drive_space() const -> std::uint64_t {
   return meta_db_->get_total_size();
 }
 
+void base_provider::invalidate_listing(std::string_view api_path) {
+  listing_cache_.invalidate(utils::path::get_parent_api_path(api_path));
+  listing_cache_.invalidate(api_path);
+}
+
+auto base_provider::is_changed_externally(std::string_view api_path,
+                                          const listing_snapshot::entry &item)
+    -> bool {
+  const auto *previous{previous_snapshot_.find(api_path)};
+  if (previous == nullptr || previous->directory ||
+      (previous->modified_date == item.modified_date &&
+       previous->size == item.size)) {
+    return false;
+  }
+
+  // The first change observed after one of our own uploads is expected.
+  mutex_lock uploaded_lock(uploaded_mtx_);
+  return uploaded_paths_.erase(std::string{api_path}) == 0U;
+}
+
+auto base_provider::load_directory_items(std::string_view api_path,
+                                         directory_item_list &list) const
+    -> api_error {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  try {
+    bool exists{};
+    auto res = is_directory(api_path, exists);
+    if (res != api_error::success) {
+      return res;
+    }
+
+    if (not exists) {
+      res = is_file(api_path, exists);
+      if (res != api_error::success) {
+        utils::error::raise_api_path_error(
+            function_name, api_path, res, "failed to determine if file exists");
+      }
+
+      return exists ? api_error::item_exists : api_error::directory_not_found;
+    }
+
+    res = get_directory_items_impl(api_path, list);
+    if (res != api_error::success) {
+      return res;
+    }
+  } catch (const std::exception &e) {
+    utils::error::raise_api_path_error(function_name, api_path, e,
+                                       "failed to get directory items");
+    return api_error::error;
+  }
+
+  std::sort(list.begin(), list.end(),
+            [](const auto &item1, const auto &item2) -> bool {
+              return (item1.directory && not item2.directory) ||
+                     (not(item2.directory && not item1.directory) &&
+                      (item1.api_path.compare(item2.api_path) < 0));
+            });
+
+  return api_error::success;
+}
+
 void base_provider::process_removed_directories(
     std::deque<removed_item> removed_list, stop_type &stop_requested) {
   REPERTORY_USES_FUNCTION_NAME();
@@ -495,6 +541,7 @@ void base_provider::process_removed_directories(
     }
 
     meta_db_->remove_api_path(item.api_path);
+    invalidate_listing(item.api_path);
     event_system::instance().raise<directory_removed_externally>(
         item.api_path, function_name, item.source_path);
   }
@@ -522,6 +569,7 @@ void base_provider::process_removed_files(std::deque<removed_item> removed_list,
 
     if (not utils::file::file{item.source_path}.exists()) {
       meta_db_->remove_api_path(item.api_path);
+      invalidate_listing(item.api_path);
       event_system::instance().raise<file_removed_externally>(
           item.api_path, function_name, item.source_path);
       continue;
@@ -566,73 +614,162 @@ void base_provider::process_removed_files(std::deque<removed_item> removed_list,
     }
 
     meta_db_->remove_api_path(item.api_path);
+    invalidate_listing(item.api_path);
     event_system::instance().raise<file_removed_externally>(
         item.api_path, function_name, item.source_path);
   }
 }
 
-void base_provider::process_removed_items(stop_type &stop_requested) {
+auto base_provider::process_changed_file(std::string_view api_path,
+                                         const listing_snapshot::entry &item,
+                                         api_meta_map &meta) -> bool {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  if (fm_->is_processing(api_path)) {
+    return false;
+  }
+
+  const auto &source_path{meta[META_SOURCE]};
+  if (not source_path.empty() && utils::file::file{source_path}.exists() &&
+      not fm_->evict_file(api_path)) {
+    return false;
+  }
+
+  auto res = meta_db_->set_item_meta(
+      api_path, {
+                    {META_MODIFIED, std::to_string(item.modified_date)},
+                    {META_SIZE, std::to_string(item.size)},
+                    {META_WRITTEN, std::to_string(item.modified_date)},
+                });
+  if (res != api_error::success) {
+    utils::error::raise_api_path_error(function_name, api_path, res,
+                                       "failed to update changed item meta");
+    return false;
+  }
+
+  invalidate_listing(api_path);
+
+  event_system::instance().raise<file_changed_externally>(
+      api_path, function_name, source_path);
+  return true;
+}
+
+auto base_provider::read_file_bytes(std::string_view api_path,
+                                    std::uint64_t offset, data_span data,
+                                    std::size_t &bytes_read,
+                                    stop_type &stop_requested) -> api_error {
+  bytes_read = 0U;
+
+  // Remote providers receive into a response buffer owned by the transport
+  data_buffer buffer;
+  auto res{
+      read_file_bytes(api_path, data.size(), offset, buffer, stop_requested),
+  };
+  if (res != api_error::success) {
+    return res;
+  }
+
+  bytes_read = std::min(buffer.size(), data.size());
+  std::memcpy(data.data(), buffer.data(), bytes_read);
+  return api_error::success;
+}
+
+void base_provider::reconcile_items(listing_snapshot &snapshot,
+                                    stop_type &stop_requested) {
   const auto get_stop_requested = [&stop_requested]() -> bool {
     return stop_requested || app_config::get_stop_requested();
   };
 
-  meta_db_->enumerate_api_path_list(
-      [this, &get_stop_requested](auto &&list) {
-        [[maybe_unused]] auto res =
-            std::all_of(list.begin(), list.end(), [&](auto &&api_path) -> bool {
-              if (get_stop_requested()) {
-                return false;
-              }
-
-              tasks::instance().schedule({
-                  [this, api_path](auto &&task_stopped) {
-                    api_meta_map meta{};
-                    auto result = get_item_meta(api_path, meta);
-                    if (result != api_error::success) {
-                      return;
-                    }
-
-                    if (utils::string::to_bool(meta[META_DIRECTORY])) {
-                      bool exists{};
-                      if (is_directory(api_path, exists) !=
-                          api_error::success) {
-                        return;
-                      }
-
-                      if (exists) {
-                        return;
-                      }
-
-                      process_removed_directories(
-                          {
-                              removed_item{api_path, true, ""},
-                          },
-                          task_stopped);
-
-                      return;
-                    }
-
-                    bool exists{};
-                    if (is_file(api_path, exists) != api_error::success) {
-                      return;
-                    }
-
-                    if (exists) {
-                      return;
-                    }
-
-                    process_removed_files(
-                        {
-                            removed_item{api_path, false, meta[META_SOURCE]},
-                        },
-                        task_stopped);
-                  },
-              });
-
-              return not get_stop_requested();
-            });
-      },
-      get_stop_requested);
+  std::deque<removed_item> removed_list;
+  std::vector<listing_snapshot::entry> skipped_list;
+  const auto reconcile_item = [&](const std::string &api_path) {
+    api_meta_map meta{};
+    if (meta_db_->get_item_meta(api_path, meta) != api_error::success) {
+      return;
+    }
+
+    auto directory{utils::string::to_bool(meta[META_DIRECTORY])};
+    const auto *item{snapshot.find(api_path)};
+    if (item != nullptr && item->directory == directory) {
+      if (not directory && is_change_detection_supported() &&
+          is_changed_externally(api_path, *item) &&
+          not process_changed_file(api_path, *item, meta)) {
+        // Keep the previous entry so the next pass detects the change again
+        skipped_list.push_back(*previous_snapshot_.find(api_path));
+      }
+      return;
+    }
+
+    // Missing from a complete listing; confirm before removing since the
+    // item may have been created or uploaded after its page was listed.
+    // Empty directories never appear in a file listing.
+    if (fm_->is_processing(api_path)) {
+      return;
+    }
+
+    bool exists{};
+    auto res{
+        directory ? is_directory(api_path, exists) : is_file(api_path, exists),
+    };
+    if (res != api_error::success || exists) {
+      return;
+    }
+
+    removed_list.emplace_back(removed_item{
+        api_path,
+        directory,
+        directory ? "" : meta[META_SOURCE],
+    });
+  };
+
+  // The meta DB is walked in api path order starting after the cursor saved
+  // by an interrupted pass, wrapping around to finish at that cursor.
+  auto start_cursor{reconcile_cursor_};
+  auto cursor{start_cursor};
+  auto wrapped{start_cursor.empty()};
+  auto done{false};
+  while (not done && not get_stop_requested()) {
+    auto list{meta_db_->get_api_path_list(cursor, reconcile_page_size)};
+    if (list.empty()) {
+      if (wrapped) {
+        break;
+      }
+
+      wrapped = true;
+      cursor.clear();
+      continue;
+    }
+
+    for (const auto &api_path : list) {
+      if (get_stop_requested()) {
+        break;
+      }
+
+      if (wrapped && not start_cursor.empty() && api_path > start_cursor) {
+        done = true;
+        break;
+      }
+
+      reconcile_item(api_path);
+      cursor = api_path;
+    }
+  }
+
+  process_removed_files(removed_list, stop_requested);
+  process_removed_directories(removed_list, stop_requested);
+
+  if (get_stop_requested()) {
+    reconcile_cursor_ = cursor;
+    return;
+  }
+
+  reconcile_cursor_.clear();
+  if (is_change_detection_supported()) {
+    for (const auto &previous : skipped_list) {
+      snapshot.update(previous);
+    }
+    previous_snapshot_ = std::move(snapshot);
+  }
 }
 
 void base_provider::remove_deleted_items(stop_type &stop_requested) {
@@ -640,8 +777,10 @@ void base_provider::remove_deleted_items(stop_type &stop_requested) {
     return stop_requested || app_config::get_stop_requested();
   };
 
-  add_all_items(stop_requested);
-  if (get_stop_requested()) {
+  auto listing_start{utils::time::get_time_now()};
+
+  listing_snapshot snapshot;
+  if (not add_all_items(stop_requested, snapshot)) {
     return;
   }
 
@@ -650,7 +789,18 @@ void base_provider::remove_deleted_items(stop_type &stop_requested) {
     return;
   }
 
-  process_removed_items(stop_requested);
+  reconcile_items(snapshot, stop_requested);
+  if (get_stop_requested()) {
+    return;
+  }
+
+  // Every upload finished before the previous listing started has been
+  // observed by now.
+  mutex_lock uploaded_lock(uploaded_mtx_);
+  std::erase_if(uploaded_paths_, [this](auto &&item) -> bool {
+    return item.second < previous_listing_start_;
+  });
+  previous_listing_start_ = listing_start;
 }
 
 auto base_provider::remove_file(std::string_view api_path) -> api_error {
@@ -671,6 +821,7 @@ auto base_provider::remove_file(std::string_view api_path) -> api_error {
     api_meta_map meta{};
     auto res = get_item_meta(api_path, meta);
     meta_db_->remove_api_path(api_path);
+    invalidate_listing(api_path);
     return notify_end(res);
   };
 
@@ -731,13 +882,16 @@ auto base_provider::remove_directory(std::string_view api_path) -> api_error {
   }
 
   meta_db_->remove_api_path(api_path);
+  invalidate_listing(api_path);
 
   return notify_end(api_error::success);
 }
 
 auto base_provider::remove_item_meta(std::string_view api_path,
                                      std::string_view key) -> api_error {
-  return meta_db_->remove_item_meta(api_path, key);
+  auto ret = meta_db_->remove_item_meta(api_path, key);
+  invalidate_listing(api_path);
+  return ret;
 }
 
 void base_provider::remove_unmatched_source_files(stop_type &stop_requested) {
@@ -802,6 +956,8 @@ auto base_provider::set_item_meta(std::string_view api_path,
     return ret;
   }
 
+  invalidate_listing(api_path);
+
   if (key == META_PINNED && utils::string::to_bool(std::string{value})) {
     if (fm_ == nullptr || not fm_->download_pinned_file(api_path)) {
       utils::error::raise_api_path_error(function_name, api_path,
@@ -821,6 +977,8 @@ auto base_provider::set_item_meta(std::string_view api_path, api_meta_map meta)
     return ret;
   }
 
+  invalidate_listing(api_path);
+
   if (meta.contains(META_PINNED) &&
       utils::string::to_bool(meta.at(META_PINNED))) {
     if (fm_ == nullptr || not fm_->download_pinned_file(api_path)) {
@@ -885,6 +1043,7 @@ auto base_provider::start(api_item_added_callback api_item_added,
   }
 
   cache_size_mgr::instance().initialize(&config_);
+  listing_cache_.start();
 
   polling::instance().set_callback({
       "check_deleted",
@@ -898,6 +1057,8 @@ auto base_provider::start(api_item_added_callback api_item_added,
 void base_provider::stop() {
   cache_size_mgr::instance().stop();
   polling::instance().remove_callback("check_deleted");
+  listing_cache_.stop();
+  listing_cache_.clear();
   meta_db_.reset();
 }
 
@@ -917,7 +1078,13 @@ auto base_provider::upload_file(std::string_view api_path,
     event_system::instance().raise<provider_upload_begin>(
         api_path, function_name, source_path);
 
-    return notify_end(upload_file_impl(api_path, source_path, stop_requested));
+    auto res{upload_file_impl(api_path, source_path, stop_requested)};
+    if (res == api_error::success && is_change_detection_supported()) {
+      mutex_lock uploaded_lock(uploaded_mtx_);
+      uploaded_paths_[std::string{api_path}] = utils::time::get_time_now();
+    }
+
+    return notify_end(res);
   } catch (const std::exception &e) {
     utils::error::raise_error(function_name, e, "exception occurred");
   }
@@ -761,8 +761,25 @@ auto encrypt_provider::read_file_bytes(std::string_view api_path,
                                        std::size_t size, std::uint64_t offset,
                                        data_buffer &data,
                                        stop_type &stop_requested) -> api_error {
+  data.resize(size);
+
+  std::size_t bytes_read{};
+  auto res{
+      read_file_bytes(api_path, offset, data_span{data}, bytes_read,
+                      stop_requested),
+  };
+  data.resize(res == api_error::success ? bytes_read : 0U);
+  return res;
+}
+
+auto encrypt_provider::read_file_bytes(std::string_view api_path,
+                                       std::uint64_t offset, data_span data,
+                                       std::size_t &bytes_read,
+                                       stop_type &stop_requested) -> api_error {
   REPERTORY_USES_FUNCTION_NAME();
 
+  bytes_read = 0U;
+
   i_file_db::file_data file_data{};
   auto res{file_db_->get_file_data(api_path, file_data)};
   if (res != api_error::success) {
@@ -816,7 +833,7 @@ auto encrypt_provider::read_file_bytes(std::string_view api_path,
     reader_lookup_[file_data.source_path] = info;
   }
 
-  if (file_size == 0U || size == 0U) {
+  if (file_size == 0U || data.empty()) {
     return api_error::success;
   }
 
@@ -826,14 +843,23 @@ auto encrypt_provider::read_file_bytes(std::string_view api_path,
 
   mutex_lock reader_lock(info->reader_mtx);
   info->reader->set_read_position(offset);
-  data.resize(size);
 
   auto ret{
       utils::encryption::encrypting_reader::reader_function(
           reinterpret_cast<char *>(data.data()), 1U, data.size(),
           info->reader.get()),
   };
-  return ret == 0 ? api_error::os_error : api_error::success;
+  if (ret == 0U) {
+    return api_error::os_error;
+  }
+
+  if (ret == static_cast<std::size_t>(CURL_READFUNC_ABORT)) {
+    return api_error::download_stopped;
+  }
+
+  // Reads that extend past the end of the file are short
+  bytes_read = ret;
+  return api_error::success;
 }
 
 void encrypt_provider::remove_deleted_files(stop_type &stop_requested) {
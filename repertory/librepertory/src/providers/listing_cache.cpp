@@ -0,0 +1,185 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "providers/listing_cache.hpp"
+
+#include "utils/error_utils.hpp"
+
+namespace repertory {
+void listing_cache::clear() {
+  mutex_lock lock(get_mutex());
+  entries_.clear();
+  for (auto &item : loading_) {
+    item.second.invalidated = true;
+  }
+}
+
+void listing_cache::evict_oldest() {
+  auto oldest = std::ranges::min_element(
+      entries_, [](auto &&item1, auto &&item2) -> bool {
+        return item1.second.last_used < item2.second.last_used;
+      });
+  if (oldest != entries_.end()) {
+    entries_.erase(oldest);
+  }
+}
+
+auto listing_cache::get(std::string_view api_path,
+                        std::chrono::milliseconds timeout, list_ptr &list)
+    -> api_error {
+  list.reset();
+
+  if (timeout.count() == 0) {
+    return load(api_path, false, list);
+  }
+
+  unique_mutex_lock lock(get_mutex());
+  auto iter = entries_.find(std::string{api_path});
+  if (iter != entries_.end()) {
+    auto &cached = iter->second;
+    auto age = std::chrono::steady_clock::now() - cached.fetched;
+    if (age < timeout) {
+      cached.last_used = ++use_count_;
+      list = cached.list;
+      return api_error::success;
+    }
+
+    if (running_ && age < (timeout * 2)) {
+      if (not cached.refreshing) {
+        cached.refreshing = true;
+        pending_.emplace_back(api_path);
+        get_notify().notify_all();
+      }
+
+      cached.last_used = ++use_count_;
+      list = cached.list;
+      return api_error::success;
+    }
+  }
+  lock.unlock();
+
+  return load(api_path, true, list);
+}
+
+auto listing_cache::get_size() const -> std::size_t {
+  mutex_lock lock(get_mutex());
+  return entries_.size();
+}
+
+void listing_cache::invalidate(std::string_view api_path) {
+  mutex_lock lock(get_mutex());
+  entries_.erase(std::string{api_path});
+
+  auto iter = loading_.find(std::string{api_path});
+  if (iter != loading_.end()) {
+    iter->second.invalidated = true;
+  }
+}
+
+auto listing_cache::load(std::string_view api_path, bool cacheable,
+                         list_ptr &list) -> api_error {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  std::string key{api_path};
+  if (cacheable) {
+    mutex_lock lock(get_mutex());
+    ++loading_[key].count;
+  }
+
+  directory_item_list items;
+  api_error res{};
+  try {
+    res = loader_(api_path, items);
+  } catch (const std::exception &e) {
+    utils::error::raise_api_path_error(function_name, api_path, e,
+                                       "failed to load directory listing");
+    res = api_error::error;
+  }
+
+  if (res == api_error::success) {
+    list = std::make_shared<const directory_item_list>(std::move(items));
+  }
+
+  if (not cacheable) {
+    return res;
+  }
+
+  mutex_lock lock(get_mutex());
+  auto &state = loading_.at(key);
+  // A create, remove or rename that raced this load makes the result stale.
+  auto invalidated{state.invalidated};
+  if (--state.count == 0U) {
+    loading_.erase(key);
+  }
+
+  if (res != api_error::success) {
+    entries_.erase(key);
+    return res;
+  }
+
+  if (invalidated) {
+    return res;
+  }
+
+  if (not entries_.contains(key) && entries_.size() >= max_entries_) {
+    evict_oldest();
+  }
+
+  entries_[key] = entry{
+      .fetched = std::chrono::steady_clock::now(),
+      .last_used = ++use_count_,
+      .list = list,
+      .refreshing = false,
+  };
+
+  return res;
+}
+
+// Called by single_thread_service_base::start() while holding the mutex.
+void listing_cache::on_start() { running_ = true; }
+
+void listing_cache::on_stop() {
+  mutex_lock lock(get_mutex());
+  running_ = false;
+  pending_.clear();
+  for (auto &item : entries_) {
+    item.second.refreshing = false;
+  }
+}
+
+void listing_cache::service_function() {
+  unique_mutex_lock lock(get_mutex());
+  while (not get_stop_requested() && pending_.empty()) {
+    get_notify().wait(lock);
+  }
+
+  if (get_stop_requested()) {
+    return;
+  }
+
+  auto api_path = pending_.front();
+  pending_.pop_front();
+  lock.unlock();
+
+  list_ptr list;
+  std::ignore = load(api_path, true, list);
+}
+} // namespace repertory
@@ -0,0 +1,106 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "providers/listing_snapshot.hpp"
+
+#include "utils/path.hpp"
+
+namespace repertory {
+void listing_snapshot::add(const api_file &file) {
+  entries_.push_back(entry{
+      .api_path = file.api_path,
+      .directory = false,
+      .modified_date = file.modified_date,
+      .size = file.file_size,
+  });
+
+  // Listings are usually grouped by prefix, so only walk the ancestors when
+  // the parent changes; seal() removes any remaining duplicates.
+  auto parent{utils::path::get_parent_api_path(file.api_path)};
+  if (parent == last_parent_) {
+    return;
+  }
+
+  last_parent_ = parent;
+  while (parent != "/") {
+    entries_.push_back(entry{.api_path = parent, .directory = true});
+    parent = utils::path::get_parent_api_path(parent);
+  }
+}
+
+void listing_snapshot::clear() {
+  entries_.clear();
+  entries_.shrink_to_fit();
+  last_parent_.clear();
+  pos_ = 0U;
+}
+
+auto listing_snapshot::find(std::string_view api_path) -> const entry * {
+  if (pos_ > 0U && entries_.at(pos_ - 1U).api_path >= api_path) {
+    pos_ = static_cast<std::size_t>(std::distance(
+        entries_.begin(),
+        std::lower_bound(entries_.begin(), entries_.end(), api_path,
+                         [](const entry &item, std::string_view path) -> bool {
+                           return item.api_path < path;
+                         })));
+  }
+
+  while (pos_ < entries_.size() && entries_.at(pos_).api_path < api_path) {
+    ++pos_;
+  }
+
+  if (pos_ < entries_.size() && entries_.at(pos_).api_path == api_path) {
+    return &entries_.at(pos_++);
+  }
+
+  return nullptr;
+}
+
+void listing_snapshot::seal() {
+  entries_.push_back(entry{.api_path = "/", .directory = true});
+
+  std::stable_sort(entries_.begin(), entries_.end(),
+                   [](const entry &lhs, const entry &rhs) -> bool {
+                     return lhs.api_path < rhs.api_path;
+                   });
+  entries_.erase(std::unique(entries_.begin(), entries_.end(),
+                             [](const entry &lhs, const entry &rhs) -> bool {
+                               return lhs.api_path == rhs.api_path;
+                             }),
+                 entries_.end());
+  entries_.shrink_to_fit();
+
+  last_parent_.clear();
+  pos_ = 0U;
+}
+
+void listing_snapshot::update(const entry &item) {
+  auto iter{
+      std::lower_bound(entries_.begin(), entries_.end(), item.api_path,
+                       [](const entry &current, std::string_view path) -> bool {
+                         return current.api_path < path;
+                       }),
+  };
+  if (iter != entries_.end() && iter->api_path == item.api_path) {
+    *iter = item;
+  }
+}
+} // namespace repertory
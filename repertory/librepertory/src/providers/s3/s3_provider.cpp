@@ -23,8 +23,10 @@
 
 #include "app_config.hpp"
 #include "comm/i_http_comm.hpp"
+#include "db/i_file_mgr_db.hpp"
 #include "events/event_system.hpp"
 #include "events/types/debug_log.hpp"
+#include "events/types/filesystem_item_closed.hpp"
 #include "events/types/service_start_begin.hpp"
 #include "events/types/service_start_end.hpp"
 #include "events/types/service_stop_begin.hpp"
@@ -63,11 +65,67 @@ namespace {
              ? repertory::api_error::name_too_long
              : repertory::api_error::success;
 }
+
+[[nodiscard]] auto get_upload_part_size(const repertory::s3_config &cfg)
+    -> std::uint64_t {
+  return static_cast<std::uint64_t>(
+             std::max(cfg.upload_part_size,
+                      static_cast<std::uint32_t>(
+                          repertory::min_upload_part_size))) *
+         1024ULL * 1024ULL;
+}
 } // namespace
 
 namespace repertory {
 s3_provider::s3_provider(app_config &config, i_http_comm &comm)
-    : base_provider(config, comm), s3_config_(config.get_s3_config()) {}
+    : base_provider(config, comm), s3_config_(config.get_s3_config()) {
+  E_SUBSCRIBE(filesystem_item_closed, [this](auto &&event) {
+    remove_data_key(event.api_path);
+  });
+}
+
+s3_provider::~s3_provider() { E_CONSUMER_RELEASE(); }
+
+auto s3_provider::abort_multipart_upload(std::string_view object_name,
+                                         std::string_view upload_id) const
+    -> api_error {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  const auto &cfg{get_s3_config()};
+
+  std::string response_data;
+  curl::requests::http_delete del{};
+  del.allow_timeout = true;
+  del.aws_service = "aws:amz:" + cfg.region + ":s3";
+  del.query["uploadId"] = upload_id;
+  del.response_handler = [&response_data](auto &&data,
+                                          long /*response_code*/) {
+    response_data = std::string(data.begin(), data.end());
+  };
+
+  auto res{set_request_path(del, object_name)};
+  if (res != api_error::success) {
+    return res;
+  }
+
+  long response_code{};
+  stop_type stop_requested{};
+  if (not get_comm().make_request(del, response_code, stop_requested)) {
+    return api_error::comm_error;
+  }
+
+  if ((response_code < http_error_codes::ok ||
+       response_code >= http_error_codes::multiple_choices) &&
+      response_code != http_error_codes::not_found) {
+    utils::error::raise_error(
+        function_name, response_code,
+        fmt::format("failed to abort multipart upload|key|{}|response|{}",
+                    object_name, response_data));
+    return api_error::comm_error;
+  }
+
+  return api_error::success;
+}
 
 auto s3_provider::add_if_not_found(api_file &file,
                                    std::string_view object_name) const
@@ -87,6 +145,61 @@ auto s3_provider::add_if_not_found(api_file &file,
   return res;
 }
 
+auto s3_provider::complete_multipart_upload(
+    std::string_view object_name,
+    const i_file_mgr_db::multipart_entry &entry) const -> api_error {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  const auto &cfg{get_s3_config()};
+
+  std::string body{"<CompleteMultipartUpload>"};
+  for (const auto &[part_number, etag] : entry.parts) {
+    body += fmt::format(
+        "<Part><PartNumber>{}</PartNumber><ETag>{}</ETag></Part>",
+        part_number, etag);
+  }
+  body += "</CompleteMultipartUpload>";
+
+  std::string response_data;
+  curl::requests::http_post post{};
+  post.aws_service = "aws:amz:" + cfg.region + ":s3";
+  post.body = body;
+  post.headers["content-type"] = "application/xml";
+  post.query["uploadId"] = entry.upload_id;
+  post.response_handler = [&response_data](auto &&data,
+                                           long /*response_code*/) {
+    response_data = std::string(data.begin(), data.end());
+  };
+
+  auto res{set_request_path(post, object_name)};
+  if (res != api_error::success) {
+    return res;
+  }
+
+  long response_code{};
+  stop_type stop_requested{};
+  if (not get_comm().make_request(post, response_code, stop_requested)) {
+    return api_error::comm_error;
+  }
+
+  // S3 may report a failure with a 200 response and an error document
+  pugi::xml_document doc;
+  if (response_code != http_error_codes::ok ||
+      (doc.load_string(response_data.c_str()).status ==
+           pugi::xml_parse_status::status_ok &&
+       not doc.select_node("/Error").node().empty())) {
+    utils::error::raise_error(
+        function_name, response_code,
+        fmt::format("failed to complete multipart upload|key|{}|response|{}",
+                    object_name, response_data));
+    return response_code == http_error_codes::not_found
+               ? api_error::item_not_found
+               : api_error::comm_error;
+  }
+
+  return api_error::success;
+}
+
 auto s3_provider::convert_api_date(std::string_view date) -> std::uint64_t {
   // 2009-10-12T17:50:30.000Z
   auto date_parts{utils::string::split(date, '.', true)};
@@ -251,6 +364,57 @@ auto s3_provider::create_file_extra(std::string_view api_path,
   return set_meta_key(api_path, meta);
 }
 
+auto s3_provider::create_multipart_upload(std::string_view object_name,
+                                          std::string &upload_id) const
+    -> api_error {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  const auto &cfg{get_s3_config()};
+
+  std::string response_data;
+  curl::requests::http_post post{};
+  post.aws_service = "aws:amz:" + cfg.region + ":s3";
+  post.body = "";
+  post.query["uploads"] = "";
+  post.response_handler = [&response_data](auto &&data,
+                                           long /*response_code*/) {
+    response_data = std::string(data.begin(), data.end());
+  };
+
+  auto res{set_request_path(post, object_name)};
+  if (res != api_error::success) {
+    return res;
+  }
+
+  long response_code{};
+  stop_type stop_requested{};
+  if (not get_comm().make_request(post, response_code, stop_requested)) {
+    return api_error::comm_error;
+  }
+
+  if (response_code != http_error_codes::ok) {
+    utils::error::raise_error(
+        function_name, response_code,
+        fmt::format("failed to create multipart upload|key|{}|response|{}",
+                    object_name, response_data));
+    return api_error::comm_error;
+  }
+
+  pugi::xml_document doc;
+  auto result{doc.load_string(response_data.c_str())};
+  if (result.status != pugi::xml_parse_status::status_ok) {
+    utils::error::raise_error(function_name, result.status,
+                              "failed to parse xml document");
+    return api_error::comm_error;
+  }
+
+  upload_id = doc.select_node("/InitiateMultipartUploadResult/UploadId")
+                  .node()
+                  .text()
+                  .as_string();
+  return upload_id.empty() ? api_error::comm_error : api_error::success;
+}
+
 auto s3_provider::decrypt_object_name(std::string &object_name) const
     -> api_error {
   if (legacy_bucket_) {
@@ -269,6 +433,34 @@ auto s3_provider::decrypt_object_name(std::string &object_name) const
   return api_error::decryption_error;
 }
 
+auto s3_provider::get_data_key(std::string_view api_path,
+                               std::string_view kdf_str)
+    -> utils::hash::hash_256_t {
+  {
+    mutex_lock lock(data_key_mtx_);
+    auto iter = data_key_cache_.find(std::string{api_path});
+    if (iter != data_key_cache_.end() && iter->second.kdf == kdf_str) {
+      return iter->second.key;
+    }
+  }
+
+  auto data_cfg = nlohmann::json::parse(kdf_str)
+                      .get<utils::encryption::kdf_config>();
+  auto data_key = data_cfg.recreate_subkey(
+      utils::encryption::kdf_context::data, master_key_);
+
+  mutex_lock lock(data_key_mtx_);
+  if (data_key_cache_.size() >= max_cached_data_keys) {
+    data_key_cache_.clear();
+  }
+
+  data_key_cache_[std::string{api_path}] = data_key_entry{
+      .kdf = std::string{kdf_str},
+      .key = data_key,
+  };
+  return data_key;
+}
+
 auto s3_provider::get_directory_item_count(std::string_view api_path) const
     -> std::uint64_t {
   REPERTORY_USES_FUNCTION_NAME();
@@ -999,6 +1191,8 @@ auto s3_provider::remove_directory_impl(std::string_view api_path)
 auto s3_provider::remove_file_impl(std::string_view api_path) -> api_error {
   REPERTORY_USES_FUNCTION_NAME();
 
+  remove_data_key(api_path);
+
   const auto &cfg{get_s3_config()};
   auto is_encrypted{not cfg.encryption_token.empty()};
 
@@ -1014,6 +1208,18 @@ auto s3_provider::remove_file_impl(std::string_view api_path) -> api_error {
       utils::path::create_api_path(is_encrypted ? key : api_path),
   };
 
+  auto *mgr_db{
+      get_file_mgr() == nullptr ? nullptr
+                                : get_file_mgr()->get_file_mgr_db(),
+  };
+  if (mgr_db != nullptr) {
+    auto entry{mgr_db->get_multipart(api_path)};
+    if (entry.has_value()) {
+      std::ignore = abort_multipart_upload(object_name, entry->upload_id);
+      std::ignore = mgr_db->remove_multipart(api_path);
+    }
+  }
+
   std::string response_data;
   curl::requests::http_delete del_file{};
   del_file.allow_timeout = true;
@@ -1053,6 +1259,11 @@ auto s3_provider::rename_file(std::string_view /* from_api_path */,
   return api_error::not_implemented;
 }
 
+void s3_provider::remove_data_key(std::string_view api_path) {
+  mutex_lock lock(data_key_mtx_);
+  data_key_cache_.erase(std::string{api_path});
+}
+
 auto s3_provider::search_keys_for_master_kdf(std::string_view encryption_token)
     -> bool {
   REPERTORY_USES_FUNCTION_NAME();
@@ -1214,6 +1425,12 @@ void s3_provider::stop() {
   event_system::instance().raise<service_stop_begin>(function_name,
                                                      "s3_provider");
   base_provider::stop();
+
+  {
+    mutex_lock lock(data_key_mtx_);
+    data_key_cache_.clear();
+  }
+
   event_system::instance().raise<service_stop_end>(function_name,
                                                    "s3_provider");
 }
@@ -1247,6 +1464,18 @@ auto s3_provider::upload_file_impl(std::string_view api_path,
       utils::path::create_api_path(is_encrypted ? key : api_path),
   };
 
+  auto upload_size{file_size};
+  if (is_encrypted && file_size > 0U) {
+    upload_size =
+        utils::encryption::encrypting_reader::calculate_encrypted_size(
+            file_size, not legacy_bucket_);
+  }
+
+  if (upload_size > get_upload_part_size(cfg)) {
+    return upload_multipart(api_path, object_name, source_path, file_size,
+                            upload_size, stop_requested);
+  }
+
   std::string response_data;
   curl::requests::http_put_file put_file{};
   put_file.aws_service = "aws:amz:" + cfg.region + ":s3";
@@ -1297,6 +1526,259 @@ auto s3_provider::upload_file_impl(std::string_view api_path,
   return api_error::success;
 }
 
+auto s3_provider::upload_multipart(std::string_view api_path,
+                                   std::string_view object_name,
+                                   std::string_view source_path,
+                                   std::uint64_t file_size,
+                                   std::uint64_t upload_size,
+                                   stop_type &stop_requested) -> api_error {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  const auto &cfg{get_s3_config()};
+  auto is_encrypted{not cfg.encryption_token.empty()};
+
+  // A resumed upload encrypts its remaining parts with new IVs. Encrypted
+  // parts therefore hold whole encrypted chunks so no chunk mixes IV sets.
+  auto layout{
+      is_encrypted
+          ? multipart_layout::create(
+                upload_size, get_upload_part_size(cfg),
+                legacy_bucket_ ? 0U : utils::encryption::kdf_config::size(),
+                utils::encryption::encrypting_reader::
+                    get_encrypted_chunk_size())
+          : multipart_layout::create(upload_size, get_upload_part_size(cfg)),
+  };
+  auto source_modified{
+      utils::file::get_time(source_path, utils::file::time_type::modified)
+          .value_or(0U),
+  };
+
+  auto *mgr_db{
+      get_file_mgr() == nullptr ? nullptr
+                                : get_file_mgr()->get_file_mgr_db(),
+  };
+
+  std::optional<i_file_mgr_db::multipart_entry> entry;
+  if (mgr_db != nullptr) {
+    entry = mgr_db->get_multipart(api_path);
+  }
+
+  // Parts may only be reused while the source file and part layout are
+  // unchanged and, for KDF buckets, the data key header is still available.
+  std::string kdf_str;
+  if (entry.has_value()) {
+    auto is_valid{
+        entry->part_size == layout.part_size &&
+            entry->source_modified == source_modified &&
+            entry->source_path == source_path &&
+            entry->source_size == file_size,
+    };
+    if (is_valid && is_encrypted && not legacy_bucket_) {
+      is_valid = get_item_meta(api_path, META_KDF, kdf_str) ==
+                     api_error::success &&
+                 not kdf_str.empty();
+    }
+
+    if (not is_valid) {
+      std::ignore = abort_multipart_upload(object_name, entry->upload_id);
+      std::ignore = mgr_db->remove_multipart(api_path);
+      entry.reset();
+    }
+  }
+
+  std::shared_ptr<utils::encryption::encrypting_reader> reader;
+  if (is_encrypted) {
+    auto stop_cb = []() -> bool { return app_config::get_stop_requested(); };
+    if (legacy_bucket_) {
+      reader = std::make_shared<utils::encryption::encrypting_reader>(
+          object_name, source_path, stop_cb, cfg.encryption_token,
+          std::nullopt, -1);
+    } else if (entry.has_value()) {
+      reader = std::make_shared<utils::encryption::encrypting_reader>(
+          object_name, source_path, stop_cb, master_key_,
+          std::make_pair(nlohmann::json::parse(kdf_str)
+                             .get<utils::encryption::kdf_config>(),
+                         master_kdf_cfg_),
+          std::nullopt, -1);
+    } else {
+      reader = std::make_shared<utils::encryption::encrypting_reader>(
+          object_name, source_path, stop_cb, master_key_, master_kdf_cfg_,
+          std::nullopt, -1);
+
+      auto res{
+          set_item_meta(
+              api_path, META_KDF,
+              nlohmann::json(*reader->get_kdf_config_for_data()).dump()),
+      };
+      if (res != api_error::success) {
+        return res;
+      }
+    }
+  }
+
+  if (not entry.has_value()) {
+    std::string upload_id;
+    auto res{create_multipart_upload(object_name, upload_id)};
+    if (res != api_error::success) {
+      return res;
+    }
+
+    entry = i_file_mgr_db::multipart_entry{
+        .api_path = std::string{api_path},
+        .upload_id = upload_id,
+        .part_size = layout.part_size,
+        .parts = {},
+        .source_modified = source_modified,
+        .source_path = std::string{source_path},
+        .source_size = file_size,
+    };
+    if (mgr_db != nullptr && not mgr_db->add_multipart(entry.value())) {
+      utils::error::raise_api_path_error(function_name, api_path,
+                                         api_error::error,
+                                         "failed to persist multipart upload");
+    }
+  }
+
+  std::mutex entry_mtx;
+  auto upload_one = [&](std::uint32_t part_number) -> api_error {
+    auto range{layout.get_range(part_number)};
+
+    std::string etag;
+    auto res{
+        upload_part(object_name, source_path, entry->upload_id, part_number,
+                    range,
+                    reader
+                        ? std::make_shared<
+                              utils::encryption::encrypting_reader>(*reader)
+                        : nullptr,
+                    etag, stop_requested),
+    };
+    if (res != api_error::success) {
+      return res;
+    }
+
+    mutex_lock lock(entry_mtx);
+    entry->parts[part_number] = etag;
+    if (mgr_db != nullptr && not mgr_db->add_multipart(entry.value())) {
+      utils::error::raise_api_path_error(function_name, api_path,
+                                         api_error::error,
+                                         "failed to persist upload part");
+    }
+
+    return api_error::success;
+  };
+
+  auto max_count{
+      static_cast<std::size_t>(
+          std::max(cfg.max_upload_part_count, std::uint16_t{1U})),
+  };
+
+  std::vector<std::uint32_t> pending;
+  for (std::uint32_t part_number = 1U; part_number <= layout.part_count;
+       ++part_number) {
+    if (not entry->parts.contains(part_number)) {
+      pending.push_back(part_number);
+    }
+  }
+
+  auto ret{api_error::success};
+  std::deque<std::future<api_error>> active;
+  for (const auto &part_number : pending) {
+    if (stop_requested || app_config::get_stop_requested()) {
+      ret = api_error::comm_error;
+      break;
+    }
+
+    if (active.size() >= max_count) {
+      auto res{active.front().get()};
+      active.pop_front();
+      if (res != api_error::success) {
+        ret = res;
+        break;
+      }
+    }
+
+    active.emplace_back(
+        std::async(std::launch::async, upload_one, part_number));
+  }
+
+  for (auto &item : active) {
+    auto res{item.get()};
+    if (ret == api_error::success) {
+      ret = res;
+    }
+  }
+
+  if (ret == api_error::success) {
+    ret = complete_multipart_upload(object_name, entry.value());
+  }
+
+  // The upload no longer exists on the server, so the next attempt must start
+  // over instead of resuming.
+  if (ret == api_error::item_not_found) {
+    ret = api_error::comm_error;
+    if (mgr_db != nullptr) {
+      std::ignore = mgr_db->remove_multipart(api_path);
+    }
+  }
+
+  if (ret == api_error::success && mgr_db != nullptr &&
+      not mgr_db->remove_multipart(api_path)) {
+    utils::error::raise_api_path_error(function_name, api_path,
+                                       api_error::error,
+                                       "failed to remove multipart upload");
+  }
+
+  return ret;
+}
+
+auto s3_provider::upload_part(
+    std::string_view object_name, std::string_view source_path,
+    std::string_view upload_id, std::uint32_t part_number, http_range range,
+    std::shared_ptr<utils::encryption::encrypting_reader> reader,
+    std::string &etag, stop_type &stop_requested) const -> api_error {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  const auto &cfg{get_s3_config()};
+
+  std::string response_data;
+  curl::requests::http_put_file put_file{};
+  put_file.aws_service = "aws:amz:" + cfg.region + ":s3";
+  put_file.query["partNumber"] = std::to_string(part_number);
+  put_file.query["uploadId"] = upload_id;
+  put_file.reader = reader;
+  put_file.response_handler = [&response_data](auto &&data,
+                                               long /*response_code*/) {
+    response_data = std::string(data.begin(), data.end());
+  };
+  put_file.response_headers = http_headers{};
+  put_file.source_path = source_path;
+  put_file.source_range = range;
+
+  auto res{set_request_path(put_file, object_name)};
+  if (res != api_error::success) {
+    return res;
+  }
+
+  long response_code{};
+  if (not get_comm().make_request(put_file, response_code, stop_requested)) {
+    return api_error::comm_error;
+  }
+
+  if (response_code != http_error_codes::ok) {
+    utils::error::raise_error(
+        function_name, response_code,
+        fmt::format("failed to upload part|key|{}|part|{}|response|{}",
+                    object_name, part_number, response_data));
+    return response_code == http_error_codes::not_found
+               ? api_error::item_not_found
+               : api_error::comm_error;
+  }
+
+  etag = put_file.response_headers.value()["etag"];
+  return etag.empty() ? api_error::comm_error : api_error::success;
+}
+
 auto s3_provider::read_file_bytes(std::string_view api_path, std::size_t size,
                                   std::uint64_t offset, data_buffer &data,
                                   stop_type &stop_requested) -> api_error {
@@ -1401,9 +1883,13 @@ auto s3_provider::read_file_bytes(std::string_view api_path, std::size_t size,
       data_key = utils::encryption::generate_key<utils::hash::hash_256_t>(
           cfg.encryption_token);
     } else {
-      utils::encryption::kdf_config data_cfg;
-      ret = get_kdf_config_from_meta(api_path, data_cfg);
-      if (ret == api_error::item_not_found) {
+      std::string kdf_str;
+      ret = get_item_meta(api_path, META_KDF, kdf_str);
+      if (ret != api_error::success) {
+        return ret;
+      }
+
+      if (kdf_str.empty()) {
         data_buffer header_buffer;
         ret = read_bytes(utils::encryption::kdf_config::size(), 0U,
                          header_buffer);
@@ -1411,21 +1897,20 @@ auto s3_provider::read_file_bytes(std::string_view api_path, std::size_t size,
           return ret;
         }
 
-        if (utils::encryption::kdf_config::from_header(header_buffer,
-                                                       data_cfg)) {
-          ret = set_item_meta(api_path, META_KDF,
-                              nlohmann::json(data_cfg).dump());
-        } else {
-          ret = api_error::decryption_error;
+        utils::encryption::kdf_config data_cfg;
+        if (not utils::encryption::kdf_config::from_header(header_buffer,
+                                                           data_cfg)) {
+          return api_error::decryption_error;
         }
-      }
 
-      if (ret != api_error::success) {
-        return ret;
+        kdf_str = nlohmann::json(data_cfg).dump();
+        ret = set_item_meta(api_path, META_KDF, kdf_str);
+        if (ret != api_error::success) {
+          return ret;
+        }
       }
 
-      data_key = data_cfg.recreate_subkey(utils::encryption::kdf_context::data,
-                                          master_key_);
+      data_key = get_data_key(api_path, kdf_str);
     }
 
     return utils::encryption::read_encrypted_range(
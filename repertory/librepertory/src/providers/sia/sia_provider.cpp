@@ -863,7 +863,10 @@ auto sia_provider::rename_file(std::string_view from_api_path,
       return api_error::item_not_found;
     }
 
-    return get_db().rename_item_meta(from_api_path, to_api_path);
+    res = get_db().rename_item_meta(from_api_path, to_api_path);
+    invalidate_listing(from_api_path);
+    invalidate_listing(to_api_path);
+    return res;
   } catch (const std::exception &e) {
     utils::error::raise_api_path_error(
         function_name, fmt::format("{}|{}", from_api_path, to_api_path), e,
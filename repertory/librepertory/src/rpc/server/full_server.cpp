@@ -66,11 +66,20 @@ void full_server::handle_get_item_info(const httplib::Request &req,
 
 void full_server::handle_get_drive_information(const httplib::Request & /*req*/,
                                                httplib::Response &res) {
+  auto stats{cache_size_mgr::instance().get_stats()};
   res.set_content(
       json({
+               {"cache_evicted_bytes", stats.evicted_bytes},
+               {"cache_evicted_count", stats.evicted_count},
+               {"cache_max_stall_ms", stats.max_stall_ms},
                {"cache_space_used", cache_size_mgr::instance().size()},
+               {"cache_stall_count", stats.stall_count},
+               {"cache_stall_ms", stats.stall_ms},
+               {"cache_stall_timeout_count", stats.stall_timeout_count},
                {"drive_space_total", provider_.get_total_drive_space()},
                {"drive_space_used", provider_.get_used_drive_space()},
+               {"event_dropped_count",
+                event_system::instance().get_dropped_count()},
                {"item_count", provider_.get_total_item_count()},
            })
           .dump(),
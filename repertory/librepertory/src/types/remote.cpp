@@ -21,6 +21,8 @@
 */
 #include "types/remote.hpp"
 
+#include "utils/path.hpp"
+
 namespace repertory::remote {
 #if !defined(_WIN32)
 auto create_open_flags(std::uint32_t flags) -> open_flags {
@@ -115,4 +117,34 @@ auto create_os_open_flags(const open_flags &flags) -> std::uint32_t {
   return ret;
 }
 #endif
+
+auto read_directory_page(std::string_view api_path, file_offset offset,
+                         std::uint32_t max_count,
+                         const read_directory_entry_callback &read_entry,
+                         const get_directory_entry_attr_callback &get_attr,
+                         std::vector<directory_entry> &entries)
+    -> std::int32_t {
+  entries.clear();
+
+  std::int32_t ret{0};
+  while (entries.size() < max_count) {
+    directory_entry entry{};
+    ret = read_entry(offset + entries.size(), entry.item_path);
+    if (ret != 0) {
+      break;
+    }
+
+    auto stat_path{entry.item_path};
+    if (entry.item_path == ".") {
+      stat_path = api_path;
+    } else if (entry.item_path == "..") {
+      stat_path = utils::path::get_parent_api_path(api_path);
+    }
+
+    entry.res = get_attr(stat_path, entry.r_stat, entry.directory);
+    entries.emplace_back(std::move(entry));
+  }
+
+  return entries.empty() ? ret : 0;
+}
 } // namespace repertory::remote
@@ -274,4 +274,38 @@ auto provider_type_from_string(std::string_view type,
 auto provider_type_to_string(provider_type type) -> std::string {
   return app_config::get_provider_name(type);
 }
+
+auto read_ahead_policy_from_string(std::string_view policy,
+                                   read_ahead_policy default_policy)
+    -> read_ahead_policy {
+  auto policy_lower =
+      utils::string::to_lower(utils::string::trim_copy(std::string{policy}));
+  if (policy_lower == "adaptive") {
+    return read_ahead_policy::adaptive;
+  }
+
+  if (policy_lower == "full") {
+    return read_ahead_policy::full;
+  }
+
+  if (policy_lower == "none") {
+    return read_ahead_policy::none;
+  }
+
+  return default_policy;
+}
+
+auto read_ahead_policy_to_string(const read_ahead_policy &policy)
+    -> std::string {
+  switch (policy) {
+  case read_ahead_policy::adaptive:
+    return "adaptive";
+  case read_ahead_policy::full:
+    return "full";
+  case read_ahead_policy::none:
+    return "none";
+  default:
+    return "adaptive";
+  }
+}
 } // namespace repertory
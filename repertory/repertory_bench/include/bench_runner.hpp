@@ -0,0 +1,153 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_BENCH_INCLUDE_BENCH_RUNNER_HPP_
+#define REPERTORY_BENCH_INCLUDE_BENCH_RUNNER_HPP_
+
+#include "s3_stand_in.hpp"
+#include "types/repertory.hpp"
+
+namespace repertory {
+class app_config;
+class file_manager;
+class i_http_comm;
+class i_open_file;
+class i_provider;
+} // namespace repertory
+
+namespace repertory::bench {
+struct bench_options final {
+  std::uint64_t bandwidth{};
+  std::size_t file_count{256U};
+  std::uint64_t file_size{64ULL * 1024ULL * 1024ULL};
+  std::chrono::milliseconds latency{};
+  std::size_t listing_count{20U};
+  std::string mount_location;
+  std::size_t random_read_count{1024U};
+  std::string repertory_path{"./repertory"};
+  std::vector<std::string> workloads;
+  std::string working_directory;
+};
+
+struct bench_result final {
+  std::string workload;
+  std::string target;
+  std::uint64_t bytes{};
+  std::chrono::nanoseconds elapsed{};
+  std::string error;
+  nlohmann::json extra = nlohmann::json::object();
+  std::vector<std::uint64_t> latencies;
+
+  [[nodiscard]] auto to_json() const -> nlohmann::json;
+};
+
+// Drives file_manager, the open file implementations and, when a mount
+// location is given, a fuse_drive mounted by the repertory executable
+// against an in-process s3_stand_in.
+class bench_runner final {
+public:
+  static constexpr std::size_t io_size{128UL * 1024UL};
+  static constexpr std::size_t random_io_size{4UL * 1024UL};
+  static constexpr std::size_t small_file_size{4UL * 1024UL};
+
+  static constexpr std::string_view bucket{"bench"};
+  static constexpr std::string_view large_file{"/bench_large.bin"};
+  static constexpr std::string_view read_file{"/bench_read.bin"};
+  static constexpr std::string_view small_file_dir{"/bench_small"};
+
+  static constexpr std::array<std::string_view, 5U> all_workloads{
+      "sequential_read",  "random_read_4k",    "small_file_create",
+      "large_write_upload", "directory_listing",
+  };
+
+  static constexpr std::array<std::string_view, 4U> read_targets{
+      "direct_open_file",
+      "ring_buffer_open_file",
+      "open_file",
+      "file_manager",
+  };
+
+public:
+  explicit bench_runner(bench_options options);
+
+  bench_runner(const bench_runner &) = delete;
+  bench_runner(bench_runner &&) = delete;
+
+  ~bench_runner();
+
+  auto operator=(const bench_runner &) -> bench_runner & = delete;
+  auto operator=(bench_runner &&) -> bench_runner & = delete;
+
+private:
+  bench_options options_;
+
+private:
+  std::unique_ptr<i_http_comm> comm_;
+  std::unique_ptr<app_config> config_;
+  std::unique_ptr<file_manager> file_mgr_;
+  std::unique_ptr<i_provider> provider_;
+  std::vector<bench_result> results_;
+  s3_stand_in stand_in_;
+
+private:
+  void close_target(std::string_view target, std::uint64_t handle,
+                    std::shared_ptr<i_open_file> file);
+
+  [[nodiscard]] auto create_file(std::string_view api_path,
+                                 std::uint64_t file_size,
+                                 std::vector<std::uint64_t> *latencies)
+      -> api_error;
+
+  [[nodiscard]] auto is_enabled(std::string_view workload) const -> bool;
+
+  [[nodiscard]] auto open_target(std::string_view target,
+                                 std::uint64_t &handle,
+                                 std::shared_ptr<i_open_file> &file)
+      -> api_error;
+
+  void populate_small_files(bench_result &result);
+
+  void run_directory_listing();
+
+  void run_large_write_upload();
+
+  void run_random_read(std::string_view target);
+
+  void run_sequential_read(std::string_view target);
+
+  void run_small_file_create();
+
+#if !defined(_WIN32)
+  void run_fuse_drive();
+#endif // !defined(_WIN32)
+
+  [[nodiscard]] auto start() -> bool;
+
+  void stop();
+
+  [[nodiscard]] auto wait_for_upload(std::string_view api_path) const -> bool;
+
+public:
+  [[nodiscard]] auto run() -> nlohmann::json;
+};
+} // namespace repertory::bench
+
+#endif // REPERTORY_BENCH_INCLUDE_BENCH_RUNNER_HPP_
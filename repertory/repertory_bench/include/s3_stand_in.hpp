@@ -0,0 +1,116 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_BENCH_INCLUDE_S3_STAND_IN_HPP_
+#define REPERTORY_BENCH_INCLUDE_S3_STAND_IN_HPP_
+
+#include "types/repertory.hpp"
+
+namespace repertory::bench {
+// Minimal in-memory S3 endpoint covering the requests made by s3_provider:
+// ListObjectsV2, HEAD/GET (ranged), PUT, DELETE and multipart uploads.
+// Every response is delayed by a fixed latency plus the time its payload
+// would take at the configured per-request bandwidth.
+class s3_stand_in final {
+public:
+  struct options final {
+    std::uint64_t bandwidth{}; // bytes per second, 0 is unlimited
+    std::chrono::milliseconds latency{};
+  };
+
+  struct counters final {
+    std::uint64_t bytes_received{};
+    std::uint64_t bytes_sent{};
+    std::uint64_t requests{};
+  };
+
+public:
+  s3_stand_in(std::string bucket, options opts);
+
+  s3_stand_in(const s3_stand_in &) = delete;
+  s3_stand_in(s3_stand_in &&) = delete;
+
+  ~s3_stand_in();
+
+  auto operator=(const s3_stand_in &) -> s3_stand_in & = delete;
+  auto operator=(s3_stand_in &&) -> s3_stand_in & = delete;
+
+private:
+  static constexpr std::size_t max_keys{1000U};
+
+  struct object final {
+    std::shared_ptr<const data_buffer> data;
+    std::chrono::sys_seconds modified;
+  };
+
+  struct multipart_upload final {
+    std::string key;
+    std::map<std::uint32_t, data_buffer> parts;
+  };
+
+private:
+  std::string bucket_;
+  options options_;
+
+private:
+  std::atomic<std::uint64_t> bytes_received_{0U};
+  std::atomic<std::uint64_t> bytes_sent_{0U};
+  mutable std::mutex mtx_;
+  std::uint64_t next_upload_id_{0U};
+  std::map<std::string, object> objects_;
+  std::uint16_t port_{0U};
+  std::atomic<std::uint64_t> requests_{0U};
+  std::unique_ptr<httplib::Server> server_;
+  std::unique_ptr<std::thread> server_thread_;
+  std::unordered_map<std::string, multipart_upload> uploads_;
+
+private:
+  void delay() const;
+
+  void handle_delete(const httplib::Request &req, httplib::Response &res);
+
+  void handle_get(const httplib::Request &req, httplib::Response &res);
+
+  void handle_list(const httplib::Request &req, httplib::Response &res);
+
+  void handle_post(const httplib::Request &req, httplib::Response &res);
+
+  void handle_put(const httplib::Request &req, httplib::Response &res);
+
+  void throttle(std::uint64_t bytes) const;
+
+public:
+  [[nodiscard]] auto get_counters() const -> counters;
+
+  [[nodiscard]] auto get_object_size(std::string_view key) const
+      -> std::optional<std::uint64_t>;
+
+  [[nodiscard]] auto get_url() const -> std::string;
+
+  void put_object(std::string_view key, data_buffer data);
+
+  [[nodiscard]] auto start() -> bool;
+
+  void stop();
+};
+} // namespace repertory::bench
+
+#endif // REPERTORY_BENCH_INCLUDE_S3_STAND_IN_HPP_
@@ -0,0 +1,171 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#if defined(PROJECT_ENABLE_BACKWARD_CPP)
+#include "backward.hpp"
+#endif // defined(PROJECT_ENABLE_BACKWARD_CPP)
+
+#include "bench_runner.hpp"
+#include "initialize.hpp"
+#include "utils/error.hpp"
+#include "utils/file.hpp"
+#include "utils/path.hpp"
+#include "utils/string.hpp"
+#include "utils/time.hpp"
+
+using namespace repertory;
+
+namespace {
+void print_usage() {
+  std::cout
+      << "Usage: repertory_bench [options]\n"
+         "  --bandwidth <MiB/s>       per request stand-in bandwidth, 0 is "
+         "unlimited\n"
+         "  --file_count <count>      small files to create and list\n"
+         "  --file_size <MiB>         size of the read and large write files\n"
+         "  --latency <ms>            stand-in latency added to each request\n"
+         "  --listing_count <count>   directory listings to time\n"
+         "  --mount <path>            also run workloads through a FUSE "
+         "mount\n"
+         "  --output <path>           write JSON results to a file\n"
+         "  --random_reads <count>    4KiB reads per random read workload\n"
+         "  --repertory <path>        repertory executable used for --mount\n"
+         "  --workload <name>         run only the named workload, may be "
+         "repeated\n"
+         "  --working_directory <path> parent of the bench_<time> directory "
+         "created for each run\n";
+}
+
+[[nodiscard]] auto parse_args(std::span<char *> args,
+                              bench::bench_options &options,
+                              std::string &output_path) -> bool {
+  for (std::size_t idx{1U}; idx < args.size(); ++idx) {
+    std::string_view name{args[idx]};
+    if (idx + 1U >= args.size()) {
+      return false;
+    }
+    std::string value{args[++idx]};
+
+    if (name == "--bandwidth") {
+      options.bandwidth = utils::string::to_uint64(value) * 1024ULL * 1024ULL;
+    } else if (name == "--file_count") {
+      options.file_count = utils::string::to_size_t(value);
+    } else if (name == "--file_size") {
+      options.file_size = utils::string::to_uint64(value) * 1024ULL * 1024ULL;
+    } else if (name == "--latency") {
+      options.latency =
+          std::chrono::milliseconds(utils::string::to_uint64(value));
+    } else if (name == "--listing_count") {
+      options.listing_count = utils::string::to_size_t(value);
+    } else if (name == "--mount") {
+      options.mount_location = utils::path::absolute(value);
+    } else if (name == "--output") {
+      output_path = value;
+    } else if (name == "--random_reads") {
+      options.random_read_count = utils::string::to_size_t(value);
+    } else if (name == "--repertory") {
+      options.repertory_path = value;
+    } else if (name == "--workload") {
+      if (std::ranges::find(bench::bench_runner::all_workloads, value) ==
+          bench::bench_runner::all_workloads.end()) {
+        return false;
+      }
+      options.workloads.push_back(value);
+    } else if (name == "--working_directory") {
+      options.working_directory = utils::path::absolute(value);
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+  REPERTORY_USES_FUNCTION_NAME();
+
+#if defined(PROJECT_ENABLE_BACKWARD_CPP)
+  static backward::SignalHandling sh;
+#endif // defined(PROJECT_ENABLE_BACKWARD_CPP)
+
+  if (not repertory::project_initialize()) {
+    repertory::project_cleanup();
+    return -1;
+  }
+
+  int ret{0};
+  try {
+    bench::bench_options options{};
+    options.working_directory =
+        utils::path::absolute(utils::path::combine(".", {"bench_data"}));
+
+    std::string output_path;
+    if (not parse_args(std::span(argv, static_cast<std::size_t>(argc)),
+                       options, output_path)) {
+      print_usage();
+      ret = 1;
+    } else {
+      // Each run works in a directory of its own; only that directory is
+      // removed afterwards, never the one given on the command line.
+      options.working_directory = utils::path::combine(
+          options.working_directory,
+          {fmt::format("bench_{}", utils::time::get_time_now())});
+      utils::file::directory working_dir{options.working_directory};
+      if (working_dir.exists() || not working_dir.create_directory()) {
+        throw std::runtime_error(
+            fmt::format("failed to create working directory|{}",
+                        options.working_directory));
+      }
+
+      nlohmann::json results;
+      {
+        bench::bench_runner runner(options);
+        results = runner.run();
+      }
+
+      if (not working_dir.remove_recursively()) {
+        throw std::runtime_error(
+            fmt::format("failed to remove working directory|{}",
+                        options.working_directory));
+      }
+
+      if (output_path.empty()) {
+        std::cout << results.dump(2) << std::endl;
+      } else if (not utils::file::write_json_file(output_path, results)) {
+        throw std::runtime_error(
+            fmt::format("failed to write results|{}", output_path));
+      }
+
+      ret = results.contains("error") ? 1 : 0;
+    }
+  } catch (const std::exception &e) {
+    utils::error::handle_exception(function_name, e);
+    ret = 1;
+  } catch (...) {
+    utils::error::handle_exception(function_name);
+    ret = 1;
+  }
+
+  repertory::project_cleanup();
+
+  return ret;
+}
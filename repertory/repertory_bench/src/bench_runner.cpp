@@ -0,0 +1,822 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "bench_runner.hpp"
+
+#include "app_config.hpp"
+#include "comm/curl/curl_comm.hpp"
+#include "events/event_system.hpp"
+#include "file_manager/direct_open_file.hpp"
+#include "file_manager/file_manager.hpp"
+#include "file_manager/open_file.hpp"
+#include "file_manager/ring_buffer_open_file.hpp"
+#include "platform/platform.hpp"
+#include "providers/s3/s3_provider.hpp"
+#include "utils/common.hpp"
+#include "utils/encrypting_reader.hpp"
+#include "utils/file.hpp"
+#include "utils/path.hpp"
+#include "utils/polling.hpp"
+#include "utils/time.hpp"
+#include "version.hpp"
+
+namespace {
+constexpr auto upload_timeout{10min};
+
+[[nodiscard]] auto create_data(std::size_t size, std::uint64_t seed)
+    -> repertory::data_buffer {
+  repertory::data_buffer data(size);
+  std::mt19937_64 engine(seed);
+  std::ranges::generate(data, [&engine]() -> unsigned char {
+    return static_cast<unsigned char>(engine());
+  });
+  return data;
+}
+
+[[nodiscard]] auto create_item_meta(bool directory,
+                                    std::string_view source_path)
+    -> repertory::api_meta_map {
+  auto now{repertory::utils::time::get_time_now()};
+#if defined(_WIN32)
+  std::uint32_t mode{0U};
+#else  // !defined(_WIN32)
+  std::uint32_t mode{directory ? (S_IFDIR | 0755U) : (S_IFREG | 0644U)};
+#endif // defined(_WIN32)
+  return repertory::create_meta_attributes(
+      now, directory ? FILE_ATTRIBUTE_DIRECTORY : FILE_ATTRIBUTE_ARCHIVE, now,
+      now, directory, 0U, "", mode, now, 0U, 0U, source_path, 0U, now);
+}
+
+[[nodiscard]] auto elapsed_since(std::chrono::steady_clock::time_point start)
+    -> std::chrono::nanoseconds {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+
+template <typename operation_t>
+auto time_operation(std::vector<std::uint64_t> &latencies,
+                    operation_t &&operation) -> decltype(operation()) {
+  auto start{std::chrono::steady_clock::now()};
+  auto ret = operation();
+  latencies.push_back(
+      static_cast<std::uint64_t>(elapsed_since(start).count()));
+  return ret;
+}
+} // namespace
+
+namespace repertory::bench {
+auto bench_result::to_json() const -> nlohmann::json {
+  auto sorted{latencies};
+  std::ranges::sort(sorted);
+
+  const auto percentile = [&sorted](std::size_t pct) -> std::uint64_t {
+    if (sorted.empty()) {
+      return 0U;
+    }
+    return sorted.at(std::min(sorted.size() - 1U, sorted.size() * pct / 100U));
+  };
+
+  auto elapsed_ns{static_cast<std::uint64_t>(elapsed.count())};
+  const auto per_second = [elapsed_ns](std::uint64_t count) -> double {
+    return elapsed_ns == 0U ? 0.0
+                            : static_cast<double>(count) * 1000000000.0 /
+                                  static_cast<double>(elapsed_ns);
+  };
+
+  nlohmann::json ret{
+      {"bytes", bytes},
+      {"bytes_per_sec", per_second(bytes)},
+      {"elapsed_ns", elapsed_ns},
+      {"extra", extra},
+      {"latency_ns",
+       {
+           {"max", sorted.empty() ? 0U : sorted.back()},
+           {"p50", percentile(50U)},
+           {"p95", percentile(95U)},
+           {"p99", percentile(99U)},
+       }},
+      {"operations", latencies.size()},
+      {"operations_per_sec", per_second(latencies.size())},
+      {"target", target},
+      {"workload", workload},
+  };
+  if (not error.empty()) {
+    ret["error"] = error;
+  }
+
+  return ret;
+}
+
+bench_runner::bench_runner(bench_options options)
+    : options_(std::move(options)),
+      stand_in_(std::string{bucket}, {
+                                         .bandwidth = options_.bandwidth,
+                                         .latency = options_.latency,
+                                     }) {}
+
+bench_runner::~bench_runner() { stop(); }
+
+void bench_runner::close_target(std::string_view target, std::uint64_t handle,
+                                std::shared_ptr<i_open_file> file) {
+  if (target == "file_manager") {
+    file.reset();
+    file_mgr_->close(handle);
+    std::ignore = file_mgr_->evict_file(read_file);
+    return;
+  }
+
+  auto closeable_file = std::dynamic_pointer_cast<i_closeable_open_file>(file);
+  file.reset();
+  closeable_file->close();
+
+  if (target == "open_file") {
+    std::ignore = file_manager::remove_source_and_shrink_cache(
+        read_file, closeable_file->get_source_path(),
+        closeable_file->get_file_size(), closeable_file->get_allocated());
+  }
+}
+
+auto bench_runner::create_file(std::string_view api_path,
+                               std::uint64_t file_size,
+                               std::vector<std::uint64_t> *latencies)
+    -> api_error {
+  auto source_path{
+      utils::path::combine(config_->get_cache_directory(),
+                           {utils::create_uuid_string()}),
+  };
+  auto meta{create_item_meta(false, source_path)};
+
+  std::uint64_t handle{};
+  std::shared_ptr<i_open_file> file;
+  auto res = file_mgr_->create(api_path, meta, {}, handle, file);
+  if (res != api_error::success) {
+    return res;
+  }
+
+  auto data{create_data(std::min<std::uint64_t>(file_size, io_size), 2U)};
+  for (std::uint64_t offset{}; res == api_error::success && offset < file_size;
+       offset += data.size()) {
+    auto size{
+        static_cast<std::size_t>(
+            std::min<std::uint64_t>(data.size(), file_size - offset)),
+    };
+
+    std::size_t bytes_written{};
+    const auto write_data = [&]() -> api_error {
+      return file->write(offset, data_cspan{data.data(), size}, bytes_written);
+    };
+    res = latencies == nullptr ? write_data()
+                               : time_operation(*latencies, write_data);
+  }
+
+  file.reset();
+  file_mgr_->close(handle);
+  return res;
+}
+
+auto bench_runner::is_enabled(std::string_view workload) const -> bool {
+  return options_.workloads.empty() ||
+         std::ranges::find(options_.workloads, workload) !=
+             options_.workloads.end();
+}
+
+auto bench_runner::open_target(std::string_view target, std::uint64_t &handle,
+                               std::shared_ptr<i_open_file> &file)
+    -> api_error {
+  if (target == "file_manager") {
+    return file_mgr_->open(read_file, false, {}, handle, file);
+  }
+
+  filesystem_item fsi{};
+  auto res = provider_->get_filesystem_item(read_file, false, fsi);
+  if (res != api_error::success) {
+    return res;
+  }
+
+  auto chunk_size{
+      utils::encryption::encrypting_reader::get_data_chunk_size(),
+  };
+  auto chunk_timeout{config_->get_download_timeout_secs()};
+
+  if (target == "direct_open_file") {
+    file = std::make_shared<direct_open_file>(chunk_size, chunk_timeout, fsi,
+                                              *provider_);
+    return api_error::success;
+  }
+
+  if (target == "ring_buffer_open_file") {
+    if (not ring_buffer_open_file::can_handle_file(
+            fsi.size, chunk_size, ring_buffer_base::min_ring_size)) {
+      return api_error::invalid_operation;
+    }
+
+    auto buffer_directory{
+        utils::path::combine(options_.working_directory, {"buffer"}),
+    };
+    if (not utils::file::directory{buffer_directory}.create_directory()) {
+      return api_error::os_error;
+    }
+
+    file = std::make_shared<ring_buffer_open_file>(
+        buffer_directory, chunk_size, chunk_timeout, fsi, *provider_,
+        ring_buffer_base::min_ring_size);
+    return api_error::success;
+  }
+
+  fsi.source_path = utils::path::combine(config_->get_cache_directory(),
+                                         {utils::create_uuid_string()});
+  file = std::make_shared<open_file>(chunk_size, chunk_timeout, fsi,
+                                     *provider_, *file_mgr_);
+  return api_error::success;
+}
+
+void bench_runner::populate_small_files(bench_result &result) {
+  auto meta{create_item_meta(true, "")};
+  auto res = provider_->create_directory(small_file_dir, meta);
+  if (res != api_error::success && res != api_error::directory_exists) {
+    result.error = api_error_to_string(res);
+    return;
+  }
+
+  for (std::size_t idx{}; idx < options_.file_count; ++idx) {
+    auto api_path{
+        utils::path::create_api_path(utils::path::combine(
+            small_file_dir, {fmt::format("file_{}.bin", idx)})),
+    };
+    res = time_operation(result.latencies, [&]() -> api_error {
+      return create_file(api_path, small_file_size, nullptr);
+    });
+    if (res != api_error::success && res != api_error::item_exists) {
+      result.error = api_error_to_string(res);
+      return;
+    }
+
+    result.bytes += small_file_size;
+  }
+}
+
+auto bench_runner::run() -> nlohmann::json {
+  nlohmann::json ret{
+      {"git_rev", project_get_git_rev()},
+      {"options",
+       {
+           {"bandwidth", options_.bandwidth},
+           {"file_count", options_.file_count},
+           {"file_size", options_.file_size},
+           {"latency_ms", options_.latency.count()},
+           {"listing_count", options_.listing_count},
+           {"random_read_count", options_.random_read_count},
+       }},
+      {"timestamp", utils::time::get_time_now()},
+      {"version", project_get_version()},
+  };
+
+  if (not start()) {
+    ret["error"] = "failed to start benchmark";
+    return ret;
+  }
+
+  stand_in_.put_object(read_file.substr(1U),
+                       create_data(options_.file_size, 1U));
+  std::ignore = file_mgr_->get_directory_items("/");
+
+  for (const auto &target : read_targets) {
+    if (is_enabled("sequential_read")) {
+      run_sequential_read(target);
+    }
+
+    if (is_enabled("random_read_4k")) {
+      run_random_read(target);
+    }
+  }
+
+  if (is_enabled("small_file_create")) {
+    run_small_file_create();
+  }
+
+  if (is_enabled("large_write_upload")) {
+    run_large_write_upload();
+  }
+
+  if (is_enabled("directory_listing")) {
+    run_directory_listing();
+  }
+
+#if !defined(_WIN32)
+  if (not options_.mount_location.empty()) {
+    run_fuse_drive();
+  }
+#endif // !defined(_WIN32)
+
+  stop();
+
+  auto counters{stand_in_.get_counters()};
+  ret["stand_in"] = {
+      {"bytes_received", counters.bytes_received},
+      {"bytes_sent", counters.bytes_sent},
+      {"requests", counters.requests},
+  };
+
+  ret["results"] = nlohmann::json::array();
+  for (const auto &result : results_) {
+    ret["results"].push_back(result.to_json());
+  }
+
+  return ret;
+}
+
+void bench_runner::run_directory_listing() {
+  bench_result result{
+      .workload = "directory_listing",
+      .target = "file_manager",
+  };
+
+  if (not is_enabled("small_file_create")) {
+    bench_result populate{};
+    populate_small_files(populate);
+    if (not populate.error.empty()) {
+      result.error = populate.error;
+      results_.push_back(std::move(result));
+      return;
+    }
+  }
+
+  auto start{std::chrono::steady_clock::now()};
+  for (std::size_t idx{}; idx < options_.listing_count; ++idx) {
+    auto list = time_operation(result.latencies, [this]() -> auto {
+      return file_mgr_->get_directory_items(small_file_dir);
+    });
+    result.extra["item_count"] = list.size();
+  }
+  result.elapsed = elapsed_since(start);
+
+  results_.push_back(std::move(result));
+}
+
+#if !defined(_WIN32)
+void bench_runner::run_fuse_drive() {
+  auto data_directory{
+      utils::path::combine(options_.working_directory, {"fuse_data"}),
+  };
+  {
+    app_config cfg(provider_type::s3, data_directory);
+    cfg.set_s3_config(config_->get_s3_config());
+  }
+
+  const auto execute = [this, &data_directory](std::string_view args) -> int {
+    auto cmd{
+        fmt::format(R"("{}" -dd "{}" -s3 -na {} {})", options_.repertory_path,
+                    data_directory, bucket, args),
+    };
+    return std::system(cmd.c_str());
+  };
+
+  const auto &mount_location{options_.mount_location};
+  const auto is_mounted = [&mount_location]() -> bool {
+    struct stat mount_st{};
+    struct stat parent_st{};
+    return stat(mount_location.c_str(), &mount_st) == 0 &&
+           stat(utils::path::get_parent_path(mount_location).c_str(),
+                &parent_st) == 0 &&
+           mount_st.st_dev != parent_st.st_dev;
+  };
+
+  const auto get_path = [&mount_location](std::string_view api_path) {
+    return utils::path::combine(mount_location, {api_path});
+  };
+
+  bench_result mount_result{
+      .workload = "mount",
+      .target = "fuse_drive",
+  };
+
+  auto start{std::chrono::steady_clock::now()};
+  if (not utils::file::directory{mount_location}.create_directory() ||
+      execute(fmt::format(R"("{}")", mount_location)) != 0) {
+    mount_result.error = "failed to mount";
+  } else {
+    auto deadline{start + 30s};
+    while (not is_mounted() && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(100ms);
+    }
+
+    if (not is_mounted()) {
+      mount_result.error = "mount timed out";
+    }
+  }
+  mount_result.elapsed = elapsed_since(start);
+
+  auto mounted{mount_result.error.empty()};
+  results_.push_back(std::move(mount_result));
+  if (not mounted) {
+    return;
+  }
+
+  const auto read_workload = [&](std::string_view workload, bool random) {
+    bench_result result{
+        .workload = std::string{workload},
+        .target = "fuse_drive",
+    };
+
+    auto read_start{std::chrono::steady_clock::now()};
+    auto desc = open(get_path(read_file).c_str(), O_RDONLY);
+    if (desc == -1) {
+      result.error = fmt::format("open failed|{}", errno);
+      results_.push_back(std::move(result));
+      return;
+    }
+
+    auto size{static_cast<std::uint64_t>(lseek(desc, 0, SEEK_END))};
+    auto count{random ? options_.random_read_count
+                      : utils::divide_with_ceiling(size, io_size)};
+    std::mt19937_64 engine(3U);
+    std::uniform_int_distribution<std::uint64_t> dist(
+        0U, std::max<std::uint64_t>(size / random_io_size, 1U) - 1U);
+
+    data_buffer data(io_size);
+    for (std::uint64_t idx{}; idx < count; ++idx) {
+      auto offset{random ? dist(engine) * random_io_size : idx * io_size};
+      auto bytes_read = time_operation(result.latencies, [&]() -> ssize_t {
+        return pread(desc, data.data(), random ? random_io_size : io_size,
+                     static_cast<off_t>(offset));
+      });
+      if (bytes_read < 0) {
+        result.error = fmt::format("read failed|{}", errno);
+        break;
+      }
+
+      result.bytes += static_cast<std::uint64_t>(bytes_read);
+    }
+
+    close(desc);
+    result.elapsed = elapsed_since(read_start);
+    results_.push_back(std::move(result));
+  };
+
+  const auto write_file = [&](std::string_view api_path, std::uint64_t size,
+                              std::vector<std::uint64_t> *latencies) -> int {
+    auto desc = open(get_path(api_path).c_str(), O_CREAT | O_TRUNC | O_WRONLY,
+                     0644);
+    if (desc == -1) {
+      return errno;
+    }
+
+    auto data{create_data(std::min<std::uint64_t>(size, io_size), 2U)};
+    auto ret{0};
+    for (std::uint64_t offset{}; ret == 0 && offset < size;
+         offset += data.size()) {
+      auto count{
+          static_cast<std::size_t>(
+              std::min<std::uint64_t>(data.size(), size - offset)),
+      };
+      const auto write_data = [&]() -> ssize_t {
+        return pwrite(desc, data.data(), count, static_cast<off_t>(offset));
+      };
+      auto written = latencies == nullptr
+                         ? write_data()
+                         : time_operation(*latencies, write_data);
+      if (written != static_cast<ssize_t>(count)) {
+        ret = errno;
+      }
+    }
+
+    close(desc);
+    return ret;
+  };
+
+  const auto wait_for_object = [this](std::string_view api_path,
+                                      std::uint64_t size) -> bool {
+    auto deadline{std::chrono::steady_clock::now() + upload_timeout};
+    while (stand_in_.get_object_size(api_path.substr(1U)) != size) {
+      if (std::chrono::steady_clock::now() >= deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(10ms);
+    }
+    return true;
+  };
+
+  if (is_enabled("sequential_read")) {
+    read_workload("sequential_read", false);
+  }
+
+  if (is_enabled("random_read_4k")) {
+    read_workload("random_read_4k", true);
+  }
+
+  std::string small_dir{"/bench_fuse_small"};
+  if (is_enabled("small_file_create") || is_enabled("directory_listing")) {
+    bench_result result{
+        .workload = "small_file_create",
+        .target = "fuse_drive",
+    };
+
+    auto create_start{std::chrono::steady_clock::now()};
+    if (mkdir(get_path(small_dir).c_str(), 0755) != 0 && errno != EEXIST) {
+      result.error = fmt::format("mkdir failed|{}", errno);
+    }
+
+    for (std::size_t idx{}; result.error.empty() && idx < options_.file_count;
+         ++idx) {
+      auto api_path{fmt::format("{}/file_{}.bin", small_dir, idx)};
+      auto err = time_operation(result.latencies, [&]() -> int {
+        return write_file(api_path, small_file_size, nullptr);
+      });
+      if (err != 0) {
+        result.error = fmt::format("write failed|{}", err);
+        break;
+      }
+
+      result.bytes += small_file_size;
+    }
+    auto create_elapsed{elapsed_since(create_start)};
+
+    for (std::size_t idx{}; result.error.empty() && idx < options_.file_count;
+         ++idx) {
+      if (not wait_for_object(fmt::format("{}/file_{}.bin", small_dir, idx),
+                              small_file_size)) {
+        result.error = "upload timed out";
+      }
+    }
+
+    result.elapsed = elapsed_since(create_start);
+    result.extra["create_ns"] = create_elapsed.count();
+    result.extra["upload_drain_ns"] = (result.elapsed - create_elapsed).count();
+    if (is_enabled("small_file_create")) {
+      results_.push_back(std::move(result));
+    }
+  }
+
+  if (is_enabled("large_write_upload")) {
+    bench_result result{
+        .workload = "large_write_upload",
+        .target = "fuse_drive",
+    };
+
+    std::string api_path{"/bench_fuse_large.bin"};
+    auto write_start{std::chrono::steady_clock::now()};
+    auto err = write_file(api_path, options_.file_size, &result.latencies);
+    auto write_elapsed{elapsed_since(write_start)};
+    if (err != 0) {
+      result.error = fmt::format("write failed|{}", err);
+    } else if (not wait_for_object(api_path, options_.file_size)) {
+      result.error = "upload timed out";
+    }
+
+    result.bytes = options_.file_size;
+    result.elapsed = elapsed_since(write_start);
+    result.extra["write_ns"] = write_elapsed.count();
+    result.extra["upload_ns"] = (result.elapsed - write_elapsed).count();
+    results_.push_back(std::move(result));
+  }
+
+  if (is_enabled("directory_listing")) {
+    bench_result result{
+        .workload = "directory_listing",
+        .target = "fuse_drive",
+    };
+
+    auto list_start{std::chrono::steady_clock::now()};
+    for (std::size_t idx{}; idx < options_.listing_count; ++idx) {
+      auto count = time_operation(result.latencies, [&]() -> std::size_t {
+        std::size_t item_count{};
+        auto *dir = opendir(get_path(small_dir).c_str());
+        if (dir == nullptr) {
+          return item_count;
+        }
+
+        while (readdir(dir) != nullptr) {
+          ++item_count;
+        }
+        closedir(dir);
+        return item_count;
+      });
+      result.extra["item_count"] = count;
+    }
+    result.elapsed = elapsed_since(list_start);
+    results_.push_back(std::move(result));
+  }
+
+  std::ignore = execute("-unmount");
+}
+#endif // !defined(_WIN32)
+
+void bench_runner::run_large_write_upload() {
+  bench_result result{
+      .workload = "large_write_upload",
+      .target = "file_manager",
+  };
+
+  auto start{std::chrono::steady_clock::now()};
+  auto res = create_file(large_file, options_.file_size, &result.latencies);
+  auto write_elapsed{elapsed_since(start)};
+  if (res != api_error::success) {
+    result.error = api_error_to_string(res);
+  } else if (not wait_for_upload(large_file)) {
+    result.error = "upload timed out";
+  }
+
+  result.bytes = options_.file_size;
+  result.elapsed = elapsed_since(start);
+  result.extra["write_ns"] = write_elapsed.count();
+  result.extra["upload_ns"] = (result.elapsed - write_elapsed).count();
+  results_.push_back(std::move(result));
+}
+
+void bench_runner::run_random_read(std::string_view target) {
+  bench_result result{
+      .workload = "random_read_4k",
+      .target = std::string{target},
+  };
+
+  auto start{std::chrono::steady_clock::now()};
+
+  std::uint64_t handle{};
+  std::shared_ptr<i_open_file> file;
+  auto res = open_target(target, handle, file);
+  if (res != api_error::success) {
+    result.error = api_error_to_string(res);
+    results_.push_back(std::move(result));
+    return;
+  }
+
+  auto block_count{file->get_file_size() / random_io_size};
+  std::mt19937_64 engine(3U);
+  std::uniform_int_distribution<std::uint64_t> dist(
+      0U, block_count == 0U ? 0U : block_count - 1U);
+
+  data_buffer data;
+  for (std::size_t idx{}; idx < options_.random_read_count; ++idx) {
+    auto offset{dist(engine) * random_io_size};
+    data.clear();
+    res = time_operation(result.latencies, [&]() -> api_error {
+      return file->read(random_io_size, offset, data);
+    });
+    if (res != api_error::success) {
+      result.error = api_error_to_string(res);
+      break;
+    }
+
+    result.bytes += data.size();
+  }
+
+  result.elapsed = elapsed_since(start);
+  close_target(target, handle, std::move(file));
+  results_.push_back(std::move(result));
+}
+
+void bench_runner::run_sequential_read(std::string_view target) {
+  bench_result result{
+      .workload = "sequential_read",
+      .target = std::string{target},
+  };
+
+  auto start{std::chrono::steady_clock::now()};
+
+  std::uint64_t handle{};
+  std::shared_ptr<i_open_file> file;
+  auto res = open_target(target, handle, file);
+  if (res != api_error::success) {
+    result.error = api_error_to_string(res);
+    results_.push_back(std::move(result));
+    return;
+  }
+
+  data_buffer data;
+  for (std::uint64_t offset{}; offset < file->get_file_size();
+       offset += io_size) {
+    data.clear();
+    res = time_operation(result.latencies, [&]() -> api_error {
+      return file->read(io_size, offset, data);
+    });
+    if (res != api_error::success) {
+      result.error = api_error_to_string(res);
+      break;
+    }
+
+    result.bytes += data.size();
+  }
+
+  result.elapsed = elapsed_since(start);
+  close_target(target, handle, std::move(file));
+  results_.push_back(std::move(result));
+}
+
+void bench_runner::run_small_file_create() {
+  bench_result result{
+      .workload = "small_file_create",
+      .target = "file_manager",
+  };
+
+  auto start{std::chrono::steady_clock::now()};
+  populate_small_files(result);
+  auto create_elapsed{elapsed_since(start)};
+
+  for (std::size_t idx{}; result.error.empty() && idx < options_.file_count;
+       ++idx) {
+    if (not wait_for_upload(utils::path::create_api_path(utils::path::combine(
+            small_file_dir, {fmt::format("file_{}.bin", idx)})))) {
+      result.error = "upload timed out";
+    }
+  }
+
+  result.elapsed = elapsed_since(start);
+  result.extra["create_ns"] = create_elapsed.count();
+  result.extra["upload_drain_ns"] = (result.elapsed - create_elapsed).count();
+  results_.push_back(std::move(result));
+}
+
+auto bench_runner::start() -> bool {
+  if (not stand_in_.start()) {
+    return false;
+  }
+
+  auto data_directory{
+      utils::path::combine(options_.working_directory, {"data"}),
+  };
+  config_ = std::make_unique<app_config>(provider_type::s3, data_directory);
+
+  auto cfg{config_->get_s3_config()};
+  cfg.access_key = "bench";
+  cfg.bucket = bucket;
+  cfg.region = "any";
+  cfg.secret_key = "bench";
+  cfg.url = stand_in_.get_url();
+  cfg.use_path_style = true;
+  config_->set_s3_config(cfg);
+
+  event_system::instance().start();
+
+  comm_ = std::make_unique<curl_comm>(config_->get_s3_config());
+  provider_ = std::make_unique<s3_provider>(*config_, *comm_);
+  file_mgr_ = std::make_unique<file_manager>(*config_, *provider_);
+
+  if (not provider_->start(
+          [this](bool directory, api_file &file) -> api_error {
+            return provider_meta_handler(*provider_, directory, file);
+          },
+          file_mgr_.get())) {
+    return false;
+  }
+
+  file_mgr_->start();
+  polling::instance().start(config_.get());
+  return true;
+}
+
+void bench_runner::stop() {
+  if (not config_) {
+    stand_in_.stop();
+    return;
+  }
+
+  polling::instance().stop();
+
+  if (file_mgr_) {
+    file_mgr_->stop();
+  }
+
+  if (provider_) {
+    provider_->stop();
+  }
+
+  file_mgr_.reset();
+  provider_.reset();
+  comm_.reset();
+  config_.reset();
+
+  event_system::instance().stop();
+  stand_in_.stop();
+}
+
+auto bench_runner::wait_for_upload(std::string_view api_path) const -> bool {
+  auto deadline{std::chrono::steady_clock::now() + upload_timeout};
+  while (file_mgr_->is_processing(api_path)) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+
+    std::this_thread::sleep_for(10ms);
+  }
+
+  return true;
+}
+} // namespace repertory::bench
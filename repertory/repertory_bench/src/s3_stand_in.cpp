@@ -0,0 +1,373 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "s3_stand_in.hpp"
+
+#include "utils/error_utils.hpp"
+#include "utils/string.hpp"
+
+namespace {
+constexpr std::size_t send_block_size{64UL * 1024UL};
+
+[[nodiscard]] auto format_http_date(std::chrono::sys_seconds time)
+    -> std::string {
+  return fmt::format("{:%a, %d %b %Y %H:%M:%S} GMT", time);
+}
+
+[[nodiscard]] auto format_iso_date(std::chrono::sys_seconds time)
+    -> std::string {
+  return fmt::format("{:%Y-%m-%dT%H:%M:%S}.000Z", time);
+}
+
+[[nodiscard]] auto get_key(const httplib::Request &req) -> std::string {
+  return req.matches.size() > 1U ? req.matches[1].str() : std::string{};
+}
+
+[[nodiscard]] auto now_seconds() -> std::chrono::sys_seconds {
+  return std::chrono::floor<std::chrono::seconds>(
+      std::chrono::system_clock::now());
+}
+
+void set_xml(httplib::Response &res, const pugi::xml_document &doc) {
+  std::stringstream stream;
+  doc.save(stream, "", pugi::format_raw);
+  res.set_content(stream.str(), "application/xml");
+}
+} // namespace
+
+namespace repertory::bench {
+s3_stand_in::s3_stand_in(std::string bucket, options opts)
+    : bucket_(std::move(bucket)), options_(opts) {}
+
+s3_stand_in::~s3_stand_in() { stop(); }
+
+void s3_stand_in::delay() const {
+  if (options_.latency.count() > 0) {
+    std::this_thread::sleep_for(options_.latency);
+  }
+}
+
+auto s3_stand_in::get_counters() const -> counters {
+  return {
+      .bytes_received = bytes_received_,
+      .bytes_sent = bytes_sent_,
+      .requests = requests_,
+  };
+}
+
+auto s3_stand_in::get_object_size(std::string_view key) const
+    -> std::optional<std::uint64_t> {
+  mutex_lock lock(mtx_);
+  auto iter = objects_.find(std::string{key});
+  if (iter == objects_.end()) {
+    return std::nullopt;
+  }
+
+  return iter->second.data->size();
+}
+
+auto s3_stand_in::get_url() const -> std::string {
+  return fmt::format("http://127.0.0.1:{}", port_);
+}
+
+void s3_stand_in::handle_delete(const httplib::Request &req,
+                                httplib::Response &res) {
+  auto key{get_key(req)};
+
+  mutex_lock lock(mtx_);
+  if (req.has_param("uploadId")) {
+    uploads_.erase(req.get_param_value("uploadId"));
+  } else {
+    objects_.erase(key);
+  }
+
+  res.status = 204;
+}
+
+void s3_stand_in::handle_get(const httplib::Request &req,
+                             httplib::Response &res) {
+  auto key{get_key(req)};
+  if (key.empty() || req.has_param("list-type")) {
+    handle_list(req, res);
+    return;
+  }
+
+  object obj{};
+  {
+    mutex_lock lock(mtx_);
+    auto iter = objects_.find(key);
+    if (iter == objects_.end()) {
+      res.status = 404;
+      return;
+    }
+    obj = iter->second;
+  }
+
+  res.set_header("ETag", fmt::format("\"{}\"", obj.data->size()));
+  res.set_header("Last-Modified", format_http_date(obj.modified));
+  if (obj.data->empty()) {
+    res.set_content("", "binary/octet-stream");
+    return;
+  }
+
+  res.set_content_provider(
+      obj.data->size(), "binary/octet-stream",
+      [this, data = obj.data](std::size_t offset, std::size_t length,
+                              httplib::DataSink &sink) -> bool {
+        auto count{std::min(length, send_block_size)};
+        throttle(count);
+        bytes_sent_ += count;
+        return sink.write(reinterpret_cast<const char *>(&data->at(offset)),
+                          count);
+      });
+}
+
+void s3_stand_in::handle_list(const httplib::Request &req,
+                              httplib::Response &res) {
+  auto delimiter{req.get_param_value("delimiter")};
+  auto prefix{req.get_param_value("prefix")};
+  auto token{req.get_param_value("continuation-token")};
+
+  pugi::xml_document doc;
+  auto result = doc.append_child("ListBucketResult");
+  result.append_child("Name").text().set(bucket_.c_str());
+  result.append_child("Prefix").text().set(prefix.c_str());
+  result.append_child("MaxKeys").text().set(std::to_string(max_keys).c_str());
+
+  std::size_t count{};
+  std::string last_key;
+  std::string last_prefix;
+
+  mutex_lock lock(mtx_);
+  auto iter = token.empty() ? objects_.lower_bound(prefix)
+                            : objects_.upper_bound(token);
+  for (; iter != objects_.end() && count < max_keys; ++iter) {
+    const auto &[key, obj] = *iter;
+    if (not key.starts_with(prefix)) {
+      break;
+    }
+
+    last_key = key;
+    ++count;
+
+    auto pos{
+        delimiter.empty() ? std::string::npos
+                          : key.find(delimiter, prefix.size()),
+    };
+    if (pos != std::string::npos) {
+      // Keys are ordered, so keys sharing a common prefix are adjacent
+      auto common_prefix{key.substr(0U, pos + delimiter.size())};
+      if (common_prefix != last_prefix) {
+        result.append_child("CommonPrefixes")
+            .append_child("Prefix")
+            .text()
+            .set(common_prefix.c_str());
+        last_prefix = common_prefix;
+      }
+      continue;
+    }
+
+    auto contents = result.append_child("Contents");
+    contents.append_child("Key").text().set(key.c_str());
+    contents.append_child("LastModified")
+        .text()
+        .set(format_iso_date(obj.modified).c_str());
+    contents.append_child("Size").text().set(
+        std::to_string(obj.data->size()).c_str());
+    contents.append_child("StorageClass").text().set("STANDARD");
+  }
+
+  auto truncated{
+      iter != objects_.end() && iter->first.starts_with(prefix),
+  };
+  lock.unlock();
+
+  result.append_child("KeyCount").text().set(std::to_string(count).c_str());
+  result.append_child("IsTruncated").text().set(truncated ? "true" : "false");
+  if (truncated) {
+    result.append_child("NextContinuationToken").text().set(last_key.c_str());
+  }
+
+  set_xml(res, doc);
+}
+
+void s3_stand_in::handle_post(const httplib::Request &req,
+                              httplib::Response &res) {
+  auto key{get_key(req)};
+
+  pugi::xml_document doc;
+  if (req.has_param("uploads")) {
+    unique_mutex_lock lock(mtx_);
+    auto upload_id{std::to_string(++next_upload_id_)};
+    uploads_[upload_id].key = key;
+    lock.unlock();
+
+    auto result = doc.append_child("InitiateMultipartUploadResult");
+    result.append_child("Bucket").text().set(bucket_.c_str());
+    result.append_child("Key").text().set(key.c_str());
+    result.append_child("UploadId").text().set(upload_id.c_str());
+    set_xml(res, doc);
+    return;
+  }
+
+  if (not req.has_param("uploadId")) {
+    res.status = 400;
+    return;
+  }
+
+  unique_mutex_lock lock(mtx_);
+  auto iter = uploads_.find(req.get_param_value("uploadId"));
+  if (iter == uploads_.end()) {
+    res.status = 404;
+    return;
+  }
+
+  auto upload{std::move(iter->second)};
+  uploads_.erase(iter);
+  lock.unlock();
+
+  auto data{std::make_shared<data_buffer>()};
+  for (const auto &part : upload.parts | std::views::values) {
+    data->insert(data->end(), part.begin(), part.end());
+  }
+
+  auto size{data->size()};
+  lock.lock();
+  objects_[key] = {
+      .data = std::move(data),
+      .modified = now_seconds(),
+  };
+  lock.unlock();
+
+  auto result = doc.append_child("CompleteMultipartUploadResult");
+  result.append_child("Bucket").text().set(bucket_.c_str());
+  result.append_child("Key").text().set(key.c_str());
+  result.append_child("ETag").text().set(fmt::format("\"{}\"", size).c_str());
+  set_xml(res, doc);
+}
+
+void s3_stand_in::handle_put(const httplib::Request &req,
+                             httplib::Response &res) {
+  auto key{get_key(req)};
+
+  throttle(req.body.size());
+  bytes_received_ += req.body.size();
+  data_buffer data(req.body.begin(), req.body.end());
+
+  if (req.has_param("uploadId")) {
+    auto part_number{
+        utils::string::to_uint32(req.get_param_value("partNumber")),
+    };
+
+    mutex_lock lock(mtx_);
+    auto iter = uploads_.find(req.get_param_value("uploadId"));
+    if (iter == uploads_.end()) {
+      res.status = 404;
+      return;
+    }
+
+    iter->second.parts[part_number] = std::move(data);
+    res.set_header("ETag", fmt::format("\"{}-{}\"", iter->first, part_number));
+    return;
+  }
+
+  res.set_header("ETag", fmt::format("\"{}\"", data.size()));
+
+  mutex_lock lock(mtx_);
+  objects_[key] = {
+      .data = std::make_shared<const data_buffer>(std::move(data)),
+      .modified = now_seconds(),
+  };
+}
+
+void s3_stand_in::put_object(std::string_view key, data_buffer data) {
+  mutex_lock lock(mtx_);
+  objects_[std::string{key}] = {
+      .data = std::make_shared<const data_buffer>(std::move(data)),
+      .modified = now_seconds(),
+  };
+}
+
+auto s3_stand_in::start() -> bool {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  if (server_thread_) {
+    return true;
+  }
+
+  server_ = std::make_unique<httplib::Server>();
+  server_->set_payload_max_length(std::numeric_limits<std::size_t>::max());
+  server_->set_pre_routing_handler(
+      [this](auto && /* req */,
+             auto && /* res */) -> httplib::Server::HandlerResponse {
+        ++requests_;
+        delay();
+        return httplib::Server::HandlerResponse::Unhandled;
+      });
+
+  auto bucket_path{"/" + bucket_};
+  auto key_path{bucket_path + "/(.*)"};
+  for (const auto &path : {bucket_path, key_path}) {
+    server_->Delete(path, [this](auto &&req, auto &&res) {
+      handle_delete(req, res);
+    });
+    server_->Get(path,
+                 [this](auto &&req, auto &&res) { handle_get(req, res); });
+    server_->Post(path,
+                  [this](auto &&req, auto &&res) { handle_post(req, res); });
+    server_->Put(path,
+                 [this](auto &&req, auto &&res) { handle_put(req, res); });
+  }
+
+  auto port{server_->bind_to_any_port("127.0.0.1")};
+  if (port <= 0) {
+    utils::error::raise_error(function_name, "failed to bind s3 stand-in");
+    server_.reset();
+    return false;
+  }
+
+  port_ = static_cast<std::uint16_t>(port);
+  server_thread_ =
+      std::make_unique<std::thread>([this]() { server_->listen_after_bind(); });
+  server_->wait_until_ready();
+  return true;
+}
+
+void s3_stand_in::stop() {
+  if (not server_thread_) {
+    return;
+  }
+
+  server_->stop();
+  server_thread_->join();
+  server_thread_.reset();
+  server_.reset();
+}
+
+void s3_stand_in::throttle(std::uint64_t bytes) const {
+  if (options_.bandwidth == 0U || bytes == 0U) {
+    return;
+  }
+
+  std::this_thread::sleep_for(std::chrono::microseconds(
+      bytes * 1000000ULL / options_.bandwidth));
+}
+} // namespace repertory::bench
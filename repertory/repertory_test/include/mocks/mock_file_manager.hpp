@@ -0,0 +1,61 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef REPERTORY_TEST_INCLUDE_MOCKS_MOCK_FILE_MANAGER_HPP_
+#define REPERTORY_TEST_INCLUDE_MOCKS_MOCK_FILE_MANAGER_HPP_
+
+#include "test_common.hpp"
+
+#include "file_manager/i_file_manager.hpp"
+
+namespace repertory {
+class mock_file_manager : public i_file_manager {
+public:
+  MOCK_METHOD(bool, download_pinned_file, (std::string_view api_path),
+              (override));
+
+  MOCK_METHOD(bool, evict_file, (std::string_view api_path), (override));
+
+  MOCK_METHOD(std::size_t, get_cached_file_count, (), (const, override));
+
+  MOCK_METHOD(api_error, get_directory_item,
+              (std::string_view api_path, directory_item &item),
+              (const, override));
+
+  MOCK_METHOD(directory_item_list, get_directory_items,
+              (std::string_view api_path), (const, override));
+
+  MOCK_METHOD(std::vector<std::string>, get_eviction_candidates,
+              (std::size_t count, std::uint64_t max_accessed), (override));
+
+  MOCK_METHOD(i_file_mgr_db *, get_file_mgr_db, (), (override));
+
+  MOCK_METHOD((std::unordered_map<std::string, std::size_t>), get_open_files,
+              (), (const, override));
+
+  MOCK_METHOD(bool, has_no_open_file_handles, (), (const, override));
+
+  MOCK_METHOD(bool, is_processing, (std::string_view api_path),
+              (const, override));
+};
+} // namespace repertory
+
+#endif // REPERTORY_TEST_INCLUDE_MOCKS_MOCK_FILE_MANAGER_HPP_
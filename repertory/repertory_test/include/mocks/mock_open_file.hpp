@@ -37,6 +37,8 @@ public:
 
   MOCK_METHOD(bool, close, (), (override));
 
+  MOCK_METHOD(api_error, flush_pending_meta, (), (override));
+
   MOCK_METHOD(void, force_download, (), (override));
 
   MOCK_METHOD(std::string, get_api_path, (), (const, override));
@@ -55,6 +57,8 @@ public:
 
   MOCK_METHOD(std::size_t, get_open_file_count, (), (const, override));
 
+  MOCK_METHOD(api_meta_map, get_pending_meta, (), (const, override));
+
   MOCK_METHOD(boost::dynamic_bitset<>, get_read_state, (), (const, override));
 
   MOCK_METHOD(bool, get_allocated, (), (const, override));
@@ -81,6 +85,10 @@ public:
 
   MOCK_METHOD(bool, is_modified, (), (const, override));
 
+  MOCK_METHOD(bool, is_pending_meta_expired, (), (const, override));
+
+  MOCK_METHOD(bool, is_sync_requested, (), (const, override));
+
   MOCK_METHOD(bool, is_unlinked, (), (const, override));
 
   MOCK_METHOD(bool, is_write_supported, (), (const, override));
@@ -97,6 +105,11 @@ public:
                data_buffer &data),
               (override));
 
+  MOCK_METHOD(api_error, read,
+              (std::uint64_t read_offset, data_span data,
+               std::size_t &bytes_read),
+              (override));
+
   MOCK_METHOD(void, remove, (std::uint64_t handle), (override));
 
   MOCK_METHOD(void, remove_all, (), (override));
@@ -105,6 +118,14 @@ public:
 
   MOCK_METHOD(void, set_api_path, (std::string_view api_path), (override));
 
+  MOCK_METHOD(void, set_meta_flush_interval, (std::uint16_t seconds),
+              (override));
+
+  MOCK_METHOD(api_error, set_pending_meta, (const api_meta_map &meta),
+              (override));
+
+  MOCK_METHOD(void, set_sync_requested, (bool value), (override));
+
   MOCK_METHOD(void, set_unlinked, (bool value), (override));
 
   MOCK_METHOD(void, set_unlinked_meta, (api_meta_map meta), (override));
@@ -113,6 +134,11 @@ public:
               (std::uint64_t write_offset, const data_buffer &data,
                std::size_t &bytes_written),
               (override));
+
+  MOCK_METHOD(api_error, write,
+              (std::uint64_t write_offset, data_cspan data,
+               std::size_t &bytes_written),
+              (override));
 };
 } // namespace repertory
 
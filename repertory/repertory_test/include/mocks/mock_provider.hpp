@@ -120,6 +120,20 @@ public:
                data_buffer &data, stop_type &stop_requested),
               (override));
 
+  auto read_file_bytes(std::string_view api_path, std::uint64_t offset,
+                       data_span data, std::size_t &bytes_read,
+                       stop_type &stop_requested) -> api_error override {
+    data_buffer buffer;
+    auto res = read_file_bytes(api_path, data.size(), offset, buffer,
+                               stop_requested);
+    bytes_read = 0U;
+    if (res == api_error::success) {
+      bytes_read = std::min(buffer.size(), data.size());
+      std::memcpy(data.data(), buffer.data(), bytes_read);
+    }
+    return res;
+  }
+
   MOCK_METHOD(api_error, remove_directory, (std::string_view api_path),
               (override));
 
@@ -0,0 +1,130 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "file_manager/access_pattern.hpp"
+
+namespace {
+constexpr std::uint64_t test_chunk_size{1024U};
+constexpr std::size_t test_chunk_count{100U};
+} // namespace
+
+namespace repertory {
+TEST(access_pattern_test, detects_sequential_reads_and_grows_window) {
+  access_pattern pattern{test_chunk_size};
+
+  EXPECT_TRUE(pattern.record(0U, test_chunk_size, test_chunk_count).empty());
+  EXPECT_TRUE(pattern
+                  .record(test_chunk_size, test_chunk_size, test_chunk_count)
+                  .empty());
+
+  auto window =
+      pattern.record(test_chunk_size * 2U, test_chunk_size, test_chunk_count);
+  EXPECT_EQ(access_pattern::type::sequential, pattern.get_last_type());
+  EXPECT_EQ((std::vector<std::size_t>{3U}), window);
+
+  window =
+      pattern.record(test_chunk_size * 3U, test_chunk_size, test_chunk_count);
+  EXPECT_EQ((std::vector<std::size_t>{4U, 5U}), window);
+
+  for (std::size_t chunk = 4U; chunk < 20U; ++chunk) {
+    window = pattern.record(chunk * test_chunk_size, test_chunk_size,
+                            test_chunk_count);
+  }
+  EXPECT_EQ(access_pattern::default_max_window, window.size());
+  EXPECT_EQ(20U, window.front());
+}
+
+TEST(access_pattern_test, small_reads_within_a_chunk_do_not_grow_window) {
+  access_pattern pattern{test_chunk_size};
+
+  std::vector<std::size_t> window;
+  for (std::uint64_t offset = 0U; offset < test_chunk_size; offset += 64U) {
+    window = pattern.record(offset, 64U, test_chunk_count);
+  }
+
+  EXPECT_EQ(access_pattern::type::sequential, pattern.get_last_type());
+  EXPECT_EQ((std::vector<std::size_t>{1U}), window);
+}
+
+TEST(access_pattern_test, detects_reverse_reads) {
+  access_pattern pattern{test_chunk_size};
+
+  std::vector<std::size_t> window;
+  for (std::size_t chunk = 50U; chunk > 46U; --chunk) {
+    window = pattern.record(chunk * test_chunk_size, test_chunk_size,
+                            test_chunk_count);
+  }
+
+  EXPECT_EQ(access_pattern::type::reverse, pattern.get_last_type());
+  EXPECT_EQ((std::vector<std::size_t>{46U, 45U}), window);
+}
+
+TEST(access_pattern_test, detects_strided_reads) {
+  access_pattern pattern{test_chunk_size};
+
+  std::vector<std::size_t> window;
+  for (std::size_t idx = 0U; idx < 5U; ++idx) {
+    window = pattern.record(idx * 5U * test_chunk_size, 512U, test_chunk_count);
+  }
+
+  EXPECT_EQ(access_pattern::type::strided, pattern.get_last_type());
+  EXPECT_EQ((std::vector<std::size_t>{25U, 30U}), window);
+}
+
+TEST(access_pattern_test, random_reads_do_not_read_ahead) {
+  access_pattern pattern{test_chunk_size};
+
+  for (const auto &chunk : {42U, 7U, 93U, 18U, 66U, 3U, 51U, 80U}) {
+    EXPECT_TRUE(
+        pattern.record(chunk * test_chunk_size, 64U, test_chunk_count).empty());
+    EXPECT_EQ(access_pattern::type::random, pattern.get_last_type());
+  }
+}
+
+TEST(access_pattern_test, tracks_interleaved_streams) {
+  access_pattern pattern{test_chunk_size};
+
+  std::vector<std::size_t> window1;
+  std::vector<std::size_t> window2;
+  for (std::size_t chunk = 0U; chunk < 3U; ++chunk) {
+    window1 = pattern.record(chunk * test_chunk_size, test_chunk_size,
+                             test_chunk_count);
+    window2 = pattern.record((60U + chunk) * test_chunk_size, test_chunk_size,
+                             test_chunk_count);
+  }
+
+  EXPECT_EQ((std::vector<std::size_t>{3U}), window1);
+  EXPECT_EQ((std::vector<std::size_t>{63U}), window2);
+}
+
+TEST(access_pattern_test, window_is_clipped_to_chunk_count) {
+  access_pattern pattern{test_chunk_size};
+
+  std::vector<std::size_t> window;
+  for (std::size_t chunk = 0U; chunk < 10U; ++chunk) {
+    window = pattern.record(chunk * test_chunk_size, test_chunk_size, 12U);
+  }
+
+  EXPECT_EQ((std::vector<std::size_t>{10U, 11U}), window);
+}
+} // namespace repertory
@@ -68,15 +68,19 @@ public:
 static void remove_unused_types(auto &data, provider_type prov) {
   switch (prov) {
   case provider_type::encrypt:
+    data.erase(JSON_DIRECTORY_CACHE_TIMEOUT_SECS);
     data.erase(JSON_DOWNLOAD_TIMEOUT_SECS);
     data.erase(JSON_ENABLE_DOWNLOAD_TIMEOUT);
     data.erase(JSON_EVICTION_DELAY_MINS);
     data.erase(JSON_EVICTION_USE_ACCESS_TIME);
     data.erase(JSON_HOST_CONFIG);
     data.erase(JSON_MAX_CACHE_SIZE_BYTES);
+    data.erase(JSON_MAX_DOWNLOAD_COUNT);
+    data.erase(JSON_MAX_UPLOAD_BYTES);
     data.erase(JSON_MAX_UPLOAD_COUNT);
     data.erase(JSON_ONLINE_CHECK_RETRY_SECS);
     data.erase(JSON_PREFERRED_DOWNLOAD_TYPE);
+    data.erase(JSON_READ_AHEAD_POLICY);
     data.erase(JSON_REMOTE_CONFIG);
     data.erase(JSON_RETRY_READ_COUNT);
     data.erase(JSON_RING_BUFFER_FILE_SIZE);
@@ -85,7 +89,9 @@ static void remove_unused_types(auto &data, provider_type prov) {
     break;
 
   case provider_type::remote:
+    data.erase(JSON_CHUNK_CACHE_SIZE_BYTES);
     data.erase(JSON_DATABASE_TYPE);
+    data.erase(JSON_DIRECTORY_CACHE_TIMEOUT_SECS);
     data.erase(JSON_DOWNLOAD_TIMEOUT_SECS);
     data.erase(JSON_ENABLE_DOWNLOAD_TIMEOUT);
     data.erase(JSON_ENCRYPT_CONFIG);
@@ -95,10 +101,14 @@ static void remove_unused_types(auto &data, provider_type prov) {
     data.erase(JSON_HOST_CONFIG);
     data.erase(JSON_LOW_FREQ_INTERVAL_SECS);
     data.erase(JSON_MAX_CACHE_SIZE_BYTES);
+    data.erase(JSON_MAX_DOWNLOAD_COUNT);
+    data.erase(JSON_MAX_UPLOAD_BYTES);
     data.erase(JSON_MAX_UPLOAD_COUNT);
     data.erase(JSON_MED_FREQ_INTERVAL_SECS);
+    data.erase(JSON_META_FLUSH_INTERVAL_SECS);
     data.erase(JSON_ONLINE_CHECK_RETRY_SECS);
     data.erase(JSON_PREFERRED_DOWNLOAD_TYPE);
+    data.erase(JSON_READ_AHEAD_POLICY);
     data.erase(JSON_REMOTE_MOUNT);
     data.erase(JSON_RETRY_READ_COUNT);
     data.erase(JSON_RING_BUFFER_FILE_SIZE);
@@ -130,8 +140,10 @@ static void defaults_tests(const json &json_data, provider_type prov) {
   json json_defaults = {
       {JSON_API_PORT, default_rpc_port},
       {JSON_API_USER, std::string{REPERTORY}},
+      {JSON_CHUNK_CACHE_SIZE_BYTES, default_chunk_cache_size_bytes},
       {JSON_DOWNLOAD_TIMEOUT_SECS, default_download_timeout_secs},
       {JSON_DATABASE_TYPE, database_type::rocksdb},
+      {JSON_DIRECTORY_CACHE_TIMEOUT_SECS, default_directory_cache_timeout_secs},
       {JSON_ENABLE_DOWNLOAD_TIMEOUT, true},
       {JSON_ENABLE_DRIVE_EVENTS, false},
 #if defined(_WIN32)
@@ -143,12 +155,17 @@ static void defaults_tests(const json &json_data, provider_type prov) {
       {JSON_EVICTION_USE_ACCESS_TIME, false},
       {JSON_HIGH_FREQ_INTERVAL_SECS, default_high_freq_interval_secs},
       {JSON_HOST_CONFIG, host_config{}},
+      {JSON_KERNEL_ATTR_TIMEOUT_SECS, default_kernel_attr_timeout_secs},
       {JSON_LOW_FREQ_INTERVAL_SECS, default_low_freq_interval_secs},
       {JSON_MAX_CACHE_SIZE_BYTES, default_max_cache_size_bytes},
+      {JSON_MAX_DOWNLOAD_COUNT, default_max_download_count},
+      {JSON_MAX_UPLOAD_BYTES, default_max_upload_bytes},
       {JSON_MAX_UPLOAD_COUNT, default_max_upload_count},
       {JSON_MED_FREQ_INTERVAL_SECS, default_med_freq_interval_secs},
+      {JSON_META_FLUSH_INTERVAL_SECS, default_meta_flush_interval_secs},
       {JSON_ONLINE_CHECK_RETRY_SECS, default_online_check_retry_secs},
       {JSON_PREFERRED_DOWNLOAD_TYPE, download_type::default_},
+      {JSON_READ_AHEAD_POLICY, read_ahead_policy::adaptive},
       {JSON_REMOTE_CONFIG, remote::remote_config{}},
       {JSON_REMOTE_MOUNT, remote::remote_mount{}},
       {JSON_RETRY_READ_COUNT, default_retry_read_count},
@@ -235,6 +252,13 @@ static void common_tests(app_config &config, provider_type prov) {
                             &app_config::set_api_user, "", "user",
                             JSON_API_USER, "user2");
        }},
+      {JSON_CHUNK_CACHE_SIZE_BYTES,
+       [](app_config &cfg) {
+         test_getter_setter(cfg, &app_config::get_chunk_cache_size_bytes,
+                            &app_config::set_chunk_cache_size_bytes,
+                            std::uint64_t{1U}, std::uint64_t{2U},
+                            JSON_CHUNK_CACHE_SIZE_BYTES, "3");
+       }},
       {JSON_DOWNLOAD_TIMEOUT_SECS,
        [](app_config &cfg) {
          test_getter_setter(cfg, &app_config::get_download_timeout_secs,
@@ -254,6 +278,19 @@ static void common_tests(app_config &config, provider_type prov) {
                             database_type::rocksdb, database_type::sqlite,
                             JSON_DATABASE_TYPE, "rocksdb");
        }},
+      {JSON_DIRECTORY_CACHE_TIMEOUT_SECS,
+       [](app_config &cfg) {
+         test_getter_setter(
+             cfg, &app_config::get_directory_cache_timeout_secs,
+             &app_config::set_directory_cache_timeout_secs,
+             std::uint16_t{default_directory_cache_timeout_secs + 1U},
+             std::uint16_t{default_directory_cache_timeout_secs + 2U},
+             JSON_DIRECTORY_CACHE_TIMEOUT_SECS,
+             std::to_string(default_directory_cache_timeout_secs + 3U));
+
+         cfg.set_directory_cache_timeout_secs(0U);
+         EXPECT_EQ(0U, cfg.get_directory_cache_timeout_secs());
+       }},
       {JSON_ENABLE_DOWNLOAD_TIMEOUT,
        [](app_config &cfg) {
          test_getter_setter(cfg, &app_config::get_enable_download_timeout,
@@ -410,6 +447,19 @@ static void common_tests(app_config &config, provider_type prov) {
              std::to_string(cfg3.timeout_ms));
          EXPECT_STREQ(std::to_string(cfg3.timeout_ms).c_str(), value.c_str());
        }},
+      {JSON_KERNEL_ATTR_TIMEOUT_SECS,
+       [](app_config &cfg) {
+         test_getter_setter(
+             cfg, &app_config::get_kernel_attr_timeout_secs,
+             &app_config::set_kernel_attr_timeout_secs,
+             std::uint16_t{default_kernel_attr_timeout_secs + 1U},
+             std::uint16_t{default_kernel_attr_timeout_secs + 2U},
+             JSON_KERNEL_ATTR_TIMEOUT_SECS,
+             std::to_string(default_kernel_attr_timeout_secs + 3U));
+
+         cfg.set_kernel_attr_timeout_secs(0U);
+         EXPECT_EQ(0U, cfg.get_kernel_attr_timeout_secs());
+       }},
       {JSON_LOW_FREQ_INTERVAL_SECS,
        [](app_config &cfg) {
          test_getter_setter(
@@ -434,6 +484,23 @@ static void common_tests(app_config &config, provider_type prov) {
          cfg.set_max_cache_size_bytes(min_cache_size_bytes - 1U);
          EXPECT_EQ(min_cache_size_bytes, cfg.get_max_cache_size_bytes());
        }},
+      {JSON_MAX_DOWNLOAD_COUNT,
+       [](app_config &cfg) {
+         test_getter_setter(cfg, &app_config::get_max_download_count,
+                            &app_config::set_max_download_count,
+                            std::uint8_t{1U}, std::uint8_t{2U},
+                            JSON_MAX_DOWNLOAD_COUNT, "3");
+
+         cfg.set_max_download_count(0U);
+         EXPECT_EQ(1U, cfg.get_max_download_count());
+       }},
+      {JSON_MAX_UPLOAD_BYTES,
+       [](app_config &cfg) {
+         test_getter_setter(cfg, &app_config::get_max_upload_bytes,
+                            &app_config::set_max_upload_bytes,
+                            std::uint64_t{1U}, std::uint64_t{2U},
+                            JSON_MAX_UPLOAD_BYTES, "3");
+       }},
       {JSON_MAX_UPLOAD_COUNT,
        [](app_config &cfg) {
          test_getter_setter(cfg, &app_config::get_max_upload_count,
@@ -456,6 +523,19 @@ static void common_tests(app_config &config, provider_type prov) {
          cfg.set_med_frequency_interval_secs(0U);
          EXPECT_EQ(1U, cfg.get_med_frequency_interval_secs());
        }},
+      {JSON_META_FLUSH_INTERVAL_SECS,
+       [](app_config &cfg) {
+         test_getter_setter(
+             cfg, &app_config::get_meta_flush_interval_secs,
+             &app_config::set_meta_flush_interval_secs,
+             std::uint16_t{default_meta_flush_interval_secs + 1U},
+             std::uint16_t{default_meta_flush_interval_secs + 2U},
+             JSON_META_FLUSH_INTERVAL_SECS,
+             std::to_string(default_meta_flush_interval_secs + 3U));
+
+         cfg.set_meta_flush_interval_secs(0U);
+         EXPECT_EQ(0U, cfg.get_meta_flush_interval_secs());
+       }},
       {JSON_ONLINE_CHECK_RETRY_SECS,
        [](app_config &cfg) {
          test_getter_setter(cfg, &app_config::get_online_check_retry_secs,
@@ -476,6 +556,13 @@ static void common_tests(app_config &config, provider_type prov) {
                             download_type::direct, download_type::default_,
                             JSON_PREFERRED_DOWNLOAD_TYPE, "ring_buffer");
        }},
+      {JSON_READ_AHEAD_POLICY,
+       [](app_config &cfg) {
+         test_getter_setter(cfg, &app_config::get_read_ahead_policy,
+                            &app_config::set_read_ahead_policy,
+                            read_ahead_policy::full, read_ahead_policy::none,
+                            JSON_READ_AHEAD_POLICY, "adaptive");
+       }},
       {JSON_REMOTE_CONFIG,
        [](app_config &cfg) {
          remote::remote_config remote_cfg1{};
@@ -634,6 +721,8 @@ static void common_tests(app_config &config, provider_type prov) {
          cfg1.use_path_style = false;
          cfg1.use_region_in_url = false;
          cfg1.force_legacy_encryption = false;
+         cfg1.max_upload_part_count = 1U;
+         cfg1.upload_part_size = 16U;
 
          s3_config cfg2{};
          cfg2.access_key = "8";
@@ -646,6 +735,8 @@ static void common_tests(app_config &config, provider_type prov) {
          cfg2.use_path_style = true;
          cfg2.use_region_in_url = true;
          cfg2.force_legacy_encryption = true;
+         cfg2.max_upload_part_count = 2U;
+         cfg2.upload_part_size = 32U;
 
          ASSERT_NE(cfg1, cfg2);
 
@@ -663,6 +754,8 @@ static void common_tests(app_config &config, provider_type prov) {
          cfg3.use_path_style = true;
          cfg3.use_region_in_url = true;
          cfg3.force_legacy_encryption = true;
+         cfg3.max_upload_part_count = 3U;
+         cfg3.upload_part_size = 48U;
 
          auto value = cfg.set_value_by_name(
              fmt::format("{}.{}", JSON_S3_CONFIG, JSON_ACCESS_KEY),
@@ -714,6 +807,18 @@ static void common_tests(app_config &config, provider_type prov) {
          EXPECT_STREQ(
              utils::string::from_bool(cfg3.force_legacy_encryption).c_str(),
              value.c_str());
+
+         value = cfg.set_value_by_name(
+             fmt::format("{}.{}", JSON_S3_CONFIG, JSON_MAX_UPLOAD_PART_COUNT),
+             std::to_string(cfg3.max_upload_part_count));
+         EXPECT_STREQ(std::to_string(cfg3.max_upload_part_count).c_str(),
+                      value.c_str());
+
+         value = cfg.set_value_by_name(
+             fmt::format("{}.{}", JSON_S3_CONFIG, JSON_UPLOAD_PART_SIZE),
+             std::to_string(cfg3.upload_part_size));
+         EXPECT_STREQ(std::to_string(cfg3.upload_part_size).c_str(),
+                      value.c_str());
        }},
       {JSON_SIA_CONFIG,
        [](app_config &cfg) {
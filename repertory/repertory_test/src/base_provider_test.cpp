@@ -0,0 +1,387 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "app_config.hpp"
+#include "comm/curl/curl_comm.hpp"
+#include "mocks/mock_file_manager.hpp"
+#include "providers/base_provider.hpp"
+
+namespace {
+[[nodiscard]] auto create_test_file(std::string_view api_path,
+                                    std::uint64_t size,
+                                    std::uint64_t modified_date)
+    -> repertory::api_file {
+  return {
+      .api_path = std::string{api_path},
+      .api_parent = repertory::utils::path::get_parent_api_path(api_path),
+      .file_size = size,
+      .modified_date = modified_date,
+  };
+}
+} // namespace
+
+namespace repertory {
+// Serves a fixed listing and reports remote sizes and modified times so the
+// reconcile pass can be driven without a backend.
+class test_provider final : public base_provider {
+public:
+  test_provider(app_config &config, i_http_comm &comm)
+      : base_provider(config, comm) {}
+
+private:
+  api_file_list files_;
+  mutable std::mutex files_mtx_;
+
+protected:
+  [[nodiscard]] auto create_directory_impl(std::string_view /* api_path */,
+                                           api_meta_map & /* meta */)
+      -> api_error override {
+    return api_error::success;
+  }
+
+  [[nodiscard]] auto get_directory_items_impl(std::string_view api_path,
+                                              directory_item_list &list) const
+      -> api_error override {
+    for (const auto &file : get_files()) {
+      if (file.api_parent != api_path) {
+        continue;
+      }
+
+      api_meta_map meta;
+      auto res = get_item_meta(file.api_path, meta);
+      if (res != api_error::success) {
+        return res;
+      }
+
+      list.push_back(directory_item{
+          .api_path = file.api_path,
+          .api_parent = file.api_parent,
+          .directory = false,
+          .size = utils::string::to_uint64(meta[META_SIZE]),
+          .meta = meta,
+      });
+    }
+
+    return api_error::success;
+  }
+
+  [[nodiscard]] auto is_change_detection_supported() const -> bool override {
+    return true;
+  }
+
+  [[nodiscard]] auto remove_directory_impl(std::string_view /* api_path */)
+      -> api_error override {
+    return api_error::success;
+  }
+
+  [[nodiscard]] auto remove_file_impl(std::string_view /* api_path */)
+      -> api_error override {
+    return api_error::success;
+  }
+
+  [[nodiscard]] auto upload_file_impl(std::string_view /* api_path */,
+                                      std::string_view /* source_path */,
+                                      stop_type & /* stop_requested */)
+      -> api_error override {
+    return api_error::success;
+  }
+
+public:
+  using base_provider::remove_deleted_items;
+
+  [[nodiscard]] auto check_version(std::string & /* required_version */,
+                                   std::string & /* returned_version */) const
+      -> bool override {
+    return true;
+  }
+
+  [[nodiscard]] auto
+  get_directory_item_count(std::string_view /* api_path */) const
+      -> std::uint64_t override {
+    return 0U;
+  }
+
+  [[nodiscard]] auto get_file(std::string_view /* api_path */,
+                              api_file & /* file */) const
+      -> api_error override {
+    return api_error::not_implemented;
+  }
+
+  [[nodiscard]] auto get_file_list(api_file_list &list,
+                                   std::string & /* marker */) const
+      -> api_error override {
+    list = get_files();
+    return api_error::success;
+  }
+
+  [[nodiscard]] auto get_files() const -> api_file_list {
+    mutex_lock lock(files_mtx_);
+    return files_;
+  }
+
+  [[nodiscard]] auto get_provider_type() const -> provider_type override {
+    return provider_type::s3;
+  }
+
+  [[nodiscard]] auto get_total_drive_space() const -> std::uint64_t override {
+    return 0U;
+  }
+
+  [[nodiscard]] auto is_directory(std::string_view api_path,
+                                  bool &exists) const -> api_error override {
+    exists = (api_path == "/");
+    return api_error::success;
+  }
+
+  [[nodiscard]] auto is_file(std::string_view api_path, bool &exists) const
+      -> api_error override {
+    auto files = get_files();
+    exists = std::ranges::any_of(files, [&api_path](auto &&file) -> bool {
+      return file.api_path == api_path;
+    });
+    return api_error::success;
+  }
+
+  [[nodiscard]] auto is_online() const -> bool override { return true; }
+
+  [[nodiscard]] auto is_rename_supported() const -> bool override {
+    return false;
+  }
+
+  using base_provider::read_file_bytes;
+
+  [[nodiscard]] auto read_file_bytes(std::string_view /* api_path */,
+                                     std::size_t /* size */,
+                                     std::uint64_t /* offset */,
+                                     data_buffer & /* data */,
+                                     stop_type & /* stop_requested */)
+      -> api_error override {
+    return api_error::not_implemented;
+  }
+
+  [[nodiscard]] auto rename_file(std::string_view /* from_api_path */,
+                                 std::string_view /* to_api_path */)
+      -> api_error override {
+    return api_error::not_implemented;
+  }
+
+  void set_files(api_file_list files) {
+    mutex_lock lock(files_mtx_);
+    files_ = std::move(files);
+  }
+};
+
+class base_provider_test : public ::testing::Test {
+public:
+  console_consumer con_consumer;
+  std::unique_ptr<app_config> config;
+  std::unique_ptr<curl_comm> comm;
+  mock_file_manager mgr;
+  std::unique_ptr<test_provider> provider;
+
+private:
+  static std::atomic<std::size_t> idx;
+
+protected:
+  void SetUp() override {
+    event_system::instance().start();
+
+    config = std::make_unique<app_config>(
+        provider_type::s3,
+        utils::path::combine(test::get_test_output_dir(),
+                             {
+                                 "base_provider_test",
+                                 std::to_string(++idx),
+                             }));
+    config->set_database_type(database_type::sqlite);
+
+    comm = std::make_unique<curl_comm>(config->get_s3_config());
+    provider = std::make_unique<test_provider>(*config, *comm);
+
+    EXPECT_CALL(mgr, is_processing).WillRepeatedly(Return(false));
+
+    ASSERT_TRUE(provider->start(
+        [this](bool directory, api_file &file) -> api_error {
+          return add_item(directory, file);
+        },
+        &mgr));
+  }
+
+  void TearDown() override {
+    provider->stop();
+    provider.reset();
+    comm.reset();
+    config.reset();
+
+    event_system::instance().stop();
+  }
+
+  auto add_item(bool directory, const api_file &file) -> api_error {
+    return provider->set_item_meta(
+        file.api_path,
+        {
+            {META_DIRECTORY, utils::string::from_bool(directory)},
+            {META_MODIFIED, std::to_string(file.modified_date)},
+            {META_SIZE, std::to_string(file.file_size)},
+            {META_SOURCE, ""},
+        });
+  }
+
+  void add_files(const api_file_list &files) {
+    for (const auto &file : files) {
+      EXPECT_EQ(api_error::success, add_item(false, file));
+    }
+    provider->set_files(files);
+  }
+
+  [[nodiscard]] auto get_size(std::string_view api_path) -> std::uint64_t {
+    std::string value;
+    EXPECT_EQ(api_error::success,
+              provider->get_item_meta(api_path, META_SIZE, value));
+    return utils::string::to_uint64(value);
+  }
+
+  void reconcile() {
+    stop_type stop_requested{false};
+    provider->remove_deleted_items(stop_requested);
+  }
+};
+
+std::atomic<std::size_t> base_provider_test::idx{0U};
+
+TEST_F(base_provider_test, items_missing_from_listing_are_removed) {
+  add_files({
+      create_test_file("/a.txt", 10U, 1U),
+      create_test_file("/b.txt", 10U, 1U),
+  });
+  reconcile();
+
+  provider->set_files({
+      create_test_file("/a.txt", 10U, 1U),
+  });
+  reconcile();
+
+  api_meta_map meta;
+  EXPECT_EQ(api_error::success, provider->get_item_meta("/a.txt", meta));
+  EXPECT_EQ(api_error::item_not_found, provider->get_item_meta("/b.txt", meta));
+}
+
+TEST_F(base_provider_test, items_being_processed_are_not_removed) {
+  add_files({
+      create_test_file("/a.txt", 10U, 1U),
+  });
+  reconcile();
+
+  EXPECT_CALL(mgr, is_processing(std::string_view{"/a.txt"}))
+      .WillRepeatedly(Return(true));
+  provider->set_files({});
+  reconcile();
+
+  api_meta_map meta;
+  EXPECT_EQ(api_error::success, provider->get_item_meta("/a.txt", meta));
+}
+
+TEST_F(base_provider_test, unchanged_file_is_not_reported_as_changed) {
+  add_files({
+      create_test_file("/a.txt", 10U, 1U),
+  });
+  reconcile();
+
+  EXPECT_EQ(api_error::success,
+            provider->set_item_meta("/a.txt", META_SIZE, "5"));
+  reconcile();
+
+  EXPECT_EQ(5U, get_size("/a.txt"));
+}
+
+TEST_F(base_provider_test, external_change_updates_meta_and_listing) {
+  add_files({
+      create_test_file("/a.txt", 10U, 1U),
+  });
+  reconcile();
+
+  directory_item_list list;
+  EXPECT_EQ(api_error::success, provider->get_directory_items("/", list));
+  ASSERT_EQ(3U, list.size());
+  EXPECT_EQ(10U, list.at(2U).size);
+
+  provider->set_files({
+      create_test_file("/a.txt", 20U, 2U),
+  });
+  reconcile();
+
+  EXPECT_EQ(20U, get_size("/a.txt"));
+
+  std::string value;
+  EXPECT_EQ(api_error::success,
+            provider->get_item_meta("/a.txt", META_MODIFIED, value));
+  EXPECT_STREQ("2", value.c_str());
+
+  EXPECT_EQ(api_error::success, provider->get_directory_items("/", list));
+  ASSERT_EQ(3U, list.size());
+  EXPECT_EQ(20U, list.at(2U).size);
+}
+
+TEST_F(base_provider_test, first_change_after_own_upload_is_ignored) {
+  add_files({
+      create_test_file("/a.txt", 10U, 1U),
+  });
+  reconcile();
+
+  stop_type stop_requested{false};
+  EXPECT_EQ(api_error::success,
+            provider->upload_file("/a.txt", "", stop_requested));
+
+  provider->set_files({
+      create_test_file("/a.txt", 20U, 2U),
+  });
+  reconcile();
+  EXPECT_EQ(10U, get_size("/a.txt"));
+
+  provider->set_files({
+      create_test_file("/a.txt", 30U, 3U),
+  });
+  reconcile();
+  EXPECT_EQ(30U, get_size("/a.txt"));
+}
+
+TEST_F(base_provider_test, change_skipped_while_processing_is_retried) {
+  add_files({
+      create_test_file("/a.txt", 10U, 1U),
+  });
+  reconcile();
+
+  EXPECT_CALL(mgr, is_processing(std::string_view{"/a.txt"}))
+      .WillOnce(Return(true))
+      .WillRepeatedly(Return(false));
+
+  provider->set_files({
+      create_test_file("/a.txt", 20U, 2U),
+  });
+  reconcile();
+  EXPECT_EQ(10U, get_size("/a.txt"));
+
+  reconcile();
+  EXPECT_EQ(20U, get_size("/a.txt"));
+}
+} // namespace repertory
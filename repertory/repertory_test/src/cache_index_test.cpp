@@ -0,0 +1,115 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "file_manager/cache_index.hpp"
+
+namespace repertory {
+TEST(cache_index_test, pop_returns_least_recently_used_first) {
+  cache_index index;
+  index.touch("/cache/c", 3U);
+  index.touch("/cache/a", 1U);
+  index.touch("/cache/b", 2U);
+  EXPECT_EQ(std::size_t(3U), index.size());
+
+  auto entries = index.pop(2U, 10U);
+  ASSERT_EQ(std::size_t(2U), entries.size());
+  EXPECT_STREQ("/cache/c", entries.at(0U).source_path.c_str());
+  EXPECT_EQ(std::uint64_t(3U), entries.at(0U).accessed);
+  EXPECT_STREQ("/cache/a", entries.at(1U).source_path.c_str());
+  EXPECT_EQ(std::size_t(3U), index.size());
+}
+
+TEST(cache_index_test, touch_moves_entry_to_back) {
+  cache_index index;
+  index.touch("/cache/a", 1U);
+  index.touch("/cache/b", 2U);
+  index.touch("/cache/a", 3U);
+  EXPECT_EQ(std::size_t(2U), index.size());
+
+  auto entries = index.pop(2U, 10U);
+  ASSERT_EQ(std::size_t(2U), entries.size());
+  EXPECT_STREQ("/cache/b", entries.at(0U).source_path.c_str());
+  EXPECT_STREQ("/cache/a", entries.at(1U).source_path.c_str());
+  EXPECT_EQ(std::uint64_t(3U), entries.at(1U).accessed);
+}
+
+TEST(cache_index_test, pop_stops_at_recently_accessed_entry) {
+  cache_index index;
+  index.touch("/cache/a", 1U);
+  index.touch("/cache/b", 5U);
+  index.touch("/cache/c", 2U);
+
+  auto entries = index.pop(3U, 4U);
+  ASSERT_EQ(std::size_t(1U), entries.size());
+  EXPECT_STREQ("/cache/a", entries.at(0U).source_path.c_str());
+
+  EXPECT_TRUE(index.pop(3U, 0U).empty());
+}
+
+TEST(cache_index_test, pop_does_not_return_entry_twice) {
+  cache_index index;
+  index.touch("/cache/a", 1U);
+  index.touch("/cache/b", 2U);
+
+  auto entries = index.pop(5U, 10U);
+  ASSERT_EQ(std::size_t(2U), entries.size());
+
+  entries = index.pop(1U, 10U);
+  ASSERT_EQ(std::size_t(1U), entries.size());
+  EXPECT_STREQ("/cache/a", entries.at(0U).source_path.c_str());
+}
+
+TEST(cache_index_test, can_remove_entries) {
+  cache_index index;
+  index.touch("/cache/a", 1U);
+  index.touch("/cache/b", 2U);
+
+  EXPECT_TRUE(index.contains("/cache/a"));
+  EXPECT_TRUE(index.remove("/cache/a"));
+  EXPECT_FALSE(index.remove("/cache/a"));
+  EXPECT_FALSE(index.contains("/cache/a"));
+  EXPECT_EQ(std::size_t(1U), index.size());
+
+  index.clear();
+  EXPECT_EQ(std::size_t(0U), index.size());
+  EXPECT_FALSE(index.contains("/cache/b"));
+}
+
+TEST(cache_index_test, load_orders_by_access_time) {
+  cache_index index;
+  index.touch("/cache/old", 1U);
+  index.load({
+      {.source_path = "/cache/b", .accessed = 20U},
+      {.source_path = "/cache/a", .accessed = 10U},
+      {.source_path = "/cache/b", .accessed = 30U},
+  });
+  EXPECT_EQ(std::size_t(2U), index.size());
+  EXPECT_FALSE(index.contains("/cache/old"));
+
+  auto entries = index.pop(2U, 100U);
+  ASSERT_EQ(std::size_t(2U), entries.size());
+  EXPECT_STREQ("/cache/a", entries.at(0U).source_path.c_str());
+  EXPECT_STREQ("/cache/b", entries.at(1U).source_path.c_str());
+  EXPECT_EQ(std::uint64_t(30U), entries.at(1U).accessed);
+}
+} // namespace repertory
@@ -0,0 +1,132 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "app_config.hpp"
+#include "file_manager/cache_size_mgr.hpp"
+#include "utils/path.hpp"
+
+namespace repertory {
+class cache_size_mgr_test : public ::testing::Test {
+public:
+  std::unique_ptr<app_config> cfg;
+  static std::atomic<std::size_t> inst;
+
+protected:
+  void SetUp() override {
+    event_system::instance().start();
+
+    cfg = std::make_unique<app_config>(
+        provider_type::sia,
+        utils::path::combine(test::get_test_output_dir(),
+                             {
+                                 "cache_size_mgr_test" + std::to_string(++inst),
+                             }));
+    cache_size_mgr::instance().initialize(cfg.get());
+
+    // A cache holding a single file never stalls, since there is nothing left
+    // to evict
+    for (const auto &name : {"file1", "file2"}) {
+      ASSERT_TRUE(utils::file::file::open_or_create_file(
+          utils::path::combine(cfg->get_cache_directory(), {name})));
+    }
+  }
+
+  void TearDown() override {
+    cache_size_mgr::instance().set_pressure_callback({});
+    event_system::instance().stop();
+  }
+};
+
+std::atomic<std::size_t> cache_size_mgr_test::inst{0U};
+
+TEST_F(cache_size_mgr_test, expand_returns_immediately_below_max_size) {
+  auto &mgr = cache_size_mgr::instance();
+  auto stats{mgr.get_stats()};
+
+  auto size{cfg->get_max_cache_size_bytes() - mgr.size()};
+  auto start{std::chrono::steady_clock::now()};
+  EXPECT_EQ(api_error::success, mgr.expand(size));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+
+  EXPECT_EQ(stats.stall_count, mgr.get_stats().stall_count);
+  EXPECT_EQ(api_error::success, mgr.shrink(size));
+}
+
+TEST_F(cache_size_mgr_test, expand_waits_until_cache_shrinks) {
+  auto &mgr = cache_size_mgr::instance();
+  auto stats{mgr.get_stats()};
+
+  auto size{cfg->get_max_cache_size_bytes() - mgr.size() + 1U};
+  std::thread shrink_thread([&mgr]() {
+    std::this_thread::sleep_for(500ms);
+    EXPECT_EQ(api_error::success, mgr.shrink(1U));
+  });
+
+  auto start{std::chrono::steady_clock::now()};
+  EXPECT_EQ(api_error::success, mgr.expand(size));
+  auto elapsed{std::chrono::steady_clock::now() - start};
+  shrink_thread.join();
+
+  EXPECT_GE(elapsed, 500ms);
+  EXPECT_LT(elapsed, cache_size_mgr::max_stall_secs);
+
+  auto new_stats{mgr.get_stats()};
+  EXPECT_EQ(stats.stall_count + 1U, new_stats.stall_count);
+  EXPECT_EQ(stats.stall_timeout_count, new_stats.stall_timeout_count);
+  EXPECT_GE(new_stats.stall_ms, stats.stall_ms + 500U);
+  EXPECT_EQ(api_error::success, mgr.shrink(size - 1U));
+}
+
+TEST_F(cache_size_mgr_test, expand_times_out_when_eviction_cannot_keep_up) {
+  constexpr std::uint64_t evicted_size{1024U};
+
+  auto &mgr = cache_size_mgr::instance();
+  auto stats{mgr.get_stats()};
+
+  // Evictions are recorded, but never free enough space to go below the
+  // maximum cache size
+  mgr.set_pressure_callback([&mgr]() { mgr.record_eviction(evicted_size); });
+
+  auto size{cfg->get_max_cache_size_bytes() - mgr.size() + 1U};
+  auto start{std::chrono::steady_clock::now()};
+  EXPECT_EQ(api_error::success, mgr.expand(size));
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            cache_size_mgr::max_stall_secs);
+
+  auto new_stats{mgr.get_stats()};
+  EXPECT_EQ(stats.stall_count + 1U, new_stats.stall_count);
+  EXPECT_EQ(stats.stall_timeout_count + 1U, new_stats.stall_timeout_count);
+  EXPECT_GT(new_stats.evicted_count, stats.evicted_count);
+  EXPECT_EQ(stats.evicted_bytes +
+                (new_stats.evicted_count - stats.evicted_count) * evicted_size,
+            new_stats.evicted_bytes);
+  EXPECT_GE(new_stats.max_stall_ms,
+            static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    cache_size_mgr::max_stall_secs)
+                    .count()));
+
+  mgr.set_pressure_callback({});
+  EXPECT_EQ(api_error::success, mgr.shrink(size));
+}
+} // namespace repertory
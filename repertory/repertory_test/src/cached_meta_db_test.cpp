@@ -0,0 +1,186 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "app_config.hpp"
+#include "db/impl/cached_meta_db.hpp"
+#include "db/impl/sqlite_meta_db.hpp"
+
+namespace {
+[[nodiscard]] auto create_test_config()
+    -> std::unique_ptr<repertory::app_config> {
+  static std::atomic<std::uint64_t> idx{};
+
+  auto cfg_directory = repertory::utils::path::combine(
+      repertory::test::get_test_output_dir(),
+      {
+          "cached_meta_db_test",
+          std::to_string(++idx),
+      });
+  return std::make_unique<repertory::app_config>(repertory::provider_type::s3,
+                                                 cfg_directory);
+}
+
+[[nodiscard]] auto create_test_meta(std::string_view uid)
+    -> repertory::api_meta_map {
+  return {
+      {repertory::META_DIRECTORY, repertory::utils::string::from_bool(false)},
+      {repertory::META_SIZE, "2"},
+      {repertory::META_UID, std::string{uid}},
+  };
+}
+} // namespace
+
+namespace repertory {
+TEST(cached_meta_db_test, missing_item_is_cached_until_written) {
+  auto cfg = create_test_config();
+  cached_meta_db cache(std::make_unique<sqlite_meta_db>(*cfg), 1h);
+  sqlite_meta_db external(*cfg);
+
+  api_meta_map meta;
+  EXPECT_EQ(api_error::item_not_found, cache.get_item_meta("/test", meta));
+
+  EXPECT_EQ(api_error::success,
+            external.set_item_meta("/test", create_test_meta("1")));
+  EXPECT_EQ(api_error::item_not_found, cache.get_item_meta("/test", meta));
+
+  EXPECT_EQ(api_error::success, cache.set_item_meta("/test", META_UID, "2"));
+  EXPECT_EQ(api_error::success, cache.get_item_meta("/test", meta));
+  EXPECT_STREQ("2", meta[META_UID].c_str());
+}
+
+TEST(cached_meta_db_test, expired_entries_are_reloaded) {
+  auto cfg = create_test_config();
+  cached_meta_db cache(std::make_unique<sqlite_meta_db>(*cfg), 50ms);
+  sqlite_meta_db external(*cfg);
+
+  EXPECT_EQ(api_error::success,
+            cache.set_item_meta("/test", create_test_meta("1")));
+
+  std::string value;
+  EXPECT_EQ(api_error::success, cache.get_item_meta("/test", META_UID, value));
+  EXPECT_STREQ("1", value.c_str());
+
+  EXPECT_EQ(api_error::success, external.set_item_meta("/test", META_UID, "2"));
+  EXPECT_EQ(api_error::success, cache.get_item_meta("/test", META_UID, value));
+  EXPECT_STREQ("1", value.c_str());
+
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(api_error::success, cache.get_item_meta("/test", META_UID, value));
+  EXPECT_STREQ("2", value.c_str());
+}
+
+TEST(cached_meta_db_test, rename_invalidates_both_paths) {
+  auto cfg = create_test_config();
+  cached_meta_db cache(std::make_unique<sqlite_meta_db>(*cfg), 1h);
+
+  EXPECT_EQ(api_error::success,
+            cache.set_item_meta("/test", create_test_meta("1")));
+
+  api_meta_map meta;
+  EXPECT_EQ(api_error::success, cache.get_item_meta("/test", meta));
+  EXPECT_EQ(api_error::item_not_found, cache.get_item_meta("/test2", meta));
+
+  EXPECT_EQ(api_error::success, cache.rename_item_meta("/test", "/test2"));
+  EXPECT_EQ(api_error::item_not_found, cache.get_item_meta("/test", meta));
+  EXPECT_EQ(api_error::success, cache.get_item_meta("/test2", meta));
+}
+
+TEST(cached_meta_db_test, remove_api_path_invalidates_entry) {
+  auto cfg = create_test_config();
+  cached_meta_db cache(std::make_unique<sqlite_meta_db>(*cfg), 1h);
+
+  EXPECT_EQ(api_error::success,
+            cache.set_item_meta("/test", create_test_meta("1")));
+
+  api_meta_map meta;
+  EXPECT_EQ(api_error::success, cache.get_item_meta("/test", meta));
+
+  cache.remove_api_path("/test");
+  EXPECT_EQ(api_error::item_not_found, cache.get_item_meta("/test", meta));
+}
+
+TEST(cached_meta_db_test, eviction_does_not_return_stale_entries) {
+  auto cfg = create_test_config();
+  cached_meta_db cache(std::make_unique<sqlite_meta_db>(*cfg), 1h,
+                       cached_meta_db::shard_count);
+
+  api_meta_map meta;
+  for (std::size_t idx = 0U; idx < 1000U; ++idx) {
+    EXPECT_EQ(api_error::item_not_found,
+              cache.get_item_meta("/test" + std::to_string(idx), meta));
+  }
+
+  EXPECT_EQ(api_error::success,
+            cache.set_item_meta("/test0", create_test_meta("1")));
+  EXPECT_EQ(api_error::success, cache.get_item_meta("/test0", meta));
+}
+
+TEST(cached_meta_db_test, full_shard_evicts_least_recently_used_entry) {
+  auto cfg = create_test_config();
+  cached_meta_db cache(std::make_unique<sqlite_meta_db>(*cfg), 1h,
+                       cached_meta_db::shard_count * 2U);
+  sqlite_meta_db external(*cfg);
+
+  // Three paths sharing one shard that holds two entries
+  std::vector<std::string> paths;
+  auto shard{std::hash<std::string_view>{}("/test0") %
+             cached_meta_db::shard_count};
+  for (std::size_t idx = 0U; paths.size() < 3U; ++idx) {
+    auto api_path = "/test" + std::to_string(idx);
+    if (std::hash<std::string_view>{}(api_path) % cached_meta_db::shard_count ==
+        shard) {
+      paths.push_back(api_path);
+    }
+  }
+
+  for (const auto &api_path : paths) {
+    EXPECT_EQ(api_error::success,
+              external.set_item_meta(api_path, create_test_meta("1")));
+  }
+
+  std::string value;
+  EXPECT_EQ(api_error::success,
+            cache.get_item_meta(paths.at(0U), META_UID, value));
+  EXPECT_EQ(api_error::success,
+            cache.get_item_meta(paths.at(1U), META_UID, value));
+  EXPECT_EQ(api_error::success,
+            cache.get_item_meta(paths.at(0U), META_UID, value));
+
+  for (const auto &api_path : paths) {
+    EXPECT_EQ(api_error::success,
+              external.set_item_meta(api_path, META_UID, "2"));
+  }
+
+  EXPECT_EQ(api_error::success,
+            cache.get_item_meta(paths.at(2U), META_UID, value));
+  EXPECT_STREQ("2", value.c_str());
+
+  EXPECT_EQ(api_error::success,
+            cache.get_item_meta(paths.at(0U), META_UID, value));
+  EXPECT_STREQ("1", value.c_str());
+
+  EXPECT_EQ(api_error::success,
+            cache.get_item_meta(paths.at(1U), META_UID, value));
+  EXPECT_STREQ("2", value.c_str());
+}
+} // namespace repertory
@@ -0,0 +1,176 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "file_manager/chunk_cache.hpp"
+
+namespace {
+[[nodiscard]] auto make_loader(std::size_t size, unsigned char value,
+                               std::atomic<std::size_t> &calls)
+    -> repertory::chunk_cache::loader_t {
+  return [size, value, &calls](repertory::data_buffer &data) {
+    ++calls;
+    data.assign(size, value);
+    return repertory::api_error::success;
+  };
+}
+} // namespace
+
+namespace repertory {
+TEST(chunk_cache_test, loads_chunk_once_and_returns_cached_buffer) {
+  chunk_cache cache{1024U};
+  std::atomic<std::size_t> calls{0U};
+
+  chunk_cache::buffer_ptr buffer;
+  EXPECT_EQ(api_error::success,
+            cache.get_or_load("/test.txt", "1", 0U, make_loader(16U, 1U, calls),
+                              buffer));
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(16U, buffer->size());
+
+  chunk_cache::buffer_ptr buffer2;
+  EXPECT_EQ(api_error::success,
+            cache.get_or_load("/test.txt", "1", 0U, make_loader(16U, 2U, calls),
+                              buffer2));
+  EXPECT_EQ(buffer.get(), buffer2.get());
+  EXPECT_EQ(1U, calls);
+  EXPECT_EQ(16U, cache.get_size());
+}
+
+TEST(chunk_cache_test, version_change_loads_new_data) {
+  chunk_cache cache{1024U};
+  std::atomic<std::size_t> calls{0U};
+
+  chunk_cache::buffer_ptr buffer;
+  EXPECT_EQ(api_error::success,
+            cache.get_or_load("/test.txt", "1", 0U, make_loader(16U, 1U, calls),
+                              buffer));
+  EXPECT_EQ(api_error::success,
+            cache.get_or_load("/test.txt", "2", 0U, make_loader(16U, 2U, calls),
+                              buffer));
+  EXPECT_EQ(2U, calls);
+  EXPECT_EQ(2U, buffer->at(0U));
+}
+
+TEST(chunk_cache_test, concurrent_readers_share_a_single_load) {
+  chunk_cache cache{1024U};
+  std::atomic<std::size_t> calls{0U};
+
+  const auto loader = [&calls](data_buffer &data) -> api_error {
+    ++calls;
+    std::this_thread::sleep_for(100ms);
+    data.assign(16U, 1U);
+    return api_error::success;
+  };
+
+  std::vector<std::future<chunk_cache::buffer_ptr>> readers;
+  for (std::size_t idx = 0U; idx < 4U; ++idx) {
+    readers.emplace_back(std::async(std::launch::async, [&]() {
+      chunk_cache::buffer_ptr buffer;
+      EXPECT_EQ(api_error::success,
+                cache.get_or_load("/test.txt", "1", 0U, loader, buffer));
+      return buffer;
+    }));
+  }
+
+  for (auto &reader : readers) {
+    auto buffer = reader.get();
+    ASSERT_TRUE(buffer);
+    EXPECT_EQ(16U, buffer->size());
+  }
+  EXPECT_EQ(1U, calls);
+}
+
+TEST(chunk_cache_test, evicts_unpinned_chunks_when_full) {
+  chunk_cache cache{32U};
+  std::atomic<std::size_t> calls{0U};
+
+  for (std::size_t chunk = 0U; chunk < 4U; ++chunk) {
+    chunk_cache::buffer_ptr buffer;
+    EXPECT_EQ(api_error::success,
+              cache.get_or_load("/test.txt", "1", chunk,
+                                make_loader(16U, 1U, calls), buffer));
+  }
+
+  EXPECT_EQ(4U, calls);
+  EXPECT_LE(cache.get_size(), 32U);
+}
+
+TEST(chunk_cache_test, pinned_chunks_are_not_evicted) {
+  chunk_cache cache{32U};
+  std::atomic<std::size_t> calls{0U};
+
+  chunk_cache::buffer_ptr pinned;
+  EXPECT_EQ(api_error::success,
+            cache.get_or_load("/test.txt", "1", 0U, make_loader(16U, 1U, calls),
+                              pinned));
+
+  for (std::size_t chunk = 1U; chunk < 4U; ++chunk) {
+    chunk_cache::buffer_ptr buffer;
+    EXPECT_EQ(api_error::success,
+              cache.get_or_load("/test.txt", "1", chunk,
+                                make_loader(16U, 1U, calls), buffer));
+  }
+
+  chunk_cache::buffer_ptr buffer;
+  EXPECT_EQ(api_error::success,
+            cache.get_or_load("/test.txt", "1", 0U, make_loader(16U, 2U, calls),
+                              buffer));
+  EXPECT_EQ(pinned.get(), buffer.get());
+  EXPECT_EQ(4U, calls);
+}
+
+TEST(chunk_cache_test, invalidate_removes_only_matching_path) {
+  chunk_cache cache{1024U};
+  std::atomic<std::size_t> calls{0U};
+
+  chunk_cache::buffer_ptr buffer;
+  EXPECT_EQ(api_error::success,
+            cache.get_or_load("/test.txt", "1", 0U, make_loader(16U, 1U, calls),
+                              buffer));
+  EXPECT_EQ(api_error::success,
+            cache.get_or_load("/test.txt2", "1", 0U,
+                              make_loader(16U, 1U, calls), buffer));
+  EXPECT_EQ(32U, cache.get_size());
+
+  cache.invalidate("/test.txt");
+  EXPECT_EQ(16U, cache.get_size());
+
+  EXPECT_EQ(api_error::success,
+            cache.get_or_load("/test.txt2", "1", 0U,
+                              make_loader(16U, 1U, calls), buffer));
+  EXPECT_EQ(2U, calls);
+}
+
+TEST(chunk_cache_test, failed_load_is_not_cached) {
+  chunk_cache cache{1024U};
+
+  chunk_cache::buffer_ptr buffer;
+  EXPECT_EQ(api_error::comm_error,
+            cache.get_or_load(
+                "/test.txt", "1", 0U,
+                [](data_buffer & /* data */) { return api_error::comm_error; },
+                buffer));
+  EXPECT_FALSE(buffer);
+  EXPECT_EQ(0U, cache.get_size());
+}
+} // namespace repertory
@@ -22,6 +22,7 @@
 #include "test_common.hpp"
 
 #include "comm/curl/curl_comm.hpp"
+#include "comm/curl/curl_shared.hpp"
 #include "types/repertory.hpp"
 
 namespace repertory {
@@ -78,4 +79,34 @@ TEST(curl_comm_test, can_create_s3_host_config_with_region_and_path_style) {
   EXPECT_STREQ("s3.any.test.com", hc.host_name_or_ip.c_str());
   EXPECT_STREQ("/repertory", hc.path.c_str());
 }
+
+TEST(curl_comm_test, pool_key_includes_protocol_host_and_port) {
+  host_config cfg{};
+  cfg.protocol = "https";
+  cfg.host_name_or_ip = " s3.test.com ";
+  cfg.api_port = 443U;
+
+  EXPECT_STREQ("https://s3.test.com:443",
+               curl_comm::get_pool_key(cfg).c_str());
+}
+
+TEST(curl_comm_test, released_handle_is_reused_for_same_key) {
+  auto *curl = curl_shared::acquire("curl_comm_test://reuse");
+  ASSERT_NE(nullptr, curl);
+  curl_shared::release("curl_comm_test://reuse", curl);
+
+  auto hits = curl_shared::get_pool_hits();
+  auto *reused = curl_shared::acquire("curl_comm_test://reuse");
+  EXPECT_EQ(curl, reused);
+  EXPECT_EQ(hits + 1U, curl_shared::get_pool_hits());
+
+  auto misses = curl_shared::get_pool_misses();
+  auto *other = curl_shared::acquire("curl_comm_test://other");
+  ASSERT_NE(nullptr, other);
+  EXPECT_NE(reused, other);
+  EXPECT_EQ(misses + 1U, curl_shared::get_pool_misses());
+
+  curl_shared::release("curl_comm_test://reuse", reused);
+  curl_shared::release("curl_comm_test://other", other);
+}
 } // namespace repertory
@@ -557,4 +557,59 @@ TEST_F(direct_open_file_test, tiny_file_smaller_than_chunk) {
 
   source_file.close();
 }
+
+TEST_F(direct_open_file_test, cached_chunks_are_not_pinned_by_open_file) {
+  auto &source_file = test::create_random_file(test_chunk_size * 8U);
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.directory = false;
+  fsi.size = test_chunk_size * 8U;
+
+  auto test_buffer = build_test_buffer(source_file);
+
+  EXPECT_CALL(provider, read_file_bytes)
+      .WillRepeatedly([test_buffer](std::string_view, std::size_t size,
+                                    std::uint64_t offset, data_buffer &data,
+                                    stop_type &stop_requested) -> api_error {
+        if (stop_requested) {
+          return api_error::download_stopped;
+        }
+        data.resize(size);
+        std::memcpy(data.data(),
+                    test_buffer.data() + static_cast<std::size_t>(offset),
+                    size);
+        return api_error::success;
+      });
+
+  chunk_cache cache;
+  {
+    direct_open_file file(test_chunk_size, 30U, fsi, provider);
+    file.set_chunk_cache(&cache, "1");
+
+    for (std::size_t chunk = 0U; chunk < 8U; ++chunk) {
+      data_buffer data{};
+      EXPECT_EQ(api_error::success,
+                file.read(test_chunk_size, chunk * test_chunk_size, data));
+      EXPECT_EQ(0, std::memcmp(data.data(),
+                               &test_buffer.at(chunk * test_chunk_size),
+                               test_chunk_size));
+    }
+
+    // Every chunk has been read, so nothing may stay pinned while the file is
+    // still open. Retry briefly in case a read ahead is finishing up.
+    for (auto idx = 0U; idx < 100U && cache.get_size() != 0U; ++idx) {
+      cache.set_max_size(0U);
+      std::this_thread::sleep_for(10ms);
+    }
+    EXPECT_EQ(0U, cache.get_size());
+
+    data_buffer data{};
+    EXPECT_EQ(api_error::success, file.read(test_chunk_size, 0U, data));
+    EXPECT_EQ(0, std::memcmp(data.data(), test_buffer.data(), test_chunk_size));
+  }
+
+  source_file.close();
+}
 } // namespace repertory
@@ -0,0 +1,245 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "events/event_queue.hpp"
+#include "events/event_system.hpp"
+#include "events/i_event.hpp"
+
+namespace {
+std::atomic<std::uint64_t> created_count{0U};
+
+template <repertory::event_level event_level>
+struct test_event final : public repertory::i_event {
+  explicit test_event(std::uint64_t value_) : value(value_) {
+    ++created_count;
+  }
+
+  static constexpr repertory::event_level level{event_level};
+  static constexpr std::string_view name{"event_system_test_event"};
+
+  std::uint64_t value{};
+
+  [[nodiscard]] auto get_event_level() const
+      -> repertory::event_level override {
+    return level;
+  }
+
+  [[nodiscard]] auto get_name() const -> std::string_view override {
+    return name;
+  }
+
+  [[nodiscard]] auto get_single_line() const -> std::string override {
+    return std::string{name};
+  }
+};
+
+using debug_event = test_event<repertory::event_level::debug>;
+using error_event = test_event<repertory::event_level::error>;
+
+void wait_for_count(const std::atomic<std::uint64_t> &count,
+                    std::uint64_t expected) {
+  for (std::uint16_t idx = 0U; count < expected && idx < 500U; ++idx) {
+    std::this_thread::sleep_for(10ms);
+  }
+}
+} // namespace
+
+namespace repertory {
+class event_system_test : public ::testing::Test {
+protected:
+  void SetUp() override { event_system::instance().start(); }
+
+  void TearDown() override { event_system::instance().stop(); }
+};
+
+TEST(event_queue_test, push_fails_when_full_and_pop_is_fifo) {
+  event_queue queue(4U);
+  EXPECT_EQ(std::size_t(4U), queue.get_capacity());
+
+  for (std::uint64_t idx = 0U; idx < queue.get_capacity(); ++idx) {
+    EXPECT_TRUE(queue.push(std::make_shared<debug_event>(idx)));
+  }
+  EXPECT_FALSE(queue.push(std::make_shared<debug_event>(4U)));
+
+  for (std::uint64_t idx = 0U; idx < queue.get_capacity(); ++idx) {
+    std::shared_ptr<i_event> evt;
+    ASSERT_TRUE(queue.pop(evt));
+    EXPECT_EQ(idx, dynamic_cast<const debug_event &>(*evt).value);
+  }
+
+  std::shared_ptr<i_event> evt;
+  EXPECT_FALSE(queue.pop(evt));
+  EXPECT_TRUE(queue.push(std::make_shared<debug_event>(5U)));
+}
+
+TEST_F(event_system_test, event_without_subscriber_is_not_created) {
+  created_count = 0U;
+  event_system::instance().raise<debug_event>(1U);
+  EXPECT_EQ(0U, created_count);
+}
+
+TEST_F(event_system_test, event_below_consumer_level_is_not_created) {
+  std::atomic<std::uint64_t> received{0U};
+  event_consumer consumer(
+      [&received](const i_event &evt) {
+        if (evt.get_name() == debug_event::name) {
+          ++received;
+        }
+      },
+      event_level::info);
+
+  created_count = 0U;
+  event_system::instance().raise<debug_event>(1U);
+  EXPECT_EQ(0U, created_count);
+
+  event_system::instance().raise<error_event>(2U);
+  EXPECT_EQ(1U, created_count);
+  wait_for_count(received, 1U);
+  EXPECT_EQ(1U, received);
+
+  consumer.set_level(event_level::debug);
+  event_system::instance().raise<debug_event>(3U);
+  EXPECT_EQ(2U, created_count);
+  wait_for_count(received, 2U);
+  EXPECT_EQ(2U, received);
+}
+
+TEST_F(event_system_test, named_consumer_receives_events_in_order) {
+  std::mutex mtx;
+  std::vector<std::uint64_t> values;
+  std::atomic<std::uint64_t> received{0U};
+  event_consumer consumer(debug_event::name, [&](const i_event &evt) {
+    mutex_lock lock(mtx);
+    values.push_back(dynamic_cast<const debug_event &>(evt).value);
+    ++received;
+  });
+
+  for (std::uint64_t idx = 0U; idx < 100U; ++idx) {
+    event_system::instance().raise<debug_event>(idx);
+  }
+  wait_for_count(received, 100U);
+
+  mutex_lock lock(mtx);
+  ASSERT_EQ(std::size_t(100U), values.size());
+  for (std::uint64_t idx = 0U; idx < 100U; ++idx) {
+    EXPECT_EQ(idx, values.at(idx));
+  }
+}
+
+TEST_F(event_system_test, overflow_drops_events_without_blocking) {
+  std::promise<void> blocked;
+  auto blocked_future = blocked.get_future().share();
+  event_consumer consumer(debug_event::name,
+                          [blocked_future](const i_event & /* evt */) {
+                            blocked_future.wait();
+                          });
+
+  auto dropped = event_system::instance().get_dropped_count();
+  for (std::size_t idx = 0U; idx < event_system::max_queue_size + 10U;
+       ++idx) {
+    event_system::instance().raise<debug_event>(idx);
+  }
+  EXPECT_LE(dropped + 9U, event_system::instance().get_dropped_count());
+
+  blocked.set_value();
+}
+
+TEST_F(event_system_test, consumers_share_one_dispatch_thread) {
+  std::mutex mtx;
+  std::set<std::thread::id> thread_ids;
+  std::atomic<std::uint64_t> received{0U};
+  const auto callback = [&](const i_event & /* evt */) {
+    mutex_lock lock(mtx);
+    thread_ids.insert(std::this_thread::get_id());
+    ++received;
+  };
+
+  event_consumer consumer1(debug_event::name, callback);
+  event_consumer consumer2(debug_event::name, callback);
+  event_consumer consumer3(callback, event_level::debug);
+
+  event_system::instance().raise<debug_event>(1U);
+  wait_for_count(received, 3U);
+  EXPECT_EQ(3U, received);
+
+  mutex_lock lock(mtx);
+  EXPECT_EQ(std::size_t(1U), thread_ids.size());
+  EXPECT_FALSE(thread_ids.contains(std::this_thread::get_id()));
+}
+
+TEST_F(event_system_test, stop_delivers_queued_events) {
+  std::atomic<std::uint64_t> received{0U};
+  event_consumer consumer(debug_event::name,
+                          [&received](const i_event & /* evt */) {
+                            std::this_thread::sleep_for(1ms);
+                            ++received;
+                          });
+
+  for (std::uint64_t idx = 0U; idx < 100U; ++idx) {
+    event_system::instance().raise<debug_event>(idx);
+  }
+
+  event_system::instance().stop();
+  EXPECT_EQ(100U, received);
+}
+
+TEST_F(event_system_test, events_raised_before_start_are_delivered) {
+  event_system::instance().stop();
+
+  std::atomic<std::uint64_t> received{0U};
+  event_consumer consumer(debug_event::name,
+                          [&received](const i_event & /* evt */) {
+                            ++received;
+                          });
+
+  event_system::instance().raise<debug_event>(1U);
+  std::this_thread::sleep_for(50ms);
+  EXPECT_EQ(0U, received);
+
+  event_system::instance().start();
+  wait_for_count(received, 1U);
+  EXPECT_EQ(1U, received);
+}
+
+TEST_F(event_system_test, consumer_released_during_dispatch_is_not_called) {
+  std::atomic<std::uint64_t> received{0U};
+  std::unique_ptr<event_consumer> consumer2;
+
+  std::atomic<std::uint64_t> released{0U};
+  event_consumer consumer1(debug_event::name,
+                           [&consumer2, &released](const i_event &) {
+                             consumer2.reset();
+                             ++released;
+                           });
+  consumer2 = std::make_unique<event_consumer>(
+      debug_event::name,
+      [&received](const i_event & /* evt */) { ++received; });
+
+  event_system::instance().raise<debug_event>(1U);
+  wait_for_count(released, 1U);
+  event_system::instance().stop();
+
+  EXPECT_EQ(1U, released);
+  EXPECT_EQ(0U, received);
+}
+} // namespace repertory
@@ -462,7 +462,9 @@ TEST_F(file_manager_test,
           return api_error::download_stopped;
         }
 
-        if (offset == 0u) {
+        // The write only fetches the part of the first chunk it leaves intact
+        if (offset <
+            utils::encryption::encrypting_reader::get_data_chunk_size()) {
           std::size_t bytes_read{};
           data.resize(size);
           auto ret = file.read(data, offset, &bytes_read) ? api_error::success
@@ -839,6 +841,63 @@ TEST_F(file_manager_test, evict_file_fails_if_file_is_open) {
   mgr.close(handle);
 }
 
+TEST_F(file_manager_test, file_open_at_stop_is_indexed_after_restart) {
+  EXPECT_CALL(mp, is_read_only()).WillRepeatedly(Return(false));
+  EXPECT_CALL(mp, get_pinned_files())
+      .WillRepeatedly(Return(std::vector<std::string>()));
+
+  auto source_path = utils::path::combine(cfg->get_cache_directory(),
+                                          {utils::create_uuid_string()});
+  EXPECT_CALL(mp, get_filesystem_item)
+      .WillOnce([&source_path](std::string_view api_path, bool directory,
+                               filesystem_item &fsi) -> api_error {
+        EXPECT_STREQ("/test_open.txt", std::string{api_path}.c_str());
+        EXPECT_FALSE(directory);
+        fsi.api_path = api_path;
+        fsi.api_parent = utils::path::get_parent_api_path(api_path);
+        fsi.directory = directory;
+        fsi.size = 0U;
+        fsi.source_path = source_path;
+        return api_error::success;
+      });
+
+  {
+    file_manager mgr(*cfg, mp);
+    mgr.start();
+
+    // An existing entry keeps the next start from seeding the index from the
+    // cache directory
+    EXPECT_TRUE(mgr.get_file_mgr_db()->add_cache_entry({
+        .source_path = utils::path::combine(cfg->get_cache_directory(),
+                                            {utils::create_uuid_string()}),
+        .accessed = utils::time::get_time_now(),
+    }));
+
+    std::uint64_t handle{};
+    std::shared_ptr<i_open_file> open_file{};
+#if defined(_WIN32)
+    EXPECT_EQ(api_error::success,
+              mgr.open("/test_open.txt", false, {}, handle, open_file));
+#else
+    EXPECT_EQ(api_error::success,
+              mgr.open("/test_open.txt", false, O_RDWR, handle, open_file));
+#endif
+    EXPECT_TRUE(utils::file::file{source_path}.exists());
+
+    mgr.stop();
+  }
+
+  file_manager mgr(*cfg, mp);
+  mgr.start();
+  EXPECT_EQ(2U, mgr.get_cached_file_count());
+
+  auto entries = mgr.get_file_mgr_db()->get_cache_entry_list();
+  EXPECT_TRUE(std::ranges::any_of(entries, [&source_path](auto &&entry) {
+    return entry.source_path == source_path;
+  }));
+  mgr.stop();
+}
+
 TEST_F(file_manager_test, evict_file_fails_if_unable_to_get_filesystem_item) {
   EXPECT_CALL(mp, is_read_only()).WillRepeatedly(Return(false));
   file_manager mgr(*cfg, mp);
@@ -1218,6 +1277,46 @@ TEST_F(file_manager_test,
   EXPECT_EQ(std::size_t(1U), mgr.get_open_file_count());
 }
 
+TEST_F(file_manager_test, pending_meta_is_flushed_when_handle_is_closed) {
+  EXPECT_CALL(mp, is_read_only()).WillRepeatedly(Return(false));
+
+  cfg->set_meta_flush_interval_secs(3U);
+  file_manager mgr(*cfg, mp);
+
+  auto file = std::make_shared<mock_open_file>();
+  EXPECT_CALL(*file, is_directory).WillRepeatedly(Return(false));
+  EXPECT_CALL(*file, add).WillOnce(Return());
+  EXPECT_CALL(*file, get_api_path).WillRepeatedly(Return("/test_open.txt"));
+  EXPECT_CALL(*file, get_source_path).WillRepeatedly(Return("/test_open.src"));
+  EXPECT_CALL(*file, set_meta_flush_interval(3U)).Times(1);
+
+  EXPECT_CALL(mp, get_filesystem_item)
+      .WillOnce([](std::string_view api_path, bool directory,
+                   filesystem_item &fsi) -> api_error {
+        fsi.api_path = api_path;
+        fsi.api_parent = utils::path::get_parent_api_path(api_path);
+        fsi.directory = directory;
+        fsi.size = 10U;
+        fsi.source_path = "/test_open.src";
+        return api_error::success;
+      });
+
+  std::uint64_t handle{};
+  std::shared_ptr<i_open_file> open_file{};
+#if defined(_WIN32)
+  EXPECT_EQ(api_error::success, mgr.open(file, {}, handle, open_file));
+#else
+  EXPECT_EQ(api_error::success, mgr.open(file, O_RDWR, handle, open_file));
+#endif
+
+  EXPECT_CALL(*file, has_handle(handle)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*file, remove(handle)).Times(1);
+  EXPECT_CALL(*file, flush_pending_meta)
+      .WillOnce(Return(api_error::success));
+
+  mgr.close(handle);
+}
+
 TEST_F(file_manager_test, open_file_fails_if_file_is_not_found) {
   EXPECT_CALL(mp, is_read_only()).WillRepeatedly(Return(false));
 
@@ -157,4 +157,87 @@ TYPED_TEST(file_mgr_db_test, uploads_are_correctly_ordered) {
   upload = this->file_mgr_db->get_next_upload();
   EXPECT_FALSE(upload.has_value());
 }
+
+TYPED_TEST(file_mgr_db_test, upload_list_is_returned_in_queue_order) {
+  this->file_mgr_db->clear();
+  EXPECT_TRUE(this->file_mgr_db->get_upload_list().empty());
+
+  EXPECT_TRUE(this->file_mgr_db->add_upload({
+      "/test08",
+      "/src/test0",
+  }));
+
+  EXPECT_TRUE(this->file_mgr_db->add_upload({
+      "/test|07",
+      "/src/test1",
+  }));
+
+  auto list = this->file_mgr_db->get_upload_list();
+  ASSERT_EQ(std::size_t(2U), list.size());
+  EXPECT_STREQ("/test08", list.at(0U).api_path.c_str());
+  EXPECT_STREQ("/src/test0", list.at(0U).source_path.c_str());
+  EXPECT_STREQ("/test|07", list.at(1U).api_path.c_str());
+  EXPECT_STREQ("/src/test1", list.at(1U).source_path.c_str());
+}
+
+TYPED_TEST(file_mgr_db_test, can_add_get_and_remove_cache_entries) {
+  this->file_mgr_db->clear();
+  EXPECT_TRUE(this->file_mgr_db->get_cache_entry_list().empty());
+
+  EXPECT_TRUE(this->file_mgr_db->add_cache_entry({"/src/test0", 1U}));
+  EXPECT_TRUE(this->file_mgr_db->add_cache_entry({"/src/test1", 2U}));
+  EXPECT_TRUE(this->file_mgr_db->add_cache_entry({"/src/test0", 3U}));
+
+  auto list = this->file_mgr_db->get_cache_entry_list();
+  std::ranges::sort(list, [](auto &&entry1, auto &&entry2) -> bool {
+    return entry1.source_path < entry2.source_path;
+  });
+  ASSERT_EQ(std::size_t(2U), list.size());
+  EXPECT_STREQ("/src/test0", list.at(0U).source_path.c_str());
+  EXPECT_EQ(3U, list.at(0U).accessed);
+  EXPECT_STREQ("/src/test1", list.at(1U).source_path.c_str());
+  EXPECT_EQ(2U, list.at(1U).accessed);
+
+  EXPECT_TRUE(this->file_mgr_db->remove_cache_entry("/src/test0"));
+  list = this->file_mgr_db->get_cache_entry_list();
+  ASSERT_EQ(std::size_t(1U), list.size());
+  EXPECT_STREQ("/src/test1", list.at(0U).source_path.c_str());
+
+  this->file_mgr_db->clear();
+  EXPECT_TRUE(this->file_mgr_db->get_cache_entry_list().empty());
+}
+
+TYPED_TEST(file_mgr_db_test, can_add_get_and_remove_multipart) {
+  this->file_mgr_db->clear();
+
+  EXPECT_FALSE(this->file_mgr_db->get_multipart("/test0").has_value());
+
+  i_file_mgr_db::multipart_entry entry{
+      .api_path = "/test0",
+      .upload_id = "upload_id",
+      .part_size = 5ULL * 1024ULL * 1024ULL,
+      .parts = {},
+      .source_modified = 3ULL,
+      .source_path = "/src/test0",
+      .source_size = 12ULL * 1024ULL * 1024ULL,
+  };
+  EXPECT_TRUE(this->file_mgr_db->add_multipart(entry));
+
+  entry.parts[1U] = "\"etag1\"";
+  entry.parts[3U] = "\"etag3\"";
+  EXPECT_TRUE(this->file_mgr_db->add_multipart(entry));
+
+  auto multipart = this->file_mgr_db->get_multipart("/test0");
+  ASSERT_TRUE(multipart.has_value());
+  EXPECT_STREQ("/test0", multipart->api_path.c_str());
+  EXPECT_STREQ("upload_id", multipart->upload_id.c_str());
+  EXPECT_EQ(entry.part_size, multipart->part_size);
+  EXPECT_EQ(entry.parts, multipart->parts);
+  EXPECT_EQ(3ULL, multipart->source_modified);
+  EXPECT_STREQ("/src/test0", multipart->source_path.c_str());
+  EXPECT_EQ(entry.source_size, multipart->source_size);
+
+  EXPECT_TRUE(this->file_mgr_db->remove_multipart("/test0"));
+  EXPECT_FALSE(this->file_mgr_db->get_multipart("/test0").has_value());
+}
 } // namespace repertory
@@ -0,0 +1,121 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "file_manager/io_engine.hpp"
+
+namespace repertory {
+TEST(io_engine_test, strand_runs_items_in_submission_order) {
+  static constexpr std::size_t item_count{100U};
+
+  auto str = std::make_shared<io_engine::strand>();
+
+  std::mutex mtx;
+  std::vector<std::size_t> order;
+  for (std::size_t idx = 0U; idx < item_count; ++idx) {
+    io_engine::instance().submit(
+        str,
+        [idx, &mtx, &order]() -> api_error {
+          mutex_lock lock(mtx);
+          order.push_back(idx);
+          return api_error::success;
+        },
+        [](api_error result) { EXPECT_EQ(api_error::success, result); });
+  }
+  str->wait();
+
+  EXPECT_TRUE(str->is_idle());
+  ASSERT_EQ(item_count, order.size());
+  for (std::size_t idx = 0U; idx < item_count; ++idx) {
+    EXPECT_EQ(idx, order.at(idx));
+  }
+}
+
+TEST(io_engine_test, strand_never_runs_items_concurrently) {
+  auto str = std::make_shared<io_engine::strand>();
+
+  std::atomic<std::size_t> running{0U};
+  std::atomic<bool> overlapped{false};
+  for (std::size_t idx = 0U; idx < io_engine::max_strand_batch * 4U; ++idx) {
+    io_engine::instance().submit(
+        str,
+        [&overlapped, &running]() -> api_error {
+          if (++running != 1U) {
+            overlapped = true;
+          }
+          std::this_thread::sleep_for(std::chrono::microseconds(100U));
+          --running;
+          return api_error::success;
+        },
+        [](api_error /* result */) {});
+  }
+  str->wait();
+
+  EXPECT_FALSE(overlapped);
+}
+
+TEST(io_engine_test, execute_returns_action_result) {
+  auto str = std::make_shared<io_engine::strand>();
+
+  EXPECT_EQ(api_error::success,
+            io_engine::instance().execute(
+                str, []() -> api_error { return api_error::success; }));
+  EXPECT_EQ(api_error::item_not_found,
+            io_engine::instance().execute(
+                str, []() -> api_error { return api_error::item_not_found; }));
+  EXPECT_EQ(api_error::error,
+            io_engine::instance().execute(str, []() -> api_error {
+              throw std::runtime_error("failed");
+            }));
+
+  str->wait();
+  EXPECT_TRUE(str->is_idle());
+}
+
+TEST(io_engine_test, scheduled_tasks_run_outside_io_workers) {
+  auto str = std::make_shared<io_engine::strand>();
+
+  std::mutex mtx;
+  std::condition_variable notify;
+  bool done{false};
+
+  // A task blocking on strand work must not starve the I/O workers
+  io_engine::instance().schedule([&]() {
+    auto res = io_engine::instance().execute(
+        str, []() -> api_error { return api_error::success; });
+    EXPECT_EQ(api_error::success, res);
+
+    mutex_lock lock(mtx);
+    done = true;
+    notify.notify_all();
+  });
+
+  unique_mutex_lock lock(mtx);
+  EXPECT_TRUE(notify.wait_for(lock, std::chrono::seconds(10U),
+                              [&done]() -> bool { return done; }));
+
+  EXPECT_LE(io_engine::min_io_threads,
+            io_engine::instance().get_io_thread_count());
+  EXPECT_LE(io_engine::min_task_threads,
+            io_engine::instance().get_task_thread_count());
+}
+} // namespace repertory
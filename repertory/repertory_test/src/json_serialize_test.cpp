@@ -173,9 +173,11 @@ TEST(json_serialize_test, can_handle_s3_config) {
       .access_key = "access",
       .bucket = "bucket",
       .encryption_token = "token",
+      .max_upload_part_count = 3U,
       .region = "region",
       .secret_key = "secret",
       .timeout_ms = 31U,
+      .upload_part_size = 17U,
       .url = "url",
       .use_path_style = true,
       .use_region_in_url = false,
@@ -189,6 +191,8 @@ TEST(json_serialize_test, can_handle_s3_config) {
   EXPECT_STREQ("region", data.at(JSON_REGION).get<std::string>().c_str());
   EXPECT_STREQ("secret", data.at(JSON_SECRET_KEY).get<std::string>().c_str());
   EXPECT_EQ(31U, data.at(JSON_TIMEOUT_MS).get<std::uint32_t>());
+  EXPECT_EQ(3U, data.at(JSON_MAX_UPLOAD_PART_COUNT).get<std::uint16_t>());
+  EXPECT_EQ(17U, data.at(JSON_UPLOAD_PART_SIZE).get<std::uint32_t>());
   EXPECT_STREQ("url", data.at(JSON_URL).get<std::string>().c_str());
   EXPECT_TRUE(data.at(JSON_USE_PATH_STYLE).get<bool>());
   EXPECT_FALSE(data.at(JSON_USE_REGION_IN_URL).get<bool>());
@@ -201,6 +205,8 @@ TEST(json_serialize_test, can_handle_s3_config) {
     EXPECT_STREQ(cfg2.region.c_str(), cfg.region.c_str());
     EXPECT_STREQ(cfg2.secret_key.c_str(), cfg.secret_key.c_str());
     EXPECT_EQ(cfg2.timeout_ms, cfg.timeout_ms);
+    EXPECT_EQ(cfg2.max_upload_part_count, cfg.max_upload_part_count);
+    EXPECT_EQ(cfg2.upload_part_size, cfg.upload_part_size);
     EXPECT_STREQ(cfg2.url.c_str(), cfg.url.c_str());
     EXPECT_EQ(cfg2.use_path_style, cfg.use_path_style);
     EXPECT_EQ(cfg2.use_region_in_url, cfg.use_region_in_url);
@@ -285,6 +291,20 @@ TEST(json_serialize_test, can_handle_event_level) {
   EXPECT_STREQ("trace", data.get<std::string>().c_str());
 }
 
+TEST(json_serialize_test, can_handle_read_ahead_policy) {
+  json data(read_ahead_policy::adaptive);
+  EXPECT_EQ(read_ahead_policy::adaptive, data.get<read_ahead_policy>());
+  EXPECT_STREQ("adaptive", data.get<std::string>().c_str());
+
+  data = read_ahead_policy::full;
+  EXPECT_EQ(read_ahead_policy::full, data.get<read_ahead_policy>());
+  EXPECT_STREQ("full", data.get<std::string>().c_str());
+
+  data = read_ahead_policy::none;
+  EXPECT_EQ(read_ahead_policy::none, data.get<read_ahead_policy>());
+  EXPECT_STREQ("none", data.get<std::string>().c_str());
+}
+
 TEST(json_serialize_test, can_handle_atomic_database_type) {
   json data(utils::atomic<database_type>{database_type::rocksdb});
   EXPECT_EQ(database_type::rocksdb, data.get<utils::atomic<database_type>>());
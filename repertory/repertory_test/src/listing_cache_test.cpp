@@ -0,0 +1,166 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "providers/listing_cache.hpp"
+
+namespace repertory {
+class listing_cache_test : public ::testing::Test {
+public:
+  std::atomic<std::size_t> calls{0U};
+  std::unique_ptr<listing_cache> cache;
+  std::atomic<api_error> result{api_error::success};
+
+protected:
+  void SetUp() override { create_cache(listing_cache::default_max_entries); }
+
+  void TearDown() override { cache->stop(); }
+
+  void create_cache(std::size_t max_entries) {
+    cache = std::make_unique<listing_cache>(
+        [this](std::string_view api_path,
+               directory_item_list &list) -> api_error {
+          list.push_back(directory_item{
+              .api_path = fmt::format("{}/{}", api_path, ++calls),
+          });
+          return result;
+        },
+        max_entries);
+  }
+};
+
+TEST_F(listing_cache_test, listing_is_served_from_cache_within_timeout) {
+  listing_cache::list_ptr list1;
+  EXPECT_EQ(api_error::success, cache->get("/dir", 10s, list1));
+  ASSERT_TRUE(list1);
+
+  listing_cache::list_ptr list2;
+  EXPECT_EQ(api_error::success, cache->get("/dir", 10s, list2));
+  EXPECT_EQ(list1, list2);
+  EXPECT_EQ(1U, calls);
+}
+
+TEST_F(listing_cache_test, zero_timeout_disables_cache) {
+  listing_cache::list_ptr list;
+  EXPECT_EQ(api_error::success, cache->get("/dir", 0s, list));
+  EXPECT_EQ(api_error::success, cache->get("/dir", 0s, list));
+  EXPECT_EQ(2U, calls);
+  EXPECT_EQ(0U, cache->get_size());
+}
+
+TEST_F(listing_cache_test, invalidate_forces_reload) {
+  listing_cache::list_ptr list;
+  EXPECT_EQ(api_error::success, cache->get("/dir", 10s, list));
+
+  cache->invalidate("/dir");
+  EXPECT_EQ(0U, cache->get_size());
+
+  EXPECT_EQ(api_error::success, cache->get("/dir", 10s, list));
+  EXPECT_EQ(2U, calls);
+  EXPECT_STREQ("/dir/2", list->at(0U).api_path.c_str());
+}
+
+TEST_F(listing_cache_test, failed_loads_are_not_cached) {
+  result = api_error::directory_not_found;
+
+  listing_cache::list_ptr list;
+  EXPECT_EQ(api_error::directory_not_found, cache->get("/dir", 10s, list));
+  EXPECT_FALSE(list);
+  EXPECT_EQ(0U, cache->get_size());
+
+  result = api_error::success;
+  EXPECT_EQ(api_error::success, cache->get("/dir", 10s, list));
+  EXPECT_EQ(2U, calls);
+}
+
+TEST_F(listing_cache_test, least_recently_used_listing_is_evicted) {
+  create_cache(2U);
+
+  listing_cache::list_ptr list;
+  EXPECT_EQ(api_error::success, cache->get("/dir1", 10s, list));
+  EXPECT_EQ(api_error::success, cache->get("/dir2", 10s, list));
+  EXPECT_EQ(api_error::success, cache->get("/dir1", 10s, list));
+  EXPECT_EQ(api_error::success, cache->get("/dir3", 10s, list));
+  EXPECT_EQ(2U, cache->get_size());
+  EXPECT_EQ(3U, calls);
+
+  EXPECT_EQ(api_error::success, cache->get("/dir1", 10s, list));
+  EXPECT_EQ(3U, calls);
+
+  EXPECT_EQ(api_error::success, cache->get("/dir2", 10s, list));
+  EXPECT_EQ(4U, calls);
+}
+
+TEST_F(listing_cache_test, stale_listing_is_refreshed_in_background) {
+  cache->start();
+
+  listing_cache::list_ptr list1;
+  EXPECT_EQ(api_error::success, cache->get("/dir", 500ms, list1));
+
+  std::this_thread::sleep_for(600ms);
+
+  listing_cache::list_ptr list2;
+  EXPECT_EQ(api_error::success, cache->get("/dir", 500ms, list2));
+  EXPECT_EQ(list1, list2);
+
+  for (auto idx = 0U; idx < 50U && calls < 2U; ++idx) {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_EQ(2U, calls);
+
+  listing_cache::list_ptr list3;
+  EXPECT_EQ(api_error::success, cache->get("/dir", 500ms, list3));
+  EXPECT_NE(list1, list3);
+  EXPECT_STREQ("/dir/2", list3->at(0U).api_path.c_str());
+}
+
+TEST_F(listing_cache_test, expired_listing_is_reloaded_without_service) {
+  listing_cache::list_ptr list1;
+  EXPECT_EQ(api_error::success, cache->get("/dir", 100ms, list1));
+
+  std::this_thread::sleep_for(150ms);
+
+  listing_cache::list_ptr list2;
+  EXPECT_EQ(api_error::success, cache->get("/dir", 100ms, list2));
+  EXPECT_NE(list1, list2);
+  EXPECT_EQ(2U, calls);
+}
+
+TEST_F(listing_cache_test, invalidation_during_load_discards_result) {
+  cache = std::make_unique<listing_cache>(
+      [this](std::string_view api_path,
+             directory_item_list & /* list */) -> api_error {
+        if (++calls == 1U) {
+          cache->invalidate(api_path);
+        }
+        return api_error::success;
+      });
+
+  listing_cache::list_ptr list;
+  EXPECT_EQ(api_error::success, cache->get("/dir", 10s, list));
+  EXPECT_EQ(0U, cache->get_size());
+
+  EXPECT_EQ(api_error::success, cache->get("/dir", 10s, list));
+  EXPECT_EQ(1U, cache->get_size());
+  EXPECT_EQ(2U, calls);
+}
+} // namespace repertory
@@ -0,0 +1,123 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "providers/listing_snapshot.hpp"
+
+namespace {
+[[nodiscard]] auto create_file(std::string_view api_path,
+                               std::uint64_t modified_date = 1U,
+                               std::uint64_t size = 2U) -> repertory::api_file {
+  return repertory::api_file{
+      .api_path = std::string{api_path},
+      .file_size = size,
+      .modified_date = modified_date,
+  };
+}
+} // namespace
+
+namespace repertory {
+TEST(listing_snapshot_test, files_and_parent_directories_are_found) {
+  listing_snapshot snapshot;
+  snapshot.add(create_file("/a/b/file.txt", 3U, 4U));
+  snapshot.add(create_file("/root.txt"));
+  snapshot.seal();
+
+  const auto *item = snapshot.find("/");
+  ASSERT_NE(nullptr, item);
+  EXPECT_TRUE(item->directory);
+
+  item = snapshot.find("/a");
+  ASSERT_NE(nullptr, item);
+  EXPECT_TRUE(item->directory);
+
+  item = snapshot.find("/a/b");
+  ASSERT_NE(nullptr, item);
+  EXPECT_TRUE(item->directory);
+
+  item = snapshot.find("/a/b/file.txt");
+  ASSERT_NE(nullptr, item);
+  EXPECT_FALSE(item->directory);
+  EXPECT_EQ(3U, item->modified_date);
+  EXPECT_EQ(4U, item->size);
+
+  EXPECT_EQ(nullptr, snapshot.find("/missing.txt"));
+  EXPECT_NE(nullptr, snapshot.find("/root.txt"));
+}
+
+TEST(listing_snapshot_test, unsorted_input_is_deduplicated) {
+  listing_snapshot snapshot;
+  snapshot.add(create_file("/z/2.txt"));
+  snapshot.add(create_file("/a/1.txt"));
+  snapshot.add(create_file("/z/1.txt"));
+  snapshot.add(create_file("/a/2.txt"));
+  snapshot.seal();
+
+  EXPECT_EQ(7U, snapshot.size());
+}
+
+TEST(listing_snapshot_test, lookup_behind_cursor_restarts) {
+  listing_snapshot snapshot;
+  for (const auto *path : {"/1.txt", "/2.txt", "/3.txt", "/4.txt"}) {
+    snapshot.add(create_file(path));
+  }
+  snapshot.seal();
+
+  EXPECT_NE(nullptr, snapshot.find("/3.txt"));
+  EXPECT_NE(nullptr, snapshot.find("/4.txt"));
+  EXPECT_NE(nullptr, snapshot.find("/1.txt"));
+  EXPECT_NE(nullptr, snapshot.find("/1.txt"));
+  EXPECT_EQ(nullptr, snapshot.find("/20.txt"));
+  EXPECT_NE(nullptr, snapshot.find("/2.txt"));
+}
+
+TEST(listing_snapshot_test, update_replaces_existing_entry_only) {
+  listing_snapshot snapshot;
+  snapshot.add(create_file("/1.txt"));
+  snapshot.add(create_file("/2.txt", 3U, 4U));
+  snapshot.seal();
+
+  EXPECT_NE(nullptr, snapshot.find("/2.txt"));
+  snapshot.update(listing_snapshot::entry{
+      .api_path = "/2.txt",
+      .modified_date = 5U,
+      .size = 6U,
+  });
+  snapshot.update(listing_snapshot::entry{.api_path = "/3.txt"});
+  EXPECT_EQ(3U, snapshot.size());
+
+  const auto *item = snapshot.find("/2.txt");
+  ASSERT_NE(nullptr, item);
+  EXPECT_EQ(5U, item->modified_date);
+  EXPECT_EQ(6U, item->size);
+  EXPECT_EQ(nullptr, snapshot.find("/3.txt"));
+}
+
+TEST(listing_snapshot_test, empty_listing_contains_only_root) {
+  listing_snapshot snapshot;
+  snapshot.seal();
+
+  EXPECT_EQ(1U, snapshot.size());
+  EXPECT_NE(nullptr, snapshot.find("/"));
+  EXPECT_EQ(nullptr, snapshot.find("/file.txt"));
+}
+} // namespace repertory
@@ -0,0 +1,118 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "db/meta_codec.hpp"
+#include "types/repertory.hpp"
+
+namespace repertory {
+TEST(meta_codec_test, can_encode_and_decode_meta) {
+  api_meta_map meta{
+      {META_ACCESSED, "1700000000000000000"},
+      {META_BACKUP, ""},
+      {META_DIRECTORY, "0"},
+      {META_MODE, "0644"},
+      {META_UID, "1000"},
+      {"user.custom", std::string{"\0\1\2", 3U}},
+  };
+
+  auto data = meta_codec::encode(meta);
+  EXPECT_FALSE(meta_codec::is_legacy_json(data));
+
+  api_meta_map decoded;
+  EXPECT_TRUE(meta_codec::decode(data, decoded));
+  EXPECT_EQ(meta, decoded);
+}
+
+TEST(meta_codec_test, encoding_is_smaller_than_json) {
+  api_meta_map meta{
+      {META_ACCESSED, "1700000000000000000"},
+      {META_CHANGED, "1700000000000000000"},
+      {META_CREATION, "1700000000000000000"},
+      {META_DIRECTORY, "0"},
+      {META_GID, "1000"},
+      {META_MODE, "33188"},
+      {META_MODIFIED, "1700000000000000000"},
+      {META_UID, "1000"},
+      {META_WRITTEN, "1700000000000000000"},
+  };
+
+  EXPECT_LT(meta_codec::encode(meta).size(),
+            nlohmann::json(meta).dump().size());
+}
+
+TEST(meta_codec_test, decode_fails_for_truncated_data) {
+  auto data = meta_codec::encode({
+      {META_UID, "1000"},
+      {"user.custom", "value"},
+  });
+
+  api_meta_map meta;
+  EXPECT_FALSE(meta_codec::decode(data.substr(0U, data.size() - 1U), meta));
+  EXPECT_FALSE(meta_codec::decode(R"({"uid":"1000"})", meta));
+}
+
+TEST(meta_codec_test, persisted_tags_are_stable) {
+  // Stored records depend on these values; update the test only when a new
+  // tag is appended
+  EXPECT_EQ(std::string{"\x01\x00\x01\x01\x01x", 6U},
+            meta_codec::encode({{META_ACCESSED, "x"}}));
+  EXPECT_EQ(std::string{"\x01\x00\x01\x09\x01x", 6U},
+            meta_codec::encode({{META_KEY, "x"}}));
+  EXPECT_EQ(std::string{"\x01\x00\x01\x0F\x01x", 6U},
+            meta_codec::encode({{META_SOURCE, "x"}}));
+  EXPECT_EQ(std::string{"\x01\x00\x01\x11\x01x", 6U},
+            meta_codec::encode({{META_WRITTEN, "x"}}));
+
+  // Numeric values are flagged by their bit in the mask
+  EXPECT_EQ(std::string{"\x01\x01\x05\x00", 4U},
+            meta_codec::encode({{META_ACCESSED, "5"}}));
+  EXPECT_EQ(std::string{"\x01\x80\x02\x05\x00", 5U},
+            meta_codec::encode({{META_UID, "5"}}));
+
+  // Every well-known key has exactly one tag
+  for (const auto &name : META_USED_NAMES) {
+    EXPECT_EQ(1, std::ranges::count_if(meta_codec::KEY_TAGS,
+                                       [&name](auto &&item) -> bool {
+                                         return item.second == name;
+                                       }));
+  }
+}
+
+TEST(meta_codec_test, decode_fails_for_unknown_tag) {
+  api_meta_map meta;
+  EXPECT_FALSE(meta_codec::decode(std::string{"\x01\x00\x01\x7F\x01x", 6U},
+                                  meta));
+}
+
+TEST(meta_codec_test, to_numeric_only_accepts_canonical_values) {
+  EXPECT_EQ(std::uint64_t{0U}, meta_codec::to_numeric("0"));
+  EXPECT_EQ(std::uint64_t{1000U}, meta_codec::to_numeric("1000"));
+  EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(),
+            meta_codec::to_numeric("18446744073709551615"));
+  EXPECT_FALSE(meta_codec::to_numeric("").has_value());
+  EXPECT_FALSE(meta_codec::to_numeric("01").has_value());
+  EXPECT_FALSE(meta_codec::to_numeric("-1").has_value());
+  EXPECT_FALSE(meta_codec::to_numeric("1a").has_value());
+  EXPECT_FALSE(meta_codec::to_numeric("18446744073709551616").has_value());
+}
+} // namespace repertory
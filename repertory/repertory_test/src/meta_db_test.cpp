@@ -22,6 +22,9 @@
 
 #include "fixtures/meta_db_fixture.hpp"
 
+#include "utils/db/sqlite/db_common.hpp"
+#include "utils/db/sqlite/db_insert.hpp"
+
 namespace {
 [[nodiscard]] auto create_test_file() -> std::string {
   static std::atomic<std::uint64_t> idx{};
@@ -118,6 +121,36 @@ TYPED_TEST(meta_db_test, can_get_api_file_list) {
   }
 }
 
+TYPED_TEST(meta_db_test, can_page_api_path_list_in_order) {
+  std::vector<std::string> files{};
+  for (auto idx = 0U; idx < 5U; ++idx) {
+    auto test_file = create_test_file();
+    files.push_back(test_file);
+    EXPECT_EQ(
+        api_error::success,
+        this->meta_db->set_item_meta(
+            test_file, {
+                           {META_DIRECTORY, utils::string::from_bool(false)},
+                       }));
+  }
+
+  std::vector<std::string> paged_list{};
+  std::string after{};
+  auto page = this->meta_db->get_api_path_list(after, 2U);
+  while (not page.empty()) {
+    EXPECT_GE(2U, page.size());
+    paged_list.insert(paged_list.end(), page.begin(), page.end());
+    after = page.back();
+    page = this->meta_db->get_api_path_list(after, 2U);
+  }
+
+  EXPECT_TRUE(std::ranges::is_sorted(paged_list));
+  EXPECT_EQ(this->meta_db->get_api_path_list().size(), paged_list.size());
+  for (const auto &api_path : files) {
+    EXPECT_TRUE(utils::collection::includes(paged_list, api_path));
+  }
+}
+
 TYPED_TEST(meta_db_test,
            full_get_item_meta_returns_item_not_found_if_item_does_not_exist) {
   auto api_path = create_test_file();
@@ -646,4 +679,93 @@ TYPED_TEST(meta_db_test, can_enumerate_api_path_list) {
 
   EXPECT_EQ(std::size_t(1U), call_count);
 }
+
+TYPED_TEST(meta_db_test, typed_and_custom_meta_values_are_preserved) {
+  auto test_file = create_test_file();
+  api_meta_map expected{
+      {META_ACCESSED,
+       std::to_string(std::numeric_limits<std::uint64_t>::max())},
+      {META_ATTRIBUTES, "32"},
+      {META_BACKUP, "backup"},
+      {META_CHANGED, "0"},
+      {META_CREATION, "1700000000000000000"},
+      {META_DIRECTORY, utils::string::from_bool(false)},
+      {META_GID, "0012"},
+      {META_KDF, ""},
+      {META_KEY, "key"},
+      {META_MODE, ""},
+      {META_MODIFIED, "-1"},
+      {META_OSXFLAGS, "4"},
+      {META_PINNED, utils::string::from_bool(true)},
+      {META_SIZE, "2"},
+      {META_SOURCE, create_test_file()},
+      {META_UID, "1000"},
+      {META_WRITTEN, "2"},
+      {"user.custom", std::string{"a\0b", 3U}},
+  };
+  EXPECT_EQ(api_error::success,
+            this->meta_db->set_item_meta(test_file, expected));
+
+  api_meta_map meta;
+  EXPECT_EQ(api_error::success, this->meta_db->get_item_meta(test_file, meta));
+  EXPECT_EQ(expected, meta);
+
+  for (const auto &item : expected) {
+    std::string value;
+    EXPECT_EQ(api_error::success,
+              this->meta_db->get_item_meta(test_file, item.first, value));
+    EXPECT_EQ(item.second, value);
+  }
+}
+
+TEST(sqlite_meta_db_migration, legacy_json_data_is_migrated) {
+  auto cfg_directory = utils::path::combine(test::get_test_output_dir(),
+                                            {
+                                                "meta_db_test",
+                                                "legacy",
+                                            });
+  ASSERT_TRUE(utils::file::directory{cfg_directory}.remove_recursively());
+  app_config cfg(provider_type::s3, cfg_directory);
+
+  auto db_dir = utils::path::combine(cfg.get_data_directory(), {"db"});
+  ASSERT_TRUE(utils::file::directory{db_dir}.create_directory());
+
+  {
+    auto db3 = utils::db::sqlite::create_db(
+        utils::path::combine(db_dir, {"meta.db"}),
+        {
+            {
+                "meta",
+                "CREATE TABLE IF NOT EXISTS meta (api_path TEXT PRIMARY KEY "
+                "ASC, data TEXT, directory INTEGER, pinned INTEGER, size "
+                "INTEGER, source_path TEXT);",
+            },
+        });
+    auto result = utils::db::sqlite::db_insert{*db3, "meta"}
+                      .column_value("api_path", "/legacy")
+                      .column_value("data", R"({"mode":"420","uid":"1000",)"
+                                            R"("user.custom":"value"})")
+                      .column_value("directory", 0)
+                      .column_value("pinned", 1)
+                      .column_value("size", 10)
+                      .column_value("source_path", "/source")
+                      .go();
+    ASSERT_TRUE(result.ok());
+  }
+
+  sqlite_meta_db meta_db(cfg);
+
+  api_meta_map meta;
+  EXPECT_EQ(api_error::success, meta_db.get_item_meta("/legacy", meta));
+  EXPECT_STREQ("420", meta[META_MODE].c_str());
+  EXPECT_STREQ("1000", meta[META_UID].c_str());
+  EXPECT_STREQ("value", meta["user.custom"].c_str());
+  EXPECT_TRUE(utils::string::to_bool(meta[META_PINNED]));
+  EXPECT_EQ(10U, utils::string::to_uint64(meta[META_SIZE]));
+  EXPECT_STREQ("/source", meta[META_SOURCE].c_str());
+
+  std::string api_path;
+  EXPECT_EQ(api_error::success, meta_db.get_api_path("/source", api_path));
+  EXPECT_STREQ("/legacy", api_path.c_str());
+}
 } // namespace repertory
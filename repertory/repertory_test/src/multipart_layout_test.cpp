@@ -0,0 +1,163 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "types/s3.hpp"
+#include "utils/encrypting_reader.hpp"
+#include "utils/encryption.hpp"
+
+namespace {
+constexpr auto min_part_size{5ULL * 1024ULL * 1024ULL};
+
+const auto get_stop_requested = []() -> bool { return false; };
+
+void read_part(const repertory::multipart_layout &layout,
+               const repertory::utils::encryption::encrypting_reader &reader,
+               std::uint32_t part_number, repertory::data_buffer &object) {
+  auto part_reader{reader};
+  auto range{layout.get_range(part_number)};
+  auto size{static_cast<std::size_t>(range.end - range.begin + 1U)};
+  part_reader.set_read_position(range.begin);
+  EXPECT_EQ(size,
+            repertory::utils::encryption::encrypting_reader::reader_function(
+                reinterpret_cast<char *>(&object.at(range.begin)), 1U, size,
+                &part_reader));
+}
+} // namespace
+
+namespace repertory {
+TEST(multipart_layout_test, parts_cover_the_whole_object) {
+  auto total_size{23ULL * 1024ULL * 1024ULL + 17ULL};
+  auto layout{multipart_layout::create(total_size, min_part_size)};
+  EXPECT_EQ(min_part_size, layout.part_size);
+  EXPECT_EQ(5U, layout.part_count);
+
+  std::uint64_t offset{};
+  for (std::uint32_t part = 1U; part <= layout.part_count; ++part) {
+    auto range{layout.get_range(part)};
+    EXPECT_EQ(offset, range.begin);
+    offset = range.end + 1U;
+  }
+  EXPECT_EQ(total_size, offset);
+}
+
+TEST(multipart_layout_test, part_size_grows_to_stay_within_part_limit) {
+  auto total_size{static_cast<std::uint64_t>(max_s3_upload_part_count) *
+                      min_part_size +
+                  1U};
+  auto layout{multipart_layout::create(total_size, min_part_size)};
+  EXPECT_GT(layout.part_size, min_part_size);
+  EXPECT_LE(layout.part_count, max_s3_upload_part_count);
+}
+
+TEST(multipart_layout_test, encrypted_parts_end_on_chunk_boundaries) {
+  auto chunk_size{
+      utils::encryption::encrypting_reader::get_encrypted_chunk_size(),
+  };
+  auto header_size{utils::encryption::kdf_config::size()};
+  auto total_size{
+      utils::encryption::encrypting_reader::calculate_encrypted_size(
+          5U * utils::encryption::encrypting_reader::get_data_chunk_size() +
+              4321U,
+          true),
+  };
+
+  auto layout{
+      multipart_layout::create(total_size, min_part_size, header_size,
+                               chunk_size),
+  };
+  EXPECT_EQ(0U, layout.part_size % chunk_size);
+  EXPECT_EQ(6U, layout.part_count);
+
+  std::uint64_t offset{};
+  for (std::uint32_t part = 1U; part <= layout.part_count; ++part) {
+    auto range{layout.get_range(part)};
+    EXPECT_EQ(offset, range.begin);
+    if (part != 1U) {
+      EXPECT_EQ(0U, (range.begin - header_size) % chunk_size);
+    }
+    offset = range.end + 1U;
+  }
+  EXPECT_EQ(total_size, offset);
+}
+
+TEST(multipart_layout_test, resumed_encrypted_upload_can_be_decrypted) {
+  const auto token = std::string("moose");
+  utils::encryption::kdf_config cfg;
+  auto master_key{
+      utils::encryption::generate_key<utils::hash::hash_256_t>(token, cfg),
+  };
+
+  auto file_size{
+      3U * utils::encryption::encrypting_reader::get_data_chunk_size() + 4321U,
+  };
+  auto &source_file = test::create_random_file(file_size);
+  ASSERT_TRUE(source_file);
+
+  utils::encryption::encrypting_reader first_reader(
+      "test.dat", source_file.get_path(), get_stop_requested, master_key, cfg,
+      std::nullopt);
+  auto data_cfg{*first_reader.get_kdf_config_for_data()};
+
+  auto layout{
+      multipart_layout::create(
+          first_reader.get_total_size(), min_part_size,
+          utils::encryption::kdf_config::size(),
+          utils::encryption::encrypting_reader::get_encrypted_chunk_size()),
+  };
+  ASSERT_EQ(4U, layout.part_count);
+
+  // The first attempt stops after two parts. The resumed attempt reuses the
+  // stored data header but generates new IVs for the remaining parts.
+  data_buffer object(first_reader.get_total_size());
+  read_part(layout, first_reader, 1U, object);
+  read_part(layout, first_reader, 2U, object);
+
+  utils::encryption::encrypting_reader resumed_reader(
+      "test.dat", source_file.get_path(), get_stop_requested, master_key,
+      std::make_pair(data_cfg, cfg), std::nullopt);
+  EXPECT_NE(first_reader.get_iv_list(), resumed_reader.get_iv_list());
+  read_part(layout, resumed_reader, 3U, object);
+  read_part(layout, resumed_reader, 4U, object);
+
+  utils::hash::hash_256_t data_key;
+  std::tie(data_key, std::ignore) = cfg.create_subkey(
+      utils::encryption::kdf_context::data, data_cfg.unique_id, master_key);
+
+  data_buffer decrypted;
+  EXPECT_TRUE(utils::encryption::read_encrypted_range(
+      {0U, file_size - 1U}, data_key, true,
+      [&object](data_buffer &cypher_text, std::uint64_t start_offset,
+                std::uint64_t end_offset) -> bool {
+        cypher_text.assign(
+            std::next(object.begin(), static_cast<std::int64_t>(start_offset)),
+            std::next(object.begin(),
+                      static_cast<std::int64_t>(end_offset + 1U)));
+        return true;
+      },
+      file_size, decrypted));
+
+  data_buffer source_data;
+  EXPECT_TRUE(source_file.read_all(source_data, 0U));
+  EXPECT_EQ(source_data, decrypted);
+}
+} // namespace repertory
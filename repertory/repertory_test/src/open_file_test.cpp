@@ -267,7 +267,7 @@ TEST_F(open_file_test, write_with_incomplete_download) {
           return api_error::download_stopped;
         }
 
-        if (offset == 0U) {
+        if (offset < test_chunk_size) {
           std::size_t bytes_read{};
           data.resize(size);
           auto ret = nf.read(data, offset, &bytes_read) ? api_error::success
@@ -321,6 +321,159 @@ TEST_F(open_file_test, write_with_incomplete_download) {
   EXPECT_TRUE(utils::file::file(fsi.source_path).exists());
 }
 
+TEST_F(open_file_test, write_does_not_download_fully_covered_chunks) {
+  const auto source_path = test::generate_test_file_name("test");
+
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.size = test_chunk_size * 2U;
+  fsi.source_path = source_path;
+
+  EXPECT_CALL(provider, set_item_meta(fsi.api_path, _))
+      .WillRepeatedly(Return(api_error::success));
+
+  // The reader thread is held on chunk 1 so only the write can touch chunk 0
+  EXPECT_CALL(provider, read_file_bytes)
+      .WillRepeatedly([](std::string_view /* api_path */,
+                         std::size_t /* size */, std::uint64_t offset,
+                         data_buffer & /* data */,
+                         stop_type &stop_requested) -> api_error {
+        EXPECT_LE(test_chunk_size, offset);
+        while (not stop_requested) {
+          std::this_thread::sleep_for(10ms);
+        }
+        return api_error::download_stopped;
+      });
+
+  open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  file.set_max_download_count(1U);
+
+  data_buffer data(test_chunk_size, 7U);
+  std::size_t bytes_written{};
+  EXPECT_EQ(api_error::success, file.write(0U, data, bytes_written));
+  EXPECT_EQ(data.size(), bytes_written);
+
+  EXPECT_TRUE(file.get_read_state(0U));
+  EXPECT_FALSE(file.get_read_state(1U));
+
+  data_buffer read_data;
+  EXPECT_EQ(api_error::success,
+            file.read(test_chunk_size - 1U, 0U, read_data));
+  EXPECT_TRUE(std::equal(read_data.begin(), read_data.end(), data.begin()));
+
+  file.close();
+}
+
+TEST_F(open_file_test, write_downloads_only_head_and_tail_of_partial_chunk) {
+  auto &nf = test::create_random_file(test_chunk_size * 2U);
+  data_buffer source_data;
+  source_data.resize(test_chunk_size * 2U);
+  std::size_t bytes_read{};
+  EXPECT_TRUE(nf.read(source_data, 0U, &bytes_read));
+  nf.close();
+
+  const auto source_path = test::generate_test_file_name("test");
+
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.size = test_chunk_size * 2U;
+  fsi.source_path = source_path;
+
+  EXPECT_CALL(provider, set_item_meta(fsi.api_path, _))
+      .WillRepeatedly(Return(api_error::success));
+
+  std::mutex requests_mtx;
+  std::vector<std::pair<std::uint64_t, std::size_t>> requests;
+  EXPECT_CALL(provider, read_file_bytes)
+      .WillRepeatedly([&requests, &requests_mtx, &source_data](
+                          std::string_view /* api_path */, std::size_t size,
+                          std::uint64_t offset, data_buffer &data,
+                          stop_type &stop_requested) -> api_error {
+        if (offset >= test_chunk_size) {
+          while (not stop_requested) {
+            std::this_thread::sleep_for(10ms);
+          }
+          return api_error::download_stopped;
+        }
+
+        {
+          mutex_lock lock(requests_mtx);
+          requests.emplace_back(offset, size);
+        }
+
+        data = data_buffer(
+            std::next(source_data.begin(), static_cast<std::int64_t>(offset)),
+            std::next(source_data.begin(),
+                      static_cast<std::int64_t>(offset + size)));
+        return api_error::success;
+      });
+
+  open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  file.set_max_download_count(1U);
+
+  data_buffer data(test_chunk_size / 4U, 7U);
+  std::size_t bytes_written{};
+  EXPECT_EQ(api_error::success,
+            file.write(test_chunk_size / 4U, data, bytes_written));
+  EXPECT_TRUE(file.get_read_state(0U));
+
+  {
+    mutex_lock lock(requests_mtx);
+    EXPECT_EQ((std::vector<std::pair<std::uint64_t, std::size_t>>{
+                  {0U, test_chunk_size / 4U},
+                  {test_chunk_size / 2U, test_chunk_size / 2U},
+              }),
+              requests);
+  }
+
+  // Reads ending on a chunk boundary also wait on the next chunk
+  auto expected = data_buffer(source_data.begin(),
+                              std::next(source_data.begin(),
+                                        static_cast<std::int64_t>(
+                                            test_chunk_size - 1U)));
+  std::copy(data.begin(), data.end(),
+            std::next(expected.begin(),
+                      static_cast<std::int64_t>(test_chunk_size / 4U)));
+
+  data_buffer read_data;
+  EXPECT_EQ(api_error::success,
+            file.read(test_chunk_size - 1U, 0U, read_data));
+  EXPECT_EQ(expected, read_data);
+
+  file.close();
+}
+
+TEST_F(open_file_test, truncate_and_rewrite_does_not_download) {
+  const auto source_path = test::generate_test_file_name("test");
+
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.size = test_chunk_size * 4U;
+  fsi.source_path = source_path;
+
+  EXPECT_CALL(provider, set_item_meta(fsi.api_path, _))
+      .WillRepeatedly(Return(api_error::success));
+  EXPECT_CALL(provider, read_file_bytes).Times(0);
+
+  open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  EXPECT_EQ(api_error::success, file.resize(0U));
+
+  data_buffer data(test_chunk_size * 3U + 1U, 7U);
+  std::size_t bytes_written{};
+  EXPECT_EQ(api_error::success, file.write(0U, data, bytes_written));
+  validate_write(file, 0U, data, bytes_written);
+  EXPECT_TRUE(file.get_read_state().all());
+  EXPECT_EQ(data.size(), file.get_file_size());
+
+  file.close();
+}
+
 TEST_F(open_file_test, write_new_file) {
   const auto source_path =
       test::generate_test_file_name("file_manager_open_file_test");
@@ -339,6 +492,7 @@ TEST_F(open_file_test, write_new_file) {
       });
 
   open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  file.set_meta_flush_interval(0U);
   test_closeable_open_file(file, false, api_error::success, 0U, source_path);
   data_buffer data = {10, 9, 8};
 
@@ -411,6 +565,7 @@ TEST_F(open_file_test, write_new_file_multiple_chunks) {
         EXPECT_EQ(fsi.source_path, file.get_source_path());
       });
   open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  file.set_meta_flush_interval(0U);
   test_closeable_open_file(file, false, api_error::success, 0U, source_path);
   data_buffer data = {10, 9, 8};
 
@@ -714,6 +869,389 @@ TEST_F(open_file_test,
        can_read_locally_after_write_with_file_size_greater_than_existing_size) {
 }
 
+TEST_F(open_file_test, read_downloads_missing_chunks_concurrently) {
+  constexpr std::size_t chunk_count{4U};
+
+  auto &nf = test::create_random_file(test_chunk_size * chunk_count);
+  data_buffer source_data;
+  source_data.resize(test_chunk_size * chunk_count);
+  std::size_t bytes_read{};
+  EXPECT_TRUE(nf.read(source_data, 0U, &bytes_read));
+  nf.close();
+
+  const auto source_path =
+      test::generate_test_file_name("file_manager_open_file_test");
+
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.size = test_chunk_size * chunk_count;
+  fsi.source_path = source_path;
+
+  std::atomic<std::size_t> active{0U};
+  std::atomic<std::size_t> max_active{0U};
+  EXPECT_CALL(provider, read_file_bytes)
+      .WillRepeatedly([&active, &max_active, &source_data](
+                          std::string_view /* api_path */, std::size_t size,
+                          std::uint64_t offset, data_buffer &data,
+                          stop_type &stop_requested) -> api_error {
+        auto count = ++active;
+        auto current = max_active.load();
+        while ((count > current) &&
+               not max_active.compare_exchange_weak(current, count)) {
+        }
+
+        std::this_thread::sleep_for(100ms);
+        --active;
+
+        if (stop_requested) {
+          return api_error::download_stopped;
+        }
+
+        data = data_buffer(
+            std::next(source_data.begin(), static_cast<std::int64_t>(offset)),
+            std::next(source_data.begin(),
+                      static_cast<std::int64_t>(offset + size)));
+        return api_error::success;
+      });
+
+  EXPECT_CALL(upload_mgr, remove_resume)
+      .WillOnce(
+          [&fsi](std::string_view api_path, std::string_view source_path2) {
+            EXPECT_EQ(fsi.api_path, api_path);
+            EXPECT_EQ(fsi.source_path, source_path2);
+          });
+
+  open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  file.set_max_download_count(std::uint8_t{chunk_count});
+
+  data_buffer data;
+  EXPECT_EQ(api_error::success, file.read(fsi.size, 0U, data));
+  EXPECT_EQ(source_data, data);
+  EXPECT_TRUE(file.get_read_state().all());
+  EXPECT_LT(std::size_t(1U), max_active.load());
+
+  file.close();
+}
+
+TEST_F(open_file_test, write_meta_is_coalesced_until_flushed) {
+  const auto source_path =
+      test::generate_test_file_name("file_manager_open_file_test");
+
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.size = 0U;
+  fsi.source_path = source_path;
+
+  EXPECT_CALL(upload_mgr, store_resume).Times(1);
+  EXPECT_CALL(upload_mgr, remove_upload).Times(1);
+  EXPECT_CALL(upload_mgr, queue_upload).Times(1);
+
+  open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  file.set_meta_flush_interval(1U);
+
+  data_buffer data = {10, 9, 8};
+  std::size_t flush_count{};
+  EXPECT_CALL(provider, set_item_meta(fsi.api_path, _))
+      .WillOnce([&data, &flush_count](std::string_view,
+                                      const api_meta_map &meta) -> api_error {
+        ++flush_count;
+        EXPECT_EQ(data.size() * 10U,
+                  utils::string::to_size_t(meta.at(META_SIZE)));
+        return api_error::success;
+      });
+
+  std::size_t bytes_written{};
+  for (std::size_t idx = 0U; idx < 10U; ++idx) {
+    EXPECT_EQ(api_error::success,
+              file.write(idx * data.size(), data, bytes_written));
+  }
+
+  auto pending = file.get_pending_meta();
+  EXPECT_NO_THROW(EXPECT_FALSE(pending.at(META_CHANGED).empty()));
+  EXPECT_NO_THROW(EXPECT_FALSE(pending.at(META_MODIFIED).empty()));
+  EXPECT_NO_THROW(EXPECT_FALSE(pending.at(META_WRITTEN).empty()));
+  EXPECT_EQ(data.size() * 10U, utils::string::to_size_t(pending.at(META_SIZE)));
+  EXPECT_FALSE(file.is_pending_meta_expired());
+
+  std::this_thread::sleep_for(1100ms);
+  EXPECT_TRUE(file.is_pending_meta_expired());
+  EXPECT_EQ(std::size_t(0U), flush_count);
+
+  EXPECT_EQ(api_error::success, file.flush_pending_meta());
+  EXPECT_EQ(std::size_t(1U), flush_count);
+  EXPECT_TRUE(file.get_pending_meta().empty());
+  EXPECT_FALSE(file.is_pending_meta_expired());
+
+  file.close();
+}
+
+TEST_F(open_file_test, failed_meta_flush_is_kept_for_next_flush) {
+  const auto source_path =
+      test::generate_test_file_name("file_manager_open_file_test");
+
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.size = 0U;
+  fsi.source_path = source_path;
+
+  EXPECT_CALL(upload_mgr, store_resume).Times(1);
+  EXPECT_CALL(upload_mgr, remove_upload).Times(1);
+  EXPECT_CALL(upload_mgr, queue_upload).Times(1);
+
+  open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  file.set_meta_flush_interval(1U);
+
+  data_buffer data = {10, 9, 8};
+  std::size_t bytes_written{};
+  EXPECT_EQ(api_error::success, file.write(0U, data, bytes_written));
+
+  api_meta_map flushed;
+  EXPECT_CALL(provider, set_item_meta(fsi.api_path, _))
+      .WillOnce([&file](std::string_view,
+                        const api_meta_map & /* meta */) -> api_error {
+        // Set while the failing flush is in flight
+        EXPECT_EQ(api_error::success,
+                  file.set_pending_meta({{META_SIZE, "100"}}));
+        return api_error::comm_error;
+      })
+      .WillOnce([&flushed](std::string_view,
+                           const api_meta_map &meta) -> api_error {
+        flushed = meta;
+        return api_error::success;
+      });
+
+  EXPECT_EQ(api_error::comm_error, file.flush_pending_meta());
+
+  auto pending = file.get_pending_meta();
+  EXPECT_NO_THROW(EXPECT_FALSE(pending.at(META_WRITTEN).empty()));
+  EXPECT_NO_THROW(EXPECT_STREQ("100", pending.at(META_SIZE).c_str()));
+
+  EXPECT_EQ(api_error::success, file.flush_pending_meta());
+  EXPECT_TRUE(file.get_pending_meta().empty());
+  EXPECT_NO_THROW(EXPECT_FALSE(flushed.at(META_WRITTEN).empty()));
+  EXPECT_NO_THROW(EXPECT_STREQ("100", flushed.at(META_SIZE).c_str()));
+
+  file.close();
+}
+
+TEST_F(open_file_test, write_meta_is_applied_to_unlinked_meta) {
+  const auto source_path =
+      test::generate_test_file_name("file_manager_open_file_test");
+
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.size = 0U;
+  fsi.source_path = source_path;
+
+  open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  file.set_unlinked(true);
+
+  EXPECT_CALL(provider, set_item_meta(fsi.api_path, _)).Times(0);
+
+  data_buffer data = {10, 9, 8};
+  std::size_t bytes_written{};
+  EXPECT_EQ(api_error::success, file.write(0U, data, bytes_written));
+  EXPECT_TRUE(file.get_pending_meta().empty());
+
+  auto meta = file.get_unlinked_meta();
+  EXPECT_NO_THROW(EXPECT_FALSE(meta.at(META_WRITTEN).empty()));
+  EXPECT_EQ(data.size(), utils::string::to_size_t(meta.at(META_SIZE)));
+
+  file.close();
+}
+
+TEST_F(open_file_test, random_reads_do_not_trigger_background_download) {
+  constexpr std::size_t chunk_count{8U};
+
+  const auto source_path = test::generate_test_file_name("test");
+
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.size = test_chunk_size * chunk_count;
+  fsi.source_path = source_path;
+
+  std::mutex requests_mtx;
+  std::vector<std::uint64_t> requests;
+  EXPECT_CALL(provider, read_file_bytes)
+      .WillRepeatedly([&requests, &requests_mtx](
+                          std::string_view /* api_path */, std::size_t size,
+                          std::uint64_t offset, data_buffer &data,
+                          stop_type & /* stop_requested */) -> api_error {
+        mutex_lock lock(requests_mtx);
+        requests.push_back(offset / test_chunk_size);
+        data.resize(size);
+        return api_error::success;
+      });
+
+  EXPECT_CALL(provider, set_item_meta(fsi.api_path, META_SOURCE, _))
+      .WillOnce(Return(api_error::success));
+
+  open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  EXPECT_EQ(read_ahead_policy::adaptive, file.get_read_ahead_policy());
+
+  for (const auto &chunk : {5U, 1U, 7U, 3U}) {
+    data_buffer data;
+    EXPECT_EQ(api_error::success,
+              file.read(16U, chunk * test_chunk_size, data));
+  }
+  std::this_thread::sleep_for(250ms);
+
+  {
+    mutex_lock lock(requests_mtx);
+    std::sort(requests.begin(), requests.end());
+    EXPECT_EQ((std::vector<std::uint64_t>{1U, 3U, 5U, 7U}), requests);
+  }
+
+  file.close();
+}
+
+TEST_F(open_file_test, sequential_reads_download_ahead_of_the_reader) {
+  constexpr std::size_t chunk_count{8U};
+
+  const auto source_path = test::generate_test_file_name("test");
+
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.size = test_chunk_size * chunk_count;
+  fsi.source_path = source_path;
+
+  EXPECT_CALL(provider, read_file_bytes)
+      .WillRepeatedly([](std::string_view /* api_path */, std::size_t size,
+                         std::uint64_t /* offset */, data_buffer &data,
+                         stop_type & /* stop_requested */) -> api_error {
+        data.resize(size);
+        return api_error::success;
+      });
+
+  EXPECT_CALL(provider, set_item_meta(fsi.api_path, META_SOURCE, _))
+      .WillOnce(Return(api_error::success));
+
+  open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+
+  for (std::size_t chunk = 0U; chunk < 3U; ++chunk) {
+    data_buffer data;
+    EXPECT_EQ(api_error::success,
+              file.read(16U, chunk * test_chunk_size, data));
+  }
+
+  for (std::size_t idx = 0U; (idx < 20U) && not file.get_read_state(3U);
+       ++idx) {
+    std::this_thread::sleep_for(50ms);
+  }
+  std::this_thread::sleep_for(100ms);
+
+  EXPECT_TRUE(file.get_read_state(3U));
+  EXPECT_FALSE(file.get_read_state(chunk_count - 1U));
+
+  file.close();
+}
+
+TEST_F(open_file_test, full_read_ahead_policy_downloads_entire_file) {
+  constexpr std::size_t chunk_count{8U};
+
+  const auto source_path = test::generate_test_file_name("test");
+
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.size = test_chunk_size * chunk_count;
+  fsi.source_path = source_path;
+
+  EXPECT_CALL(provider, read_file_bytes)
+      .WillRepeatedly([](std::string_view /* api_path */, std::size_t size,
+                         std::uint64_t /* offset */, data_buffer &data,
+                         stop_type & /* stop_requested */) -> api_error {
+        data.resize(size);
+        return api_error::success;
+      });
+
+  EXPECT_CALL(upload_mgr, remove_resume)
+      .WillOnce(
+          [&fsi](std::string_view api_path, std::string_view source_path2) {
+            EXPECT_EQ(fsi.api_path, api_path);
+            EXPECT_EQ(fsi.source_path, source_path2);
+          });
+
+  open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  file.set_read_ahead_policy(read_ahead_policy::full);
+
+  data_buffer data;
+  EXPECT_EQ(api_error::success, file.read(16U, 5U * test_chunk_size, data));
+
+  for (std::size_t idx = 0U; (idx < 40U) && not file.is_complete(); ++idx) {
+    std::this_thread::sleep_for(50ms);
+  }
+  EXPECT_TRUE(file.is_complete());
+
+  file.close();
+}
+
+TEST_F(open_file_test, span_write_and_read_report_transferred_bytes) {
+  const auto source_path = test::generate_test_file_name("test");
+
+  EXPECT_CALL(provider, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.api_path = "/test.txt";
+  fsi.size = 0U;
+  fsi.source_path = source_path;
+
+  EXPECT_CALL(provider, set_item_meta(fsi.api_path, _))
+      .WillRepeatedly(Return(api_error::success));
+  EXPECT_CALL(upload_mgr, store_resume).Times(AnyNumber());
+  EXPECT_CALL(upload_mgr, remove_upload).Times(AnyNumber());
+  EXPECT_CALL(upload_mgr, queue_upload).Times(AnyNumber());
+
+  open_file file(test_chunk_size, 0U, fsi, provider, upload_mgr);
+  file.set_meta_flush_interval(0U);
+
+  data_buffer data(test_chunk_size + 7U);
+  for (std::size_t idx = 0U; idx < data.size(); ++idx) {
+    data.at(idx) = static_cast<unsigned char>(idx % 251U);
+  }
+
+  std::size_t bytes_written{};
+  EXPECT_EQ(api_error::success,
+            file.write(0U, data_cspan{data}, bytes_written));
+  EXPECT_EQ(data.size(), bytes_written);
+  EXPECT_EQ(data.size(), file.get_file_size());
+
+  // Reads that extend past the end of the file are short
+  data_buffer read_data(data.size() + 16U);
+  std::size_t bytes_read{};
+  EXPECT_EQ(api_error::success,
+            file.read(0U, data_span{read_data}, bytes_read));
+  EXPECT_EQ(data.size(), bytes_read);
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), read_data.begin()));
+
+  EXPECT_EQ(api_error::success,
+            file.read(test_chunk_size - 2U, data_span{read_data}.first(4U),
+                      bytes_read));
+  EXPECT_EQ(4U, bytes_read);
+  EXPECT_TRUE(std::equal(std::next(data.begin(), test_chunk_size - 2U),
+                         std::next(data.begin(), test_chunk_size + 2U),
+                         read_data.begin()));
+
+  EXPECT_EQ(api_error::success,
+            file.read(data.size(), data_span{read_data}, bytes_read));
+  EXPECT_EQ(0U, bytes_read);
+
+  file.close();
+}
+
 TEST_F(open_file_test, test_valid_download_chunks) {}
 
 TEST_F(open_file_test, test_full_download_with_partial_chunk) {}
@@ -21,14 +21,20 @@
 */
 #include "test_common.hpp"
 
+#include "app_config.hpp"
 #include "comm/packet/packet.hpp"
 #include "comm/packet/packet_client.hpp"
 #include "comm/packet/packet_server.hpp"
 #include "types/remote.hpp"
 #include "utils/common.hpp"
+#include "utils/path.hpp"
 #include "utils/utils.hpp"
 #include "version.hpp"
 
+#if !defined(_WIN32)
+#include "drives/fuse/remotefuse/remote_client.hpp"
+#endif // !defined(_WIN32)
+
 using namespace repertory;
 using namespace repertory::comm;
 
@@ -156,4 +162,287 @@ TEST(packet_client_test, pooled_connection_reused_on_second_send) {
 
   EXPECT_EQ(close_count, 0U);
 }
+
+TEST(packet_client_test, responses_are_matched_out_of_order) {
+  std::string token{"test_token"};
+  std::uint16_t port{};
+  ASSERT_TRUE(utils::get_next_available_port(50000U, port));
+
+  // The slow response is held back until every fast response has arrived
+  std::promise<void> slow_received;
+  std::promise<void> release_slow;
+  auto slow_released = release_slow.get_future().share();
+
+  packet_server server{
+      port, token, 2U, [](std::string /*client_id*/) {},
+      [&slow_received, slow_released](
+          std::uint32_t /*service_flags_in*/, std::string /*client_id*/,
+          std::uint64_t /*thread_id*/, std::string method, packet *request,
+          packet &response, packet_server::message_complete_callback done) {
+        std::uint32_t value{};
+        if (request->decode(value) != 0) {
+          done(packet::error_type{-1});
+          return;
+        }
+
+        response.encode(value);
+        if (method != "slow") {
+          done(packet::error_type{0});
+          return;
+        }
+
+        slow_received.set_value();
+        std::thread([done, slow_released]() {
+          slow_released.wait();
+          done(packet::error_type{0});
+        }).detach();
+      }};
+
+  auto cfg = ::make_cfg(port, token);
+  cfg.max_connections = 1U;
+  packet_client client(cfg);
+
+  const auto send_value = [&client](std::string_view method,
+                                    std::uint32_t value) -> std::uint32_t {
+    std::uint32_t service_flags{};
+    packet request;
+    request.encode(value);
+    packet response;
+    EXPECT_EQ(0, client.send(method, request, response, service_flags));
+
+    std::uint32_t result{};
+    EXPECT_EQ(0, response.decode(result));
+    return result;
+  };
+
+  EXPECT_EQ(1U, send_value("ping", 1U));
+
+  auto slow = std::async(std::launch::async,
+                         [&send_value]() { return send_value("slow", 2U); });
+  slow_received.get_future().wait();
+
+  std::vector<std::future<std::uint32_t>> fast;
+  for (std::uint32_t value = 3U; value < 11U; ++value) {
+    fast.emplace_back(std::async(std::launch::async, [&send_value, value]() {
+      return send_value("ping", value);
+    }));
+  }
+
+  // Requests queued behind the slow one would never complete. The timeout
+  // only keeps a broken client from hanging the test.
+  for (auto &result : fast) {
+    EXPECT_EQ(std::future_status::ready, result.wait_for(30s));
+  }
+  EXPECT_EQ(std::future_status::timeout, slow.wait_for(0ms));
+
+  release_slow.set_value();
+
+  for (std::uint32_t idx = 0U; idx < fast.size(); ++idx) {
+    EXPECT_EQ(idx + 3U, fast.at(idx).get());
+  }
+  EXPECT_EQ(2U, slow.get());
+}
+
+TEST(packet_client_test, negotiates_highest_protocol_supported_by_server) {
+  std::string token{"test_token"};
+
+  for (const auto &max_protocol : {
+           packet_protocol_multiplexed,
+           packet_protocol_latest,
+       }) {
+    std::uint16_t port{};
+    ASSERT_TRUE(utils::get_next_available_port(50000U, port));
+
+    packet_server server{
+        port,
+        token,
+        2U,
+        [](std::string /*client_id*/) {},
+        [](std::uint32_t /*service_flags_in*/, std::string /*client_id*/,
+           std::uint64_t /*thread_id*/, std::string /*method*/,
+           packet * /*request*/, packet & /*response*/,
+           packet_server::message_complete_callback done) {
+          done(packet::error_type{0});
+        },
+        max_protocol,
+    };
+
+    packet_client client(::make_cfg(port, token));
+    EXPECT_EQ(0U, client.get_protocol());
+
+    std::uint32_t service_flags{};
+    EXPECT_EQ(0, client.send("ping", service_flags));
+    EXPECT_EQ(max_protocol, client.get_protocol());
+  }
+}
+
+#if !defined(_WIN32)
+// Serves ::fuse_readdir_plus the same way remote_server_base does, over a
+// fixed listing of /dir
+class test_readdir_plus_server final {
+public:
+  test_readdir_plus_server(std::uint16_t port, std::string token,
+                           std::uint32_t max_protocol)
+      : server_(std::make_unique<packet_server>(
+            port, std::move(token), 2U, [](std::string /*client_id*/) {},
+            [this](std::uint32_t /*service_flags_in*/,
+                   std::string /*client_id*/, std::uint64_t /*thread_id*/,
+                   std::string method, packet *request, packet &response,
+                   packet_server::message_complete_callback done) {
+              done(handle_message(method, request, response));
+            },
+            max_protocol)) {}
+
+public:
+  static constexpr std::array<std::string_view, 5U> listing{
+      ".", "..", "/dir/file1", "/dir/missing", "/dir/sub",
+  };
+
+  std::atomic<std::uint32_t> readdir_plus_count{0U};
+
+private:
+  std::unique_ptr<packet_server> server_;
+
+private:
+  [[nodiscard]] auto handle_message(std::string_view method, packet *request,
+                                    packet &response) -> packet::error_type {
+    if (not method.ends_with("fuse_readdir_plus")) {
+      return method.ends_with("check") ? 0 : -1;
+    }
+
+    ++readdir_plus_count;
+
+    packet::error_type ret{0};
+
+    std::string path;
+    DECODE_OR_RETURN(request, path);
+
+    remote::file_offset offset{};
+    DECODE_OR_RETURN(request, offset);
+
+    remote::file_handle handle{};
+    DECODE_OR_RETURN(request, handle);
+
+    std::uint32_t max_count{};
+    DECODE_OR_RETURN(request, max_count);
+
+    std::vector<remote::directory_entry> entries;
+    ret = remote::read_directory_page(
+        path, offset, max_count,
+        [](remote::file_offset item_offset, std::string &item_path) -> auto {
+          if (item_offset >= listing.size()) {
+            return -120;
+          }
+
+          item_path = listing.at(static_cast<std::size_t>(item_offset));
+          return 0;
+        },
+        [](std::string_view stat_path, remote::stat &r_stat,
+           bool &directory) -> auto {
+          if (stat_path == "/dir/missing") {
+            return -ENOENT;
+          }
+
+          directory = not utils::path::strip_to_file_name(std::string{
+              stat_path,
+          }).starts_with("file");
+          r_stat.st_size = stat_path.size();
+          return 0;
+        },
+        entries);
+    if (ret == 0) {
+      response.encode(static_cast<std::uint32_t>(entries.size()));
+      for (const auto &entry : entries) {
+        response.encode(entry);
+      }
+    }
+
+    return ret;
+  }
+};
+
+[[nodiscard]] auto create_remote_config(std::uint16_t port,
+                                        std::string_view token)
+    -> std::unique_ptr<app_config> {
+  auto cfg{
+      std::make_unique<app_config>(
+          provider_type::remote,
+          utils::path::combine(test::get_test_output_dir(),
+                               {
+                                   "packet_client_test",
+                                   std::to_string(port),
+                               })),
+  };
+  cfg->set_remote_config(::make_cfg(port, token));
+  return cfg;
+}
+
+TEST(packet_client_test, readdir_plus_pages_until_end_of_listing) {
+  std::string token{"test_token"};
+  std::uint16_t port{};
+  ASSERT_TRUE(utils::get_next_available_port(50000U, port));
+
+  test_readdir_plus_server server(port, token, packet_protocol_latest);
+
+  auto cfg{create_remote_config(port, token)};
+  remote_fuse::remote_client client(*cfg);
+
+  std::vector<remote::directory_entry> list;
+  std::vector<remote::directory_entry> entries;
+  packet::error_type ret{};
+  while ((ret = client.fuse_readdir_plus("/dir", list.size(), 1U, 2U,
+                                         entries)) == 0) {
+    EXPECT_FALSE(entries.empty());
+    EXPECT_LE(entries.size(), 2U);
+    list.insert(list.end(), entries.begin(), entries.end());
+  }
+  EXPECT_EQ(-120, ret);
+  EXPECT_TRUE(entries.empty());
+  EXPECT_EQ(4U, server.readdir_plus_count);
+
+  ASSERT_EQ(test_readdir_plus_server::listing.size(), list.size());
+  for (std::size_t idx = 0U; idx < list.size(); ++idx) {
+    EXPECT_EQ(test_readdir_plus_server::listing.at(idx),
+              list.at(idx).item_path);
+  }
+
+  // "." and ".." are stat'd as the directory and its parent
+  EXPECT_EQ(0, list.at(0U).res);
+  EXPECT_TRUE(list.at(0U).directory);
+  EXPECT_EQ(std::string{"/dir"}.size(), list.at(0U).r_stat.st_size);
+  EXPECT_EQ(0, list.at(1U).res);
+  EXPECT_EQ(std::string{"/"}.size(), list.at(1U).r_stat.st_size);
+
+  EXPECT_EQ(0, list.at(2U).res);
+  EXPECT_FALSE(list.at(2U).directory);
+  EXPECT_EQ(list.at(2U).item_path.size(), list.at(2U).r_stat.st_size);
+
+  EXPECT_EQ(-ENOENT, list.at(3U).res);
+
+  EXPECT_EQ(0, list.at(4U).res);
+  EXPECT_TRUE(list.at(4U).directory);
+}
+
+TEST(packet_client_test, readdir_plus_is_not_supported_by_protocol_2_server) {
+  std::string token{"test_token"};
+  std::uint16_t port{};
+  ASSERT_TRUE(utils::get_next_available_port(50000U, port));
+
+  test_readdir_plus_server server(port, token, packet_protocol_multiplexed);
+
+  auto cfg{create_remote_config(port, token)};
+  remote_fuse::remote_client client(*cfg);
+
+  // The first request is sent before the protocol is known
+  std::vector<remote::directory_entry> entries{remote::directory_entry{}};
+  EXPECT_EQ(-ENOTSUP, client.fuse_readdir_plus("/dir", 0U, 1U, 2U, entries));
+  EXPECT_TRUE(entries.empty());
+  EXPECT_EQ(1U, server.readdir_plus_count);
+
+  entries.emplace_back();
+  EXPECT_EQ(-ENOTSUP, client.fuse_readdir_plus("/dir", 0U, 1U, 2U, entries));
+  EXPECT_TRUE(entries.empty());
+  EXPECT_EQ(1U, server.readdir_plus_count);
+}
+#endif // !defined(_WIN32)
 } // namespace
@@ -17,6 +17,7 @@
 */
 #include "test_common.hpp"
 
+#include "comm/packet/common.hpp"
 #include "comm/packet/packet.hpp"
 #include "types/remote.hpp"
 
@@ -289,6 +290,38 @@ TEST(packet_test, encrypt_and_decrypt_without_size_prefix) {
   EXPECT_EQ("opaque", out);
 }
 
+TEST(packet_test, session_key_matches_token_and_rejects_other_keys) {
+  auto token_key =
+      utils::encryption::generate_key<utils::hash::hash_256_t>("moose");
+  auto session_key = comm::create_session_key(token_key, "nonce");
+  EXPECT_NE(token_key, session_key);
+  EXPECT_EQ(session_key, comm::create_session_key(token_key, "nonce"));
+
+  packet pkt;
+  pkt.encode("opaque");
+  pkt.encrypt(token_key);
+
+  std::uint32_t size{};
+  EXPECT_EQ(0, pkt.decode(size));
+  EXPECT_EQ(0, pkt.decrypt("moose"));
+
+  std::string out;
+  EXPECT_EQ(0, pkt.decode(out));
+  EXPECT_EQ("opaque", out);
+
+  pkt = packet{};
+  pkt.encode("opaque");
+  pkt.encrypt(session_key, false);
+  EXPECT_NE(0, pkt.decrypt(token_key));
+
+  pkt = packet{};
+  pkt.encode("opaque");
+  pkt.encrypt(session_key, false);
+  EXPECT_EQ(0, pkt.decrypt(session_key));
+  EXPECT_EQ(0, pkt.decode(out));
+  EXPECT_EQ("opaque", out);
+}
+
 TEST(packet_test, decode_fails_when_empty) {
   packet pkt;
   std::uint32_t val{};
@@ -463,4 +496,52 @@ TEST(packet_test, remote_file_info_round_trip) {
   EXPECT_EQ(fi.HardLinks, out.HardLinks);
   EXPECT_EQ(fi.EaSize, out.EaSize);
 }
+
+TEST(packet_test, remote_directory_entry_round_trip) {
+  packet pkt;
+
+  remote::directory_entry entry{};
+  entry.item_path = "/dir/file.txt";
+  entry.r_stat.st_mode = 0644U;
+  entry.r_stat.st_size = 1234U;
+  entry.r_stat.st_uid = 1000U;
+  pkt.encode(entry);
+
+  remote::directory_entry dir_entry{};
+  dir_entry.item_path = "/dir/sub";
+  dir_entry.directory = true;
+  pkt.encode(dir_entry);
+
+  remote::directory_entry failed_entry{};
+  failed_entry.item_path = "/dir/missing";
+  failed_entry.res = -ENOENT;
+  failed_entry.r_stat.st_size = 5678U;
+  pkt.encode(failed_entry);
+  pkt.encode(std::uint32_t{42U});
+
+  remote::directory_entry out{};
+  EXPECT_EQ(0, pkt.decode(out));
+  EXPECT_EQ(entry.item_path, out.item_path);
+  EXPECT_EQ(0, out.res);
+  EXPECT_FALSE(out.directory);
+  EXPECT_EQ(entry.r_stat.st_mode, out.r_stat.st_mode);
+  EXPECT_EQ(entry.r_stat.st_size, out.r_stat.st_size);
+  EXPECT_EQ(entry.r_stat.st_uid, out.r_stat.st_uid);
+
+  remote::directory_entry dir_out{};
+  EXPECT_EQ(0, pkt.decode(dir_out));
+  EXPECT_EQ(dir_entry.item_path, dir_out.item_path);
+  EXPECT_TRUE(dir_out.directory);
+
+  // Attributes are not sent for entries that failed
+  remote::directory_entry failed_out{};
+  EXPECT_EQ(0, pkt.decode(failed_out));
+  EXPECT_EQ(failed_entry.item_path, failed_out.item_path);
+  EXPECT_EQ(-ENOENT, failed_out.res);
+  EXPECT_EQ(0U, failed_out.r_stat.st_size);
+
+  std::uint32_t trailer{};
+  EXPECT_EQ(0, pkt.decode(trailer));
+  EXPECT_EQ(42U, trailer);
+}
 } // namespace repertory
@@ -695,6 +695,48 @@ TYPED_TEST(providers_test, get_file_size_fails_if_path_not_found) {
   EXPECT_EQ(0U, size);
 }
 
+TYPED_TEST(providers_test, read_file_bytes_into_span_reports_bytes_read) {
+  if (this->provider->get_provider_type() != provider_type::encrypt) {
+    return;
+  }
+
+  auto source_path = utils::path::combine(
+      this->config->get_encrypt_config().path, {"test.txt"});
+
+  std::string api_path{};
+  EXPECT_EQ(api_error::success,
+            this->provider->get_api_path_from_source(source_path, api_path));
+
+  std::uint64_t file_size{};
+  EXPECT_EQ(api_error::success,
+            this->provider->get_file_size(api_path, file_size));
+  ASSERT_GT(file_size, 10U);
+
+  stop_type stop_requested{false};
+  data_buffer data;
+  EXPECT_EQ(api_error::success,
+            this->provider->read_file_bytes(api_path, file_size, 0U, data,
+                                            stop_requested));
+  EXPECT_EQ(file_size, data.size());
+
+  // Spans that extend past the end of the file are only partially filled
+  data_buffer span_data(file_size + 16U);
+  std::size_t bytes_read{};
+  EXPECT_EQ(api_error::success,
+            this->provider->read_file_bytes(api_path, 0U, data_span{span_data},
+                                            bytes_read, stop_requested));
+  EXPECT_EQ(file_size, bytes_read);
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), span_data.begin()));
+
+  EXPECT_EQ(api_error::success,
+            this->provider->read_file_bytes(api_path, file_size - 10U,
+                                            data_span{span_data}, bytes_read,
+                                            stop_requested));
+  EXPECT_EQ(10U, bytes_read);
+  EXPECT_TRUE(std::equal(std::prev(data.end(), 10), data.end(),
+                         span_data.begin()));
+}
+
 TYPED_TEST(providers_test, get_filesystem_item) {
   if (this->provider->get_provider_type() == provider_type::encrypt) {
     std::string api_path{};
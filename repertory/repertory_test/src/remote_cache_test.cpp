@@ -0,0 +1,300 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "drives/fuse/remotefuse/remote_cache.hpp"
+
+namespace repertory {
+class remote_cache_test : public ::testing::Test {
+public:
+  std::size_t attr_calls{0U};
+  std::size_t read_calls{0U};
+  std::vector<remote::file_size> read_sizes;
+
+  [[nodiscard]] auto get_attr(remote_fuse::remote_cache &cache,
+                              const std::string &api_path,
+                              packet::error_type res = 0)
+      -> packet::error_type {
+    remote::stat r_stat{};
+    bool directory{};
+    return cache.get_attr(api_path, r_stat, directory,
+                          [this, res](remote::stat &st, bool &dir) {
+                            ++attr_calls;
+                            st.st_size = 42U;
+                            dir = false;
+                            return res;
+                          });
+  }
+
+  [[nodiscard]] auto read(remote_fuse::remote_cache &cache,
+                          remote::file_handle handle,
+                          remote::file_offset offset, std::size_t size,
+                          std::vector<char> &out,
+                          const std::string &api_path = "/file")
+      -> packet::error_type {
+    out.resize(size);
+    return cache.read(
+        api_path, handle, out.data(), size, offset,
+        [this](char *buffer, remote::file_size read_size,
+               remote::file_offset read_offset) -> packet::error_type {
+          ++read_calls;
+          read_sizes.push_back(read_size);
+          for (std::size_t idx = 0U; idx < read_size; ++idx) {
+            buffer[idx] = static_cast<char>((read_offset + idx) % 251U);
+          }
+          return static_cast<packet::error_type>(read_size);
+        });
+  }
+
+  [[nodiscard]] static auto is_expected(const std::vector<char> &data,
+                                        remote::file_offset offset) -> bool {
+    for (std::size_t idx = 0U; idx < data.size(); ++idx) {
+      if (data.at(idx) != static_cast<char>((offset + idx) % 251U)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+};
+
+TEST_F(remote_cache_test, attributes_are_cached_until_invalidated) {
+  remote_fuse::remote_cache cache{10s};
+  EXPECT_EQ(0, get_attr(cache, "/dir/file"));
+
+  remote::stat r_stat{};
+  bool directory{true};
+  EXPECT_EQ(0, cache.get_attr("/dir/file", r_stat, directory,
+                              [this](remote::stat &, bool &) {
+                                ++attr_calls;
+                                return -EIO;
+                              }));
+  EXPECT_EQ(42U, r_stat.st_size);
+  EXPECT_FALSE(directory);
+  EXPECT_EQ(1U, attr_calls);
+
+  cache.invalidate("/dir/file");
+  EXPECT_EQ(0, get_attr(cache, "/dir/file"));
+  EXPECT_EQ(2U, attr_calls);
+}
+
+TEST_F(remote_cache_test, zero_timeout_disables_attribute_cache) {
+  remote_fuse::remote_cache cache{0s};
+  EXPECT_EQ(0, get_attr(cache, "/file"));
+  EXPECT_EQ(0, get_attr(cache, "/file"));
+  EXPECT_EQ(2U, attr_calls);
+}
+
+TEST_F(remote_cache_test, missing_entries_are_cached_until_child_changes) {
+  remote_fuse::remote_cache cache{10s};
+  EXPECT_EQ(-ENOENT, get_attr(cache, "/dir", -ENOENT));
+  EXPECT_EQ(-ENOENT, get_attr(cache, "/dir", -ENOENT));
+  EXPECT_EQ(1U, attr_calls);
+
+  EXPECT_EQ(-EIO, get_attr(cache, "/file", -EIO));
+  EXPECT_EQ(-EIO, get_attr(cache, "/file", -EIO));
+  EXPECT_EQ(3U, attr_calls);
+
+  cache.invalidate("/dir/child");
+  EXPECT_EQ(0, get_attr(cache, "/dir"));
+  EXPECT_EQ(4U, attr_calls);
+}
+
+TEST_F(remote_cache_test, access_results_expire_with_attributes) {
+  remote_fuse::remote_cache cache{10s};
+  EXPECT_EQ(0, get_attr(cache, "/file"));
+
+  constexpr std::int32_t read_mask{4};
+  constexpr std::int32_t write_mask{2};
+
+  std::size_t access_calls{};
+  const auto check = [&cache, &access_calls](std::int32_t mask) {
+    return cache.check_access("/file", mask, [&access_calls, mask]() {
+      ++access_calls;
+      return mask == write_mask ? -EACCES : 0;
+    });
+  };
+
+  EXPECT_EQ(0, check(read_mask));
+  EXPECT_EQ(-EACCES, check(write_mask));
+  EXPECT_EQ(0, check(read_mask));
+  EXPECT_EQ(-EACCES, check(write_mask));
+  EXPECT_EQ(2U, access_calls);
+
+  cache.invalidate("/file");
+  EXPECT_EQ(0, check(read_mask));
+  EXPECT_EQ(3U, access_calls);
+}
+
+TEST_F(remote_cache_test, recursive_invalidation_drops_descendants) {
+  remote_fuse::remote_cache cache{10s};
+  EXPECT_EQ(0, get_attr(cache, "/dir/sub/file"));
+  EXPECT_EQ(0, get_attr(cache, "/dir2"));
+
+  cache.invalidate("/dir", true);
+  EXPECT_EQ(0, get_attr(cache, "/dir/sub/file"));
+  EXPECT_EQ(0, get_attr(cache, "/dir2"));
+  EXPECT_EQ(3U, attr_calls);
+}
+
+TEST_F(remote_cache_test, invalidation_keeps_sibling_attributes) {
+  remote_fuse::remote_cache cache{10s};
+  EXPECT_EQ(0, get_attr(cache, "/dir/file"));
+  EXPECT_EQ(0, get_attr(cache, "/dir/file2"));
+
+  cache.invalidate("/dir/file");
+  EXPECT_EQ(0, get_attr(cache, "/dir/file2"));
+  EXPECT_EQ(2U, attr_calls);
+
+  EXPECT_EQ(0, get_attr(cache, "/dir/file"));
+  EXPECT_EQ(3U, attr_calls);
+}
+
+TEST_F(remote_cache_test, listed_attributes_are_cached_unless_invalidated) {
+  remote_fuse::remote_cache cache{10s};
+
+  remote::stat r_stat{};
+  r_stat.st_size = 42U;
+
+  auto generation = cache.get_generation();
+  cache.set_attr("/dir/file", generation, r_stat, false);
+  EXPECT_EQ(0, get_attr(cache, "/dir/file"));
+  EXPECT_EQ(0U, attr_calls);
+
+  generation = cache.get_generation();
+  cache.invalidate("/dir/other");
+  cache.set_attr("/dir/other", generation, r_stat, false);
+  EXPECT_EQ(0, get_attr(cache, "/dir/other"));
+  EXPECT_EQ(1U, attr_calls);
+}
+
+TEST_F(remote_cache_test, sequential_reads_grow_the_readahead_window) {
+  remote_fuse::remote_cache cache{10s};
+
+  constexpr std::size_t read_size{64U * 1024U};
+  std::vector<char> data;
+  remote::file_offset offset{};
+  for (std::size_t idx = 0U; idx < 64U; ++idx) {
+    ASSERT_EQ(static_cast<packet::error_type>(read_size),
+              read(cache, 1U, offset, read_size, data));
+    EXPECT_TRUE(is_expected(data, offset));
+    offset += read_size;
+  }
+
+  EXPECT_LT(read_calls, 10U);
+  ASSERT_LT(1U, read_sizes.size());
+  EXPECT_LT(read_sizes.front(), read_sizes.back());
+  EXPECT_GE(remote_fuse::remote_cache::max_readahead_size, read_sizes.back());
+}
+
+TEST_F(remote_cache_test, random_reads_are_not_read_ahead) {
+  remote_fuse::remote_cache cache{10s};
+
+  constexpr std::size_t read_size{4096U};
+  std::vector<char> data;
+  for (auto offset : {1048576U, 65536U, 524288U, 8192U}) {
+    ASSERT_EQ(static_cast<packet::error_type>(read_size),
+              read(cache, 1U, offset, read_size, data));
+    EXPECT_TRUE(is_expected(data, offset));
+  }
+
+  EXPECT_EQ(4U, read_calls);
+  for (auto size : read_sizes) {
+    EXPECT_EQ(read_size, size);
+  }
+}
+
+TEST_F(remote_cache_test, invalidation_drops_readahead_data) {
+  remote_fuse::remote_cache cache{10s};
+
+  constexpr std::size_t read_size{4096U};
+  std::vector<char> data;
+  EXPECT_EQ(static_cast<packet::error_type>(read_size),
+            read(cache, 1U, 0U, read_size, data));
+  EXPECT_EQ(static_cast<packet::error_type>(read_size),
+            read(cache, 1U, read_size, read_size, data));
+  EXPECT_EQ(1U, read_calls);
+
+  cache.invalidate("/file");
+  EXPECT_EQ(static_cast<packet::error_type>(read_size),
+            read(cache, 1U, read_size * 2U, read_size, data));
+  EXPECT_TRUE(is_expected(data, read_size * 2U));
+  EXPECT_EQ(2U, read_calls);
+
+  cache.release(1U);
+  EXPECT_EQ(static_cast<packet::error_type>(read_size),
+            read(cache, 1U, read_size * 3U, read_size, data));
+  EXPECT_EQ(3U, read_calls);
+}
+
+TEST_F(remote_cache_test, invalidation_only_drops_readahead_of_matching_paths) {
+  remote_fuse::remote_cache cache{10s};
+
+  constexpr std::size_t read_size{4096U};
+  std::vector<char> data;
+  for (const auto &[handle, api_path] : {
+           std::pair<remote::file_handle, std::string>{1U, "/dir/sub/file"},
+           std::pair<remote::file_handle, std::string>{2U, "/dir2/file"},
+       }) {
+    EXPECT_EQ(static_cast<packet::error_type>(read_size),
+              read(cache, handle, 0U, read_size, data, api_path));
+  }
+  EXPECT_EQ(2U, read_calls);
+
+  cache.invalidate("/dir/sub");
+  EXPECT_EQ(static_cast<packet::error_type>(read_size),
+            read(cache, 1U, read_size, read_size, data, "/dir/sub/file"));
+  EXPECT_EQ(2U, read_calls);
+
+  cache.invalidate("/dir", true);
+  EXPECT_EQ(static_cast<packet::error_type>(read_size),
+            read(cache, 1U, read_size * 2U, read_size, data, "/dir/sub/file"));
+  EXPECT_EQ(3U, read_calls);
+
+  EXPECT_EQ(static_cast<packet::error_type>(read_size),
+            read(cache, 2U, read_size, read_size, data, "/dir2/file"));
+  EXPECT_TRUE(is_expected(data, read_size));
+  EXPECT_EQ(3U, read_calls);
+}
+
+TEST_F(remote_cache_test, renamed_handles_are_invalidated_by_new_path) {
+  remote_fuse::remote_cache cache{10s};
+
+  constexpr std::size_t read_size{4096U};
+  std::vector<char> data;
+  EXPECT_EQ(static_cast<packet::error_type>(read_size),
+            read(cache, 1U, 0U, read_size, data, "/file"));
+  EXPECT_EQ(static_cast<packet::error_type>(read_size),
+            read(cache, 1U, read_size, read_size, data, "/renamed"));
+  EXPECT_EQ(1U, read_calls);
+
+  cache.invalidate("/file");
+  EXPECT_EQ(static_cast<packet::error_type>(read_size),
+            read(cache, 1U, read_size * 2U, read_size, data, "/renamed"));
+  EXPECT_EQ(1U, read_calls);
+
+  cache.invalidate("/renamed");
+  EXPECT_EQ(static_cast<packet::error_type>(read_size),
+            read(cache, 1U, read_size * 3U, read_size, data, "/renamed"));
+  EXPECT_EQ(2U, read_calls);
+}
+} // namespace repertory
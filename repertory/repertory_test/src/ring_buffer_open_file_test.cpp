@@ -437,6 +437,69 @@ TEST_F(ring_buffer_open_file_test, read_full_file_in_reverse) {
   }
 }
 
+TEST_F(ring_buffer_open_file_test, read_full_file_into_spans) {
+  constexpr std::size_t read_size{1000U};
+
+  auto file_size{test_chunk_size * 8U + 17U};
+  auto &nf = test::create_random_file(file_size);
+
+  mock_provider mp;
+
+  EXPECT_CALL(mp, is_read_only()).WillRepeatedly(Return(false));
+
+  filesystem_item fsi;
+  fsi.directory = false;
+  fsi.api_path = "/test.txt";
+  fsi.size = file_size;
+  fsi.source_path = test::generate_test_file_name("test");
+
+  std::mutex read_mtx;
+  EXPECT_CALL(mp, read_file_bytes)
+      .WillRepeatedly([&read_mtx, &nf](std::string_view /* api_path */,
+                                       std::size_t size, std::uint64_t offset,
+                                       data_buffer &data,
+                                       stop_type & /* stop_requested */)
+                          -> api_error {
+        mutex_lock lock(read_mtx);
+
+        std::size_t bytes_read{};
+        data.resize(size);
+        auto ret = nf.read(data, offset, &bytes_read) ? api_error::success
+                                                      : api_error::os_error;
+        data.resize(bytes_read);
+        return ret;
+      });
+  {
+    ring_buffer_open_file rb(ring_buffer_dir, test_chunk_size, 30U, fsi, mp,
+                             8U);
+
+    data_buffer source_data;
+    EXPECT_TRUE(nf.read_all(source_data, 0U));
+
+    data_buffer data(file_size);
+    std::uint64_t total_read{};
+    while (total_read < file_size) {
+      // Every span has room for read_size bytes, so the last read is short
+      data_buffer buffer(read_size);
+      std::size_t bytes_read{};
+      EXPECT_EQ(api_error::success,
+                rb.read(total_read, data_span{buffer}, bytes_read));
+      EXPECT_EQ(std::min(read_size, file_size - total_read), bytes_read);
+      if (bytes_read == 0U) {
+        break;
+      }
+
+      std::copy_n(buffer.begin(), bytes_read,
+                  std::next(data.begin(), static_cast<std::int64_t>(total_read)));
+      total_read += bytes_read;
+    }
+
+    EXPECT_EQ(file_size, total_read);
+    EXPECT_EQ(source_data, data);
+    nf.close();
+  }
+}
+
 TEST_F(ring_buffer_open_file_test, read_full_file_in_partial_chunks) {
   auto &nf = test::create_random_file(test_chunk_size * 32u);
   auto download_source_path = nf.get_path();
@@ -0,0 +1,193 @@
+/*
+  Copyright <2018-2025> <scott.e.graves@protonmail.com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "test_common.hpp"
+
+#include "file_manager/upload_scheduler.hpp"
+
+namespace repertory {
+static auto create_entry(std::string api_path, std::uint64_t file_size,
+                         bool sync_requested = false)
+    -> upload_scheduler::entry {
+  return upload_scheduler::entry{
+      .api_path = api_path,
+      .file_size = file_size,
+      .priority = upload_scheduler::get_priority(file_size, sync_requested),
+      .ready_time = std::chrono::steady_clock::now(),
+      .source_path = "/src" + api_path,
+  };
+}
+
+TEST(upload_scheduler_test, priority_is_based_on_size_and_sync) {
+  EXPECT_EQ(upload_priority::small_file,
+            upload_scheduler::get_priority(0U, false));
+  EXPECT_EQ(upload_priority::small_file,
+            upload_scheduler::get_priority(upload_scheduler::small_file_size,
+                                           false));
+  EXPECT_EQ(upload_priority::normal,
+            upload_scheduler::get_priority(
+                upload_scheduler::small_file_size + 1U, false));
+  EXPECT_EQ(upload_priority::sync_requested,
+            upload_scheduler::get_priority(
+                upload_scheduler::small_file_size + 1U, true));
+}
+
+TEST(upload_scheduler_test, entries_are_taken_by_priority_then_queue_order) {
+  static constexpr std::uint64_t large_size{
+      upload_scheduler::small_file_size * 2U,
+  };
+
+  upload_scheduler scheduler;
+  EXPECT_TRUE(scheduler.push(create_entry("/large1", large_size)));
+  EXPECT_TRUE(scheduler.push(create_entry("/small1", 1U)));
+  EXPECT_TRUE(scheduler.push(create_entry("/large2", large_size)));
+  EXPECT_TRUE(scheduler.push(create_entry("/synced", large_size, true)));
+  EXPECT_TRUE(scheduler.push(create_entry("/small2", 2U)));
+  EXPECT_EQ(std::size_t(5U), scheduler.get_queued_count());
+
+  std::vector<std::string> order;
+  while (auto entry = scheduler.pop(10U, 0U)) {
+    order.push_back(entry->api_path);
+  }
+
+  EXPECT_EQ((std::vector<std::string>{
+                "/synced",
+                "/small1",
+                "/small2",
+                "/large1",
+                "/large2",
+            }),
+            order);
+  EXPECT_EQ(std::size_t(0U), scheduler.get_queued_count());
+  EXPECT_EQ(std::size_t(5U), scheduler.get_active_count());
+  EXPECT_EQ(large_size * 3U + 3U, scheduler.get_active_bytes());
+}
+
+TEST(upload_scheduler_test, repeated_push_merges_queued_entry) {
+  upload_scheduler scheduler;
+  EXPECT_TRUE(scheduler.push(create_entry("/first", 5U)));
+  EXPECT_TRUE(scheduler.push(create_entry("/second", 5U)));
+  EXPECT_FALSE(scheduler.push(create_entry("/first", 7U)));
+  EXPECT_EQ(std::size_t(2U), scheduler.get_queued_count());
+
+  auto entry = scheduler.pop(1U, 0U);
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_STREQ("/first", entry->api_path.c_str());
+  EXPECT_EQ(7U, entry->file_size);
+}
+
+TEST(upload_scheduler_test, merged_sync_request_raises_priority) {
+  upload_scheduler scheduler;
+  EXPECT_TRUE(scheduler.push(create_entry("/first", 5U)));
+  EXPECT_TRUE(scheduler.push(create_entry("/second", 5U)));
+  EXPECT_FALSE(scheduler.push(create_entry("/second", 5U, true)));
+  EXPECT_FALSE(scheduler.push(create_entry("/second", 5U)));
+
+  auto entry = scheduler.pop(2U, 0U);
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_STREQ("/second", entry->api_path.c_str());
+  EXPECT_EQ(upload_priority::sync_requested, entry->priority);
+}
+
+TEST(upload_scheduler_test, active_count_is_limited) {
+  upload_scheduler scheduler;
+  EXPECT_TRUE(scheduler.push(create_entry("/first", 1U)));
+  EXPECT_TRUE(scheduler.push(create_entry("/second", 1U)));
+
+  EXPECT_TRUE(scheduler.pop(1U, 0U).has_value());
+  EXPECT_FALSE(scheduler.pop(1U, 0U).has_value());
+
+  scheduler.release("/first");
+  EXPECT_EQ(std::size_t(0U), scheduler.get_active_count());
+
+  auto entry = scheduler.pop(1U, 0U);
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_STREQ("/second", entry->api_path.c_str());
+}
+
+TEST(upload_scheduler_test, byte_budget_skips_entries_that_do_not_fit) {
+  upload_scheduler scheduler;
+  EXPECT_TRUE(scheduler.push(create_entry("/first", 60U)));
+  EXPECT_TRUE(scheduler.push(create_entry("/second", 60U)));
+  EXPECT_TRUE(scheduler.push(create_entry("/third", 30U)));
+
+  EXPECT_STREQ("/first", scheduler.pop(5U, 100U)->api_path.c_str());
+  EXPECT_STREQ("/third", scheduler.pop(5U, 100U)->api_path.c_str());
+  EXPECT_FALSE(scheduler.pop(5U, 100U).has_value());
+  EXPECT_EQ(90U, scheduler.get_active_bytes());
+
+  scheduler.release("/first");
+  scheduler.release("/third");
+  EXPECT_EQ(0U, scheduler.get_active_bytes());
+  EXPECT_STREQ("/second", scheduler.pop(5U, 100U)->api_path.c_str());
+}
+
+TEST(upload_scheduler_test, oversized_entry_starts_when_nothing_is_active) {
+  upload_scheduler scheduler;
+  EXPECT_TRUE(scheduler.push(create_entry("/large", 500U)));
+
+  auto entry = scheduler.pop(5U, 100U);
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_STREQ("/large", entry->api_path.c_str());
+}
+
+TEST(upload_scheduler_test, active_path_is_not_started_twice) {
+  upload_scheduler scheduler;
+  EXPECT_TRUE(scheduler.push(create_entry("/file", 1U)));
+  EXPECT_TRUE(scheduler.pop(5U, 0U).has_value());
+  EXPECT_TRUE(scheduler.is_active("/file"));
+
+  EXPECT_TRUE(scheduler.push(create_entry("/file", 1U)));
+  EXPECT_TRUE(scheduler.is_queued("/file"));
+  EXPECT_FALSE(scheduler.pop(5U, 0U).has_value());
+
+  scheduler.release("/file");
+  EXPECT_TRUE(scheduler.pop(5U, 0U).has_value());
+}
+
+TEST(upload_scheduler_test, delayed_entries_wait_until_ready) {
+  upload_scheduler scheduler;
+  auto delayed{create_entry("/delayed", 1U)};
+  delayed.ready_time += 1h;
+  EXPECT_TRUE(scheduler.push(delayed));
+  EXPECT_TRUE(scheduler.push(create_entry("/ready", 1U)));
+
+  EXPECT_STREQ("/ready", scheduler.pop(5U, 0U)->api_path.c_str());
+  EXPECT_FALSE(scheduler.pop(5U, 0U).has_value());
+
+  auto ready_time = scheduler.get_next_ready_time();
+  ASSERT_TRUE(ready_time.has_value());
+  EXPECT_EQ(delayed.ready_time, ready_time.value());
+
+  EXPECT_FALSE(scheduler.push(create_entry("/delayed", 1U)));
+  EXPECT_FALSE(scheduler.get_next_ready_time().has_value());
+  EXPECT_STREQ("/delayed", scheduler.pop(5U, 0U)->api_path.c_str());
+}
+
+TEST(upload_scheduler_test, can_remove_queued_entry) {
+  upload_scheduler scheduler;
+  EXPECT_TRUE(scheduler.push(create_entry("/file", 1U)));
+  EXPECT_TRUE(scheduler.remove("/file"));
+  EXPECT_FALSE(scheduler.remove("/file"));
+  EXPECT_FALSE(scheduler.is_queued("/file"));
+  EXPECT_FALSE(scheduler.pop(5U, 0U).has_value());
+}
+} // namespace repertory
@@ -60,9 +60,11 @@ TEST(upload_test, can_upload_a_valid_file) {
         EXPECT_FALSE(stop_requested);
         return api_error::success;
       });
+  event_capture evt_cap({file_upload_completed::name});
+
   upload upload(fsi, mock_prov);
+  upload.execute();
 
-  event_capture evt_cap({file_upload_completed::name});
   evt_cap.wait_for_empty();
 
   EXPECT_EQ(api_error::success, upload.get_api_error());
@@ -117,8 +119,11 @@ TEST(upload_test, can_cancel_upload) {
         return api_error::comm_error;
       });
 
+  event_capture evt_cap({file_upload_completed::name});
+
   unique_mutex_lock lock(mtx);
   upload upload(fsi, mock_provider);
+  std::thread upload_thread([&upload]() { upload.execute(); });
   notify.wait(lock);
 
   upload.cancel();
@@ -126,7 +131,7 @@ TEST(upload_test, can_cancel_upload) {
   notify.notify_one();
   lock.unlock();
 
-  event_capture evt_cap({file_upload_completed::name});
+  upload_thread.join();
   evt_cap.wait_for_empty();
 
   EXPECT_EQ(api_error::comm_error, upload.get_api_error());
@@ -170,12 +175,16 @@ TEST(upload_test, can_stop_upload) {
 
   event_capture evt_cap({file_upload_completed::name});
 
-  {
-    upload upload(fsi, mock_provider);
-  }
+  upload upload(fsi, mock_provider);
+  std::thread upload_thread([&upload]() { upload.execute(); });
+  upload.stop();
+  upload_thread.join();
 
   evt_cap.wait_for_empty();
 
+  EXPECT_EQ(api_error::comm_error, upload.get_api_error());
+  EXPECT_FALSE(upload.is_cancelled());
+
   event_system::instance().stop();
 }
 } // namespace repertory
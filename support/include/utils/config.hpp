@@ -134,6 +134,7 @@
 #include <random>
 #include <ranges>
 #include <regex>
+#include <shared_mutex>
 #include <span>
 #include <sstream>
 #include <stdexcept>
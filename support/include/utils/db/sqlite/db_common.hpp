@@ -28,7 +28,7 @@
 #include "utils/error.hpp"
 
 namespace repertory::utils::db::sqlite {
-using db_types_t = std::variant<std::int64_t, std::string>;
+using db_types_t = std::variant<std::int64_t, std::string, data_buffer>;
 
 struct sqlite3_deleter final {
   void operator()(sqlite3 *db3) const;
@@ -37,15 +37,25 @@ struct sqlite3_deleter final {
 using db3_t = std::unique_ptr<sqlite3, sqlite3_deleter>;
 
 struct sqlite3_statement_deleter final {
-  void operator()(sqlite3_stmt *stmt) const {
-    if (stmt != nullptr) {
-      sqlite3_finalize(stmt);
-    }
-  }
+  // Statements obtained from 'prepare_statement()' carry their SQL text and
+  // are reset and returned to the connection's statement cache instead of
+  // being finalized.
+  std::string sql;
+
+  void operator()(sqlite3_stmt *stmt) const;
 };
 
 using db3_stmt_t = std::unique_ptr<sqlite3_stmt, sqlite3_statement_deleter>;
 
+inline constexpr const std::size_t max_cached_statements{64U};
+
+void clear_statement_cache(sqlite3 &db3);
+
+[[nodiscard]] auto get_cached_statement_count(sqlite3 &db3) -> std::size_t;
+
+[[nodiscard]] auto prepare_statement(sqlite3 &db3, std::string sql,
+                                     db3_stmt_t &stmt) -> std::int32_t;
+
 [[nodiscard]] auto
 create_db(std::string db_path,
           const std::map<std::string, std::string> &sql_create_tables) -> db3_t;
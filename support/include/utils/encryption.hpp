@@ -431,6 +431,64 @@ encrypt_data(const std::array<unsigned char,
                          buf.size(), res);
 }
 
+template <typename arr_t, std::size_t arr_size>
+[[nodiscard]] inline auto
+decrypt_data_in_place(const std::array<arr_t, arr_size> &key, data_buffer &buf,
+                      std::size_t offset = 0U) -> bool {
+  if (offset > buf.size() ||
+      (buf.size() - offset) <= encryption_header_size) {
+    return false;
+  }
+
+  auto *data = &buf[offset];
+  std::uint32_t size = boost::endian::native_to_big(
+      static_cast<std::uint32_t>(buf.size() - offset));
+  if (crypto_aead_xchacha20poly1305_ietf_decrypt_detached(
+          &data[encryption_header_size], nullptr,
+          &data[encryption_header_size],
+          buf.size() - offset - encryption_header_size,
+          &data[crypto_aead_xchacha20poly1305_IETF_NPUBBYTES],
+          reinterpret_cast<const unsigned char *>(&size), sizeof(size), data,
+          key.data()) != 0) {
+    return false;
+  }
+
+  buf.erase(buf.begin(),
+            std::next(buf.begin(),
+                      static_cast<std::ptrdiff_t>(offset +
+                                                  encryption_header_size)));
+  return true;
+}
+
+template <typename arr_t, std::size_t arr_size>
+inline void encrypt_data_in_place(const std::array<arr_t, arr_size> &key,
+                                  data_buffer &buf) {
+  REPERTORY_USES_FUNCTION_NAME();
+
+  auto data_size = buf.size();
+  buf.insert(buf.begin(), encryption_header_size, 0U);
+
+  std::array<unsigned char, crypto_aead_xchacha20poly1305_IETF_NPUBBYTES> iv{};
+  randombytes_buf(iv.data(), iv.size());
+
+  const std::uint32_t size =
+      boost::endian::native_to_big(static_cast<std::uint32_t>(buf.size()));
+
+  unsigned long long mac_length{};
+  if (crypto_aead_xchacha20poly1305_ietf_encrypt_detached(
+          &buf[encryption_header_size], &buf[iv.size()], &mac_length,
+          &buf[encryption_header_size], data_size,
+          reinterpret_cast<const unsigned char *>(&size), sizeof(size), nullptr,
+          iv.data(), key.data()) != 0) {
+    throw repertory::utils::error::create_exception(function_name,
+                                                    {
+                                                        "encryption failed",
+                                                    });
+  }
+
+  std::memcpy(buf.data(), iv.data(), iv.size());
+}
+
 using reader_func_t =
     std::function<bool(data_buffer &cypher_text, std::uint64_t start_offset,
                        std::uint64_t end_offset)>;
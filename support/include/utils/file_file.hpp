@@ -26,6 +26,10 @@
 
 namespace repertory::utils::file {
 class file final : public i_file {
+public:
+  static constexpr std::size_t direct_io_alignment{4096U};
+  static constexpr std::size_t direct_io_min_size{1024U * 1024U};
+
 public:
   // [[nodiscard]] static auto
   // attach_file(native_handle handle,
@@ -71,7 +75,12 @@ public:
   file(file &&move_file) noexcept
       : file_(std::move(move_file.file_)),
         path_(std::move(move_file.path_)),
-        read_only_(move_file.read_only_) {}
+        read_only_(move_file.read_only_) {
+#if defined(__linux__)
+    direct_fd_ = std::exchange(move_file.direct_fd_, -1);
+    direct_io_ = move_file.direct_io_;
+#endif // defined(__linux__)
+  }
 
   ~file() override { close(); }
 
@@ -83,10 +92,35 @@ private:
 private:
   std::atomic_uint32_t read_buffer_size{65536U};
 
+#if defined(__linux__)
 private:
+  int direct_fd_{-1};
+  bool direct_io_{false};
+#endif // defined(__linux__)
+
+private:
+#if defined(__linux__)
+  void close_direct();
+
+  // Returns false when the buffer or range is not eligible for O_DIRECT or the
+  // transfer fails, in which case the caller falls back to buffered I/O
+  [[nodiscard]] auto direct_read(unsigned char *data, std::size_t to_read,
+                                 std::uint64_t offset,
+                                 std::size_t &bytes_read) const -> bool;
+
+  [[nodiscard]] auto direct_write(const unsigned char *data,
+                                  std::size_t to_write, std::uint64_t offset,
+                                  std::size_t &bytes_written) const -> bool;
+
+  void open_direct();
+#endif // defined(__linux__)
+
   void open();
 
 public:
+  auto advise(file_advice advice, std::uint64_t offset = 0U,
+              std::uint64_t size = 0U) const -> bool override;
+
   void close() override;
 
   [[nodiscard]] auto copy_to(std::string_view new_path,
@@ -104,6 +138,8 @@ public:
     return read_buffer_size;
   }
 
+  [[nodiscard]] auto is_direct_io() const -> bool override;
+
   [[nodiscard]] auto is_read_only() const -> bool override {
     return read_only_;
   }
@@ -112,12 +148,17 @@ public:
 
   [[nodiscard]] auto move_to(std::string_view new_path) -> bool override;
 
+  [[nodiscard]] auto preallocate(std::uint64_t offset,
+                                 std::uint64_t size) -> bool override;
+
   [[nodiscard]] auto read(unsigned char *data, std::size_t to_read,
                           std::uint64_t offset,
                           std::size_t *total_read = nullptr) -> bool override;
 
   [[nodiscard]] auto remove() -> bool override;
 
+  auto set_direct_io(bool enable) -> bool override;
+
   auto set_read_buffer_size(std::uint32_t size) -> std::uint32_t override {
     read_buffer_size = size;
     return read_buffer_size;
@@ -144,6 +185,11 @@ public:
       file_ = std::move(move_file.file_);
       path_ = std::move(move_file.path_);
       read_only_ = move_file.read_only_;
+#if defined(__linux__)
+      close_direct();
+      direct_fd_ = std::exchange(move_file.direct_fd_, -1);
+      direct_io_ = move_file.direct_io_;
+#endif // defined(__linux__)
     }
 
     return *this;
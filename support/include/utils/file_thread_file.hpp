@@ -106,6 +106,11 @@ private:
   void thread_func() const;
 
 public:
+  auto advise(file_advice advice, std::uint64_t offset = 0U,
+              std::uint64_t size = 0U) const -> bool override {
+    return file_->advise(advice, offset, size);
+  }
+
   void close() override;
 
   [[nodiscard]] auto copy_to(std::string_view new_path,
@@ -132,6 +137,10 @@ public:
     return file_->get_time(type);
   }
 
+  [[nodiscard]] auto is_direct_io() const -> bool override {
+    return file_->is_direct_io();
+  }
+
   [[nodiscard]] auto is_read_only() const -> bool override {
     return file_->is_read_only();
   }
@@ -142,12 +151,17 @@ public:
 
   [[nodiscard]] auto move_to(std::string_view new_path) -> bool override;
 
+  [[nodiscard]] auto preallocate(std::uint64_t offset,
+                                 std::uint64_t size) -> bool override;
+
   [[nodiscard]] auto read(unsigned char *data, std::size_t to_read,
                           std::uint64_t offset,
                           std::size_t *total_read = nullptr) -> bool override;
 
   [[nodiscard]] auto remove() -> bool override;
 
+  auto set_direct_io(bool enable) -> bool override;
+
   auto set_read_buffer_size(std::uint32_t size) -> std::uint32_t override {
     return file_->set_read_buffer_size(size);
   }
@@ -27,11 +27,26 @@
 #include "utils/types/file/i_fs_item.hpp"
 
 namespace repertory::utils::file {
+enum class file_advice {
+  dont_need,
+  normal,
+  random,
+  sequential,
+  will_need,
+};
+
 struct i_file : public i_fs_item {
   using fs_file_t = std::unique_ptr<i_file>;
 
   virtual ~i_file() = default;
 
+  // Hints the expected access pattern for a range; a size of 0 extends to the
+  // end of the file. Implementations without support ignore the hint.
+  virtual auto advise(file_advice /* advice */, std::uint64_t /* offset */ = 0U,
+                      std::uint64_t /* size */ = 0U) const -> bool {
+    return true;
+  }
+
   virtual void close() = 0;
 
   virtual void flush() const = 0;
@@ -40,12 +55,20 @@ struct i_file : public i_fs_item {
 
   [[nodiscard]] virtual auto get_read_buffer_size() const -> std::uint32_t = 0;
 
+  [[nodiscard]] virtual auto is_direct_io() const -> bool { return false; }
+
   [[nodiscard]] auto is_directory_item() const -> bool override {
     return false;
   }
 
   [[nodiscard]] virtual auto is_read_only() const -> bool = 0;
 
+  // Reserves disk space for a range without changing the file size
+  [[nodiscard]] virtual auto preallocate(std::uint64_t /* offset */,
+                                         std::uint64_t /* size */) -> bool {
+    return false;
+  }
+
   [[nodiscard]] virtual auto read(data_buffer &data, std::uint64_t offset,
                                   std::size_t *total_read = nullptr) -> bool {
     return read(data.data(), data.size(), offset, total_read);
@@ -59,6 +82,10 @@ struct i_file : public i_fs_item {
   read_all(data_buffer &data, std::uint64_t offset,
            std::size_t *total_read = nullptr) -> bool;
 
+  // Large transfers from aligned buffers bypass the page cache while enabled;
+  // returns whether direct I/O is now active
+  virtual auto set_direct_io(bool /* enable */) -> bool { return false; }
+
   virtual auto set_read_buffer_size(std::uint32_t size) -> std::uint32_t = 0;
 
   [[nodiscard]] virtual auto size() const -> std::optional<std::uint64_t> = 0;
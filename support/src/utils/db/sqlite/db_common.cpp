@@ -26,6 +26,13 @@
 #include "utils/common.hpp"
 #include "utils/error.hpp"
 
+namespace {
+using statement_list_t = std::deque<std::pair<std::string, sqlite3_stmt *>>;
+
+std::mutex statement_cache_mtx;
+std::unordered_map<sqlite3 *, statement_list_t> statement_cache;
+} // namespace
+
 namespace repertory::utils::db::sqlite {
 void sqlite3_deleter::operator()(sqlite3 *db3) const {
   REPERTORY_USES_FUNCTION_NAME();
@@ -34,6 +41,8 @@ void sqlite3_deleter::operator()(sqlite3 *db3) const {
     return;
   }
 
+  clear_statement_cache(*db3);
+
   std::string err_msg;
   if (not execute_sql(*db3, "VACUUM;", err_msg)) {
     utils::error::handle_error(function_name,
@@ -63,6 +72,39 @@ void sqlite3_deleter::operator()(sqlite3 *db3) const {
   }
 }
 
+void sqlite3_statement_deleter::operator()(sqlite3_stmt *stmt) const {
+  if (stmt == nullptr) {
+    return;
+  }
+
+  if (sql.empty()) {
+    sqlite3_finalize(stmt);
+    return;
+  }
+
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+
+  sqlite3_stmt *evicted{nullptr};
+  {
+    mutex_lock lock(statement_cache_mtx);
+    auto iter = statement_cache.find(sqlite3_db_handle(stmt));
+    if (iter == statement_cache.end()) {
+      evicted = stmt;
+    } else {
+      iter->second.emplace_front(sql, stmt);
+      if (iter->second.size() > max_cached_statements) {
+        evicted = iter->second.back().second;
+        iter->second.pop_back();
+      }
+    }
+  }
+
+  if (evicted != nullptr) {
+    sqlite3_finalize(evicted);
+  }
+}
+
 db_result::db_column::db_column(std::int32_t index, std::string name,
                                 db_types_t value) noexcept
     : index_(index), name_(std::move(name)), value_(std::move(value)) {}
@@ -74,6 +116,9 @@ auto db_result::db_column::get_value_as_json() const -> nlohmann::json {
           [this](std::int64_t value) -> auto {
             return nlohmann::json({{name_, value}});
           },
+          [this](const data_buffer &value) -> auto {
+            return nlohmann::json({{name_, value}});
+          },
           [](auto &&value) -> auto { return nlohmann::json::parse(value); },
       },
       value_);
@@ -100,6 +145,19 @@ db_result::db_row::db_row(std::shared_ptr<context> ctx) {
       value = std::string(text == nullptr ? "" : text);
     } break;
 
+    case SQLITE_BLOB: {
+      const auto *blob = reinterpret_cast<const unsigned char *>(
+          sqlite3_column_blob(ctx->stmt.get(), col));
+      value = blob == nullptr
+                  ? data_buffer{}
+                  : data_buffer(blob,
+                                std::next(blob, sqlite3_column_bytes(
+                                                    ctx->stmt.get(), col)));
+    } break;
+
+    case SQLITE_NULL:
+      continue;
+
     default:
       throw utils::error::create_exception(function_name,
                                            {
@@ -213,6 +271,24 @@ auto create_db(std::string db_path,
   return db3;
 }
 
+void clear_statement_cache(sqlite3 &db3) {
+  statement_list_t statements;
+  {
+    mutex_lock lock(statement_cache_mtx);
+    auto iter = statement_cache.find(&db3);
+    if (iter == statement_cache.end()) {
+      return;
+    }
+
+    statements = std::move(iter->second);
+    statement_cache.erase(iter);
+  }
+
+  for (auto &&item : statements) {
+    sqlite3_finalize(item.second);
+  }
+}
+
 auto execute_sql(sqlite3 &db3, const std::string &sql, std::string &err)
     -> bool {
   REPERTORY_USES_FUNCTION_NAME();
@@ -239,6 +315,42 @@ auto execute_sql(sqlite3 &db3, const std::string &sql, std::string &err)
   return false;
 }
 
+auto get_cached_statement_count(sqlite3 &db3) -> std::size_t {
+  mutex_lock lock(statement_cache_mtx);
+  auto iter = statement_cache.find(&db3);
+  return iter == statement_cache.end() ? 0U : iter->second.size();
+}
+
+auto prepare_statement(sqlite3 &db3, std::string sql, db3_stmt_t &stmt)
+    -> std::int32_t {
+  {
+    mutex_lock lock(statement_cache_mtx);
+    auto &statements = statement_cache[&db3];
+    auto iter = std::find_if(
+        statements.begin(), statements.end(),
+        [&sql](auto &&item) -> bool { return item.first == sql; });
+    if (iter != statements.end()) {
+      stmt = db3_stmt_t{
+          iter->second,
+          sqlite3_statement_deleter{std::move(sql)},
+      };
+      statements.erase(iter);
+      return SQLITE_OK;
+    }
+  }
+
+  sqlite3_stmt *stmt_ptr{nullptr};
+  auto res = sqlite3_prepare_v3(&db3, sql.c_str(), -1,
+                                SQLITE_PREPARE_PERSISTENT, &stmt_ptr, nullptr);
+  stmt = db3_stmt_t{
+      stmt_ptr,
+      sqlite3_statement_deleter{
+          res == SQLITE_OK ? std::move(sql) : std::string{},
+      },
+  };
+  return res;
+}
+
 void set_journal_mode(sqlite3 &db3) {
   sqlite3_exec(&db3,
                "PRAGMA journal_mode = WAL;PRAGMA synchronous = NORMAL;PRAGMA "
@@ -60,15 +60,8 @@ auto db_insert::dump() const -> std::string {
 }
 
 auto db_insert::go() const -> db_result {
-  sqlite3_stmt *stmt_ptr{nullptr};
-  auto query_str = dump();
-  auto res =
-      sqlite3_prepare_v2(ctx_->db3, query_str.c_str(), -1, &stmt_ptr, nullptr);
-
-  auto stmt = db3_stmt_t{
-      stmt_ptr,
-      sqlite3_statement_deleter(),
-  };
+  db3_stmt_t stmt;
+  auto res = prepare_statement(*ctx_->db3, dump(), stmt);
 
   if (res != SQLITE_OK) {
     return {std::move(stmt), res};
@@ -85,6 +78,11 @@ auto db_insert::go() const -> db_result {
                          return sqlite3_bind_text(stmt.get(), idx + 1,
                                                   data.c_str(), -1, nullptr);
                        },
+                       [&idx, &stmt](const data_buffer &data) -> std::int32_t {
+                         return sqlite3_bind_blob(
+                             stmt.get(), idx + 1, data.data(),
+                             static_cast<std::int32_t>(data.size()), nullptr);
+                       },
                    },
                    std::next(ctx_->values.begin(), idx)->second);
     if (res != SQLITE_OK) {
@@ -252,27 +252,78 @@ read_encrypted_range(http_range range, const utils::hash::hash_256_t &key,
 
   auto start_chunk = static_cast<std::size_t>(range.begin / data_chunk_size);
   auto end_chunk = static_cast<std::size_t>(range.end / data_chunk_size);
-  auto remain = range.end - range.begin + 1U;
-  auto source_offset = static_cast<std::size_t>(range.begin % data_chunk_size);
+  auto chunk_count = end_chunk - start_chunk + 1U;
+
+  auto get_start_offset = [&](std::size_t chunk) -> std::uint64_t {
+    return (chunk * encrypted_chunk_size) + file_header_size;
+  };
 
-  for (std::size_t chunk = start_chunk; chunk <= end_chunk; chunk++) {
-    data_buffer cipher;
-    auto start_offset = (chunk * encrypted_chunk_size) + file_header_size;
-    auto end_offset = std::min(
+  auto get_end_offset = [&](std::size_t chunk) -> std::uint64_t {
+    auto start_offset = get_start_offset(chunk);
+    return std::min(
         start_offset + (total_size - (chunk * data_chunk_size)) +
             encryption_header_size - 1U,
         static_cast<std::uint64_t>(start_offset + encrypted_chunk_size - 1U));
+  };
 
-    if (not reader_func(cipher, start_offset, end_offset)) {
-      return false;
+  // Fetch the cipher text for every chunk in the range with a single request
+  auto cipher_begin = get_start_offset(start_chunk);
+  auto cipher_end = get_end_offset(end_chunk);
+
+  data_buffer cipher;
+  if (not reader_func(cipher, cipher_begin, cipher_end)) {
+    return false;
+  }
+
+  if (cipher.size() !=
+      static_cast<std::size_t>(cipher_end - cipher_begin + 1U)) {
+    return false;
+  }
+
+  std::vector<data_buffer> source_buffers(chunk_count);
+  auto decrypt_chunk = [&](std::size_t idx) -> bool {
+    auto chunk = start_chunk + idx;
+    auto offset =
+        static_cast<std::size_t>(get_start_offset(chunk) - cipher_begin);
+    auto size = static_cast<std::size_t>(get_end_offset(chunk) -
+                                         get_start_offset(chunk) + 1U);
+    return utils::encryption::decrypt_data(key, &cipher.at(offset), size,
+                                           source_buffers.at(idx));
+  };
+
+  auto max_count = static_cast<std::size_t>(
+      std::max(1U, std::thread::hardware_concurrency()));
+  if (chunk_count == 1U || max_count == 1U) {
+    for (std::size_t idx = 0U; idx < chunk_count; ++idx) {
+      if (not decrypt_chunk(idx)) {
+        return false;
+      }
+    }
+  } else {
+    auto success{true};
+    std::deque<std::future<bool>> active;
+    for (std::size_t idx = 0U; idx < chunk_count; ++idx) {
+      if (active.size() >= max_count) {
+        success = active.front().get() && success;
+        active.pop_front();
+      }
+
+      active.emplace_back(std::async(std::launch::async, decrypt_chunk, idx));
+    }
+
+    for (auto &item : active) {
+      success = item.get() && success;
     }
 
-    data_buffer source_buffer;
-    if (not utils::encryption::decrypt_data(key, cipher, source_buffer)) {
+    if (not success) {
       return false;
     }
-    cipher.clear();
+  }
+  cipher.clear();
 
+  auto remain = range.end - range.begin + 1U;
+  auto source_offset = static_cast<std::size_t>(range.begin % data_chunk_size);
+  for (auto &source_buffer : source_buffers) {
     auto data_size = static_cast<std::size_t>(std::min(
         remain, static_cast<std::uint64_t>(data_chunk_size - source_offset)));
     std::copy(std::next(source_buffer.begin(),
@@ -60,6 +60,51 @@ namespace {
           not S_ISDIR(u_stat.st_mode));
 #endif // defined(_WIN32)
 }
+
+#if !defined(_WIN32)
+// pread()/pwrite() leave the shared file position alone, so non-overlapping
+// transfers on the same handle can run concurrently
+template <typename data_t, typename operation_t>
+[[nodiscard]] auto positional_io(int handle, data_t *data, std::size_t size,
+                                 std::uint64_t offset, operation_t &&operation,
+                                 std::size_t &total) -> bool {
+  total = 0U;
+  while (total != size) {
+    auto res = operation(handle, &data[total], size - total,
+                         static_cast<off_t>(offset + total));
+    if (res == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return false;
+    }
+
+    if (res == 0) {
+      break;
+    }
+
+    total += static_cast<std::size_t>(res);
+  }
+
+  return true;
+}
+#endif // !defined(_WIN32)
+
+#if defined(__linux__)
+// Copying through an aligned bounce buffer would cost more than the page
+// cache saves, so only caller buffers that are already aligned qualify
+[[nodiscard]] auto is_direct_io_eligible(const unsigned char *data,
+                                         std::size_t size,
+                                         std::uint64_t offset) -> bool {
+  using repertory::utils::file::file;
+  return size >= file::direct_io_min_size &&
+         (size % file::direct_io_alignment) == 0U &&
+         (offset % file::direct_io_alignment) == 0U &&
+         (reinterpret_cast<std::uintptr_t>(data) % file::direct_io_alignment) ==
+             0U;
+}
+#endif // defined(__linux__)
 } // namespace
 
 namespace repertory::utils::file {
@@ -112,6 +157,81 @@ namespace repertory::utils::file {
 //   return nullptr;
 // }
 
+auto file::advise(file_advice advice, std::uint64_t offset,
+                  std::uint64_t size) const -> bool {
+#if defined(__linux__)
+  if (not file_) {
+    return false;
+  }
+
+  auto value{POSIX_FADV_NORMAL};
+  switch (advice) {
+  case file_advice::dont_need:
+    value = POSIX_FADV_DONTNEED;
+    break;
+  case file_advice::normal:
+    value = POSIX_FADV_NORMAL;
+    break;
+  case file_advice::random:
+    value = POSIX_FADV_RANDOM;
+    break;
+  case file_advice::sequential:
+    value = POSIX_FADV_SEQUENTIAL;
+    break;
+  case file_advice::will_need:
+    value = POSIX_FADV_WILLNEED;
+    break;
+  }
+
+  return posix_fadvise(fileno(file_.get()), static_cast<off_t>(offset),
+                       static_cast<off_t>(size), value) == 0;
+#else  // !defined(__linux__)
+  return true;
+#endif // defined(__linux__)
+}
+
+#if defined(__linux__)
+void file::close_direct() {
+  if (direct_fd_ != -1) {
+    ::close(direct_fd_);
+    direct_fd_ = -1;
+  }
+}
+
+auto file::direct_read(unsigned char *data, std::size_t to_read,
+                       std::uint64_t offset, std::size_t &bytes_read) const
+    -> bool {
+  if (direct_fd_ == -1 || not is_direct_io_eligible(data, to_read, offset)) {
+    return false;
+  }
+
+  return positional_io(direct_fd_, data, to_read, offset, ::pread, bytes_read);
+}
+
+auto file::direct_write(const unsigned char *data, std::size_t to_write,
+                        std::uint64_t offset, std::size_t &bytes_written) const
+    -> bool {
+  if (direct_fd_ == -1 || not is_direct_io_eligible(data, to_write, offset)) {
+    return false;
+  }
+
+  return positional_io(direct_fd_, data, to_write, offset, ::pwrite,
+                       bytes_written);
+}
+
+void file::open_direct() {
+  close_direct();
+  if (not direct_io_ || not file_) {
+    return;
+  }
+
+  // Filesystems without O_DIRECT support reject the open; transfers then stay
+  // buffered
+  direct_fd_ = ::open(path_.c_str(),
+                      (read_only_ ? O_RDONLY : O_RDWR) | O_DIRECT | O_CLOEXEC);
+}
+#endif // defined(__linux__)
+
 void file::open() {
   REPERTORY_USES_FUNCTION_NAME();
 
@@ -133,6 +253,10 @@ void file::open() {
       file_deleter(),
   };
 #endif // defined(_WIN32)
+
+#if defined(__linux__)
+  open_direct();
+#endif // defined(__linux__)
 }
 
 auto file::open_file(std::string_view path, bool read_only) -> fs_file_t {
@@ -187,7 +311,13 @@ auto file::open_or_create_file(std::string_view path, bool read_only)
   return open_file(abs_path, read_only);
 }
 
-void file::close() { file_.reset(); }
+void file::close() {
+#if defined(__linux__)
+  close_direct();
+#endif // defined(__linux__)
+
+  file_.reset();
+}
 
 auto file::copy_to(std::string_view new_path, bool overwrite) const -> bool {
   REPERTORY_USES_FUNCTION_NAME();
@@ -237,6 +367,14 @@ auto file::get_handle() const -> native_handle {
   return INVALID_HANDLE_VALUE;
 }
 
+auto file::is_direct_io() const -> bool {
+#if defined(__linux__)
+  return direct_fd_ != -1;
+#else  // !defined(__linux__)
+  return false;
+#endif // defined(__linux__)
+}
+
 auto file::is_symlink() const -> bool {
   REPERTORY_USES_FUNCTION_NAME();
 
@@ -290,6 +428,25 @@ auto file::move_to(std::string_view path) -> bool {
   return false;
 }
 
+auto file::preallocate(std::uint64_t offset, std::uint64_t size) -> bool {
+#if defined(__linux__)
+  if (not file_ || read_only_) {
+    return false;
+  }
+
+  while (fallocate(fileno(file_.get()), FALLOC_FL_KEEP_SIZE,
+                   static_cast<off_t>(offset), static_cast<off_t>(size)) != 0) {
+    if (errno != EINTR) {
+      return false;
+    }
+  }
+
+  return true;
+#else  // !defined(__linux__)
+  return false;
+#endif // defined(__linux__)
+}
+
 auto file::read(unsigned char *data, std::size_t to_read, std::uint64_t offset,
                 std::size_t *total_read) -> bool {
   REPERTORY_USES_FUNCTION_NAME();
@@ -307,6 +464,8 @@ auto file::read(unsigned char *data, std::size_t to_read, std::uint64_t offset,
                                            });
     }
 
+    std::size_t bytes_read{0U};
+#if defined(_WIN32)
     if (fseeko(file_.get(), static_cast<std::int64_t>(offset), SEEK_SET) ==
         -1) {
       throw utils::error::create_exception(function_name,
@@ -316,7 +475,6 @@ auto file::read(unsigned char *data, std::size_t to_read, std::uint64_t offset,
                                            });
     }
 
-    std::size_t bytes_read{0U};
     while (bytes_read != to_read) {
       auto res =
           fread(&data[bytes_read], 1U, to_read - bytes_read, file_.get());
@@ -334,6 +492,23 @@ auto file::read(unsigned char *data, std::size_t to_read, std::uint64_t offset,
 
       bytes_read += static_cast<std::size_t>(res);
     }
+#else  // !defined(_WIN32)
+    auto transferred{false};
+#if defined(__linux__)
+    transferred = direct_read(data, to_read, offset, bytes_read);
+#endif // defined(__linux__)
+
+    if (not transferred &&
+        not positional_io(fileno(file_.get()), data, to_read, offset, ::pread,
+                          bytes_read)) {
+      throw utils::error::create_exception(function_name,
+                                           {
+                                               "failed to read file bytes",
+                                               std::to_string(errno),
+                                               path_,
+                                           });
+    }
+#endif // defined(_WIN32)
 
     if (total_read != nullptr) {
       (*total_read) = bytes_read;
@@ -458,6 +633,15 @@ auto file::remove() -> bool {
   });
 }
 
+auto file::set_direct_io([[maybe_unused]] bool enable) -> bool {
+#if defined(__linux__)
+  direct_io_ = enable;
+  open_direct();
+#endif // defined(__linux__)
+
+  return is_direct_io();
+}
+
 auto file::truncate(std::size_t size) -> bool {
   REPERTORY_USES_FUNCTION_NAME();
 
@@ -504,6 +688,8 @@ auto file::write(const unsigned char *data, std::size_t to_write,
                                            });
     }
 
+    std::size_t bytes_written{0U};
+#if defined(_WIN32)
     auto res = fseeko(file_.get(), static_cast<std::int64_t>(offset), SEEK_SET);
     if (res == -1) {
       throw utils::error::create_exception(function_name,
@@ -513,7 +699,6 @@ auto file::write(const unsigned char *data, std::size_t to_write,
                                            });
     }
 
-    std::size_t bytes_written{0U};
     while (bytes_written != to_write) {
       auto written =
           fwrite(reinterpret_cast<const char *>(&data[bytes_written]), 1U,
@@ -534,6 +719,23 @@ auto file::write(const unsigned char *data, std::size_t to_write,
     }
 
     flush();
+#else  // !defined(_WIN32)
+    auto transferred{false};
+#if defined(__linux__)
+    transferred = direct_write(data, to_write, offset, bytes_written);
+#endif // defined(__linux__)
+
+    if (not transferred &&
+        not positional_io(fileno(file_.get()), data, to_write, offset, ::pwrite,
+                          bytes_written)) {
+      throw utils::error::create_exception(function_name,
+                                           {
+                                               "failed to write file bytes",
+                                               std::to_string(errno),
+                                               path_,
+                                           });
+    }
+#endif // defined(_WIN32)
 
     if (total_written != nullptr) {
       (*total_written) = bytes_written;
@@ -554,6 +756,19 @@ auto file::size() const -> std::optional<std::uint64_t> {
 
   try {
     if (file_) {
+#if !defined(_WIN32)
+      struct stat64 u_stat{};
+      if (fstat64(fileno(file_.get()), &u_stat) == -1) {
+        throw utils::error::create_exception(function_name,
+                                             {
+                                                 "failed to get file size",
+                                                 std::to_string(errno),
+                                                 path_,
+                                             });
+      }
+
+      return static_cast<std::uint64_t>(u_stat.st_size);
+#else  // defined(_WIN32)
       if (fseeko(file_.get(), 0, SEEK_END) == -1) {
         throw utils::error::create_exception(function_name,
                                              {
@@ -572,6 +787,7 @@ auto file::size() const -> std::optional<std::uint64_t> {
       }
 
       return static_cast<std::uint64_t>(size);
+#endif // !defined(_WIN32)
     }
 
     std::uint64_t size{};
@@ -125,6 +125,13 @@ auto thread_file::move_to(std::string_view path) -> bool {
   return do_io([this, &path]() -> bool { return file_->move_to(path); });
 }
 
+auto thread_file::preallocate(std::uint64_t offset, std::uint64_t size)
+    -> bool {
+  return do_io([this, &offset, &size]() -> bool {
+    return file_->preallocate(offset, size);
+  });
+}
+
 auto thread_file::read(unsigned char *data, std::size_t to_read,
                        std::uint64_t offset, std::size_t *total_read) -> bool {
   return do_io([this, &data, &to_read, &offset, &total_read]() -> bool {
@@ -136,6 +143,11 @@ auto thread_file::remove() -> bool {
   return do_io([this]() -> bool { return file_->remove(); });
 }
 
+auto thread_file::set_direct_io(bool enable) -> bool {
+  return do_io(
+      [this, &enable]() -> bool { return file_->set_direct_io(enable); });
+}
+
 void thread_file::thread_func() const {
   unique_mutex_lock lock(*mtx_);
   notify_->notify_all();
@@ -295,6 +295,90 @@ TEST_F(utils_db_sqlite, insert_or_replace_and_delete) {
 
   common_delete(*db3.get());
 }
+
+TEST_F(utils_db_sqlite, prepared_statements_are_cached_and_reused) {
+  common_insert(*db3.get());
+
+  utils::db::sqlite::clear_statement_cache(*db3.get());
+  EXPECT_EQ(0U, utils::db::sqlite::get_cached_statement_count(*db3.get()));
+
+  const auto select_column2 = [this](std::string value) {
+    return utils::db::sqlite::db_select{*db3.get(), "table"}
+        .column("column2")
+        .where("column1")
+        .equals(value)
+        .go();
+  };
+
+  {
+    auto res = select_column2("test0");
+    EXPECT_TRUE(res.has_row());
+    EXPECT_EQ(0U, utils::db::sqlite::get_cached_statement_count(*db3.get()));
+  }
+  EXPECT_EQ(1U, utils::db::sqlite::get_cached_statement_count(*db3.get()));
+
+  {
+    auto res = select_column2("test1");
+    EXPECT_FALSE(res.has_row());
+    EXPECT_EQ(0U, utils::db::sqlite::get_cached_statement_count(*db3.get()));
+  }
+  EXPECT_EQ(1U, utils::db::sqlite::get_cached_statement_count(*db3.get()));
+
+  {
+    auto res = select_column2("test0");
+    std::optional<utils::db::sqlite::db_result::row> row;
+    EXPECT_TRUE(res.get_row(row));
+    EXPECT_TRUE(row.has_value());
+    if (row.has_value()) {
+      EXPECT_STREQ("test1",
+                   row->get_column("column2").get_value<std::string>().c_str());
+    }
+  }
+
+  common_delete(*db3.get());
+}
+
+TEST_F(utils_db_sqlite, statement_cache_is_bounded) {
+  utils::db::sqlite::clear_statement_cache(*db3.get());
+
+  for (std::size_t idx = 0U;
+       idx < utils::db::sqlite::max_cached_statements + 10U; ++idx) {
+    auto res = utils::db::sqlite::db_select{*db3.get(), "table"}
+                   .limit(static_cast<std::int32_t>(idx + 1U))
+                   .go();
+    EXPECT_TRUE(res.ok());
+  }
+
+  EXPECT_EQ(utils::db::sqlite::max_cached_statements,
+            utils::db::sqlite::get_cached_statement_count(*db3.get()));
+}
+
+TEST_F(utils_db_sqlite, insert_and_select_blob) {
+  data_buffer blob{0x00U, 0x01U, 0xFFU, 0x00U, 0x7BU};
+  {
+    auto query = utils::db::sqlite::db_insert{*db3.get(), "table"}
+                     .column_value("column1", "test0")
+                     .column_value("column2", blob);
+    auto res = query.go();
+    EXPECT_TRUE(res.ok());
+  }
+
+  {
+    auto res = utils::db::sqlite::db_select{*db3.get(), "table"}
+                   .column("column2")
+                   .where("column1")
+                   .equals("test0")
+                   .go();
+    std::optional<utils::db::sqlite::db_result::row> row;
+    EXPECT_TRUE(res.get_row(row));
+    EXPECT_TRUE(row.has_value());
+    if (row.has_value()) {
+      EXPECT_EQ(blob, row->get_column("column2").get_value<data_buffer>());
+    }
+  }
+
+  common_delete(*db3.get());
+}
 } // namespace repertory
 
 #endif // defined(PROJECT_ENABLE_SQLITE)
@@ -442,6 +442,51 @@ TEST_P(utils_encryption_read_encrypted_range_fixture,
                          plain.begin() + static_cast<std::ptrdiff_t>(begin)));
 }
 
+TEST_P(utils_encryption_read_encrypted_range_fixture,
+       multi_chunk_span_is_read_with_one_request) {
+  std::size_t call_count = 0U;
+  auto counting_reader = [this, &call_count](data_buffer &out,
+                                             std::uint64_t start,
+                                             std::uint64_t end) -> bool {
+    ++call_count;
+    return reader(out, start, end);
+  };
+
+  http_range range{0U, static_cast<std::uint64_t>(plain_sz - 1U)};
+  data_buffer out;
+
+  ASSERT_TRUE(utils::encryption::read_encrypted_range(
+      range, key, uses_kdf, counting_reader, total_size, out));
+  EXPECT_EQ(call_count, 1U);
+  EXPECT_EQ(out, plain);
+}
+
+TEST_P(utils_encryption_read_encrypted_range_fixture,
+       corrupt_chunk_fails_without_partial_data) {
+  auto encrypted_chunk =
+      utils::encryption::encrypting_reader::get_encrypted_chunk_size();
+  auto header_size = uses_kdf ? utils::encryption::kdf_config::size() : 0U;
+  cipher_blob.at(header_size + encrypted_chunk + 100U) ^= 0xFFU;
+
+  http_range range{0U, static_cast<std::uint64_t>(plain_sz - 1U)};
+
+  {
+    data_buffer out;
+    EXPECT_FALSE(utils::encryption::read_encrypted_range(
+        range, key, uses_kdf, reader, total_size, out));
+    EXPECT_TRUE(out.empty());
+  }
+
+  {
+    std::vector<unsigned char> buf(plain_sz);
+    std::size_t bytes_read = 0U;
+    EXPECT_FALSE(utils::encryption::read_encrypted_range(
+        range, key, uses_kdf, reader, total_size, buf.data(), buf.size(),
+        bytes_read));
+    EXPECT_EQ(bytes_read, 0U);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(no_kdf_and_kdf,
                          utils_encryption_read_encrypted_range_fixture,
                          ::testing::Values(false, true));
@@ -124,6 +124,115 @@ TEST(utils_file, write_fails_for_read_only_file) {
   }
 }
 
+TEST(utils_file, concurrent_reads_and_writes_use_independent_offsets) {
+  static constexpr std::size_t block_size{65536U};
+  static constexpr std::size_t thread_count{8U};
+
+  auto path = test::generate_test_file_name("utils_file");
+  auto file{utils::file::file::open_or_create_file(path)};
+  ASSERT_TRUE(*file);
+
+  const auto run_threads = [](auto &&action) {
+    std::vector<std::thread> threads;
+    for (std::size_t idx = 0U; idx < thread_count; ++idx) {
+      threads.emplace_back([&action, idx]() { action(idx); });
+    }
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  };
+
+  run_threads([&file](std::size_t idx) {
+    data_buffer data(block_size, static_cast<unsigned char>(idx + 1U));
+    std::size_t bytes_written{};
+    EXPECT_TRUE(file->write(data, idx * block_size, &bytes_written));
+    EXPECT_EQ(block_size, bytes_written);
+  });
+
+  EXPECT_EQ(block_size * thread_count, file->size().value_or(0U));
+
+  run_threads([&file](std::size_t idx) {
+    data_buffer data(block_size);
+    std::size_t bytes_read{};
+    EXPECT_TRUE(file->read(data, idx * block_size, &bytes_read));
+    EXPECT_EQ(block_size, bytes_read);
+    EXPECT_EQ(data_buffer(block_size, static_cast<unsigned char>(idx + 1U)),
+              data);
+  });
+
+  EXPECT_TRUE(file->remove());
+}
+
+TEST(utils_file, preallocate_does_not_change_size) {
+  auto path = test::generate_test_file_name("utils_file");
+  auto file{utils::file::file::open_or_create_file(path)};
+  ASSERT_TRUE(*file);
+
+  std::ignore = file->preallocate(0U, 1024U * 1024U);
+  EXPECT_EQ(0U, file->size().value_or(1U));
+
+  EXPECT_TRUE(file->advise(utils::file::file_advice::sequential));
+  EXPECT_TRUE(file->remove());
+}
+
+TEST(utils_file, direct_io_transfers_match_buffered_io) {
+  auto path = test::generate_test_file_name("utils_file");
+  auto file{utils::file::file::open_or_create_file(path)};
+  ASSERT_TRUE(*file);
+
+  if (not file->set_direct_io(true)) {
+    EXPECT_FALSE(file->is_direct_io());
+    EXPECT_TRUE(file->remove());
+    GTEST_SKIP() << "direct I/O is not supported for " << path;
+  }
+
+  data_buffer data(utils::file::file::direct_io_min_size);
+  for (std::size_t idx = 0U; idx < data.size(); ++idx) {
+    data.at(idx) = static_cast<unsigned char>(idx % 251U);
+  }
+
+  std::unique_ptr<unsigned char, decltype(&std::free)> aligned(
+      static_cast<unsigned char *>(std::aligned_alloc(
+          utils::file::file::direct_io_alignment, data.size())),
+      &std::free);
+  ASSERT_TRUE(aligned);
+  std::copy(data.begin(), data.end(), aligned.get());
+
+  // Leading byte shifts the source so it is not page aligned and the transfer
+  // falls back to buffered I/O
+  data_buffer unaligned(data.size() + 1U);
+  std::copy(data.begin(), data.end(), std::next(unaligned.begin()));
+
+  std::size_t bytes_written{};
+  EXPECT_TRUE(file->write(aligned.get(), data.size(), 0U, &bytes_written));
+  EXPECT_EQ(data.size(), bytes_written);
+  EXPECT_TRUE(
+      file->write(&unaligned.at(1U), data.size(), data.size(), &bytes_written));
+  EXPECT_EQ(data.size(), bytes_written);
+
+  data_buffer read_data(data.size());
+  std::size_t bytes_read{};
+  EXPECT_TRUE(file->read(read_data, 0U, &bytes_read));
+  EXPECT_EQ(data.size(), bytes_read);
+  EXPECT_EQ(data, read_data);
+
+  std::fill_n(aligned.get(), data.size(), 0U);
+  EXPECT_TRUE(file->read(aligned.get(), data.size(), data.size(), &bytes_read));
+  EXPECT_EQ(data.size(), bytes_read);
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), aligned.get()));
+
+  data_buffer partial(100U);
+  EXPECT_TRUE(file->read(partial, 7U, &bytes_read));
+  EXPECT_EQ(partial.size(), bytes_read);
+  EXPECT_TRUE(std::equal(partial.begin(), partial.end(),
+                         std::next(data.begin(), 7)));
+
+  EXPECT_TRUE(file->truncate(data.size() / 2U));
+  EXPECT_TRUE(file->is_direct_io());
+  EXPECT_TRUE(file->remove());
+}
+
 // TEST(utils_file, can_attach_file) {
 //   for (auto idx = 0U; idx < file_type_count; ++idx) {
 //     auto path = test::generate_test_file_name("utils_file");
@@ -32,6 +32,7 @@ const primaryAlpha = 0.12;
 const primarySurfaceAlpha = 92.0;
 const protocolTypeList = ['http', 'https'];
 const providerTypeList = ['Encrypt', 'Remote', 'S3', 'Sia'];
+const readAheadPolicyList = ['adaptive', 'full', 'none'];
 const ringBufferSizeList = ['128', '256', '512', '1024', '2048'];
 const secondaryAlpha = 0.45;
 const secondarySurfaceAlpha = 70.0;
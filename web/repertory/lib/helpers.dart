@@ -194,10 +194,18 @@ String? getSettingDescription(String settingPath) {
       return "HTTP authentication password";
     case 'ApiUser':
       return "HTTP authentication user";
+    case 'ChunkCacheSizeBytes':
+      return "Memory shared by all open files for downloaded chunks";
     case 'HostConfig.ApiPassword':
       return "RENTERD_API_PASSWORD";
     case 'S3Config.ForceLegacyEncryption':
       return "Effectively disables Argon2id KDF";
+    case 'DirectoryCacheTimeoutSeconds':
+      return "Seconds a directory listing is served from memory";
+    case 'KernelAttrTimeoutSeconds':
+      return "Seconds the OS may cache file attributes and lookups";
+    case 'S3Config.UploadPartSize':
+      return "Multipart upload part size in MiB";
     default:
       return null;
   }
@@ -211,6 +219,8 @@ List<Validator> getSettingValidators(String settingPath) {
       return [(value) => constants.databaseTypeList.contains(value)];
     case 'PreferredDownloadType':
       return [(value) => constants.downloadTypeList.contains(value)];
+    case 'ReadAheadPolicy':
+      return [(value) => constants.readAheadPolicyList.contains(value)];
     case 'EventLevel':
       return [(value) => constants.eventLevelList.contains(value)];
     case 'EncryptConfig.EncryptionToken':
@@ -106,6 +106,23 @@ class _MountSettingsWidgetState extends State<MountSettingsWidget> {
             );
           }
           break;
+        case 'ChunkCacheSizeBytes':
+          {
+            createIntSetting(
+              context,
+              commonSettings,
+              widget.settings,
+              key,
+              value,
+              true,
+              widget.showAdvanced,
+              widget,
+              setState,
+              description: getSettingDescription(key),
+              validators: getSettingValidators(key),
+            );
+          }
+          break;
         case 'DatabaseType':
           {
             createStringListSetting(
@@ -124,6 +141,23 @@ class _MountSettingsWidgetState extends State<MountSettingsWidget> {
             );
           }
           break;
+        case 'DirectoryCacheTimeoutSeconds':
+          {
+            createIntSetting(
+              context,
+              commonSettings,
+              widget.settings,
+              key,
+              value,
+              true,
+              widget.showAdvanced,
+              widget,
+              setState,
+              description: getSettingDescription(key),
+              validators: getSettingValidators(key),
+            );
+          }
+          break;
         case 'DownloadTimeoutSeconds':
           {
             createIntSetting(
@@ -224,6 +258,23 @@ class _MountSettingsWidgetState extends State<MountSettingsWidget> {
             );
           }
           break;
+        case 'KernelAttrTimeoutSeconds':
+          {
+            createIntSetting(
+              context,
+              commonSettings,
+              widget.settings,
+              key,
+              value,
+              true,
+              widget.showAdvanced,
+              widget,
+              setState,
+              description: getSettingDescription(key),
+              validators: getSettingValidators(key),
+            );
+          }
+          break;
         case 'MaxCacheSizeBytes':
           {
             createIntSetting(
@@ -241,6 +292,23 @@ class _MountSettingsWidgetState extends State<MountSettingsWidget> {
             );
           }
           break;
+        case 'MaxDownloadCount':
+          {
+            createIntSetting(
+              context,
+              commonSettings,
+              widget.settings,
+              key,
+              value,
+              true,
+              widget.showAdvanced,
+              widget,
+              setState,
+              description: getSettingDescription(key),
+              validators: getSettingValidators(key),
+            );
+          }
+          break;
         case 'MaxUploadCount':
           {
             createIntSetting(
@@ -258,6 +326,23 @@ class _MountSettingsWidgetState extends State<MountSettingsWidget> {
             );
           }
           break;
+        case 'MetaFlushIntervalSeconds':
+          {
+            createIntSetting(
+              context,
+              commonSettings,
+              widget.settings,
+              key,
+              value,
+              true,
+              widget.showAdvanced,
+              widget,
+              setState,
+              description: getSettingDescription(key),
+              validators: getSettingValidators(key),
+            );
+          }
+          break;
         case 'OnlineCheckRetrySeconds':
           {
             createIntSetting(
@@ -293,6 +378,24 @@ class _MountSettingsWidgetState extends State<MountSettingsWidget> {
             );
           }
           break;
+        case 'ReadAheadPolicy':
+          {
+            createStringListSetting(
+              context,
+              commonSettings,
+              widget.settings,
+              key,
+              value,
+              constants.readAheadPolicyList,
+              Icons.fast_forward,
+              true,
+              widget.showAdvanced,
+              widget,
+              setState,
+              description: getSettingDescription(key),
+            );
+          }
+          break;
         case 'RetryReadCount':
           {
             createIntSetting(
@@ -748,6 +851,23 @@ class _MountSettingsWidgetState extends State<MountSettingsWidget> {
             );
           }
           break;
+        case 'MaxUploadPartCount':
+          {
+            createIntSetting(
+              context,
+              s3ConfigSettings,
+              widget.settings[key],
+              subKey,
+              subValue,
+              true,
+              widget.showAdvanced,
+              widget,
+              setState,
+              description: getSettingDescription('$key.$subKey'),
+              validators: getSettingValidators('$key.$subKey'),
+            );
+          }
+          break;
         case 'TimeoutMs':
           {
             createIntSetting(
@@ -765,6 +885,23 @@ class _MountSettingsWidgetState extends State<MountSettingsWidget> {
             );
           }
           break;
+        case 'UploadPartSize':
+          {
+            createIntSetting(
+              context,
+              s3ConfigSettings,
+              widget.settings[key],
+              subKey,
+              subValue,
+              true,
+              widget.showAdvanced,
+              widget,
+              setState,
+              description: getSettingDescription('$key.$subKey'),
+              validators: getSettingValidators('$key.$subKey'),
+            );
+          }
+          break;
         case 'URL':
           {
             createStringSetting(